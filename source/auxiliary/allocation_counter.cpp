@@ -0,0 +1,20 @@
+/** @file */
+
+#include <atomic>
+
+#include "../auxiliary/allocation_counter.h"
+
+namespace
+{
+   std::atomic<std::size_t> global_number_of_allocations {0};
+}
+
+std::size_t ksi::allocation_counter::number_of_allocations()
+{
+   return global_number_of_allocations.load(std::memory_order_relaxed);
+}
+
+void ksi::allocation_counter::count()
+{
+   global_number_of_allocations.fetch_add(1, std::memory_order_relaxed);
+}
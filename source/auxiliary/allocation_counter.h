@@ -0,0 +1,28 @@
+/** @file */
+
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+namespace ksi
+{
+   /** The class counts heap allocations of the whole program.
+       The global operators new and delete are replaced in allocation_counter_new.cpp,
+       which is linked only into the benchmark binary (make bench), so other programs 
+       do not pay for counting and report no allocations.
+       The counter is a relaxed atomic, so its cost is negligible.
+       @date 2026-10-18 */
+   class allocation_counter
+   {
+   public:
+      /** @return number of allocations (calls of operator new) since the start of the program,
+                  0 if the operators are not replaced */
+      static std::size_t number_of_allocations ();
+
+      /** The method counts an allocation (called by the replaced operators new). */
+      static void count ();
+   };
+}
+
+#endif
@@ -0,0 +1,92 @@
+/** @file */
+
+#include <cstdlib>
+#include <new>
+
+#include "../auxiliary/allocation_counter.h"
+
+// Replaced global operators new and delete, linked only into the benchmark binary.
+
+namespace
+{
+   void * counted_allocation (std::size_t size)
+   {
+      ksi::allocation_counter::count();
+      if (size == 0)
+         size = 1;
+      if (void * p = std::malloc(size))
+         return p;
+      throw std::bad_alloc();
+   }
+
+   void * counted_aligned_allocation (std::size_t size, const std::align_val_t alignment)
+   {
+      ksi::allocation_counter::count();
+      const auto align = static_cast<std::size_t>(alignment);
+      // std::aligned_alloc requires a size that is a multiple of the alignment
+      size = size == 0 ? align : (size + align - 1) / align * align;
+      if (void * p = std::aligned_alloc(align, size))
+         return p;
+      throw std::bad_alloc();
+   }
+}
+
+void * operator new (std::size_t size)
+{
+   return counted_allocation(size);
+}
+
+void * operator new[] (std::size_t size)
+{
+   return counted_allocation(size);
+}
+
+void * operator new (std::size_t size, std::align_val_t alignment)
+{
+   return counted_aligned_allocation(size, alignment);
+}
+
+void * operator new[] (std::size_t size, std::align_val_t alignment)
+{
+   return counted_aligned_allocation(size, alignment);
+}
+
+void operator delete (void * p) noexcept
+{
+   std::free(p);
+}
+
+void operator delete[] (void * p) noexcept
+{
+   std::free(p);
+}
+
+void operator delete (void * p, std::size_t) noexcept
+{
+   std::free(p);
+}
+
+void operator delete[] (void * p, std::size_t) noexcept
+{
+   std::free(p);
+}
+
+void operator delete (void * p, std::align_val_t) noexcept
+{
+   std::free(p);
+}
+
+void operator delete[] (void * p, std::align_val_t) noexcept
+{
+   std::free(p);
+}
+
+void operator delete (void * p, std::size_t, std::align_val_t) noexcept
+{
+   std::free(p);
+}
+
+void operator delete[] (void * p, std::size_t, std::align_val_t) noexcept
+{
+   std::free(p);
+}
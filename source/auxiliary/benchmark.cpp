@@ -0,0 +1,136 @@
+/** @file */
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+#include <functional>
+
+#include <sys/resource.h>
+
+#include "../auxiliary/benchmark.h"
+#include "../auxiliary/allocation_counter.h"
+#include "../auxiliary/clock.h"
+#include "../auxiliary/tempus.h"
+#include "../service/exception.h"
+
+ksi::benchmark::benchmark(const std::size_t minimal_repetitions,
+                          const double minimal_time_seconds,
+                          const std::size_t maximal_repetitions)
+: _minimal_repetitions (minimal_repetitions),
+  _maximal_repetitions (maximal_repetitions),
+  _minimal_time_seconds (minimal_time_seconds)
+{
+}
+
+const ksi::benchmark_result & ksi::benchmark::run(const std::string & name,
+                                                  const std::string & parameters,
+                                                  const std::size_t rows,
+                                                  const std::function<void ()> & function,
+                                                  const std::function<void ()> & setup)
+{
+    std::size_t repetitions = 0;
+    std::size_t nanoseconds = 0;
+    std::size_t allocations = 0;
+    const double minimal_nanoseconds = _minimal_time_seconds * 1e9;
+
+    while (repetitions < _maximal_repetitions and
+          (repetitions < _minimal_repetitions or nanoseconds < minimal_nanoseconds))
+    {
+        if (setup)
+            setup();
+
+        ksi::clock zegar;
+        auto allocations_before = ksi::allocation_counter::number_of_allocations();
+        zegar.start();
+        function();
+        zegar.stop();
+        allocations += ksi::allocation_counter::number_of_allocations() - allocations_before;
+        nanoseconds += zegar.elapsed_nanoseconds();
+        ++repetitions;
+    }
+
+    ksi::benchmark_result result;
+    result.name = name;
+    result.parameters = parameters;
+    result.repetitions = repetitions;
+    result.rows = rows;
+    result.ns_per_op = repetitions ? 1.0 * nanoseconds / repetitions : 0.0;
+    result.rows_per_second = nanoseconds ? 1e9 * rows * repetitions / nanoseconds : 0.0;
+    result.allocations_per_op = repetitions ? 1.0 * allocations / repetitions : 0.0;
+    result.peak_rss_kB = peak_resident_set_size();
+
+    _results.push_back(result);
+    return _results.back();
+}
+
+void ksi::benchmark::add_measurement(const std::string & name, const double value)
+{
+    if (_results.empty())
+        throw ksi::exception ("No benchmark has been run, the measurement " + name + " cannot be added.");
+    _results.back().measurements.push_back({ name, value });
+}
+
+const std::vector<ksi::benchmark_result> & ksi::benchmark::get_results() const
+{
+    return _results;
+}
+
+std::size_t ksi::benchmark::peak_resident_set_size()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, & usage) != 0)
+        return 0;
+    return usage.ru_maxrss; // kB on Linux
+}
+
+std::string ksi::benchmark::escape(const std::string & s)
+{
+    std::string result;
+    for (const char c : s)
+    {
+        switch (c)
+        {
+            case '"'  : result += "\\\""; break;
+            case '\\' : result += "\\\\"; break;
+            case '\n' : result += "\\n";  break;
+            case '\t' : result += "\\t";  break;
+            default   : result += c;
+        }
+    }
+    return result;
+}
+
+std::string ksi::benchmark::to_json() const
+{
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "{" << std::endl;
+    ss << "  \"date\": \"" << ksi::tempus::getDateTimeNow() << "\"," << std::endl;
+    ss << "  \"benchmarks\": [" << std::endl;
+    for (std::size_t i = 0; i < _results.size(); i++)
+    {
+        const auto & r = _results[i];
+        ss << "    {";
+        ss << "\"name\": \"" << escape(r.name) << "\", ";
+        ss << "\"parameters\": \"" << escape(r.parameters) << "\", ";
+        ss << "\"repetitions\": " << r.repetitions << ", ";
+        ss << "\"rows\": " << r.rows << ", ";
+        ss << "\"ns_per_op\": " << r.ns_per_op << ", ";
+        ss << "\"rows_per_s\": " << r.rows_per_second << ", ";
+        ss << "\"allocations_per_op\": " << r.allocations_per_op << ", ";
+        ss << "\"peak_rss_kB\": " << r.peak_rss_kB;
+        if (not r.measurements.empty())
+        {
+            ss << ", \"measurements\": {";
+            for (std::size_t m = 0; m < r.measurements.size(); m++)
+                ss << (m > 0 ? ", " : "") << "\"" << escape(r.measurements[m].first) << "\": " 
+                   << std::scientific << r.measurements[m].second << std::fixed;
+            ss << "}";
+        }
+        ss << "}" << (i + 1 < _results.size() ? "," : "") << std::endl;
+    }
+    ss << "  ]" << std::endl;
+    ss << "}" << std::endl;
+    return ss.str();
+}
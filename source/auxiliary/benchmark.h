@@ -0,0 +1,93 @@
+/** @file */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <utility>
+
+namespace ksi
+{
+   /** Result of one benchmark.
+       @date 2026-10-18 */
+   struct benchmark_result
+   {
+      /** name of the benchmark */
+      std::string name;
+      /** parameters of the benchmark, eg. "n=1000 d=4 c=4" */
+      std::string parameters;
+      /** number of timed repetitions */
+      std::size_t repetitions = 0;
+      /** number of data items processed in one repetition */
+      std::size_t rows = 0;
+      /** average time of one repetition */
+      double ns_per_op = 0.0;
+      /** processed data items per second */
+      double rows_per_second = 0.0;
+      /** average number of heap allocations in one repetition */
+      double allocations_per_op = 0.0;
+      /** peak resident set size of the process after the benchmark */
+      std::size_t peak_rss_kB = 0;
+      /** additional measured values (eg. errors), pairs: name, value */
+      std::vector<std::pair<std::string, double>> measurements;
+   };
+
+   /** The class runs benchmarks and prints their results in JSON.
+       A benchmarked function is repeated until it has been run 
+       at least the minimal number of times and for at least the minimal time.
+       @date 2026-10-18 */
+   class benchmark
+   {
+   protected:
+      std::size_t _minimal_repetitions;
+      std::size_t _maximal_repetitions;
+      double _minimal_time_seconds;
+      std::vector<benchmark_result> _results;
+
+   public:
+      /** @param minimal_repetitions minimal number of repetitions of a benchmarked function
+          @param minimal_time_seconds minimal time of all repetitions of a benchmarked function
+          @param maximal_repetitions maximal number of repetitions of a benchmarked function */
+      benchmark (const std::size_t minimal_repetitions = 1,
+                 const double minimal_time_seconds = 0.2,
+                 const std::size_t maximal_repetitions = 1000);
+
+      /** The method runs a benchmark.
+          @param name name of the benchmark
+          @param parameters parameters of the benchmark
+          @param rows number of data items processed by one call of the function
+          @param function function to benchmark
+          @param setup function called (not timed) before each call of the benchmarked function,
+                 eg. for copying data the benchmarked function modifies
+          @return result of the benchmark */
+      const benchmark_result & run (const std::string & name,
+                                    const std::string & parameters,
+                                    const std::size_t rows,
+                                    const std::function<void ()> & function,
+                                    const std::function<void ()> & setup = {});
+
+      /** The method adds a measured value (eg. an error) to the result of the last benchmark.
+          @param name name of the value
+          @param value the value
+          @throw ksi::exception if no benchmark has been run
+          @date 2026-10-18 */
+      void add_measurement (const std::string & name, const double value);
+
+      /** @return results of all benchmarks run */
+      const std::vector<benchmark_result> & get_results () const;
+
+      /** @return results of all benchmarks in JSON */
+      std::string to_json () const;
+
+      /** @return peak resident set size of the process in kB (0 if unavailable) */
+      static std::size_t peak_resident_set_size ();
+
+   protected:
+      /** @return a string with escaped characters for JSON */
+      static std::string escape (const std::string & s);
+   };
+}
+
+#endif
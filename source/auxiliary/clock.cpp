@@ -27,3 +27,7 @@ std::size_t ksi::clock::elapsed_milliseconds()
     return (std::chrono::duration_cast<std::chrono::milliseconds>(_stop - _start)).count();
 }
 
+std::size_t ksi::clock::elapsed_nanoseconds()
+{
+    return (std::chrono::duration_cast<std::chrono::nanoseconds>(_stop - _start)).count();
+}
@@ -40,6 +40,11 @@ namespace ksi
         */
       std::size_t elapsed_milliseconds();
 
+      /** @return elapsed nanoseconds 
+        * @date 2026-10-18 
+        */
+      std::size_t elapsed_nanoseconds();
+
    };
 }
 
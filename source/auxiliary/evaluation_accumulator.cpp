@@ -0,0 +1,278 @@
+/** @file */
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "evaluation_accumulator.h"
+#include "../service/debug.h"
+
+namespace
+{
+   /** number of answers in a chunk accumulated by one thread */
+   const std::size_t CHUNK_SIZE = 16384;
+}
+
+ksi::evaluation_accumulator::evaluation_accumulator()
+{
+}
+
+ksi::evaluation_accumulator::evaluation_accumulator(const double positiveClassvalue,
+                                                    const double negativeClassvalue,
+                                                    const std::vector<double> & thresholds)
+: _classification (true),
+  _positive_class (positiveClassvalue), _negative_class (negativeClassvalue),
+  _epsilon (std::fabs(positiveClassvalue - negativeClassvalue) / 4),
+  _thresholds (thresholds),
+  _positives (thresholds.size() + 1, 0.0), _negatives (thresholds.size() + 1, 0.0)
+{
+   std::sort(_thresholds.begin(), _thresholds.end());
+}
+
+ksi::evaluation_accumulator::evaluation_accumulator(const double positiveClassvalue,
+                                                    const double negativeClassvalue,
+                                                    const std::vector<double> & thresholds,
+                                                    const ksi::roc_histogram & histogram)
+: evaluation_accumulator (positiveClassvalue, negativeClassvalue, thresholds)
+{
+   try
+   {
+      if (histogram.size() > 0)
+         throw ksi::exception ("The histogram is not empty (" + std::to_string(histogram.size()) + " answers).");
+      _histogram = histogram;
+   }
+   CATCH;
+}
+
+void ksi::evaluation_accumulator::add(const double expected, const double elaborated, const double weight)
+{
+   _number_of_items++;
+
+   const double error = elaborated - expected;
+   _sum_of_squared_errors  += weight * error * error;
+   _sum_of_absolute_errors += weight * std::fabs(error);
+
+   const double sum_of_weights = _sum_of_weights + weight;
+   if (sum_of_weights > 0)
+   {
+      const double delta = expected - _mean_expected;
+      _mean_expected += delta * weight / sum_of_weights;
+      _squared_deviations_expected += weight * delta * (expected - _mean_expected);
+   }
+   _sum_of_weights = sum_of_weights;
+
+   if (_classification)
+   {
+      // number of thresholds <= elaborated
+      const std::size_t k = std::upper_bound(_thresholds.begin(), _thresholds.end(), elaborated) - _thresholds.begin();
+      if (std::fabs(expected - _negative_class) < _epsilon)
+         _negatives[k] += weight;
+      else
+         _positives[k] += weight;
+   }
+
+   if (_histogram)
+      _histogram->add(expected, elaborated);
+}
+
+void ksi::evaluation_accumulator::add(const std::vector<double> & Expected, const std::vector<double> & Elaborated)
+{
+   try
+   {
+      if (Expected.size() != Elaborated.size())
+         throw ksi::exception ("Sizes of vectors do not match: expected (" + std::to_string(Expected.size()) + ") and elaborated (" + std::to_string(Elaborated.size()) + ").");
+      add_chunks(Expected, Elaborated, nullptr);
+   }
+   CATCH;
+}
+
+void ksi::evaluation_accumulator::add(const std::vector<double> & Expected, const std::vector<double> & Elaborated, const std::vector<double> & Weights)
+{
+   try
+   {
+      if (Expected.size() != Elaborated.size() or Expected.size() != Weights.size())
+         throw ksi::exception ("Sizes of vectors do not match: expected (" + std::to_string(Expected.size()) + "), elaborated (" + std::to_string(Elaborated.size()) + ") and weights (" + std::to_string(Weights.size()) + ").");
+      add_chunks(Expected, Elaborated, & Weights);
+   }
+   CATCH;
+}
+
+void ksi::evaluation_accumulator::add_chunks(const std::vector<double> & Expected, const std::vector<double> & Elaborated,
+                                             const std::vector<double> * pWeights)
+{
+   try
+   {
+      const std::size_t nItems = Expected.size();
+      const std::size_t nChunks = (nItems + CHUNK_SIZE - 1) / CHUNK_SIZE;
+      std::vector<ksi::evaluation_accumulator> partials (nChunks, empty_copy());
+
+      #pragma omp parallel for
+      for (std::size_t c = 0; c < nChunks; c++)
+      {
+         const std::size_t last = std::min(nItems, (c + 1) * CHUNK_SIZE);
+         for (std::size_t i = c * CHUNK_SIZE; i < last; i++)
+            partials[c].add(Expected[i], Elaborated[i], pWeights ? (*pWeights)[i] : 1.0);
+      }
+
+      for (const auto & partial : partials)
+         *this += partial;
+   }
+   CATCH;
+}
+
+ksi::evaluation_accumulator & ksi::evaluation_accumulator::operator += (const ksi::evaluation_accumulator & other)
+{
+   try
+   {
+      if (_classification != other._classification
+          or _positive_class != other._positive_class
+          or _negative_class != other._negative_class
+          or _thresholds != other._thresholds)
+         throw ksi::exception ("The accumulators have different labels or thresholds.");
+      if (_histogram.has_value() != other._histogram.has_value())
+         throw ksi::exception ("Only one of the accumulators has a histogram.");
+
+      _number_of_items += other._number_of_items;
+      _sum_of_squared_errors  += other._sum_of_squared_errors;
+      _sum_of_absolute_errors += other._sum_of_absolute_errors;
+
+      const double sum_of_weights = _sum_of_weights + other._sum_of_weights;
+      if (sum_of_weights > 0)
+      {
+         const double delta = other._mean_expected - _mean_expected;
+         _squared_deviations_expected += other._squared_deviations_expected
+                                       + delta * delta * _sum_of_weights * other._sum_of_weights / sum_of_weights;
+         _mean_expected += delta * other._sum_of_weights / sum_of_weights;
+      }
+      _sum_of_weights = sum_of_weights;
+
+      for (std::size_t k = 0; k < _positives.size(); k++)
+      {
+         _positives[k] += other._positives[k];
+         _negatives[k] += other._negatives[k];
+      }
+
+      if (_histogram)
+         *_histogram += *other._histogram;
+      return *this;
+   }
+   CATCH;
+}
+
+void ksi::evaluation_accumulator::clear()
+{
+   _number_of_items = 0;
+   _sum_of_weights = 0;
+   _sum_of_squared_errors = 0;
+   _sum_of_absolute_errors = 0;
+   _mean_expected = 0;
+   _squared_deviations_expected = 0;
+   std::fill(_positives.begin(), _positives.end(), 0.0);
+   std::fill(_negatives.begin(), _negatives.end(), 0.0);
+   if (_histogram)
+      _histogram->clear();
+}
+
+ksi::evaluation_accumulator ksi::evaluation_accumulator::empty_copy() const
+{
+   ksi::evaluation_accumulator copy (*this);
+   copy.clear();
+   return copy;
+}
+
+std::size_t ksi::evaluation_accumulator::size() const
+{
+   return _number_of_items;
+}
+
+double ksi::evaluation_accumulator::sum_of_weights() const
+{
+   return _sum_of_weights;
+}
+
+double ksi::evaluation_accumulator::RMSE() const
+{
+   if (_sum_of_weights > 0)
+      return std::sqrt(_sum_of_squared_errors / _sum_of_weights);
+   return 0.0;
+}
+
+double ksi::evaluation_accumulator::MAE() const
+{
+   if (_sum_of_weights > 0)
+      return _sum_of_absolute_errors / _sum_of_weights;
+   return 0.0;
+}
+
+double ksi::evaluation_accumulator::R2() const
+{
+   if (_squared_deviations_expected > 0)
+      return 1.0 - _sum_of_squared_errors / _squared_deviations_expected;
+   return std::numeric_limits<double>::quiet_NaN();
+}
+
+const std::vector<double> & ksi::evaluation_accumulator::thresholds() const
+{
+   return _thresholds;
+}
+
+std::vector<ksi::evaluation_accumulator::confusion> ksi::evaluation_accumulator::confusion_matrices() const
+{
+   try
+   {
+      if (not _classification)
+         throw ksi::exception ("The accumulator has no classification metrics.");
+
+      // items elaborated as positive for threshold t_i lie in intervals k > i
+      double positives_above = 0, negatives_above = 0;
+      double positives_all = 0, negatives_all = 0;
+      for (std::size_t k = 0; k < _positives.size(); k++)
+      {
+         positives_all += _positives[k];
+         negatives_all += _negatives[k];
+      }
+
+      const std::size_t nThresholds = _thresholds.size();
+      std::vector<confusion> result (nThresholds);
+      for (std::size_t i = nThresholds; i-- > 0; )
+      {
+         positives_above += _positives[i + 1];
+         negatives_above += _negatives[i + 1];
+         auto & matrix = result[i];
+         matrix.threshold = _thresholds[i];
+         matrix.TP = positives_above;
+         matrix.FP = negatives_above;
+         matrix.FN = positives_all - positives_above;
+         matrix.TN = negatives_all - negatives_above;
+      }
+      return result;
+   }
+   CATCH;
+}
+
+bool ksi::evaluation_accumulator::has_histogram() const
+{
+   return _histogram.has_value();
+}
+
+const ksi::roc_histogram & ksi::evaluation_accumulator::histogram() const
+{
+   try
+   {
+      if (not _histogram)
+         throw ksi::exception ("The accumulator has no histogram.");
+      return *_histogram;
+   }
+   CATCH;
+}
+
+double ksi::evaluation_accumulator::AUC() const
+{
+   try
+   {
+      return histogram().AUC();
+   }
+   CATCH;
+}
@@ -0,0 +1,158 @@
+/** @file */
+
+#ifndef EVALUATION_ACCUMULATOR_H
+#define EVALUATION_ACCUMULATOR_H
+
+#include <vector>
+#include <cstddef>
+#include <optional>
+
+#include "roc_histogram.h"
+
+namespace ksi
+{
+   /** The class evaluates regression and classification metrics in one pass
+       over pairs (expected, elaborated) with optional weights.
+       Partial accumulators (e.g. for chunks of data elaborated in parallel,
+       or for windows of a stream of answers) can be merged.
+       The state does not depend on the number of answers:
+       - regression: weighted sums of squared and absolute errors and
+         the weighted mean and sum of squared deviations of expected values
+         (merged with the Chan et al. formula), so RMSE, MAE and R^2 are available,
+       - classification (optional): for sorted thresholds t_0 < ... < t_{T-1}
+         weights of positive and negative items in T + 1 intervals between thresholds,
+         so confusion matrices for all thresholds are elaborated from cumulative sums;
+         an item is elaborated as positive for threshold t if elaborated >= t
+         (as in ksi::confusion_matrix),
+       - ROC (optional): a ksi::roc_histogram for AUC (it counts items, weights are ignored).
+       An expected value is negative if it differs from the negative label less than
+       a quarter of the distance between labels, otherwise it is positive (as in ksi::roc_histogram).
+       @date 2026-10-19 */
+   class evaluation_accumulator
+   {
+   public:
+      /** weighted confusion matrix for a threshold */
+      struct confusion
+      {
+         double threshold;
+         double TP = 0; ///< true positives
+         double TN = 0; ///< true negatives
+         double FP = 0; ///< false positives
+         double FN = 0; ///< false negatives
+      };
+
+   protected:
+      std::size_t _number_of_items = 0;
+      double _sum_of_weights = 0;
+      double _sum_of_squared_errors = 0;
+      double _sum_of_absolute_errors = 0;
+      /** weighted mean of expected values */
+      double _mean_expected = 0;
+      /** weighted sum of squared deviations of expected values from their mean */
+      double _squared_deviations_expected = 0;
+
+      bool _classification = false;
+      double _positive_class = 1;
+      double _negative_class = 0;
+      /** tolerance for recognition of a negative label */
+      double _epsilon = 0;
+      /** sorted thresholds */
+      std::vector<double> _thresholds;
+      /** weights of positive items: _positives[k] for items with k thresholds <= elaborated */
+      std::vector<double> _positives;
+      /** weights of negative items: _negatives[k] for items with k thresholds <= elaborated */
+      std::vector<double> _negatives;
+
+      std::optional<ksi::roc_histogram> _histogram;
+
+   public:
+      /** An accumulator for regression metrics only. */
+      evaluation_accumulator ();
+
+      /** An accumulator for regression and classification metrics.
+          @param positiveClassvalue label of positive class
+          @param negativeClassvalue label of negative class
+          @param thresholds thresholds for confusion matrices (any order) */
+      evaluation_accumulator (const double positiveClassvalue,
+                              const double negativeClassvalue,
+                              const std::vector<double> & thresholds);
+
+      /** An accumulator for regression and classification metrics and the ROC histogram.
+          @param positiveClassvalue label of positive class
+          @param negativeClassvalue label of negative class
+          @param thresholds thresholds for confusion matrices (any order)
+          @param histogram an empty histogram with the same labels
+          @throw ksi::exception if the histogram is not empty */
+      evaluation_accumulator (const double positiveClassvalue,
+                              const double negativeClassvalue,
+                              const std::vector<double> & thresholds,
+                              const ksi::roc_histogram & histogram);
+
+      /** The method adds an answer (e.g. in a stream of answers).
+          @param expected expected value (class label for classification)
+          @param elaborated elaborated numeric value
+          @param weight weight of the answer */
+      void add (const double expected, const double elaborated, const double weight = 1.0);
+
+      /** The method adds answers. Chunks of answers are accumulated in parallel
+          and merged in a fixed order, so results do not depend on the number of threads.
+          @throw ksi::exception if the sizes of vectors do not match */
+      void add (const std::vector<double> & Expected, const std::vector<double> & Elaborated);
+
+      /** The method adds weighted answers.
+          @throw ksi::exception if the sizes of vectors do not match */
+      void add (const std::vector<double> & Expected, const std::vector<double> & Elaborated, const std::vector<double> & Weights);
+
+      /** The method merges answers of another accumulator.
+          @throw ksi::exception if the accumulators have different labels, thresholds or histograms */
+      evaluation_accumulator & operator += (const evaluation_accumulator & other);
+
+      /** The method removes all answers (e.g. at the beginning of a new monitoring window). */
+      void clear ();
+
+      /** @return number of answers */
+      std::size_t size () const;
+
+      /** @return sum of weights of answers */
+      double sum_of_weights () const;
+
+      /** @return root mean square error */
+      double RMSE () const;
+
+      /** @return mean absolute error */
+      double MAE () const;
+
+      /** @return coefficient of determination R^2 = 1 - SSE / SST,
+                  NaN if all expected values are equal */
+      double R2 () const;
+
+      /** @return sorted thresholds */
+      const std::vector<double> & thresholds () const;
+
+      /** @return confusion matrices for all thresholds (in order of ksi::evaluation_accumulator::thresholds)
+          @throw ksi::exception if the accumulator has no classification metrics */
+      std::vector<confusion> confusion_matrices () const;
+
+      /** @return true if the accumulator has a ROC histogram */
+      bool has_histogram () const;
+
+      /** @return the ROC histogram
+          @throw ksi::exception if the accumulator has no histogram */
+      const ksi::roc_histogram & histogram () const;
+
+      /** @return area under ROC curve elaborated with the histogram
+          @throw ksi::exception if the accumulator has no histogram */
+      double AUC () const;
+
+   protected:
+      /** @return an empty accumulator with the same labels, thresholds and histogram bins */
+      evaluation_accumulator empty_copy () const;
+
+      /** The method adds answers in chunks in parallel.
+          @param pWeights weights of answers, nullptr for unit weights */
+      void add_chunks (const std::vector<double> & Expected, const std::vector<double> & Elaborated,
+                       const std::vector<double> * pWeights);
+   };
+}
+
+#endif
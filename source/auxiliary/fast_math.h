@@ -0,0 +1,92 @@
+/** @file */
+
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+namespace ksi
+{
+   /** Fast approximations of transcendental functions used in memberships.
+    *  The functions have no branches on data (only clamps and selects), are inlined,
+    *  and elaborate values in double for both float and double arguments.
+    *  Maximal errors (measured in the benchmark ksi::exp_bench,
+    *  where they are checked against the bounds below) are:
+    *  - exp:  relative error EXP_MAX_RELATIVE_ERROR for x in [-708, 709],
+    *          for x < -708 the result is exp(-708) (absolute error < 1e-307),
+    *          for x > 709 the result is exp(709),
+    *  - tanh: absolute error TANH_MAX_ABSOLUTE_ERROR,
+    *  - atan: absolute error ATAN_MAX_ABSOLUTE_ERROR.
+    *  For float arguments the rounding of the result to float
+    *  (relative error 6e-8) has to be added.
+    *  @date 2026-10-18
+    */
+   namespace fast_math
+   {
+      const double EXP_MAX_RELATIVE_ERROR  = 1e-8;
+      const double TANH_MAX_ABSOLUTE_ERROR = 1e-8;
+      const double ATAN_MAX_ABSOLUTE_ERROR = 5e-8;
+
+      /** @return approximation of exp(x): x = n ln 2 + r, |r| <= ln 2 / 2,
+                  exp(r) is approximated with a polynomial of degree 7,
+                  2^n is composed directly in the exponent bits.
+                  The argument is clamped to [-708, 709], NaN is passed through.
+                  The clamp is the only comparison, loops over arrays vectorise 
+                  if compiled with -fno-trapping-math. */
+      template <class T>
+      inline T exp (const T x)
+      {
+         const double LOG2E = 1.4426950408889634;
+         const double LN2   = 0.6931471805599453;
+         // 1.5 * 2^52: adding it rounds to an integer that is stored in low bits of the mantissa
+         const double ROUND = 6755399441055744.0;
+
+         // NaN passes through std::max and std::min
+         const double z = std::min(std::max(static_cast<double>(x), -708.0), 709.0);
+         const double shifted = z * LOG2E + ROUND;
+         const double n = shifted - ROUND;
+         const double r = z - n * LN2;
+         const double p = 1.0 + r * (1.0 + r * (1.0 / 2 + r * (1.0 / 6 + r * (1.0 / 24
+                        + r * (1.0 / 120 + r * (1.0 / 720 + r * (1.0 / 5040)))))));
+         // low bits of shifted hold n, the bits above the exponent field are shifted out
+         const std::uint64_t bits = (std::bit_cast<std::uint64_t>(shifted) + 1023) << 52;
+         return static_cast<T>(p * std::bit_cast<double>(bits));
+      }
+
+      /** @return approximation of tanh(x) = sign(x) (1 - 2 / (exp(2|x|) + 1)) with ksi::fast_math::exp */
+      template <class T>
+      inline T tanh (const T x)
+      {
+         const double e = fast_math::exp(2.0 * std::fabs(static_cast<double>(x)));
+         return static_cast<T>(std::copysign(1.0 - 2.0 / (e + 1.0), static_cast<double>(x)));
+      }
+
+      /** @return approximation of atan(x): the argument is reduced to |t| <= tan(pi/8)
+                  with atan(x) = pi/4 + atan((x - 1)/(x + 1)) and atan(x) = pi/2 - atan(1/x),
+                  atan(t) is approximated with an odd polynomial of degree 9 
+                  (minimax coefficients of atanf from the Cephes library) */
+      template <class T>
+      inline T atan (const T x)
+      {
+         const double PI_2 = 1.5707963267948966;
+         const double PI_4 = 0.7853981633974483;
+         const double TAN_3PI_8 = 2.414213562373095;
+         const double TAN_PI_8  = 0.4142135623730950;
+
+         const double a = std::fabs(static_cast<double>(x));
+         const bool big    = a > TAN_3PI_8;
+         const bool middle = a > TAN_PI_8;
+         // one division: -1 / a, (a - 1) / (a + 1), or a / 1
+         const double t = (big ? -1.0 : (middle ? a - 1.0 : a)) / (big ? a : (middle ? a + 1.0 : 1.0));
+         const double offset = big ? PI_2 : (middle ? PI_4 : 0.0);
+         const double t2 = t * t;
+         const double p = t + t * t2 * (-3.33329491539e-1 + t2 * (1.99777106478e-1 + t2 * (-1.38776856032e-1 + t2 * 8.05374449538e-2)));
+         return static_cast<T>(std::copysign(offset + p, static_cast<double>(x)));
+      }
+   }
+}
+
+#endif
@@ -4,9 +4,12 @@
 
 #include "../auxiliary/least-error-squares-regression.h"
 #include "../auxiliary/matrix.h"
+#include "../auxiliary/profiler.h"
 #include "../service/debug.h"
+#include "../service/exception.h"
  
 #include <vector>
+#include <string>
 
 const double ksi::least_square_error_regression::BIG_NUMBER = 1'000'000'000;
 
@@ -62,6 +65,7 @@ std::vector<double> ksi::least_square_error_regression::recursive_weighted_linea
          const std::vector<double> & W
       )
 {
+   ksi::scoped_timer timer ("least squares", X.size());
    //const double BIG_NUMBER = 1'000'000'000;
    Matrix<double> mX (X);
 
@@ -115,105 +119,101 @@ ksi::least_square_error_regression::least_square_error_regression (std::size_t n
    
 }
 
-void ksi::least_square_error_regression::read_data_item (
-   const std::vector<double> & X, const double Y)
+ksi::least_square_error_regression::least_square_error_regression (std::size_t nAttr, const double forgetting_factor)
+: least_square_error_regression (nAttr)
 {
-   //read_data_item(X, Y, 1.0); // waga = 1
-   
+   set_forgetting_factor(forgetting_factor);
+}
+
+void ksi::least_square_error_regression::set_forgetting_factor(const double forgetting_factor)
+{
+   try
    {
-      std::size_t nAttr = X.size();
-      std::vector<double> Rx (nAttr, 0.0);
-      for (std::size_t a = 0; a < nAttr; a++)
-      {
-         for (std::size_t k = 0; k < nAttr; k++)
-            Rx[a] += wR[a][k] * X[k];
-      }
+      if (not (forgetting_factor > 0.0 and forgetting_factor <= 1.0))
+         throw ksi::exception ("The forgetting factor (" + std::to_string(forgetting_factor) + ") should be in (0, 1].");
+      _forgetting_factor = forgetting_factor;
+   }
+   CATCH;
+}
 
-      double xTRx = 0.0;
-      for (std::size_t a = 0; a < nAttr; a++)
-         xTRx += X[a] * Rx[a];
-      
-      auto wspolczynnik = (1.0 / (1 + xTRx));
-      
-      double xTTheta = 0.0;
-      for (std::size_t a = 0; a < nAttr; a++)
-         xTTheta += X[a] * wTheta[a];
-      
-      for (std::size_t a = 0; a < nAttr; a++)
-         wTheta[a] += (Rx[a] * wspolczynnik * (Y - xTTheta));
-      
-      auto RxxT = wR;
-      for (std::size_t w = 0; w < nAttr; w++)
-      {
-         for (std::size_t k = 0; k < nAttr; k++)
-         {
-            RxxT[w][k] = Rx[w] * X[k];
-         }
-      }
-      
-      auto RxxTR = matrix_multiplication(RxxT, wR);
-      for (std::size_t w = 0; w < nAttr; w++)
-      {
-         for (std::size_t k = 0; k < nAttr; k++)
-            wR[w][k] -= (RxxTR[w][k] * wspolczynnik);
-      }
+void ksi::least_square_error_regression::set_regression_coefficients(const std::vector<double> & coefficients)
+{
+   try
+   {
+      if (coefficients.size() != wTheta.size())
+         throw ksi::exception ("The number of coefficients (" + std::to_string(coefficients.size()) + ") does not match the regression (" + std::to_string(wTheta.size()) + ").");
+      wTheta = coefficients;
    }
-    
-   /*
-   Matrix<double> xT = Matrix<double>::RowMatrix (X); // row matrix
-   Matrix<double> x  = Matrix<double>::ColumnMatrix(X); // 
-   auto Rx = R * x;
-   auto wspolczynnik = (1.0 / (1 + (xT * Rx) (0, 0)));
-   // actualisation of theta:
-   theta = theta + Rx * wspolczynnik * (Y - (xT * theta)(0, 0));
-   // actualisation of R: 
-   R -= Rx * xT * R * wspolczynnik;
+   CATCH;
+}
+
+std::size_t ksi::least_square_error_regression::get_number_of_coefficients() const
+{
+   return wTheta.size();
+}
+
+void ksi::least_square_error_regression::add_coefficients(const std::vector<double> & coefficients)
+{
+   std::size_t nOld = wTheta.size();
+   std::size_t nNew = nOld + coefficients.size();
    
-   std::cout << theta << std::endl;
-   */
+   wTheta.insert(wTheta.end(), coefficients.begin(), coefficients.end());
+   for (auto & row : wR)
+      row.resize(nNew, 0.0);
+   wR.resize(nNew, std::vector<double> (nNew, 0.0));
+   for (std::size_t a = nOld; a < nNew; a++)
+      wR[a][a] = BIG_NUMBER;
+}
+
+void ksi::least_square_error_regression::remove_coefficients(const std::size_t first, const std::size_t count)
+{
+   try
+   {
+      if (first > wTheta.size() or count > wTheta.size() - first)
+         throw ksi::exception ("Coefficients [" + std::to_string(first) + ", " + std::to_string(first + count) + ") are out of the regression (" + std::to_string(wTheta.size()) + ").");
+      wTheta.erase(wTheta.begin() + first, wTheta.begin() + first + count);
+      wR.erase(wR.begin() + first, wR.begin() + first + count);
+      for (auto & row : wR)
+         row.erase(row.begin() + first, row.begin() + first + count);
+   }
+   CATCH;
+}
+
+void ksi::least_square_error_regression::read_data_item (
+   const std::vector<double> & X, const double Y)
+{
+   read_data_item(X, Y, 1.0); // waga = 1
 }
 
 void ksi::least_square_error_regression::read_data_item (
    const std::vector<double> & X, const double Y, const double W)
 {
-    
+   std::size_t nAttr = X.size();
+   std::vector<double> Rx (nAttr, 0.0);
+   for (std::size_t a = 0; a < nAttr; a++)
    {
-      std::size_t nAttr = X.size();
-      std::vector<double> Rx (nAttr, 0.0);
-      for (std::size_t a = 0; a < nAttr; a++)
-      {
-         for (std::size_t k = 0; k < nAttr; k++)
-            Rx[a] += wR[a][k] * X[k];
-      }
+      for (std::size_t k = 0; k < nAttr; k++)
+         Rx[a] += wR[a][k] * X[k];
+   }
 
-      double xTRx = 0.0;
-      for (std::size_t a = 0; a < nAttr; a++)
-         xTRx += X[a] * Rx[a];
-      
-      auto wspolczynnik = (1.0 / (1.0 + W * xTRx));
-      
-      double xTTheta = 0.0;
-      for (std::size_t a = 0; a < nAttr; a++)
-         xTTheta += X[a] * wTheta[a];
-      
-      for (std::size_t a = 0; a < nAttr; a++)
-         wTheta[a] += (W * Rx[a] * wspolczynnik * (Y - xTTheta));
-      
-      auto RxxT = wR;
-      for (std::size_t w = 0; w < nAttr; w++)
-      {
-         for (std::size_t k = 0; k < nAttr; k++)
-         {
-            RxxT[w][k] = Rx[w] * X[k];
-         }
-      }
-      
-      auto RxxTR = matrix_multiplication(RxxT, wR);
-      for (std::size_t w = 0; w < nAttr; w++)
-      {
-         for (std::size_t k = 0; k < nAttr; k++)
-            wR[w][k] -= (W * RxxTR[w][k] * wspolczynnik);
-      }
+   double xTRx = 0.0;
+   for (std::size_t a = 0; a < nAttr; a++)
+      xTRx += X[a] * Rx[a];
+   
+   auto wspolczynnik = (W / (_forgetting_factor + W * xTRx));
+   
+   double xTTheta = 0.0;
+   for (std::size_t a = 0; a < nAttr; a++)
+      xTTheta += X[a] * wTheta[a];
+   
+   for (std::size_t a = 0; a < nAttr; a++)
+      wTheta[a] += (Rx[a] * wspolczynnik * (Y - xTTheta));
+   
+   // R is symmetric, so R x x^T R == (Rx) (Rx)^T: O(p^2) instead of a matrix product
+   for (std::size_t w = 0; w < nAttr; w++)
+   {
+      for (std::size_t k = 0; k < nAttr; k++)
+         wR[w][k] = (wR[w][k] - Rx[w] * Rx[k] * wspolczynnik) / _forgetting_factor;
    }
 }
 
@@ -230,6 +230,7 @@ std::vector<double> ksi::least_square_error_regression::recursive_linear_regress
 (const std::vector<std::vector<double>> & X, 
  const std::vector<double> & Y)
 {
+   ksi::scoped_timer timer ("least squares", X.size());
    
    Matrix<double> mX (X);
 
@@ -268,6 +269,7 @@ std::vector<double> ksi::least_square_error_regression::recursive_linear_regress
 
 std::vector<double> ksi::least_square_error_regression::linear_regression (const std::vector<std::vector<double>> & X, const std::vector<double> & Y)
 {
+    ksi::scoped_timer timer ("least squares", X.size());
     try 
     {
         Matrix<double> mX (X);
@@ -303,6 +305,7 @@ std::vector<double> ksi::least_square_error_regression::weighted_linear_regressi
    const std::vector<double> & Y, 
    const std::vector<double> & W)
 {
+    ksi::scoped_timer timer ("least squares", X.size());
     Matrix<double> mX (X);
     Matrix<double> mY (Y.size(), 1);
     Matrix<double> mW (Y.size(), Y.size(), 0.0);
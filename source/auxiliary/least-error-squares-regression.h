@@ -25,6 +25,10 @@ namespace ksi
       /** big number on diagonal of R matrix */
       static const double BIG_NUMBER;
       
+      /** forgetting factor: 1 -- all data items are equally important,
+       *  less than 1 -- older data items are forgotten exponentially */
+      double _forgetting_factor = 1.0;
+      
    public: 
       /** Constructor :-)
        * @param nAttr number of attributes of a data item
@@ -33,6 +37,46 @@ namespace ksi
        */
       least_square_error_regression (std::size_t nAttr);
       
+      /** Constructor
+       * @param nAttr number of attributes of a data item
+       * @param forgetting_factor forgetting factor from (0, 1]
+       * @date 2026-10-18
+       */
+      least_square_error_regression (std::size_t nAttr, const double forgetting_factor);
+      
+   public:
+      /** The method sets the forgetting factor.
+       * @param forgetting_factor forgetting factor from (0, 1]
+       * @throw ksi::exception if the forgetting factor is not in (0, 1]
+       * @date 2026-10-18
+       */
+      void set_forgetting_factor (const double forgetting_factor);
+      
+      /** The method sets regression coefficients, eg. to continue estimation of a trained model.
+       * @param coefficients coefficients (as many as attributes)
+       * @date 2026-10-18
+       */
+      void set_regression_coefficients (const std::vector<double> & coefficients);
+      
+      /** @return number of regression coefficients
+       *  @date 2026-10-18 */
+      std::size_t get_number_of_coefficients () const;
+      
+      /** The method appends coefficients. Their covariances with other coefficients are zero
+       *  and variances are big (the coefficients are not known yet).
+       * @param coefficients initial values of appended coefficients
+       * @date 2026-10-18
+       */
+      void add_coefficients (const std::vector<double> & coefficients);
+      
+      /** The method removes coefficients.
+       * @param first index of the first coefficient to remove
+       * @param count number of coefficients to remove
+       * @throw ksi::exception if the coefficients are out of the regression
+       * @date 2026-10-18
+       */
+      void remove_coefficients (const std::size_t first, const std::size_t count);
+      
    public:
       /** The method reads one data item for recursive regression algorithm.
        * @param X data item
@@ -44,6 +88,7 @@ namespace ksi
 
    public:
       /** The method reads one data item for recursive regression algorithm.
+       * The update costs O(p^2) for p coefficients.
        * @param X data item
        * @param Y corresponding expected output
        * @param W data item's weight
@@ -13,6 +13,11 @@ double ksi::square_root(const double & radicand)
    return sqrt(radicand);
 }
 
+float ksi::square_root(const float & radicand)
+{
+   return std::sqrt(radicand);
+}
+
 ksi::ext_fuzzy_number_gaussian ksi::square_root (const ksi::ext_fuzzy_number_gaussian & radicand)
 {
    return ksi::ext_fuzzy_number_gaussian::sqrt(radicand);
@@ -23,6 +28,11 @@ double ksi::power(const double & base, const double & exponent)
    return pow(base, exponent);
 }
 
+float ksi::power(const float & base, const double & exponent)
+{
+   return std::pow(base, static_cast<float>(exponent));
+}
+
 ksi::ext_fuzzy_number_gaussian ksi::power (const ksi::ext_fuzzy_number_gaussian & base, const double & exponent)
 {
    return ksi::ext_fuzzy_number_gaussian::pow(base, exponent);
@@ -11,12 +11,19 @@ namespace ksi
 {
    /** Just a square root of a double */
    double square_root(const double & radicand);
+   /** Just a square root of a float 
+       @date 2026-10-18 */
+   float square_root(const float & radicand);
    /** @return square root of a gaussian extensional fuzzy number */
    ksi::ext_fuzzy_number_gaussian square_root (const ksi::ext_fuzzy_number_gaussian & radicand);
    
    /** Just a power of a double */
    double power(const double & base, const double & exponent);
 
+   /** Just a power of a float 
+       @date 2026-10-18 */
+   float power(const float & base, const double & exponent);
+
    /** @return power of a gaussian extensional fuzzy number */
    ksi::ext_fuzzy_number_gaussian power (const ksi::ext_fuzzy_number_gaussian & base, const double & exponent);
    
@@ -13,6 +13,7 @@
 #include <chrono>
 
 #include "../service/debug.h"
+#include "../auxiliary/random_service.h"
 #include "../auxiliary/mathematics.h"
 
 namespace ksi
@@ -228,7 +229,7 @@ namespace ksi
            */
          void random_shuffle_rows()
          {
-            static std::default_random_engine engine(std::chrono::system_clock().now().time_since_epoch().count());
+            auto engine = ksi::random_service::next_stream();
             std::shuffle(data.begin(), data.end(), engine);
          }
 
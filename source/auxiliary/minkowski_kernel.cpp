@@ -0,0 +1,91 @@
+/** @file */
+
+#include <vector>
+#include <cmath>
+#include <string>
+
+#include "../auxiliary/minkowski_kernel.h"
+#include "../service/debug.h"
+
+const int ksi::minkowski_kernel::MAXIMAL_INTEGER_EXPONENT = 16;
+
+ksi::minkowski_kernel::minkowski_kernel(const double m) : _m (m), _kind (kind::general), _integer_m (0)
+{
+    if (m == 1.0)
+        _kind = kind::one;
+    else if (m == 2.0)
+        _kind = kind::two;
+    else if (m >= 3.0 and m <= MAXIMAL_INTEGER_EXPONENT and m == std::floor(m))
+    {
+        _kind = kind::integer;
+        _integer_m = static_cast<int>(m);
+    }
+}
+
+double ksi::minkowski_kernel::weighted_sum_of_powers(const double * l, const double * p, const double * w, const std::size_t size) const
+{
+    switch (_kind)
+    {
+        case kind::one     : return weighted_sum_of_powers_of_kind<kind::one>(l, p, w, size);
+        case kind::two     : return weighted_sum_of_powers_of_kind<kind::two>(l, p, w, size);
+        case kind::integer : return weighted_sum_of_powers_of_kind<kind::integer>(l, p, w, size);
+        default            : return weighted_sum_of_powers_of_kind<kind::general>(l, p, w, size);
+    }
+}
+
+double ksi::minkowski_kernel::sum_of_powers(const std::vector<double> & l, const std::vector<double> & p) const
+{
+    try
+    {
+        if (l.size() != p.size())
+            throw ksi::exception ("Numbers of attributes do not match: " + std::to_string(l.size()) + " and " + std::to_string(p.size()) + ".");
+        return weighted_sum_of_powers(l.data(), p.data(), nullptr, l.size());
+    }
+    CATCH;
+}
+
+double ksi::minkowski_kernel::weighted_sum_of_powers(const std::vector<double> & l, const std::vector<double> & p, const std::vector<double> & weights) const
+{
+    try
+    {
+        if (l.size() != p.size() or l.size() != weights.size())
+            throw ksi::exception ("Numbers of attributes do not match: " + std::to_string(l.size()) + ", " + std::to_string(p.size()) + " and " + std::to_string(weights.size()) + " weights.");
+        return weighted_sum_of_powers(l.data(), p.data(), weights.data(), l.size());
+    }
+    CATCH;
+}
+
+std::vector<double> ksi::minkowski_kernel::weighted_sums_of_powers(const std::vector<std::vector<double>> & X,
+                                                                   const std::vector<double> & centre,
+                                                                   const std::vector<double> & weights) const
+{
+    try
+    {
+        const auto size = centre.size();
+        if (weights.size() != size)
+            throw ksi::exception ("Numbers of attributes do not match: " + std::to_string(size) + " and " + std::to_string(weights.size()) + " weights.");
+        for (const auto & x : X)
+            if (x.size() != size)
+                throw ksi::exception ("Numbers of attributes do not match: " + std::to_string(size) + " and " + std::to_string(x.size()) + ".");
+
+        const auto nX = X.size();
+        std::vector<double> sums (nX);
+
+        auto elaborate = [&] <kind K> ()
+        {
+            #pragma omp parallel for
+            for (std::size_t x = 0; x < nX; x++)
+                sums[x] = weighted_sum_of_powers_of_kind<K>(X[x].data(), centre.data(), weights.data(), size);
+        };
+
+        switch (_kind)
+        {
+            case kind::one     : elaborate.template operator()<kind::one>();     break;
+            case kind::two     : elaborate.template operator()<kind::two>();     break;
+            case kind::integer : elaborate.template operator()<kind::integer>(); break;
+            default            : elaborate.template operator()<kind::general>();
+        }
+        return sums;
+    }
+    CATCH;
+}
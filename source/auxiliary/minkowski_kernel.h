@@ -0,0 +1,183 @@
+/** @file */
+
+#ifndef MINKOWSKI_KERNEL_H
+#define MINKOWSKI_KERNEL_H
+
+#include <vector>
+#include <cmath>
+
+namespace ksi
+{
+   /** Powers and roots for the Minkowski distance with an exponent m.
+       The kind of the exponent (1, 2, small integer, general) is recognised
+       once in the constructor. The loops over attributes are specialised
+       for each kind, so the common exponents do not call std::pow for each attribute.
+       @date 2026-10-18 */
+   class minkowski_kernel
+   {
+   public:
+      /** kind of the exponent */
+      enum class kind
+      {
+         one,      ///< m == 1
+         two,      ///< m == 2
+         integer,  ///< integer m in [3, MAXIMAL_INTEGER_EXPONENT]
+         general   ///< other values, std::pow is used
+      };
+
+      /** the largest exponent elaborated with multiplications */
+      static const int MAXIMAL_INTEGER_EXPONENT;
+
+   protected:
+      double _m;
+      kind _kind;
+      int _integer_m;
+
+      /** @return x^n for n >= 0 elaborated by squaring */
+      static double integer_power (double x, int n)
+      {
+         double result = 1.0;
+         while (n > 0)
+         {
+            if (n & 1)
+               result *= x;
+            x *= x;
+            n >>= 1;
+         }
+         return result;
+      }
+
+      /** @return |difference|^m for the kind K */
+      template <kind K>
+      double power_of_kind (const double difference) const
+      {
+         const double d = std::fabs(difference);
+         if constexpr (K == kind::one)
+            return d;
+         else if constexpr (K == kind::two)
+            return d * d;
+         else if constexpr (K == kind::integer)
+            return integer_power(d, _integer_m);
+         else
+            return std::pow(d, _m);
+      }
+
+      /** @return sum of w[a] * |l[a] - p[a]|^m for the kind K;
+          the weights are checked once, not for each attribute */
+      template <kind K>
+      double weighted_sum_of_powers_of_kind (const double * l, const double * p, const double * w, const std::size_t size) const
+      {
+         double sum = 0.0;
+         if (w)
+         {
+            for (std::size_t a = 0; a < size; a++)
+               sum += w[a] * power_of_kind<K>(l[a] - p[a]);
+         }
+         else
+         {
+            for (std::size_t a = 0; a < size; a++)
+               sum += power_of_kind<K>(l[a] - p[a]);
+         }
+         return sum;
+      }
+
+   public:
+      /** @param m exponent of the Minkowski distance */
+      minkowski_kernel (const double m);
+
+      /** @return exponent */
+      double get_exponent () const { return _m; }
+
+      /** @return kind of the exponent */
+      kind get_kind () const { return _kind; }
+
+      /** @return |difference|^m */
+      double power (const double difference) const
+      {
+         switch (_kind)
+         {
+            case kind::one     : return power_of_kind<kind::one>(difference);
+            case kind::two     : return power_of_kind<kind::two>(difference);
+            case kind::integer : return power_of_kind<kind::integer>(difference);
+            default            : return power_of_kind<kind::general>(difference);
+         }
+      }
+
+      /** The method elaborates |difference|^m and |difference|^(m-1) together.
+          @param difference difference of attribute values
+          @param[out] power_m |difference|^m
+          @param[out] power_m_1 |difference|^(m-1) */
+      void powers (const double difference, double & power_m, double & power_m_1) const
+      {
+         const double d = std::fabs(difference);
+         switch (_kind)
+         {
+            case kind::one :
+               power_m = d;
+               power_m_1 = 1.0;
+               break;
+            case kind::two :
+               power_m = d * d;
+               power_m_1 = d;
+               break;
+            case kind::integer :
+               power_m_1 = integer_power(d, _integer_m - 1);
+               power_m = power_m_1 * d;
+               break;
+            default :
+               power_m = std::pow(d, _m);
+               power_m_1 = d > 0.0 ? power_m / d : std::pow(d, _m - 1.0);
+         }
+      }
+
+      /** @return sum^(1/m) */
+      double root (const double sum) const
+      {
+         switch (_kind)
+         {
+            case kind::one : return sum;
+            case kind::two : return std::sqrt(sum);
+            default        : return std::pow(sum, 1.0 / _m);
+         }
+      }
+
+      /** @return sum^(1/m - 1) */
+      double root_m_1 (const double sum) const
+      {
+         switch (_kind)
+         {
+            case kind::one : return 1.0;
+            case kind::two : return 1.0 / std::sqrt(sum);
+            default        : return std::pow(sum, 1.0 / _m - 1.0);
+         }
+      }
+
+      /** @return sum of w[a] * |l[a] - p[a]|^m for all attributes a
+          @param l first vector
+          @param p second vector
+          @param w weights of attributes, if nullptr, all weights are 1
+          @param size number of attributes */
+      double weighted_sum_of_powers (const double * l, const double * p, const double * w, const std::size_t size) const;
+
+      /** @return sum of |l[a] - p[a]|^m for all attributes a
+          @throw ksi::exception if the sizes of the vectors do not match */
+      double sum_of_powers (const std::vector<double> & l, const std::vector<double> & p) const;
+
+      /** @return sum of weights[a] * |l[a] - p[a]|^m for all attributes a
+          @throw ksi::exception if the sizes of the vectors do not match */
+      double weighted_sum_of_powers (const std::vector<double> & l, const std::vector<double> & p, const std::vector<double> & weights) const;
+
+      /** The method elaborates weighted sums of powers for all data items 
+          with one dispatch on the kind of the exponent.
+          @param X data items
+          @param centre centre (the second argument of the distance)
+          @param weights weights of attributes
+          @return sums of weights[a] * |X[x][a] - centre[a]|^m for each data item x
+          @throw ksi::exception if the sizes of vectors do not match */
+      std::vector<double> weighted_sums_of_powers (const std::vector<std::vector<double>> & X,
+                                                   const std::vector<double> & centre,
+                                                   const std::vector<double> & weights) const;
+   };
+}
+
+#endif
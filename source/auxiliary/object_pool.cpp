@@ -0,0 +1,124 @@
+/** @file */
+
+#include <cstddef>
+#include <new>
+#include <mutex>
+
+#include "../auxiliary/object_pool.h"
+
+const std::size_t ksi::object_pool::GRANULARITY = 16;
+const std::size_t ksi::object_pool::MAXIMAL_SIZE = 256;
+
+namespace
+{
+   /** number of sizes of blocks */
+   const std::size_t NUMBER_OF_SIZES = 16; // MAXIMAL_SIZE / GRANULARITY
+   /** size of a chunk blocks are cut from */
+   const std::size_t CHUNK_SIZE = 64 * 1024;
+
+   /** a free block holds the address of the next free block */
+   struct free_block
+   {
+      free_block * next;
+   };
+
+   /** free lists handed back by exited threads, one for each size of blocks */
+   free_block * global_lists [NUMBER_OF_SIZES] = {};
+   std::mutex global_mutex;
+
+   /** free lists of a thread, one for each size of blocks */
+   struct thread_lists
+   {
+      free_block * heads [NUMBER_OF_SIZES] = {};
+
+      /** Free lists of an exiting thread are appended to the global lists. */
+      ~thread_lists ()
+      {
+         std::lock_guard<std::mutex> lock (global_mutex);
+         for (std::size_t index = 0; index < NUMBER_OF_SIZES; index++)
+         {
+            if (not heads[index])
+               continue;
+            free_block * tail = heads[index];
+            while (tail->next)
+               tail = tail->next;
+            tail->next = global_lists[index];
+            global_lists[index] = heads[index];
+            heads[index] = nullptr;
+         }
+      }
+   };
+
+   thread_local thread_lists free_lists;
+
+   /** @return index of the size of blocks for an object of size bytes */
+   std::size_t size_index (const std::size_t size)
+   {
+      return size == 0 ? 0 : (size - 1) / ksi::object_pool::GRANULARITY;
+   }
+
+   /** The function puts blocks of the index-th size on the empty free list of the thread:
+       at most a chunk of blocks taken from the global free list
+       or (if it is empty) blocks of a new chunk. */
+   void refill (const std::size_t index)
+   {
+      const std::size_t block_size = (index + 1) * ksi::object_pool::GRANULARITY;
+      const std::size_t nBlocks = CHUNK_SIZE / block_size;
+      {
+         std::lock_guard<std::mutex> lock (global_mutex);
+         if (global_lists[index])
+         {
+            // Threads share blocks of exited threads instead of taking the whole list.
+            free_block * head = global_lists[index];
+            free_block * tail = head;
+            for (std::size_t b = 1; b < nBlocks and tail->next; b++)
+               tail = tail->next;
+            global_lists[index] = tail->next;
+            tail->next = nullptr;
+            free_lists.heads[index] = head;
+            return;
+         }
+      }
+
+      char * chunk = static_cast<char *>(::operator new (CHUNK_SIZE));
+      free_block * head = free_lists.heads[index];
+      for (std::size_t b = nBlocks; b > 0; b--)
+      {
+         auto block = reinterpret_cast<free_block *>(chunk + (b - 1) * block_size);
+         block->next = head;
+         head = block;
+      }
+      free_lists.heads[index] = head;
+   }
+}
+
+void * ksi::object_pool::allocate(const std::size_t size)
+{
+   if (size > MAXIMAL_SIZE)
+      return ::operator new (size);
+
+   const std::size_t index = size_index(size);
+   auto & head = free_lists.heads[index];
+   if (not head)
+      refill(index);
+   free_block * block = head;
+   head = block->next;
+   return block;
+}
+
+void ksi::object_pool::deallocate(void * p, const std::size_t size) noexcept
+{
+   if (not p)
+      return;
+   if (size > MAXIMAL_SIZE)
+   {
+      ::operator delete (p);
+      return;
+   }
+
+   const std::size_t index = size_index(size);
+   auto block = static_cast<free_block *>(p);
+   auto & head = free_lists.heads[index];
+   block->next = head;
+   head = block;
+}
@@ -0,0 +1,51 @@
+/** @file */
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <cstddef>
+
+namespace ksi
+{
+   /** Pool of small blocks of memory for polymorphic parts of models
+       (rules, premises, descriptors, consequences and t-norms).
+       Models are copied by cloning all their parts, so a copy of a rulebase
+       allocates and frees a dozen of small objects for each rule.
+       The pool serves these objects from free lists of blocks of a few sizes (multiples of
+       GRANULARITY bytes up to MAXIMAL_SIZE bytes) cut from large chunks,
+       so an allocation is a pop and a release is a push on a list of the thread.
+       Blocks are reused, chunks are never released. A block released by another thread
+       than the one that allocated it joins the free list of the releasing thread.
+       When a thread exits, its free lists are handed back to global free lists (guarded
+       with a mutex), and a thread with an empty free list takes a global list
+       before it cuts a new chunk, so blocks of exited threads are not lost.
+       Larger objects are allocated with the global operator new.
+
+       Classes use the pool with class specific operators new and delete:
+       <pre>
+       static void * operator new (std::size_t size) { return ksi::object_pool::allocate(size); }
+       static void operator delete (void * p, std::size_t size) { ksi::object_pool::deallocate(p, size); }
+       </pre>
+       Destructors of these classes are virtual, so the size of the dynamic type
+       is passed to the operator delete.
+       @date 2026-10-19 */
+   class object_pool
+   {
+   public:
+      /** size of blocks is a multiple of GRANULARITY */
+      static const std::size_t GRANULARITY;
+      /** the largest block served by the pool */
+      static const std::size_t MAXIMAL_SIZE;
+
+      /** @return memory for an object of size bytes
+          @throw std::bad_alloc if there is no memory */
+      static void * allocate (const std::size_t size);
+
+      /** The method releases memory of an object.
+          @param p memory returned by allocate (nullptr is ignored)
+          @param size the size passed to allocate */
+      static void deallocate (void * p, const std::size_t size) noexcept;
+   };
+}
+
+#endif
@@ -0,0 +1,17 @@
+/** @file */
+
+#ifndef PRECISION_H
+#define PRECISION_H
+
+namespace ksi
+{
+   /** floating point precision of batched computations of a model
+       @date 2026-10-18 */
+   enum class precision
+   {
+      double_precision, ///< all computations in double (default)
+      single_precision  ///< data and parameters in float, sums accumulated in double
+   };
+}
+
+#endif
@@ -0,0 +1,166 @@
+/** @file */
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <cstdlib>
+
+#include "../auxiliary/profiler.h"
+#include "../auxiliary/allocation_counter.h"
+#include "../service/debug.h"
+
+namespace
+{
+   /** @return value of the KSI_PROFILE environment variable or an empty string */
+   std::string profile_variable ()
+   {
+      const char * value = std::getenv("KSI_PROFILE");
+      return value ? value : "";
+   }
+}
+
+// KSI_PROFILE=1 switches the profiler on, KSI_PROFILE=trace also records a Chrome trace.
+std::atomic<bool> ksi::profiler::_enabled { not profile_variable().empty() and profile_variable() != "0" };
+std::atomic<bool> ksi::profiler::_chrome_trace { profile_variable() == "trace" };
+
+ksi::profiler::profiler() : _origin (std::chrono::steady_clock::now())
+{
+}
+
+ksi::profiler & ksi::profiler::instance()
+{
+    static ksi::profiler the_profiler;
+    return the_profiler;
+}
+
+void ksi::profiler::enable(const bool enabled, const bool chrome_trace)
+{
+    _enabled.store(enabled, std::memory_order_relaxed);
+    _chrome_trace.store(enabled and chrome_trace, std::memory_order_relaxed);
+}
+
+bool ksi::profiler::is_enabled()
+{
+    return _enabled.load(std::memory_order_relaxed);
+}
+
+bool ksi::profiler::is_chrome_trace_enabled()
+{
+    return _chrome_trace.load(std::memory_order_relaxed);
+}
+
+void ksi::profiler::record(const std::string & name,
+                           const std::chrono::steady_clock::time_point & start,
+                           const std::chrono::steady_clock::time_point & stop,
+                           const std::size_t rows,
+                           const std::size_t allocations)
+{
+    using namespace std::chrono;
+    const std::size_t duration = duration_cast<nanoseconds>(stop - start).count();
+
+    std::lock_guard<std::mutex> lock (_mutex);
+    auto & phase = _phases[name];
+    phase.calls++;
+    phase.rows += rows;
+    phase.nanoseconds += duration;
+    phase.allocations += allocations;
+
+    if (is_chrome_trace_enabled())
+        _events.push_back({ name,
+                            static_cast<std::size_t>(duration_cast<microseconds>(start - _origin).count()),
+                            duration / 1000,
+                            std::hash<std::thread::id>{}(std::this_thread::get_id()),
+                            rows });
+}
+
+std::map<std::string, ksi::phase_statistics> ksi::profiler::get_phases() const
+{
+    std::lock_guard<std::mutex> lock (_mutex);
+    return _phases;
+}
+
+std::string ksi::profiler::report() const
+{
+    auto phases = get_phases();
+    std::stringstream ss;
+    ss << "phase profile" << std::endl;
+    ss << std::left << std::setw(40) << "phase"
+       << std::right << std::setw(10) << "calls"
+       << std::setw(14) << "rows"
+       << std::setw(14) << "time [ms]"
+       << std::setw(14) << "allocations" << std::endl;
+    for (const auto & [name, phase] : phases)
+    {
+        ss << std::left << std::setw(40) << name
+           << std::right << std::setw(10) << phase.calls
+           << std::setw(14) << phase.rows
+           << std::setw(14) << std::fixed << std::setprecision(3) << phase.nanoseconds / 1e6
+           << std::setw(14) << phase.allocations << std::endl;
+    }
+    return ss.str();
+}
+
+std::string ksi::profiler::to_chrome_trace() const
+{
+    std::lock_guard<std::mutex> lock (_mutex);
+    std::stringstream ss;
+    ss << "{\"traceEvents\": [" << std::endl;
+    for (std::size_t i = 0; i < _events.size(); i++)
+    {
+        const auto & e = _events[i];
+        ss << "  {\"name\": \"" << e.name << "\", \"ph\": \"X\", \"pid\": 1"
+           << ", \"tid\": " << e.thread
+           << ", \"ts\": " << e.start_microseconds
+           << ", \"dur\": " << e.duration_microseconds
+           << ", \"args\": {\"rows\": " << e.rows << "}}"
+           << (i + 1 < _events.size() ? "," : "") << std::endl;
+    }
+    ss << "]}" << std::endl;
+    return ss.str();
+}
+
+void ksi::profiler::write_chrome_trace(const std::string & file_name) const
+{
+    try
+    {
+        std::ofstream file (file_name);
+        if (not file)
+            throw ksi::exception ("I cannot open \"" + file_name + "\" file!");
+        file << to_chrome_trace();
+    }
+    CATCH;
+}
+
+void ksi::profiler::clear()
+{
+    std::lock_guard<std::mutex> lock (_mutex);
+    _phases.clear();
+    _events.clear();
+}
+
+ksi::scoped_timer::scoped_timer(const char * name, const std::size_t rows)
+: _name (name), _rows (rows), _active (ksi::profiler::is_enabled()), _allocations (0)
+{
+    if (_active)
+    {
+        _allocations = ksi::allocation_counter::number_of_allocations();
+        _start = std::chrono::steady_clock::now();
+    }
+}
+
+ksi::scoped_timer::~scoped_timer()
+{
+    if (_active)
+    {
+        auto stop = std::chrono::steady_clock::now();
+        auto allocations = ksi::allocation_counter::number_of_allocations() - _allocations;
+        ksi::profiler::instance().record(_name, _start, stop, _rows, allocations);
+    }
+}
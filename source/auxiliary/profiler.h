@@ -0,0 +1,125 @@
+/** @file */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+namespace ksi
+{
+   /** Statistics of a phase (eg. clustering, tuning epoch) gathered by the profiler.
+       @date 2026-10-18 */
+   struct phase_statistics
+   {
+      /** number of calls of the phase */
+      std::size_t calls = 0;
+      /** number of data items processed in all calls */
+      std::size_t rows = 0;
+      /** wall time of all calls */
+      std::size_t nanoseconds = 0;
+      /** heap allocations of the whole program during all calls (counted only in the benchmark binary, see ksi::allocation_counter) */
+      std::size_t allocations = 0;
+   };
+
+   /** A registry of phase timings and counters.
+       The profiler is disabled by default. It is switched on with the method enable
+       or with the environment variable KSI_PROFILE (1: phases, trace: phases and Chrome trace).
+       When disabled, a ksi::scoped_timer
+       only checks an atomic flag, so the instrumentation costs nearly nothing.
+       Recording is thread safe.
+       @date 2026-10-18 */
+   class profiler
+   {
+      /** an event for the Chrome trace format */
+      struct trace_event
+      {
+         std::string name;
+         std::size_t start_microseconds;
+         std::size_t duration_microseconds;
+         std::size_t thread;
+         std::size_t rows;
+      };
+
+      static std::atomic<bool> _enabled;
+      static std::atomic<bool> _chrome_trace;
+
+      mutable std::mutex _mutex;
+      std::map<std::string, phase_statistics> _phases;
+      std::vector<trace_event> _events;
+      const std::chrono::steady_clock::time_point _origin;
+
+      profiler ();
+
+   public:
+      /** @return the only instance of the profiler */
+      static profiler & instance ();
+
+      /** The method switches the profiler on or off.
+          @param enabled true to record phases
+          @param chrome_trace true to record also single events for a Chrome trace (chrome://tracing, Perfetto) */
+      static void enable (const bool enabled, const bool chrome_trace = false);
+
+      /** @return true if the profiler records phases */
+      static bool is_enabled ();
+
+      /** @return true if the profiler records events for a Chrome trace */
+      static bool is_chrome_trace_enabled ();
+
+      /** The method records one call of a phase.
+          @param name name of the phase
+          @param start start of the call
+          @param stop  end of the call
+          @param rows number of data items processed in the call
+          @param allocations number of heap allocations in the call */
+      void record (const std::string & name,
+                   const std::chrono::steady_clock::time_point & start,
+                   const std::chrono::steady_clock::time_point & stop,
+                   const std::size_t rows,
+                   const std::size_t allocations);
+
+      /** @return statistics of all recorded phases */
+      std::map<std::string, phase_statistics> get_phases () const;
+
+      /** @return a table of recorded phases (name, calls, rows, time, allocations) */
+      std::string report () const;
+
+      /** @return recorded events in the Chrome trace JSON format */
+      std::string to_chrome_trace () const;
+
+      /** The method writes recorded events in the Chrome trace JSON format into a file.
+          @param file_name name of the file
+          @throw ksi::exception if the file cannot be opened */
+      void write_chrome_trace (const std::string & file_name) const;
+
+      /** The method removes all recorded phases and events. */
+      void clear ();
+   };
+
+   /** The timer records the time of its scope in ksi::profiler.
+       If the profiler is disabled, nothing is measured.
+       @date 2026-10-18 */
+   class scoped_timer
+   {
+      const char * _name;
+      std::size_t _rows;
+      bool _active;
+      std::size_t _allocations;
+      std::chrono::steady_clock::time_point _start;
+
+   public:
+      /** @param name name of the phase
+          @param rows number of data items processed in the scope */
+      scoped_timer (const char * name, const std::size_t rows = 0);
+      ~scoped_timer ();
+
+      scoped_timer (const scoped_timer &) = delete;
+      scoped_timer & operator= (const scoped_timer &) = delete;
+   };
+}
+
+#endif
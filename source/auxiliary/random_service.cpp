@@ -0,0 +1,182 @@
+/** @file */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <charconv>
+
+#include "random_service.h"
+#include "../service/exception.h"
+
+namespace
+{
+   /** splitmix64 finaliser: mixes identifiers of streams and tasks */
+   std::uint64_t mix (std::uint64_t z)
+   {
+      z += 0x9e3779b97f4a7c15ULL;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+   }
+
+   /** @return the seed read from KSI_SEED or elaborated from the clock
+       @throw ksi::exception if KSI_SEED is not a number */
+   std::uint64_t initial_seed ()
+   {
+      const std::string value = std::getenv("KSI_SEED") ? std::getenv("KSI_SEED") : "";
+      if (value.empty())
+         return std::chrono::system_clock::now().time_since_epoch().count();
+
+      std::uint64_t seed = 0;
+      auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), seed);
+      if (error != std::errc() or end != value.data() + value.size())
+         throw ksi::exception ("The value of KSI_SEED (" + value + ") is not a non-negative integer.");
+      return seed;
+   }
+
+   /** The seed is read at the first use (not in static initialisation), 
+       so a malformed KSI_SEED is reported with an exception. */
+   std::atomic<std::uint64_t> & global_seed ()
+   {
+      static std::atomic<std::uint64_t> seed { initial_seed() };
+      return seed;
+   }
+
+   /** number of threads that have drawn streams */
+   std::atomic<std::uint64_t> number_of_threads { 0 };
+
+   /** current task of a thread and the number of streams drawn in it */
+   struct task_context
+   {
+      /** index of the thread in the order of first draws (0: the first thread) */
+      std::uint64_t thread = number_of_threads++;
+      /** Streams drawn outside tasks differ among threads: 
+          each thread starts with its own key (the first thread with 0). */
+      std::uint64_t task = thread == 0 ? 0 : mix(~thread);
+      std::uint64_t counter = 0;
+      /** number of nested tasks */
+      std::uint64_t depth = 0;
+   };
+
+   thread_local task_context context;
+}
+
+ksi::philox::philox(const std::uint64_t seed, const std::uint64_t stream)
+: _seed (seed), _stream (stream)
+{
+}
+
+std::array<std::uint32_t, 4> ksi::philox::block(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key)
+{
+   const std::uint64_t M0 = 0xD2511F53;
+   const std::uint64_t M1 = 0xCD9E8D57;
+   const std::uint32_t W0 = 0x9E3779B9;
+   const std::uint32_t W1 = 0xBB67AE85;
+
+   for (int round = 0; round < 10; round++)
+   {
+      std::uint64_t p0 = M0 * counter[0];
+      std::uint64_t p1 = M1 * counter[2];
+      counter = { static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ key[0],
+                  static_cast<std::uint32_t>(p1),
+                  static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ key[1],
+                  static_cast<std::uint32_t>(p0) };
+      key[0] += W0;
+      key[1] += W1;
+   }
+   return counter;
+}
+
+void ksi::philox::refill()
+{
+   _buffer = block({ static_cast<std::uint32_t>(_counter), static_cast<std::uint32_t>(_counter >> 32),
+                     static_cast<std::uint32_t>(_stream),  static_cast<std::uint32_t>(_stream >> 32) },
+                   { static_cast<std::uint32_t>(_seed),    static_cast<std::uint32_t>(_seed >> 32) });
+   _counter++;
+   _position = 0;
+}
+
+void ksi::philox::discard(const std::uint64_t n)
+{
+   // numbers remaining in the buffer
+   std::uint64_t in_buffer = 4 - _position;
+   if (n <= in_buffer)
+   {
+      _position += n;
+      return;
+   }
+   std::uint64_t rest = n - in_buffer;
+   _counter += rest / 4;
+   _position = 4;
+   if (rest % 4 != 0)
+   {
+      refill();
+      _position = rest % 4;
+   }
+}
+
+ksi::philox ksi::philox::split(const std::uint64_t index) const
+{
+   return philox (_seed, mix(_stream ^ mix(index)));
+}
+
+std::uint64_t ksi::philox::get_seed() const
+{
+   return _seed;
+}
+
+std::uint64_t ksi::philox::get_stream() const
+{
+   return _stream;
+}
+
+void ksi::random_service::set_seed(const std::uint64_t seed)
+{
+   global_seed() = seed;
+}
+
+std::uint64_t ksi::random_service::get_seed()
+{
+   return global_seed();
+}
+
+ksi::philox ksi::random_service::next_stream()
+{
+   return philox (global_seed(), mix(context.task ^ mix(context.counter++)));
+}
+
+std::default_random_engine ksi::random_service::make_engine(ksi::philox & stream)
+{
+   // two statements: the order of draws in one expression is unspecified
+   const std::uint64_t high = stream();
+   const std::uint64_t low = stream();
+   const std::uint64_t seed = (high << 32) | low;
+   return std::default_random_engine (seed);
+}
+
+std::default_random_engine ksi::random_service::next_engine()
+{
+   auto stream = next_stream();
+   return make_engine(stream);
+}
+
+ksi::random_task::random_task(const std::uint64_t task)
+: _previous_task (context.task), _previous_counter (context.counter)
+{
+   // The outermost task does not depend on the thread that runs it.
+   const std::uint64_t enclosing = context.depth == 0 ? 0 : context.task;
+   context.task = mix(enclosing + mix(task));
+   context.counter = 0;
+   context.depth++;
+}
+
+ksi::random_task::~random_task()
+{
+   context.task = _previous_task;
+   context.counter = _previous_counter;
+   context.depth--;
+}
@@ -0,0 +1,132 @@
+/** @file */
+
+#ifndef RANDOM_SERVICE_H
+#define RANDOM_SERVICE_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace ksi
+{
+   /** Counter-based random number generator Philox4x32-10 (Salmon et al., 2011).
+    *  The n-th number of a stream is elaborated directly from (seed, stream, n),
+    *  so streams can be split per thread or per task without any shared state
+    *  and the numbers do not depend on the order of execution.
+    *  The class satisfies the UniformRandomBitGenerator requirements
+    *  and can be used with std distributions.
+    *  @date 2026-10-18
+    */
+   class philox
+   {
+   public:
+      typedef std::uint32_t result_type;
+
+      /** @param seed key of the generator
+          @param stream identifier of the stream */
+      explicit philox (const std::uint64_t seed = 0, const std::uint64_t stream = 0);
+
+      static constexpr result_type min () { return 0; }
+      static constexpr result_type max () { return std::numeric_limits<result_type>::max(); }
+
+      /** @return the next number of the stream */
+      result_type operator() ()
+      {
+         if (_position == 4)
+            refill();
+         return _buffer[_position++];
+      }
+
+      /** The method skips numbers of the stream.
+          @param n number of numbers to skip */
+      void discard (const std::uint64_t n);
+
+      /** @return an independent stream identified by this stream and an index,
+                  eg. for a thread, a task or a data item
+          @param index index of the substream */
+      philox split (const std::uint64_t index) const;
+
+      /** @return the seed of the generator */
+      std::uint64_t get_seed () const;
+
+      /** @return the identifier of the stream */
+      std::uint64_t get_stream () const;
+
+      /** @return a block of four numbers for a counter and a key (ten rounds of Philox4x32) */
+      static std::array<std::uint32_t, 4> block (std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key);
+
+   private:
+      std::uint64_t _seed;
+      std::uint64_t _stream;
+      /** index of the next block */
+      std::uint64_t _counter = 0;
+      std::array<std::uint32_t, 4> _buffer {};
+      /** position of the next number in the buffer, 4: the buffer is empty */
+      unsigned _position = 4;
+
+      void refill ();
+   };
+
+   /** Central source of random streams of the library.
+    *
+    *  The seed is read from the environment variable KSI_SEED at the first use. If it is not set,
+    *  the seed is elaborated from the clock (results differ from run to run).
+    *  A malformed KSI_SEED is reported with ksi::exception.
+    *  Each thread draws consecutive streams from its own sequence, identified by
+    *  the current ksi::random_task. Outside tasks threads draw different streams
+    *  (a thread is identified by the order of its first draw, so only the first thread
+    *  is reproducible). Parallel code should open a random_task for
+    *  each task, so the streams do not depend on scheduling of threads.
+    *  @date 2026-10-18
+    */
+   class random_service
+   {
+   public:
+      /** The method sets the seed of all streams drawn afterwards. */
+      static void set_seed (const std::uint64_t seed);
+
+      /** @return the seed */
+      static std::uint64_t get_seed ();
+
+      /** @return the next stream of the current task of the calling thread */
+      static philox next_stream ();
+
+      /** @return an engine seeded with a stream, for interfaces that take std::default_random_engine
+          @param stream stream to draw the seed from */
+      static std::default_random_engine make_engine (philox & stream);
+
+      /** @return an engine seeded with the next stream of the calling thread */
+      static std::default_random_engine next_engine ();
+   };
+
+   /** A scope of a task for random streams. Streams drawn by a thread inside
+    *  the scope depend only on the seed, the task identifiers (of nested scopes)
+    *  and the order of draws in the task.
+    *  @code
+    *  #pragma omp parallel for
+    *  for (std::size_t t = 0; t < nTasks; t++)
+    *  {
+    *     ksi::random_task task (t);
+    *     auto engine = ksi::random_service::next_stream();
+    *     ...
+    *  }
+    *  @endcode
+    *  @date 2026-10-18
+    */
+   class random_task
+   {
+      std::uint64_t _previous_task;
+      std::uint64_t _previous_counter;
+
+   public:
+      /** @param task identifier of the task (unique among tasks of the enclosing scope) */
+      explicit random_task (const std::uint64_t task);
+      ~random_task ();
+
+      random_task (const random_task &) = delete;
+      random_task & operator= (const random_task &) = delete;
+   };
+}
+
+#endif
@@ -4,11 +4,15 @@
 #include <vector>
 #include <utility>   // std::pair
 #include <algorithm> // sort
+#include <numeric>
 #include <cmath>
+#include <limits>
 #include <string>
 
 #include "roc.h" 
+#include "../service/debug.h"
 
+const std::size_t ksi::roc::PARALLEL_SORT_THRESHOLD = 1 << 16;
   
 std::string ksi::to_string (const ksi::roc_threshold & th)
 {
@@ -28,141 +32,170 @@ double ksi::roc::trapezoidArea(double x1, double x2, double y1, double y2)
     return fabs(x1 - x2) * (y1 + y2) / 2;
 }
 
-ksi::results ksi::roc::calculate_ROC_points (std::vector<double> & Out,
-                                             std::vector<double> & Answer, 
+void ksi::roc::sort_answers(std::vector<std::pair<double, bool>> & answers)
+{
+    // Elaborated values are finite (checked by the caller).
+    auto comparator = [] (const std::pair<double, bool> & left, const std::pair<double, bool> & right)
+    {
+        return left.first < right.first;
+    };
+
+    const std::size_t size = answers.size();
+    if (size < PARALLEL_SORT_THRESHOLD)
+    {
+        std::sort(answers.begin(), answers.end(), comparator);
+        return;
+    }
+
+    // Chunks are sorted independently and then merged pairwise.
+    const std::size_t NUMBER_OF_CHUNKS = 16;
+    const std::size_t chunk = (size + NUMBER_OF_CHUNKS - 1) / NUMBER_OF_CHUNKS;
+
+    #pragma omp parallel for
+    for (std::size_t c = 0; c < NUMBER_OF_CHUNKS; c++)
+    {
+        auto first = std::min(c * chunk, size);
+        auto last  = std::min(first + chunk, size);
+        std::sort(answers.begin() + first, answers.begin() + last, comparator);
+    }
+
+    for (std::size_t width = chunk; width < size; width *= 2)
+    {
+        const std::size_t number_of_merges = (size + 2 * width - 1) / (2 * width);
+        #pragma omp parallel for
+        for (std::size_t m = 0; m < number_of_merges; m++)
+        {
+            auto first  = m * 2 * width;
+            auto middle = std::min(first + width, size);
+            auto last   = std::min(first + 2 * width, size);
+            std::inplace_merge(answers.begin() + first, answers.begin() + middle, answers.begin() + last, comparator);
+        }
+    }
+}
+
+ksi::results ksi::roc::calculate_ROC_points (const std::vector<double> & Out,
+                                             const std::vector<double> & Answer,
                                              double positiveClassvalue,
                                              double negativeClassvalue)
 {
-    double AUC = 0;
-    std::vector<std::pair<double, double> > mergeData, points;
-    ksi::results res;
+    return calculate_ROC_points(Out, Answer, positiveClassvalue, negativeClassvalue, {}, true);
+}
     
-    if (Out.size() == Answer.size())
+ksi::results ksi::roc::calculate_ROC_points (const std::vector<double> & Out,
+                                             const std::vector<double> & Answer,
+                                             double positiveClassvalue,
+                                             double negativeClassvalue,
+                                             const std::vector<double> & thresholds,
+                                             const bool store_ROC_points)
+{
+    try
     {
-        std::pair<double, double> para;
-        int liczba = Out.size();
-        for (int i = 0; i < liczba; i++)
-        {
-            para.first = Out[i];
-            para.second = Answer[i];
+        if (Out.size() != Answer.size())
+            throw ksi::exception ("The numbers of expected (" + std::to_string(Out.size()) + ") and elaborated (" + std::to_string(Answer.size()) + ") values do not match.");
             
-            mergeData.push_back(para);
-        }
-        // teraz trzeba posortowac dane wg drugiej skladowej pary.
-        struct comparator
-        {
-           bool operator() (std::pair<double, double>  left, std::pair<double, double>  right)
-           {
-              return left.second < right.second;
-           }
-        } comparator_obj;
-        std::sort(mergeData.begin(), mergeData.end(), comparator_obj);
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        ksi::results res;
+        res.AUC = 0;
+        res.Youden_index = -1;
+        res.Youden_threshold = nan;
+        res.Minimal_distance_threshold = nan;
         
-        // mam posortowane dane
-        // teraz trzeba ladnie wygenerowac krzywa ROC
-       
-        // trzeba policzyc jaka jest poczatkowa wartosc TPrate i FPrate;
-        int nPos = 0;
-        int nNeg = 0;
+        // pary: (odpowiedz, czy pozytywna), klasy liczone w tym samym przebiegu
+        const std::size_t liczba = Out.size();
+        std::vector<std::pair<double, bool>> mergeData (liczba);
+        std::size_t nPos = 0;
+        std::size_t nNeg = 0;
         
         double epsilon = fabs(positiveClassvalue - negativeClassvalue) / 4;
-        for (std::vector<double>::iterator iter = Out.begin();
-             iter != Out.end();
-             iter++)
+        for (std::size_t i = 0; i < liczba; i++)
         {
-            if (fabs(*iter - negativeClassvalue) < epsilon) // negative
-               nNeg++;
+            if (not std::isfinite(Answer[i]))
+                throw ksi::exception ("The elaborated value of the " + std::to_string(i) + "-th data item is not finite (" + std::to_string(Answer[i]) + ").");
+            bool positive = not (fabs(Out[i] - negativeClassvalue) < epsilon);
+            mergeData[i] = { Answer[i], positive };
+            if (positive)
+                nPos++;
             else
-               nPos++;
+                nNeg++;
         }
          
-        int nTP = nPos;
-        int nFP = nNeg;
-        int nTP_prev = nPos;
-        int nFP_prev = nNeg;
+        sort_answers(mergeData);
          
-        for (std::vector<std::pair<double, double> >::iterator iter = mergeData.begin();
-             iter != mergeData.end();
-             iter++)
+        // Requested thresholds are visited in ascending order during the sweep.
+        std::vector<std::size_t> order (thresholds.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&thresholds] (std::size_t l, std::size_t r) { return thresholds[l] < thresholds[r]; });
+        res.operating_points.resize(thresholds.size());
+        std::size_t next_threshold = 0;
+
+        // Initially all data are classified as positive.
+        double nTP = nPos;
+        double nFP = nNeg;
+        double nTP_prev = nPos;
+        double nFP_prev = nNeg;
+        double AUC = 0;
+        double Min_distance = 1;
+
+        std::size_t i = 0;
+        while (i < liczba)
         {
-            std::pair<double, double> punkt;
+            // grupa danych o tej samej odpowiedzi
+            const double score = mergeData[i].first;
+            std::size_t group_positives = 0;
+            std::size_t group_negatives = 0;
+            for (; i < liczba and mergeData[i].first == score; i++)
+            {
+                if (mergeData[i].second)
+                    group_positives++;
+                else
+                    group_negatives++;
+            }
+
             AUC += trapezoidArea(nFP, nFP_prev, nTP, nTP_prev);
-        
             nTP_prev = nTP;
             nFP_prev = nFP;
             
-            punkt.first  = 1.0 * nFP / nNeg;
-            punkt.second = 1.0 * nTP / nPos;
-            //cerr << "punkt: (" << punkt.first << ", " << punkt.second << ")" << endl;
-            points.push_back(punkt);
-            
-            
-            if (fabs(iter->first - negativeClassvalue) < epsilon) // negative
-            {
-               nFP--;
-               //cerr << "n ";
-            } 
-            else
-            {
-               nTP--;
-               //cerr << "p ";
-            }   
-            //cerr << iter->second << endl;
-        }
-        // jeszcze dodaje (0,0)
-        std::pair<double, double> punkt;
-        punkt.first  = 0;
-        punkt.second = 0;
-        points.push_back(punkt);       
-        // no i juz :-)
-        
-        // jeszcze tylko AUC
-        AUC += trapezoidArea(0, nFP_prev, 0, nTP_prev);
-        AUC /= (nPos * nNeg);
-        
-        // trzeba jeszcze policzyc indeksy 
-        std::pair<double, double> Min_point, Youden_point;
-        double Min_threshold;
-        double Youden_threshold;
-        double Youden_index = -1;
-        double Min_distance =  1; 
-        double Min_index;
-        unsigned int i = 0;
-        
-        
-        for (std::vector<std::pair<double, double> >::iterator iter = points.begin();
-             iter != points.end(); iter++, i++)
-        {
-            double x = iter->first;
-            double y = iter->second;
+            std::pair<double, double> punkt { nFP / nNeg, nTP / nPos };
+            if (store_ROC_points)
+                res.ROC_points.push_back(punkt);
             
+            double x = punkt.first;
+            double y = punkt.second;
             double distance = x * x + (1 - y) * (1 - y);
             if (distance < Min_distance)
             {
-               Min_distance = distance;
-               Min_threshold = mergeData[i].second;
-               Min_point = *iter;
+                Min_distance = distance;
+                res.Minimal_distance_threshold = score;
+                res.Minimal_distance_cutoff_point = punkt;
             }
             double youden = y - x;
-            if (youden > Youden_index)
+            if (youden > res.Youden_index)
             {
-               Youden_index = youden;
-               Youden_threshold = mergeData[i].second;
-               Youden_point = *iter;
+                res.Youden_index = youden;
+                res.Youden_threshold = score;
+                res.Youden_cutoff_point = punkt;
             }
+
+            // thresholds in (previous score, score] classify the same data as positive
+            for (; next_threshold < order.size() and thresholds[order[next_threshold]] <= score; next_threshold++)
+                res.operating_points[order[next_threshold]] = { thresholds[order[next_threshold]], x, y };
+
+            nTP -= group_positives;
+            nFP -= group_negatives;
         }
+        // thresholds above all elaborated values
+        for (; next_threshold < order.size(); next_threshold++)
+            res.operating_points[order[next_threshold]] = { thresholds[order[next_threshold]], 0.0, 0.0 };
         
-        res.Youden_index = Youden_index;
-        res.Youden_threshold = Youden_threshold;
-        res.Youden_cutoff_point = Youden_point;        
+        // jeszcze dodaje (0,0)
+        if (store_ROC_points)
+            res.ROC_points.push_back({0.0, 0.0});
         
-        res.Minimal_distance_threshold = Min_threshold;
-        res.Minimal_distance_cutoff_point = Min_point;
+        AUC += trapezoidArea(0, nFP_prev, 0, nTP_prev);
+        AUC /= (1.0 * nPos * nNeg);
+        res.AUC = AUC;
+
+        return res;
     }
-    
-    res.ROC_points = points;
-    res.AUC = AUC;
-    
-    
-    return res;
+    CATCH;
 }
@@ -23,6 +23,18 @@ namespace ksi
    /** @return the name of the threshold */
    std::string to_string (const roc_threshold & th);
    
+   /** A point of ROC for a threshold.
+       A data item is classified as positive if its elaborated value is not less than the threshold.
+       @date 2026-10-18 */
+   struct roc_operating_point
+   {
+      double threshold;
+      /** false positive rate (x coordinate of ROC) */
+      double false_positive_rate;
+      /** true positive rate (y coordinate of ROC) */
+      double true_positive_rate;
+   };
+
    struct results
    {
       std::vector<std::pair<double, double> > ROC_points;
@@ -36,22 +48,55 @@ namespace ksi
       double Minimal_distance_threshold;  
       std::pair<double, double> Youden_cutoff_point;
       std::pair<double, double> Minimal_distance_cutoff_point;
-       
+      /** ROC points for thresholds requested by a user (in the order of request)
+          @date 2026-10-18 */
+      std::vector<roc_operating_point> operating_points;
    };
    class roc
    {
+      /** Datasets larger than this are sorted in parallel chunks. */
+      static const std::size_t PARALLEL_SORT_THRESHOLD;
+
       double trapezoidArea(double x1, double x2, double y1, double y2);
+
+      /** The method sorts pairs (elaborated value, true for a positive item)
+          ascending by the elaborated value (all values are finite). Large vectors are sorted in chunks
+          in parallel, then the chunks are merged.
+          @date 2026-10-18 */
+      static void sort_answers (std::vector<std::pair<double, bool>> & answers);
    public :
       /** The method elaborates ROC points and indices.
+       Data are sorted once. Data items with tied elaborated values are grouped
+       and make one point of the ROC.
        @param Expected vector of expected values
        @param Elaborated vector of elaborated values
        @param positiveClassvalue label of positive class
        @param negativeClassvalue label of negative class 
+       @throw ksi::exception if the sizes of Expected and Elaborated do not match 
+              or an elaborated value is not finite
        */
-      results calculate_ROC_points (std::vector<double> & Expected, 
-                                    std::vector<double> & Elaborated, 
+      results calculate_ROC_points (const std::vector<double> & Expected,
+                                    const std::vector<double> & Elaborated,
                                     double positiveClassvalue,
                                     double negativeClassvalue);
+
+      /** The method elaborates ROC indices and ROC points for requested thresholds in one sweep.
+       @param Expected vector of expected values
+       @param Elaborated vector of elaborated values
+       @param positiveClassvalue label of positive class
+       @param negativeClassvalue label of negative class
+       @param thresholds thresholds to elaborate ROC points for (results::operating_points)
+       @param store_ROC_points if false, all ROC points are not stored in results::ROC_points
+       @throw ksi::exception if the sizes of Expected and Elaborated do not match 
+              or an elaborated value is not finite
+       @date 2026-10-18
+       */
+      results calculate_ROC_points (const std::vector<double> & Expected,
+                                    const std::vector<double> & Elaborated,
+                                    double positiveClassvalue,
+                                    double negativeClassvalue,
+                                    const std::vector<double> & thresholds,
+                                    const bool store_ROC_points = true);
    };
 }
 
@@ -0,0 +1,179 @@
+/** @file */
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "roc_histogram.h"
+#include "../service/debug.h"
+
+ksi::roc_histogram::roc_histogram(const double minimum,
+                                  const double maximum,
+                                  const std::size_t number_of_bins,
+                                  const double positiveClassvalue,
+                                  const double negativeClassvalue)
+: _minimum (minimum), _maximum (maximum), _number_of_bins (number_of_bins),
+  _positive_class (positiveClassvalue), _negative_class (negativeClassvalue),
+  _epsilon (std::fabs(positiveClassvalue - negativeClassvalue) / 4),
+  _positives (number_of_bins, 0), _negatives (number_of_bins, 0)
+{
+    try
+    {
+        if (not (maximum > minimum))
+            throw ksi::exception ("The maximum (" + std::to_string(maximum) + ") of the histogram must be greater than its minimum (" + std::to_string(minimum) + ").");
+        if (number_of_bins == 0)
+            throw ksi::exception ("The histogram must have at least one bin.");
+    }
+    CATCH;
+}
+
+std::size_t ksi::roc_histogram::bin(const double value) const
+{
+    if (not (value > _minimum))
+        return 0;
+    if (value >= _maximum)
+        return _number_of_bins - 1;
+    auto index = static_cast<std::size_t>((value - _minimum) / (_maximum - _minimum) * _number_of_bins);
+    return std::min(index, _number_of_bins - 1);
+}
+
+double ksi::roc_histogram::lower_edge(const std::size_t bin) const
+{
+    return _minimum + (_maximum - _minimum) * bin / _number_of_bins;
+}
+
+void ksi::roc_histogram::add(const double expected, const double elaborated)
+{
+    try
+    {
+        if (std::isnan(elaborated))
+            throw ksi::exception ("The elaborated value is not a number.");
+        auto b = bin(elaborated);
+        if (std::fabs(expected - _negative_class) < _epsilon)
+        {
+            _negatives[b]++;
+            _number_of_negatives++;
+        }
+        else
+        {
+            _positives[b]++;
+            _number_of_positives++;
+        }
+    }
+    CATCH;
+}
+
+void ksi::roc_histogram::add(const std::vector<double> & Expected, const std::vector<double> & Elaborated)
+{
+    try
+    {
+        if (Expected.size() != Elaborated.size())
+            throw ksi::exception ("The numbers of expected (" + std::to_string(Expected.size()) + ") and elaborated (" + std::to_string(Elaborated.size()) + ") values do not match.");
+
+        const std::size_t size = Expected.size();
+        for (std::size_t i = 0; i < size; i++)
+            add(Expected[i], Elaborated[i]);
+    }
+    CATCH;
+}
+
+ksi::roc_histogram & ksi::roc_histogram::operator += (const ksi::roc_histogram & other)
+{
+    try
+    {
+        if (_number_of_bins != other._number_of_bins or _minimum != other._minimum or _maximum != other._maximum)
+            throw ksi::exception ("The histograms have different bins.");
+
+        for (std::size_t b = 0; b < _number_of_bins; b++)
+        {
+            _positives[b] += other._positives[b];
+            _negatives[b] += other._negatives[b];
+        }
+        _number_of_positives += other._number_of_positives;
+        _number_of_negatives += other._number_of_negatives;
+        return *this;
+    }
+    CATCH;
+}
+
+void ksi::roc_histogram::clear()
+{
+    std::fill(_positives.begin(), _positives.end(), 0);
+    std::fill(_negatives.begin(), _negatives.end(), 0);
+    _number_of_positives = 0;
+    _number_of_negatives = 0;
+}
+
+std::size_t ksi::roc_histogram::size() const
+{
+    return _number_of_positives + _number_of_negatives;
+}
+
+double ksi::roc_histogram::AUC() const
+{
+    // Each negative item is compared with all positive items in higher bins,
+    // ties in the same bin count as halves.
+    double area = 0.0;
+    double positives_above = 0.0;
+    for (std::size_t b = _number_of_bins; b-- > 0; )
+    {
+        area += _negatives[b] * (positives_above + _positives[b] / 2.0);
+        positives_above += _positives[b];
+    }
+    return area / (1.0 * _number_of_positives * _number_of_negatives);
+}
+
+double ksi::roc_histogram::AUC_error_bound() const
+{
+    double ties = 0.0;
+    for (std::size_t b = 0; b < _number_of_bins; b++)
+        ties += 1.0 * _positives[b] * _negatives[b];
+    return ties / (2.0 * _number_of_positives * _number_of_negatives);
+}
+
+ksi::results ksi::roc_histogram::calculate_ROC_points() const
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    ksi::results res;
+    res.AUC = AUC();
+    res.Youden_index = -1;
+    res.Youden_threshold = nan;
+    res.Minimal_distance_threshold = nan;
+
+    double nTP = _number_of_positives;
+    double nFP = _number_of_negatives;
+    double Min_distance = 1;
+
+    for (std::size_t b = 0; b < _number_of_bins; b++)
+    {
+        if (_positives[b] == 0 and _negatives[b] == 0)
+            continue;
+
+        std::pair<double, double> punkt { nFP / _number_of_negatives, nTP / _number_of_positives };
+        res.ROC_points.push_back(punkt);
+
+        double x = punkt.first;
+        double y = punkt.second;
+        double distance = x * x + (1 - y) * (1 - y);
+        if (distance < Min_distance)
+        {
+            Min_distance = distance;
+            res.Minimal_distance_threshold = lower_edge(b);
+            res.Minimal_distance_cutoff_point = punkt;
+        }
+        double youden = y - x;
+        if (youden > res.Youden_index)
+        {
+            res.Youden_index = youden;
+            res.Youden_threshold = lower_edge(b);
+            res.Youden_cutoff_point = punkt;
+        }
+
+        nTP -= _positives[b];
+        nFP -= _negatives[b];
+    }
+    res.ROC_points.push_back({0.0, 0.0});
+    return res;
+}
@@ -0,0 +1,89 @@
+/** @file */
+
+#ifndef ROC_HISTOGRAM_H
+#define ROC_HISTOGRAM_H
+
+#include <vector>
+#include <cstddef>
+
+#include "roc.h"
+
+namespace ksi
+{
+   /** Streaming (incremental) ROC analysis on a fixed-bin histogram of elaborated values.
+       Each answer is added in O(1) time and the memory does not depend on the number of answers,
+       so the class can monitor unbounded streams of answers.
+       Histograms with the same bins can be merged (e.g. partial histograms elaborated in parallel).
+       Answers in the same bin are treated as ties, so the AUC error does not exceed AUC_error_bound().
+       Values outside [minimum, maximum] are put into the first or the last bin.
+       @date 2026-10-18 */
+   class roc_histogram
+   {
+   protected:
+      double _minimum;
+      double _maximum;
+      std::size_t _number_of_bins;
+      double _positive_class;
+      double _negative_class;
+      /** tolerance for recognition of a negative label */
+      double _epsilon;
+      /** number of positive items in bins */
+      std::vector<std::size_t> _positives;
+      /** number of negative items in bins */
+      std::vector<std::size_t> _negatives;
+      std::size_t _number_of_positives = 0;
+      std::size_t _number_of_negatives = 0;
+
+   public:
+      /** @param minimum lower bound of elaborated values
+          @param maximum upper bound of elaborated values
+          @param number_of_bins number of bins of the histogram
+          @param positiveClassvalue label of positive class
+          @param negativeClassvalue label of negative class
+          @throw ksi::exception if maximum <= minimum or number_of_bins == 0 */
+      roc_histogram (const double minimum,
+                     const double maximum,
+                     const std::size_t number_of_bins,
+                     const double positiveClassvalue,
+                     const double negativeClassvalue);
+
+      /** The method adds an answer to the histogram.
+          Infinite values are added to the first or the last bin.
+          @param expected expected class
+          @param elaborated elaborated numeric value
+          @throw ksi::exception if the elaborated value is NaN */
+      void add (const double expected, const double elaborated);
+
+      /** The method adds answers to the histogram.
+          @throw ksi::exception if the sizes of vectors do not match or an elaborated value is NaN */
+      void add (const std::vector<double> & Expected, const std::vector<double> & Elaborated);
+
+      /** The method adds all answers of another histogram.
+          @throw ksi::exception if the histograms have different bins */
+      roc_histogram & operator += (const roc_histogram & other);
+
+      /** The method removes all answers (e.g. at the beginning of a new monitoring window). */
+      void clear ();
+
+      /** @return number of answers in the histogram */
+      std::size_t size () const;
+
+      /** @return area under ROC curve */
+      double AUC () const;
+
+      /** @return maximal difference between AUC() and AUC elaborated for unbinned answers */
+      double AUC_error_bound () const;
+
+      /** @return AUC, Youden and minimal distance thresholds and ROC points at lower edges of bins.
+          Thresholds are lower edges of bins. */
+      results calculate_ROC_points () const;
+
+   protected:
+      /** @return index of a bin for a value */
+      std::size_t bin (const double value) const;
+      /** @return lower edge of a bin */
+      double lower_edge (const std::size_t bin) const;
+   };
+}
+
+#endif
@@ -12,6 +12,7 @@
 #include "../auxiliary/matrix.h"
 #include "../auxiliary/definitions.h"
 #include "../service/debug.h"
+#include "../auxiliary/random_service.h"
 
 
 namespace ksi 
@@ -188,13 +189,13 @@ namespace ksi
  
 std::vector<double> ksi::get_uniform_unit_random_vector (const std::size_t size)
 {
-    static std::default_random_engine silnik (std::chrono::system_clock::now().time_since_epoch().count());
+    auto silnik = ksi::random_service::next_stream();
     
     std::uniform_real_distribution<double> distro (0.0, 1.0);
     
     std::vector<double> w (size);
     
-    std::generate(w.begin(), w.end(), [&distro] () { return distro(silnik);});
+    std::generate(w.begin(), w.end(), [&distro, &silnik] () { return distro(silnik);});
     
     return w;   
     
@@ -33,15 +33,15 @@ void ksi::data_modifier_filter::modify(ksi::dataset & ds)
       if (_index < 0 or _index >= nDataItems)
           return;
       
-      dataset result;
+      std::vector<std::size_t> kept;
       
       for (size_t i = 0; i < nDataItems; i++)
       {
           if (_filter(ds.get(i, _index)))
-              result.addDatum(*ds.getDatum(i));
+              kept.push_back(i);
       }
       
-      ds = result;
+      ds = ds.subdataset(kept);
       
       // and call pNext modifier
       if (pNext)
@@ -195,3 +195,40 @@ std::vector< const ksi::datum* >  ksi::data_modifier_imputer_values_from_knn::ge
    return neighbours;  
 }
  
+
+ksi::imputation_overlay ksi::data_modifier_imputer_values_from_knn::overlay(const ksi::dataset & ds)
+{
+   try
+   {
+      if (_k < 0)
+         throw std::string ("number of neighbours not set");
+      
+      std::size_t nRows = ds.getNumberOfData();
+      std::size_t nCols = ds.getNumberOfAttributes();
+      
+      std::vector<std::vector<double>> candidates;
+      for (std::size_t r = 0; r < nRows; r++)
+      {
+         std::vector<std::size_t> indices_of_missing_attr;
+         for (std::size_t c = 0; c < nCols; c++)
+            if (not ds.exists(r, c))
+               indices_of_missing_attr.push_back(c);
+         
+         if (indices_of_missing_attr.size() > 0) // incomplete data item
+         {
+            // the same neighbours as in the modify method
+            std::vector<const ksi::datum *> neighbours = getNeighbours (ds, r, indices_of_missing_attr, _k);
+            
+            std::vector<double> values;
+            values.reserve(_k * indices_of_missing_attr.size());
+            for (int k = 0; k < _k; k++)
+               for (const auto a : indices_of_missing_attr)
+                  values.push_back(neighbours[k]->at(a)->getValue());
+            candidates.push_back(std::move(values));
+         }
+      }
+      
+      return ksi::imputation_overlay (ds, candidates);
+   }
+   CATCH;
+}
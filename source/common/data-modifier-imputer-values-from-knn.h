@@ -6,6 +6,7 @@
 #include "datum.h"
 #include "data-modifier.h"
 #include "data-modifier-imputer-knn.h"
+#include "imputation_overlay.h"
 
 namespace ksi
 {
@@ -52,6 +53,18 @@ namespace ksi
        */
       virtual void modify (dataset & ds);  
       
+      /** The method imputes the same values as the modify method, but 
+       * does not create the imputed data set. Only candidate values of missing
+       * attributes are stored on top of the original data.
+       * Next modifiers in the chain are not applied.
+       * @param ds dataset to impute
+       * @return imputation overlay whose upper view holds the data items of 
+       *         the imputed data set (in the same order)
+       * @throw ksi::exception if _k not set
+       * @date 2026-10-19
+       */
+      ksi::imputation_overlay overlay (const dataset & ds);
+      
   
        
    };
@@ -98,7 +98,7 @@ void ksi::data_modifier_outlier_remove_sigma::modify(ksi::dataset & ds)
       
       // 2. usunac odstajace wartosci
        
-      ksi::dataset nowy_zbior_danych;
+      std::vector<std::size_t> zostajace;
       
       for (size_t w = 0; w < nDataItems; w++)
       {
@@ -111,11 +111,11 @@ void ksi::data_modifier_outlier_remove_sigma::modify(ksi::dataset & ds)
           }
           
           if (not doUsuniecia) // kopiujemy dana
-              nowy_zbior_danych.addDatum(* ds.getDatum(w));
+              zostajace.push_back(w);
       }
       
       // i tyle
-      ds = nowy_zbior_danych;
+      ds = ds.subdataset(zostajace);
             
       
       // and call pNext modifier
@@ -74,6 +74,11 @@ void ksi::data_modifier::addModifier(ksi::data_modifier & dm)
       pNext->addModifier(dm);
 }
 
+bool ksi::data_modifier::hasNextModifier() const
+{
+   return pNext != nullptr;
+}
+
 std::string ksi::data_modifier::print() const
 {
    if (pNext)
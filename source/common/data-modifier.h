@@ -55,6 +55,10 @@ namespace ksi
           of this object. */ 
       void addModifier (data_modifier & dm);
       
+      /** @return true if a next modifier is set in the chain
+          @date 2026-10-19 */
+      bool hasNextModifier () const;
+      
       /** @return name of modifiers in chain */
       virtual std::string print () const ;
       
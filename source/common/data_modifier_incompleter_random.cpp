@@ -5,10 +5,11 @@
 #include "data-modifier.h"
 #include "data_modifier_incompleter.h"
 #include "data_modifier_incompleter_random.h"
+#include "../auxiliary/random_service.h"
 
 ksi::data_modifier_incompleter_random::data_modifier_incompleter_random (const double missing_ratio) : _missing_ratio(missing_ratio)
 {
-   random_engine = std::default_random_engine (std::chrono::system_clock::now().time_since_epoch().count());
+   random_engine = ksi::random_service::next_stream();
    distribution = std::uniform_real_distribution<double> (0.0, 1.0);
 }
 
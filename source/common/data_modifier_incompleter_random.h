@@ -8,6 +8,7 @@
 #include "dataset.h"
 #include "data-modifier.h"
 #include "data_modifier_incompleter.h"
+#include "../auxiliary/random_service.h"
 
 namespace ksi
 {
@@ -35,7 +36,7 @@ namespace ksi
       
    private:
       double _missing_ratio; 
-      std::default_random_engine random_engine;
+      ksi::philox random_engine;
       std::uniform_real_distribution<double> distribution;
       std::size_t number_of_data_items;
       
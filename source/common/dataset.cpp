@@ -13,24 +13,22 @@
 
 void ksi::dataset::remove_untypical_data(const double minimal_typicality)
 {
-    std::vector<datum *> typical_data;
+    std::vector<std::shared_ptr<datum>> typical_data;
     
     auto size = data.size();
+    std::vector<bool> kept (size, false);
     for (std::size_t i = 0; i < size; i++)
     {
         if (not data[i]->isTypicalityOn() or data[i]->getTypicality() >= minimal_typicality)
         {
-            typical_data.push_back(data[i]);
+            typical_data.push_back(std::move(data[i]));
           //  debug(data[i]->getNumberOfAttributes());
-            data[i] = nullptr;
+            kept[i] = true;
         }
     }
-    
-    for (auto & p : data)
-        if (p)
-            delete p;
         
-    data = typical_data;
+    data = std::move(typical_data);
+    keep_labels(kept);
 }
 
 void ksi::dataset::remove_untypical_data(const std::vector<bool>& typical_data)
@@ -44,23 +42,17 @@ void ksi::dataset::remove_untypical_data(const std::vector<bool>& typical_data)
             throw ksi::exception (ss.str());
         }
         
-        std::vector<datum *> typical_dataset;
+        std::vector<std::shared_ptr<datum>> typical_dataset;
         
         auto size = data.size();
         for (std::size_t i = 0; i < size; i++)
         {
             if (typical_data[i])
-            {
-                typical_dataset.push_back(data[i]);
-                data[i] = nullptr;
-            }
+                typical_dataset.push_back(std::move(data[i]));
         }
-        
-        for (auto & p : data)
-            if (p)
-                delete p;
             
-        data = typical_dataset;
+        data = std::move(typical_dataset);
+        keep_labels(typical_data);
     }
     CATCH;
 }
@@ -82,12 +74,12 @@ std::vector<bool> ksi::dataset::get_if_data_typical(const double minimal_typical
 
 
 
-ksi::dataset::dataset(const ksi::dataset & ds)
+ksi::dataset::dataset(const ksi::dataset & ds) : data (ds.data) // data items are shared
 {
-   for (auto & p : ds.data)
-      data.push_back(p->clone());
-   
    _maximalNumberLabel = ds._maximalNumberLabel;
+   _label_dictionary = ds._label_dictionary;
+   _label_offsets = ds._label_offsets;
+   _label_ids = ds._label_ids;
 }
 
 
@@ -95,6 +87,9 @@ ksi::dataset::dataset(ksi::dataset && ds)
 {
    std::swap (data, ds.data);
    std::swap ( _maximalNumberLabel, ds._maximalNumberLabel );
+   std::swap (_label_dictionary, ds._label_dictionary);
+   std::swap (_label_offsets, ds._label_offsets);
+   std::swap (_label_ids, ds._label_ids);
 }
 
 ksi::dataset::dataset()
@@ -103,11 +98,6 @@ ksi::dataset::dataset()
 
 ksi::dataset::~dataset()
 {
-   for (auto & p : data)
-   {
-      delete p;
-      p = nullptr;
-   }
 }
 
 ksi::dataset& ksi::dataset::operator=(const ksi::dataset& ds)
@@ -115,15 +105,12 @@ ksi::dataset& ksi::dataset::operator=(const ksi::dataset& ds)
    if (this == & ds)
       return *this;
    
-   for (auto & p : data)
-      delete p;
-   
-   data.clear();
-   
-   for (auto & p : ds.data)
-      data.push_back(p->clone());
+   data = ds.data; // data items are shared
    
    _maximalNumberLabel = ds._maximalNumberLabel;
+   _label_dictionary = ds._label_dictionary;
+   _label_offsets = ds._label_offsets;
+   _label_ids = ds._label_ids;
    return *this;
 }
 
@@ -164,22 +151,120 @@ ksi::dataset& ksi::dataset::operator=(ksi::dataset&& ds)
    
    std::swap (data, ds.data);
    std::swap ( _maximalNumberLabel, ds._maximalNumberLabel );
+   std::swap (_label_dictionary, ds._label_dictionary);
+   std::swap (_label_offsets, ds._label_offsets);
+   std::swap (_label_ids, ds._label_ids);
    
    return *this;
 }
 
 void ksi::dataset::addDatum(const ksi::datum & d)
 {
-   data.push_back(new ksi::datum(d));
-   if (_maximalNumberLabel < d.getID())
-       _maximalNumberLabel = d.getID();
+   addDatum(new ksi::datum(d));
 }
 
 void ksi::dataset::addDatum(ksi::datum * p)
 {
-   data.push_back(p);
+   data.emplace_back(p);
    if (_maximalNumberLabel < p->getID())
        _maximalNumberLabel = p->getID();
+   append_labels(p->releaseLabels());
+}
+
+void ksi::dataset::add_copy_of(const ksi::dataset & ds, const std::size_t r)
+{
+   data.push_back(ds.data[r]); // shared, not copied
+   if (_maximalNumberLabel < (std::size_t) ds.data[r]->getID())
+       _maximalNumberLabel = ds.data[r]->getID();
+   append_labels(ds, r);
+}
+
+void ksi::dataset::append_labels(const std::vector<std::string> & labels)
+{
+   if (labels.empty() and _label_offsets.empty())
+      return;
+   
+   if (_label_offsets.empty()) // the first labelled data item, previous items have no labels
+      _label_offsets.assign(data.size(), 0);
+   if (not _label_dictionary)
+      _label_dictionary = std::make_shared<ksi::label_dictionary>();
+   
+   for (const auto & label : labels)
+      _label_ids.push_back(_label_dictionary->intern(label));
+   _label_offsets.push_back(_label_ids.size());
+}
+
+void ksi::dataset::append_labels(const ksi::dataset & ds, const std::size_t r)
+{
+   const auto ids = ds.getLabelIds(r);
+   if (ids.empty() and _label_offsets.empty())
+      return;
+   
+   if (_label_offsets.empty())
+      _label_offsets.assign(data.size(), 0);
+   if (not _label_dictionary) // parts of a dataset share its dictionary
+      _label_dictionary = ds._label_dictionary;
+   
+   if (_label_dictionary == ds._label_dictionary)
+      _label_ids.insert(_label_ids.end(), ids.begin(), ids.end());
+   else 
+      for (const auto id : ids)
+         _label_ids.push_back(_label_dictionary->intern(ds._label_dictionary->get_label(id)));
+   _label_offsets.push_back(_label_ids.size());
+}
+
+void ksi::dataset::keep_labels(const std::vector<bool> & kept)
+{
+   if (_label_offsets.empty())
+      return;
+   
+   std::vector<std::size_t> offsets { 0 };
+   std::vector<ksi::label_dictionary::id_type> ids;
+   for (std::size_t r = 0; r < kept.size(); r++)
+   {
+      if (kept[r])
+      {
+         ids.insert(ids.end(), _label_ids.begin() + _label_offsets[r], _label_ids.begin() + _label_offsets[r + 1]);
+         offsets.push_back(ids.size());
+      }
+   }
+   _label_offsets = std::move(offsets);
+   _label_ids = std::move(ids);
+}
+
+bool ksi::dataset::hasLabels() const
+{
+   return not _label_ids.empty();
+}
+
+std::span<const ksi::label_dictionary::id_type> ksi::dataset::getLabelIds(const std::size_t row) const
+{
+   try
+   {
+      if (row >= data.size())
+         throw ksi::exception ("Illegal index of a data item: " + std::to_string(row) + ", number of data items: " + std::to_string(data.size()) + ".");
+      if (_label_offsets.empty())
+         return {};
+      return { _label_ids.data() + _label_offsets[row], _label_offsets[row + 1] - _label_offsets[row] };
+   }
+   CATCH;
+}
+
+std::vector<std::string> ksi::dataset::getLabels(const std::size_t row) const
+{
+   try
+   {
+      std::vector<std::string> labels;
+      for (const auto id : getLabelIds(row))
+         labels.push_back(_label_dictionary->get_label(id));
+      return labels;
+   }
+   CATCH;
+}
+
+std::shared_ptr<const ksi::label_dictionary> ksi::dataset::getLabelDictionary() const
+{
+   return _label_dictionary;
 }
 
 std::size_t ksi::dataset::getMaximalNumericalLabel() const
@@ -288,7 +373,7 @@ void ksi::dataset::set (std::size_t row, std::size_t col, double value)
          throw ss.str();
       }
        
-      data[row]->at(col)->setValue(value);
+      detach(row)->at(col)->setValue(value);
    }
    CATCH;
 }
@@ -324,6 +409,23 @@ std::vector<std::vector<double> > ksi::dataset::getMatrix(double) const
    CATCH;
 }
 
+std::vector<std::vector<float>> ksi::dataset::getMatrix(float) const
+{
+   try 
+   {
+      std::size_t nRow = getNumberOfData();
+      std::size_t nCol = getNumberOfAttributes();
+      
+      std::vector<std::vector<float>> wynik (nRow, std::vector<float> (nCol));
+      for (std::size_t w = 0; w < nRow; w++)
+         for (std::size_t k = 0; k < nCol; k++)
+            wynik[w][k] = get(w, k);
+      
+      return wynik;
+   }
+   CATCH;
+}
+
 
 std::vector<std::vector<ksi::ext_fuzzy_number_gaussian>> ksi::dataset::getMatrixOfFuzzyNumbers() const
 {
@@ -363,22 +465,29 @@ const ksi::datum * ksi::dataset::getDatum(std::size_t r) const
    {
       if (r < 0 or r >= data.size())
          return nullptr;
-      return data[r];
+      return data[r].get();
    }
    CATCH;
 }
 
-ksi::datum * ksi::dataset::getDatumNonConst(std::size_t r) const
+ksi::datum * ksi::dataset::getDatumNonConst(std::size_t r)
 {
    try
    {
       if (r < 0 or r >= data.size())
          return nullptr;
-      return data[r];
+      return detach(r);
    }
    CATCH;
 }
 
+ksi::datum * ksi::dataset::detach(const std::size_t r)
+{
+   if (data[r].use_count() > 1)
+      data[r] = std::shared_ptr<ksi::datum> (data[r]->clone());
+   return data[r].get();
+}
+
 
 void ksi::dataset::resetIDs()
 {
@@ -387,8 +496,9 @@ void ksi::dataset::resetIDs()
       auto maxi = getNumberOfData();
       for (long int i = 0; i < maxi; i++)
       {
-         data[i]->setID(i);
-         data[i]->setIDincomplete(-1);
+         auto p = detach(i);
+         p->setID(i);
+         p->setIDincomplete(-1);
       }
       
    }
@@ -427,7 +537,7 @@ namespace ksi
 std::string ksi::dataset::to_string() const
 {
    std::stringstream ss;
-   for (const auto row : this->data)
+   for (const auto & row : this->data)
       ss << row->to_string() << std::endl;      
    return ss.str();
 }
@@ -472,11 +582,30 @@ ksi::dataset ksi::dataset::subdataset(const std::size_t start_index, const std::
     std::size_t _end   = std::min (maximal_index, end_index);
     
     for (auto i = _start; i <= _end; i++)
-       result.data.push_back(data[i]->clone());
+       result.add_copy_of(*this, i);
     
     return result;
 }
 
+ksi::dataset ksi::dataset::subdataset(const std::vector<std::size_t> & indices) const
+{
+    try 
+    {
+        ksi::dataset result;
+        result.data.reserve(indices.size());
+        const auto size = data.size();
+        
+        for (const auto i : indices)
+        {
+            if (i >= size)
+                throw ksi::exception ("Illegal index of a data item: " + std::to_string(i) + ", number of data items: " + std::to_string(size) + ".");
+            result.add_copy_of(*this, i);
+        }
+        return result;
+    }
+    CATCH;
+}
+
 bool ksi::dataset::empty() const
 {
     return getNumberOfData() == 0;
@@ -500,13 +629,56 @@ ksi::dataset & ksi::dataset::operator += (const ksi::dataset& ds)
         std::size_t N = ds.getNumberOfData();
         
         for (std::size_t i = 0; i < N; i++)
-            this->addDatum(*(ds.getDatum(i)));
+            add_copy_of(ds, i);
+        
+        return *this;
+    }
+    CATCH;
+}
+
+
+ksi::dataset & ksi::dataset::operator += (ksi::dataset && ds)
+{
+    try 
+    {
+        if (this == & ds)
+            return *this;
+        if (not empty () and not ds.empty() and getNumberOfAttributes() != ds.getNumberOfAttributes())
+            throw ksi::exception ("Numbers of attributes in both data sets do not match: " + std::to_string(getNumberOfAttributes()) + " and " + std::to_string(ds.getNumberOfAttributes()) + ".");
+        
+        for (std::size_t i = 0; i < ds.data.size(); i++)
+        {
+            data.push_back(std::move(ds.data[i]));
+            if (_maximalNumberLabel < (std::size_t) data.back()->getID())
+                _maximalNumberLabel = data.back()->getID();
+            append_labels(ds, i);
+        }
+        ds.data.clear();
+        ds._label_offsets.clear();
+        ds._label_ids.clear();
         
         return *this;
     }
     CATCH;
 }
 
+void ksi::dataset::truncate(const std::size_t number_of_items)
+{
+    try 
+    {
+        if (number_of_items > data.size())
+            throw ksi::exception ("Cannot truncate a dataset of " + std::to_string(data.size()) + " data items to " + std::to_string(number_of_items) + " data items.");
+        
+        data.resize(number_of_items);
+        
+        if (not _label_offsets.empty())
+        {
+            _label_ids.resize(_label_offsets[number_of_items]);
+            _label_offsets.resize(number_of_items + 1);
+        }
+    }
+    CATCH;
+}
 
 std::pair<ksi::dataset, ksi::dataset> ksi::dataset::cufOffLastAttribute() const
 {
@@ -528,14 +700,48 @@ std::pair<ksi::dataset, ksi::dataset> ksi::dataset::splitDataSetHorizontally(std
     
     std::size_t i;
     for (i = 0; i < N and i < size; i++)
-        first.addDatum(*(getDatum(i)));
+        first.add_copy_of(*this, i);
     for ( ; i < size; i++)
-        second.addDatum(*(getDatum(i)));
+        second.add_copy_of(*this, i);
     
     return { first, second }; 
 }
 
 
+void ksi::dataset::save_print(std::ostream & os) const
+{
+    try
+    {
+        const auto size = data.size();
+        for (std::size_t r = 0; r < size; r++)
+        {
+            const auto ids = getLabelIds(r);
+            if (ids.empty()) // labels (if any) are held in the datum
+            {
+                data[r]->save_print(os);
+                continue;
+            }
+            
+            const auto nAttributes = data[r]->getNumberOfAttributes();
+            for (std::size_t a = 0; a < nAttributes; a++)
+            {
+                os << data[r]->at(a)->getValue();
+                if (a < nAttributes - 1)
+                    os << " ";
+            }
+            os << " | ";
+            for (std::size_t l = 0; l < ids.size(); l++)
+            {
+                os << _label_dictionary->get_label(ids[l]);
+                if (l < ids.size() - 1)
+                    os << " ";
+            }
+            os << std::endl;
+        }
+    }
+    CATCH;
+}
+
 std::vector<double> ksi::dataset::extract_weights()
 {
     std::vector<double> weights;
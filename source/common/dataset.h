@@ -5,13 +5,24 @@
 
 #include <iostream>
 #include <vector>
+#include <memory>
+#include <span>
 #include "datum.h"
+#include "label_dictionary.h"
 #include "../common/extensional-fuzzy-number-gaussian.h"
 #include "../common/DatasetStatistics.h"
 
 namespace ksi
 {
    /** Class representing a data set.
+    
+    Data items are immutable and shared: copies of a dataset, its subdatasets, 
+    horizontal splits and sums share data items (only pointers are copied). 
+    A data item is copied (copy on write) when it is modified with set, getDatumNonConst 
+    or resetIDs and it is shared with another dataset, 
+    so modifications are never visible in other datasets.
+    A pointer returned by getDatumNonConst is valid for modifications 
+    until the dataset is copied.
     @date   2017-12-29
     @author Krzysztof Siminski 
     */
@@ -21,8 +32,37 @@ namespace ksi
       /** maximal numerical label of data items  */ 
       std::size_t _maximalNumberLabel = 0; 
        
-      std::vector<datum *> data;
+      /** data items, shared by copies and parts of the dataset */
+      std::vector<std::shared_ptr<datum>> data;
       //const char MISSING_VALUE_SYMBOL = '?';
+      
+      /** Labels of data items: ids of labels of the r-th data item are 
+          [_label_offsets[r], _label_offsets[r + 1]) in _label_ids.
+          _label_offsets is empty if no data item has a label. 
+          The dictionary is shared by copies and parts of a dataset. */
+      std::shared_ptr<ksi::label_dictionary> _label_dictionary;
+      std::vector<std::size_t> _label_offsets;
+      std::vector<ksi::label_dictionary::id_type> _label_ids;
+      
+      /** The method appends labels of the last added data item. */
+      void append_labels (const std::vector<std::string> & labels);
+      
+      /** The method appends labels of the r-th data item of ds for the last added data item. */
+      void append_labels (const dataset & ds, const std::size_t r);
+      
+      /** The method keeps labels of the data items to keep. */
+      void keep_labels (const std::vector<bool> & kept);
+      /** The method adds the r-th data item of ds with its labels 
+          (the data item is shared, not copied). 
+          @param ds dataset 
+          @param r index of a data item in ds
+          @date 2026-10-19 */
+      void add_copy_of (const dataset & ds, const std::size_t r);
+      
+      /** The method copies the r-th data item if it is shared with another dataset.
+          @return the r-th data item (not shared) 
+          @date 2026-10-19 */
+      datum * detach (const std::size_t r);
    public:
       virtual ~dataset();
       
@@ -53,11 +93,45 @@ namespace ksi
        @throw ksi::exception If the numbers of attributes in both datasets do not match. */
       dataset & operator += (const dataset & ds);
       
-      /** The method adds a datum to the dataset by copying (allocates memory). */
+      /** The method moves data items from the right operand (no data items are copied).
+       * The right operand is left empty. 
+       @throw ksi::exception If the numbers of attributes in both datasets do not match. 
+       @date 2026-10-18 */
+      dataset & operator += (dataset && ds);
+      
+      /** The method removes data items with indices not less than number_of_items. 
+       @param number_of_items number of data items left in the dataset
+       @throw ksi::exception if number_of_items is greater than the number of data items
+       @date 2026-10-18 */
+      void truncate (const std::size_t number_of_items);
+      
+      /** The method adds a datum to the dataset by copying (allocates memory).
+          Labels of the datum are interned in the label dictionary of the dataset. */
       void addDatum (const ksi::datum & d);
-      /** The method adds a datum to the dataset without allocation of memory. */
+      /** The method adds a datum to the dataset without allocation of memory. 
+          Labels of the datum are moved to the label dictionary of the dataset. */
       void addDatum (ksi::datum* p);
       
+      /** @return true if any data item has labels
+          @date 2026-10-19 */
+      bool hasLabels () const;
+      
+      /** @return ids of labels of a data item in the label dictionary (empty if the item has no labels)
+          @param row index of a data item
+          @throw ksi::exception if row is illegal
+          @date 2026-10-19 */
+      std::span<const ksi::label_dictionary::id_type> getLabelIds (const std::size_t row) const;
+      
+      /** @return labels of a data item
+          @param row index of a data item
+          @throw ksi::exception if row is illegal
+          @date 2026-10-19 */
+      std::vector<std::string> getLabels (const std::size_t row) const;
+      
+      /** @return label dictionary of the dataset (nullptr if no data item has labels)
+          @date 2026-10-19 */
+      std::shared_ptr<const ksi::label_dictionary> getLabelDictionary () const;
+      
       /** @return returns number of data items in the dataset */
       std::size_t getNumberOfData() const;
       
@@ -108,6 +182,12 @@ namespace ksi
        * @param dummy dummy parameter, used only to distinguish methods, exactly the same as getMatrix()
        * @exception ksi::exception if some data do not exists */
       std::vector<std::vector<double>> getMatrix (double dummy) const ;
+      
+      /** @return a matrix of data in single precision
+       * @param dummy dummy parameter, used only to distinguish methods
+       * @exception ksi::exception if some data do not exists
+       * @date 2026-10-18 */
+      std::vector<std::vector<float>> getMatrix (float dummy) const ;
 
       /** @return a matrix of data 
        * @exception ksi::exception if some data do not exists
@@ -129,12 +209,13 @@ namespace ksi
        */
       const datum * getDatum (std::size_t r) const ;
       
-      /** A method get r-th datum from the dataset. The method does not copy the datum!
+      /** A method get r-th datum from the dataset. The method does not copy the datum
+       * unless it is shared with another dataset (copy on write).
        * @return a pointer to the datum or nullptr if r is illegal 
        * @param  r index of datum 
        * @date 2018-01-04
        */
-      datum * getDatumNonConst (std::size_t r) const;
+      datum * getDatumNonConst (std::size_t r);
 
       /** The method splits horizontally the dataset into two datasets.
        * The first dataset has number_of_items.
@@ -164,12 +245,22 @@ namespace ksi
       std::pair<dataset, dataset> cufOffLastAttribute () const ;
       
       
-      /** @return The method return a subdataset composed of copies of data with indices in range [start_index, end_index].
+      /** @return The method return a subdataset composed of data with indices in range [start_index, end_index] (shared, not copied).
        * If end_index is larger than maximal index in the data set, it is reset to the maximal possible index in the dataset.
        * @date 2019-02-27
        */
       dataset subdataset (const std::size_t start_index, const std::size_t end_index) const;
       
+      /** @return The method return a subdataset composed of data with the indices passed (shared, not copied).
+       *  The original dataset is not modified. Labels of data items are kept 
+       *  (labels are held in the label dictionary of a dataset, so data items 
+       *  copied with getDatum and addDatum lose their labels).
+       *  @param indices indices of data items to copy
+       *  @throw ksi::exception if an index is illegal
+       *  @date 2026-10-18
+       */
+      dataset subdataset (const std::vector<std::size_t> & indices) const;
+      
       /** return maximal numerical label of data items */
       std::size_t getMaximalNumericalLabel () const;
       
@@ -212,6 +303,13 @@ namespace ksi
        * @author Krzysztof Siminski
        * @date   2023-05-09 */
       std::string to_string () const;
+      
+      /** The method prints data items in the format of ksi::multilabel_reader_complete:
+       *  numerical attributes are separated from labels with a bar '|', e.g.
+       *  1.2 5.6 7.8 | A B
+       * @param os output stream
+       * @date 2026-10-19 */
+      void save_print (std::ostream & os) const;
 
       /** @author Konrad Wnuk
          * @date   2023-12-01 */
@@ -0,0 +1,79 @@
+/** @file */
+
+#include <vector>
+#include <random>
+#include <string>
+
+#include "../common/dataset_generator.h"
+#include "../common/dataset.h"
+#include "../common/datum.h"
+#include "../common/number.h"
+#include "../service/debug.h"
+
+ksi::dataset_generator::dataset_generator(const std::uint64_t seed) : _seed (seed)
+{
+}
+
+ksi::dataset ksi::dataset_generator::generate(const std::size_t number_of_items,
+                                              const std::size_t number_of_attributes,
+                                              const std::size_t number_of_clusters,
+                                              const double missing_ratio,
+                                              const bool classification) const
+{
+    try
+    {
+        if (number_of_clusters == 0)
+            throw ksi::exception ("The number of clusters must be positive.");
+        if (missing_ratio < 0.0 or missing_ratio > 1.0)
+            throw ksi::exception ("The missing ratio (" + std::to_string(missing_ratio) + ") must be in [0, 1].");
+
+        // std::mt19937_64 gives the same sequence on all platforms
+        std::mt19937_64 engine (_seed);
+        std::uniform_real_distribution<double> centres (-10.0, 10.0);
+        std::uniform_real_distribution<double> deviations (0.5, 2.0);
+        std::uniform_real_distribution<double> slopes (-1.0, 1.0);
+        std::uniform_real_distribution<double> unit (0.0, 1.0);
+        std::normal_distribution<double> gauss (0.0, 1.0);
+
+        std::vector<std::vector<double>> mean (number_of_clusters, std::vector<double>(number_of_attributes));
+        std::vector<std::vector<double>> sigma (number_of_clusters, std::vector<double>(number_of_attributes));
+        std::vector<std::vector<double>> slope (number_of_clusters, std::vector<double>(number_of_attributes + 1));
+        for (std::size_t c = 0; c < number_of_clusters; c++)
+        {
+            for (std::size_t a = 0; a < number_of_attributes; a++)
+            {
+                mean[c][a]  = centres(engine);
+                sigma[c][a] = deviations(engine);
+                slope[c][a] = slopes(engine);
+            }
+            slope[c][number_of_attributes] = centres(engine);
+        }
+
+        ksi::dataset ds;
+        for (std::size_t i = 0; i < number_of_items; i++)
+        {
+            auto c = i % number_of_clusters;
+            std::vector<double> values (number_of_attributes);
+            double decision = slope[c][number_of_attributes];
+            for (std::size_t a = 0; a < number_of_attributes; a++)
+            {
+                values[a] = mean[c][a] + sigma[c][a] * gauss(engine);
+                decision += slope[c][a] * values[a];
+            }
+            if (classification)
+                decision = c % 2;
+            else
+                decision += gauss(engine);
+
+            values.push_back(decision);
+            auto pDatum = new ksi::datum (values);
+            for (std::size_t a = 0; a < number_of_attributes; a++)
+                if (unit(engine) < missing_ratio)
+                    pDatum->make_attribute_incomplete(a);
+            pDatum->setID(i);
+            ds.addDatum(pDatum);
+        }
+        return ds;
+    }
+    CATCH;
+}
@@ -0,0 +1,48 @@
+/** @file */
+
+#ifndef DATASET_GENERATOR_H
+#define DATASET_GENERATOR_H
+
+#include <random>
+#include <cstdint>
+
+#include "../common/dataset.h"
+
+namespace ksi
+{
+   /** The class generates synthetic datasets: mixtures of gaussian clusters.
+       The generator is deterministic: the same seed and parameters always give the same dataset.
+       @date   2026-10-18
+    */
+   class dataset_generator
+   {
+   protected:
+      std::uint64_t _seed;
+
+   public:
+      /** @param seed seed of the random engine */
+      dataset_generator (const std::uint64_t seed = 0);
+
+      /** The method generates a mixture of gaussian clusters.
+          Centres of clusters are uniformly distributed in the [-10, 10] hypercube,
+          standard deviations in each dimension are drawn from [0.5, 2].
+          The last attribute is a decision: for regression a linear function of the
+          inputs (different in each cluster) with gaussian noise, for classification
+          the class label (0 or 1) of the cluster.
+          The decision attribute is never missing.
+          @param number_of_items number of data items
+          @param number_of_attributes number of input attributes (without the decision)
+          @param number_of_clusters number of gaussian clusters
+          @param missing_ratio probability of a missing value in an input attribute
+          @param classification true for class labels, false for numeric decisions
+          @return generated dataset
+          @throw ksi::exception if number_of_clusters == 0 or missing_ratio not in [0, 1] */
+      dataset generate (const std::size_t number_of_items,
+                        const std::size_t number_of_attributes,
+                        const std::size_t number_of_clusters,
+                        const double missing_ratio = 0.0,
+                        const bool classification = false) const;
+   };
+}
+
+#endif
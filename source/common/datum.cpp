@@ -388,6 +388,13 @@ std::size_t ksi::datum::getNumberOfLabels() const
     return _labels.size();
 }
 
+std::vector<std::string> ksi::datum::releaseLabels()
+{
+    std::vector<std::string> labels;
+    std::swap(labels, _labels);
+    return labels;
+}
+
 void ksi::datum::save_print(std::ostream& os) const
 {
     for (std::size_t i = 0; i < attributes.size(); ++i)
@@ -23,7 +23,7 @@ namespace ksi
       std::vector<number *> attributes;
       /** decision value */
       number * pDecision = nullptr;
-      /** labels of a datum */
+      /** labels of a datum (not held in a dataset, see ksi::dataset::getLabels) */
       std::vector<std::string> _labels;
       /** weight of a datum item, default value 1.0 */
       double _weight = 1.0;
@@ -170,6 +170,8 @@ namespace ksi
       void setLabels(const std::vector<std::string> & labels);
       
       /** The method gets labels of a datum.
+       Labels of a data item held in a dataset are stored in the dataset 
+       (ksi::dataset::getLabels).
        @return labels of a datum
        @date 2022-05-14
        @author Krzysztof Siminski */
@@ -202,6 +204,13 @@ namespace ksi
        @author Krzysztof Siminski */
       std::size_t getNumberOfLabels () const;
       
+      /** The method moves labels out of a datum, the datum is left without labels.
+       A dataset takes labels of added data items into its label dictionary
+       (ksi::dataset::getLabels).
+       @return labels of a datum
+       @date 2026-10-19 */
+      std::vector<std::string> releaseLabels ();
+      
       /** The methods makes an attribute missing. 
        @param attribute index of an attribute to be made missing 
        @date 2024-09-22
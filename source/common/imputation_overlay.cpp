@@ -0,0 +1,159 @@
+/** @file */
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "imputation_overlay.h"
+#include "dataset.h"
+#include "../service/debug.h"
+
+ksi::imputation_overlay::imputation_overlay()
+{
+}
+
+ksi::imputation_overlay::imputation_overlay(const ksi::dataset & ds, const std::vector<std::vector<double>> & candidates)
+{
+   try
+   {
+      _nRows = ds.getNumberOfData();
+      _nAttributes = ds.getNumberOfAttributes();
+      _values.assign(_nRows * _nAttributes, 0.0);
+      _missing_offsets.reserve(_nRows + 1);
+      _item_offsets.reserve(_nRows + 1);
+      _candidate_offsets.reserve(_nRows + 1);
+
+      std::size_t nIncomplete = 0;
+      for (std::size_t r = 0; r < _nRows; r++)
+      {
+         for (std::size_t a = 0; a < _nAttributes; a++)
+         {
+            if (ds.exists(r, a))
+               _values[r * _nAttributes + a] = ds.get(r, a);
+            else
+               _missing_columns.push_back(a);
+         }
+         _missing_offsets.push_back(_missing_columns.size());
+
+         const std::size_t nMissing = _missing_offsets[r + 1] - _missing_offsets[r];
+         std::size_t nItems = 1;
+         if (nMissing == 0)
+            _complete_rows.push_back(r);
+         else
+         {
+            if (nIncomplete >= candidates.size())
+               throw ksi::exception ("Too few vectors of candidates (" + std::to_string(candidates.size()) + ") for incomplete data items.");
+            const auto & values = candidates[nIncomplete++];
+            if (values.empty() or values.size() % nMissing != 0)
+               throw ksi::exception ("The number of candidate values (" + std::to_string(values.size()) + ") of the data item " + std::to_string(r) + " is not a positive multiple of the number of its missing attributes (" + std::to_string(nMissing) + ").");
+            nItems = values.size() / nMissing;
+            _candidates.insert(_candidates.end(), values.begin(), values.end());
+         }
+         _item_offsets.push_back(_item_offsets.back() + nItems);
+         _candidate_offsets.push_back(_candidates.size());
+      }
+      if (nIncomplete != candidates.size())
+         throw ksi::exception ("The number of vectors of candidates (" + std::to_string(candidates.size()) + ") does not match the number of incomplete data items (" + std::to_string(nIncomplete) + ").");
+   }
+   CATCH;
+}
+
+std::size_t ksi::imputation_overlay::get_number_of_attributes() const
+{
+   return _nAttributes;
+}
+
+std::size_t ksi::imputation_overlay::get_number_of_rows(const view v) const
+{
+   return v == view::lower ? _complete_rows.size() : _nRows;
+}
+
+std::size_t ksi::imputation_overlay::get_number_of_items(const view v) const
+{
+   return v == view::lower ? _complete_rows.size() : _item_offsets.back();
+}
+
+std::size_t ksi::imputation_overlay::get_row(const view v, const std::size_t i) const
+{
+   return v == view::lower ? _complete_rows[i] : i;
+}
+
+std::size_t ksi::imputation_overlay::get_first_item(const view v, const std::size_t i) const
+{
+   return v == view::lower ? i : _item_offsets[i];
+}
+
+std::size_t ksi::imputation_overlay::get_number_of_items(const view v, const std::size_t i) const
+{
+   return v == view::lower ? 1 : _item_offsets[i + 1] - _item_offsets[i];
+}
+
+std::span<const double> ksi::imputation_overlay::get_values(const view v, const std::size_t i) const
+{
+   return { _values.data() + get_row(v, i) * _nAttributes, _nAttributes };
+}
+
+std::span<const std::size_t> ksi::imputation_overlay::get_missing_columns(const view v, const std::size_t i) const
+{
+   if (v == view::lower)
+      return {};
+   return { _missing_columns.data() + _missing_offsets[i], _missing_offsets[i + 1] - _missing_offsets[i] };
+}
+
+std::span<const double> ksi::imputation_overlay::get_candidates(const view v, const std::size_t i) const
+{
+   if (v == view::lower)
+      return {};
+   return { _candidates.data() + _candidate_offsets[i], _candidate_offsets[i + 1] - _candidate_offsets[i] };
+}
+
+std::vector<std::vector<double>> ksi::imputation_overlay::get_matrix(const view v) const
+{
+   std::vector<std::vector<double>> matrix;
+   matrix.reserve(get_number_of_items(v));
+
+   const std::size_t nRows = get_number_of_rows(v);
+   for (std::size_t i = 0; i < nRows; i++)
+   {
+      const auto values = get_values(v, i);
+      const auto missing = get_missing_columns(v, i);
+      const auto candidates = get_candidates(v, i);
+      const std::size_t nItems = get_number_of_items(v, i);
+      for (std::size_t j = 0; j < nItems; j++)
+      {
+         std::vector<double> item (values.begin(), values.end());
+         for (std::size_t m = 0; m < missing.size(); m++)
+            item[missing[m]] = candidates[j * missing.size() + m];
+         matrix.push_back(std::move(item));
+      }
+   }
+   return matrix;
+}
+
+std::vector<double> ksi::imputation_overlay::maximum_by_rows(const std::vector<double> & values) const
+{
+   try
+   {
+      if (values.size() != _item_offsets.back())
+         throw ksi::exception ("The number of values (" + std::to_string(values.size()) + ") does not match the number of items in the upper view (" + std::to_string(_item_offsets.back()) + ").");
+
+      std::vector<double> maxima (_nRows);
+
+      // items of a row are consecutive, so rows are independent ranges
+      #pragma omp parallel for
+      for (std::size_t r = 0; r < _nRows; r++)
+         maxima[r] = *std::max_element(values.begin() + _item_offsets[r], values.begin() + _item_offsets[r + 1]);
+
+      return maxima;
+   }
+   CATCH;
+}
+
+std::size_t ksi::imputation_overlay::get_memory_size() const
+{
+   return sizeof(*this)
+        + _values.capacity() * sizeof(double)
+        + _candidates.capacity() * sizeof(double)
+        + (_missing_offsets.capacity() + _missing_columns.capacity() + _item_offsets.capacity()
+           + _candidate_offsets.capacity() + _complete_rows.capacity()) * sizeof(std::size_t);
+}
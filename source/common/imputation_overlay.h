@@ -0,0 +1,110 @@
+/** @file */
+
+#ifndef IMPUTATION_OVERLAY_H
+#define IMPUTATION_OVERLAY_H
+
+#include <vector>
+#include <span>
+
+#include "dataset.h"
+
+namespace ksi
+{
+   /** Imputed data stored as an overlay on the original (incomplete) data.
+    *  An imputer that substitutes an incomplete data item with several
+    *  data items (e.g. ksi::data_modifier_imputer_values_from_knn)
+    *  multiplies the observed values of the item. The overlay stores
+    *  the observed values once and for each incomplete data item
+    *  only indices of its missing attributes and candidate values
+    *  of the missing attributes (one vector of candidates for each imputed item).
+    *  Two views are available:
+    *  - lower: complete data items (as after ksi::data_modifier_marginaliser),
+    *  - upper: complete data items and imputed items of incomplete data items
+    *           (as after the imputer), items of a data item are consecutive
+    *           and in the order of original data items.
+    *  Clustering kernels iterate data items of a view and elaborate
+    *  the observed part of an incomplete item once for all its imputed items.
+    *  All items have unit weights.
+    *  @date 2026-10-19
+    */
+   class imputation_overlay
+   {
+   public:
+      enum class view { lower, upper };
+
+   protected:
+      std::size_t _nRows = 0;
+      std::size_t _nAttributes = 0;
+
+      /** observed values, row major, missing values are 0 */
+      std::vector<double> _values;
+
+      /** missing attributes of row r: [_missing_offsets[r], _missing_offsets[r + 1]) in _missing_columns */
+      std::vector<std::size_t> _missing_offsets { 0 };
+      std::vector<std::size_t> _missing_columns;
+
+      /** items of row r in the upper view: [_item_offsets[r], _item_offsets[r + 1]) */
+      std::vector<std::size_t> _item_offsets { 0 };
+
+      /** candidate values of row r: [_candidate_offsets[r], _candidate_offsets[r + 1]) in _candidates,
+          item major: [item * number_of_missing_attributes + m] */
+      std::vector<std::size_t> _candidate_offsets { 0 };
+      std::vector<double> _candidates;
+
+      /** rows of the lower view */
+      std::vector<std::size_t> _complete_rows;
+
+   public:
+      imputation_overlay ();
+
+      /** @param ds original data set
+          @param candidates candidate values for incomplete data items (in order of data items):
+                 for each imputed item values of all missing attributes (in ascending order of attributes)
+          @throw ksi::exception if the number of vectors of candidates does not match
+                 the number of incomplete data items or a vector is empty or its size
+                 is not a multiple of the number of missing attributes */
+      imputation_overlay (const ksi::dataset & ds, const std::vector<std::vector<double>> & candidates);
+
+      std::size_t get_number_of_attributes () const;
+
+      /** @return number of original data items in a view */
+      std::size_t get_number_of_rows (const view v) const;
+
+      /** @return number of data items in a view (for the upper view imputed items are counted) */
+      std::size_t get_number_of_items (const view v) const;
+
+      /** @return index of the i-th data item of a view in the original data set */
+      std::size_t get_row (const view v, const std::size_t i) const;
+
+      /** @return index of the first item of the i-th data item of a view */
+      std::size_t get_first_item (const view v, const std::size_t i) const;
+
+      /** @return number of items of the i-th data item of a view */
+      std::size_t get_number_of_items (const view v, const std::size_t i) const;
+
+      /** @return observed values of the i-th data item of a view (missing values are 0) */
+      std::span<const double> get_values (const view v, const std::size_t i) const;
+
+      /** @return indices of missing attributes of the i-th data item of a view
+                  (empty for the lower view) */
+      std::span<const std::size_t> get_missing_columns (const view v, const std::size_t i) const;
+
+      /** @return candidate values of the i-th data item of a view, item major
+                  (empty for the lower view) */
+      std::span<const double> get_candidates (const view v, const std::size_t i) const;
+
+      /** @return materialised matrix of items of a view */
+      std::vector<std::vector<double>> get_matrix (const view v) const;
+
+      /** The method aggregates values of items of the upper view to original data items.
+          @param values values of items of the upper view
+          @return maxima of values of items of each original data item
+          @throw ksi::exception if the number of values does not match the number of items */
+      std::vector<double> maximum_by_rows (const std::vector<double> & values) const;
+
+      /** @return number of bytes of the overlay */
+      std::size_t get_memory_size () const;
+   };
+}
+
+#endif
@@ -0,0 +1,51 @@
+/** @file */
+
+#include <string>
+#include <limits>
+
+#include "label_dictionary.h"
+#include "../service/debug.h"
+
+ksi::label_dictionary::id_type ksi::label_dictionary::intern(const std::string & label)
+{
+   try
+   {
+      auto it = _ids.find(label);
+      if (it != _ids.end())
+         return it->second;
+
+      if (_labels.size() >= std::numeric_limits<id_type>::max())
+         throw ksi::exception ("Too many distinct labels (" + std::to_string(_labels.size()) + ").");
+
+      const id_type id = _labels.size();
+      _labels.push_back(label);
+      _ids.emplace(label, id);
+      return id;
+   }
+   CATCH;
+}
+
+bool ksi::label_dictionary::find(const std::string & label, id_type & id) const
+{
+   auto it = _ids.find(label);
+   if (it == _ids.end())
+      return false;
+   id = it->second;
+   return true;
+}
+
+const std::string & ksi::label_dictionary::get_label(const id_type id) const
+{
+   try
+   {
+      if (id >= _labels.size())
+         throw ksi::exception ("Illegal label id " + std::to_string(id) + ", number of labels: " + std::to_string(_labels.size()) + ".");
+      return _labels[id];
+   }
+   CATCH;
+}
+
+std::size_t ksi::label_dictionary::size() const
+{
+   return _labels.size();
+}
@@ -0,0 +1,49 @@
+/** @file */
+
+#ifndef LABEL_DICTIONARY_H
+#define LABEL_DICTIONARY_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+namespace ksi
+{
+   /** Dictionary of symbolic labels of data items.
+    *  Each distinct label is stored once and has a dense id (0, 1, 2, ...
+    *  in the order of the first occurrence), so data items store only ids.
+    *  The dictionary only grows: an id never changes, so datasets that share
+    *  a dictionary (copies and parts of a dataset) can exchange ids.
+    *  Interning is not thread-safe.
+    *  @date 2026-10-19
+    */
+   class label_dictionary
+   {
+   public:
+      typedef std::uint32_t id_type;
+
+   protected:
+      /** labels in order of ids */
+      std::vector<std::string> _labels;
+      /** label -> id */
+      std::unordered_map<std::string, id_type> _ids;
+
+   public:
+      /** @return id of a label, a new id is created for a new label
+          @throw ksi::exception if the number of labels exceeds the range of ids */
+      id_type intern (const std::string & label);
+
+      /** @return true if the label is in the dictionary, its id is then set to id */
+      bool find (const std::string & label, id_type & id) const;
+
+      /** @return label with an id
+          @throw ksi::exception if the id is illegal */
+      const std::string & get_label (const id_type id) const;
+
+      /** @return number of distinct labels */
+      std::size_t size () const;
+   };
+}
+
+#endif
@@ -64,32 +64,6 @@ double ksi::descriptor_gaussian::getFuzzification() const
    return _stddev;
 }
 
-double ksi::descriptor_gaussian::getMembership(double x)
-{
-   try
-   {
-      if (_stddev <= 0.0)
-      {
-         // std::stringstream ss;
-         // ss << "illegal value of fuzzyfication of a gaussian set: " << NAZWA(_stddev) << " == " << _stddev;
-         // throw ss.str();
-         _stddev = 0.000'001; // tiny positive value.
-      }
-      double diff = x - _mean;
-      return last_membership = std::exp(-(diff * diff) / (2 * _stddev * _stddev));
-   }
-   CATCH;
-}
-
-void ksi::descriptor_gaussian::cummulate_differentials(
-      double x, double partial_differentials)
-{
-   double common = (x - _mean) / (_stddev * _stddev);
-   sum_dE_dmean += (partial_differentials * common);
-   sum_dE_dstddev += (partial_differentials * common * (x - _mean) / (_stddev));
-}
-
-
 std::vector<double> ksi::descriptor_gaussian::getDifferentials(double x)
 {
    try
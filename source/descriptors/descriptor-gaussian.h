@@ -6,8 +6,10 @@
 #include <iostream>
 #include <string>
 #include <array>
+#include <cmath>
 
 #include "descriptor.h" 
+#include "../auxiliary/fast_math.h"
 
 
 namespace ksi
@@ -34,6 +36,11 @@ namespace ksi
       const static std::array<std::string, 5> fuzzyDescription;
 
    public:
+      /** minimal fuzzification of gaussian sets elaborated from data 
+          (a cluster of one item or of identical items has zero standard deviation) 
+          @date 2026-10-19 */
+      static constexpr double MINIMAL_FUZZIFICATION = 1e-3;
+      
       /** @param mean mean :-)
           @param stddev standard deviation (also for upper standard deviation) */
       descriptor_gaussian (double mean, double stddev); 
@@ -45,7 +52,26 @@ namespace ksi
       /** The method elaborates membership to the fuzzy set with formula
        *  \f[  \mu(x) = \exp \left( - \frac{(x - m)^2}{2 \sigma^2} \right)   \f]
        */
-      virtual double getMembership (double x) override;
+      virtual double getMembership (double x) override
+      {
+         if (_stddev <= 0.0)
+            _stddev = 0.000'001; // tiny positive value.
+         
+         double diff = x - _mean;
+         return last_membership = std::exp(-(diff * diff) / (2 * _stddev * _stddev));
+      }
+      
+      /** The method elaborates membership with ksi::fast_math::exp 
+       *  (relative error ksi::fast_math::EXP_MAX_RELATIVE_ERROR).
+       *  @date 2026-10-18 */
+      virtual double getMembershipFast (double x) override
+      {
+         if (_stddev <= 0.0)
+            _stddev = 0.000'001; // tiny positive value.
+         
+         double diff = x - _mean;
+         return last_membership = ksi::fast_math::exp(-(diff * diff) / (2 * _stddev * _stddev));
+      }
       
       /** The method elaborates the differentials of the membership function
        *  for an attribute value x 
@@ -63,7 +89,12 @@ namespace ksi
        * @param x attribute's value
        * @param partial_differentials partial differentials 
        */
-      virtual void cummulate_differentials (double x, double partial_differentials);
+      virtual void cummulate_differentials (double x, double partial_differentials)
+      {
+         double common = (x - _mean) / (_stddev * _stddev);
+         sum_dE_dmean += (partial_differentials * common);
+         sum_dE_dstddev += (partial_differentials * common * (x - _mean) / (_stddev));
+      }
 
       virtual descriptor * clone () const override;
       
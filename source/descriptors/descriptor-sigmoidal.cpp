@@ -8,6 +8,7 @@
 #include <iostream>
 
 #include "descriptor-sigmoidal.h"
+#include "../auxiliary/fast_math.h"
 #include "../service/debug.h"
 
 std::string ksi::descriptor_sigmoidal::getName() const
@@ -65,6 +66,15 @@ double ksi::descriptor_sigmoidal::getMembership (double x)
    CATCH;
 }
 
+double ksi::descriptor_sigmoidal::getMembershipFast (double x)
+{
+   try
+   {
+      return last_membership = 1.0 / (1 + ksi::fast_math::exp (- _slope * (x - _cross)));
+   }
+   CATCH;
+}
+
 std::vector<double> ksi::descriptor_sigmoidal::getDifferentials (double x)
 {
    double memb = getMembership(x);
@@ -34,6 +34,11 @@ namespace ksi
       /** @return \f$f(x; c, s) = 1 / \left(1+ \exp\left( - s (x - c) \right) \right)\f$ */
       virtual double getMembership (double x) override;
       
+      /** @return membership elaborated with ksi::fast_math::exp 
+                  (absolute error at most ksi::fast_math::EXP_MAX_RELATIVE_ERROR / 4)
+          @date 2026-10-18 */
+      virtual double getMembershipFast (double x) override;
+      
       /** The method elaborates the differentials of the membership function
        *  for an attribute value x 
        *  @param x a parameter to calculate differentials for
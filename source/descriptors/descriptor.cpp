@@ -62,6 +62,11 @@ double ksi::descriptor::getMembershipUpper(double x)
    return getMembership(x);
 }
 
+double ksi::descriptor::getMembershipFast(double x)
+{
+   return getMembership(x);
+}
+
 std::ostream& ksi::descriptor::printLinguisticDescription(std::ostream& ss, const DescriptorStatistics& descStat) const
 {
     return ss << "[not implemented]";
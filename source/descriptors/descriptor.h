@@ -9,6 +9,7 @@
 #include <random>
 #include "../common/extensional-fuzzy-number-gaussian.h"
 #include "../common/DatasetStatistics.h"
+#include "../auxiliary/object_pool.h"
 
 namespace ksi
 {
@@ -31,6 +32,14 @@ namespace ksi
       
       virtual double getMembershipUpper (double x);
       
+      /** The method elaborates a membership value with fast approximations
+       *  of transcendental functions (ksi::fast_math). 
+       *  Default behaviour: the exact membership (getMembership). 
+       *  @param x a parameter to calculate a membership for
+       *  @return approximate membership value for a parameter
+       *  @date 2026-10-18 */
+      virtual double getMembershipFast (double x);
+      
       
       /** @return weight of a attribute. Default value is 1.0. */
       virtual double getWeight () const;
@@ -50,6 +59,11 @@ namespace ksi
       
       virtual ~descriptor();
       
+      /** Descriptors are allocated in ksi::object_pool.
+       *  @date 2026-10-19 */
+      static void * operator new (std::size_t size) { return ksi::object_pool::allocate(size); }
+      static void operator delete (void * p, std::size_t size) { ksi::object_pool::deallocate(p, size); }
+      
       /** The method sets all cummulated differentials to zero. */
       virtual void reset_differentials ();
       
@@ -8,6 +8,7 @@
 #include <array>
 
 #include "./descriptor_arctan.h"
+#include "../auxiliary/fast_math.h"
 #include "../service/debug.h"
 
 #include <iostream>
@@ -68,6 +69,15 @@ double ksi::descriptor_arctan::getMembership (const double x)
    CATCH;
 }
 
+double ksi::descriptor_arctan::getMembershipFast (const double x) 
+{
+   try
+   {
+      return last_membership = 0.5 + (std::numbers::inv_pi_v<double>) * ksi::fast_math::atan(_slope * (x - _cross)); 
+   }
+   CATCH;
+}
+
 std::vector<double> ksi::descriptor_arctan::getDifferentials (double x)
 {
    double sxc = _slope * (x - _cross);
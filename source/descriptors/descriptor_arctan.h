@@ -40,6 +40,11 @@ namespace ksi
        * \f$f(x; c, s) = 0.5 + \frac{1}{\pi} \arctan \left( s \left(x - c\right) \right)\f$. */
       virtual double getMembership (const double x) override;
       
+      /** @return membership elaborated with ksi::fast_math::atan 
+                  (absolute error at most ksi::fast_math::ATAN_MAX_ABSOLUTE_ERROR / pi)
+          @date 2026-10-18 */
+      virtual double getMembershipFast (const double x) override;
+      
       /** The method elaborates the differentials of the membership function
        *  for an attribute value x 
        *  @param x a parameter to calculate differentials for
@@ -7,6 +7,7 @@
 #include <cmath>
 
 #include "descriptor_tanh.h"
+#include "../auxiliary/fast_math.h"
 #include "../service/debug.h"
 
 #include <iostream>
@@ -67,6 +68,15 @@ double ksi::descriptor_tanh::getMembership (const double x)
    CATCH;
 }
 
+double ksi::descriptor_tanh::getMembershipFast (const double x) 
+{
+   try
+   {
+      return last_membership = 0.5 + 0.5 * ksi::fast_math::tanh(_slope * (x - _cross)); 
+   }
+   CATCH;
+}
+
 std::vector<double> ksi::descriptor_tanh::getDifferentials (double x)
 {
    double memb = getMembership(x);
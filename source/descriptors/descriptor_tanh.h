@@ -37,6 +37,11 @@ namespace ksi
       /** @return The method returns a value elaborated as \f$f(x; c, s) = \frac{1}{2} + \frac{1}{2} \tanh \left( s (x - c) \right)\f$ */
       virtual double getMembership (const double x) override;
       
+      /** @return membership elaborated with ksi::fast_math::tanh 
+                  (absolute error at most ksi::fast_math::TANH_MAX_ABSOLUTE_ERROR / 2)
+          @date 2026-10-18 */
+      virtual double getMembershipFast (const double x) override;
+      
       /** The method elaborates the differentials of the membership function
        *  for an attribute value x 
        *  @param x a parameter to calculate differentials for
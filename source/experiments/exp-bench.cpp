@@ -0,0 +1,794 @@
+/** @file */
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "../auxiliary/benchmark.h"
+#include "../auxiliary/confusion-matrix.h"
+#include "../auxiliary/error-MAE.h"
+#include "../auxiliary/error-RMSE.h"
+#include "../auxiliary/evaluation_accumulator.h"
+#include "../auxiliary/fast_math.h"
+#include "../auxiliary/least-error-squares-regression.h"
+#include "../auxiliary/precision.h"
+#include "../auxiliary/random_service.h"
+#include "../auxiliary/roc.h"
+#include "../auxiliary/roc_histogram.h"
+#include "../common/data-modifier-imputer-knn-average.h"
+#include "../common/data-modifier-imputer-knn-median.h"
+#include "../common/data-modifier-imputer-values-from-knn.h"
+#include "../common/data-modifier-marginaliser.h"
+#include "../common/imputation_overlay.h"
+#include "../common/dataset.h"
+#include "../common/dataset_generator.h"
+#include "../descriptors/descriptor-gaussian.h"
+#include "../dissimilarities/dis-log.h"
+#include "../implications/imp-reichenbach.h"
+#include "../metrics/metric-euclidean.h"
+#include "../neuro-fuzzy/annbfis.h"
+#include "../neuro-fuzzy/consequence-TSK.h"
+#include "../neuro-fuzzy/fac_prototype_mahalanobis_regression.h"
+#include "../neuro-fuzzy/fac_prototype_minkowski_regression.h"
+#include "../neuro-fuzzy/ma.h"
+#include "../neuro-fuzzy/prototype_similarity_matrix.h"
+#include "../neuro-fuzzy/rule.h"
+#include "../neuro-fuzzy/rulebase.h"
+#include "../neuro-fuzzy/tsk.h"
+#include "../owas/sowa.h"
+#include "../partitions/dbscan.h"
+#include "../partitions/fcm.h"
+#include "../partitions/fcm-T.h"
+#include "../partitions/fcm_minibatch.h"
+#include "../partitions/fcom.h"
+#include "../partitions/fubi.h"
+#include "../partitions/gk.h"
+#include "../partitions/rfcm.h"
+#include "../readers/reader-complete.h"
+#include "../service/debug.h"
+#include "../tnorms/t-norm-product.h"
+
+#include "../experiments/exp-bench.h"
+
+namespace
+{
+   const std::uint64_t SEED = 20261018;
+   const int CLUSTERING_ITERATIONS = 20;
+   
+   // tolerances of the single precision path against the double one (precisions):
+   // parameters of consequences of the unnormalised model are up to 4e5 and cancel out, 
+   // so single answers differ by up to about 1.2, although the RMSE differs by less than 0.5%
+   const double SINGLE_PRECISION_MAX_ABS_DIFFERENCE_OF_ANSWERS = 2.0;
+   const double SINGLE_PRECISION_MAX_RELATIVE_DIFFERENCE_OF_RMSE = 0.01;
+}
+
+ksi::exp_bench::exp_bench() : _benchmark (1, 0.2, 1000)
+{
+}
+
+std::string ksi::exp_bench::parameters(const std::size_t n, const std::size_t d, const std::size_t c)
+{
+    return "n=" + std::to_string(n) + " d=" + std::to_string(d) + " c=" + std::to_string(c);
+}
+
+void ksi::exp_bench::execute()
+{
+    try
+    {
+        readers();
+        datasets();
+        partitioners();
+        inference();
+        rule_activation();
+        prototype_similarities();
+        precisions();
+        fast_math();
+        training();
+        out_of_core();
+        model_copies();
+        least_squares();
+        imputers();
+        roc();
+        evaluation();
+
+        std::cout << _benchmark.to_json();
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::readers()
+{
+    try
+    {
+        ksi::dataset_generator generator (SEED);
+        for (const std::size_t n : {10'000, 100'000})
+        {
+            const std::size_t d = 8;
+            auto ds = generator.generate(n, d, 4);
+            auto file = (std::filesystem::temp_directory_path() / ("ksi-bench-" + std::to_string(n) + ".data")).string();
+            {
+                std::ofstream output (file);
+                output << ds.to_string();
+            }
+            ksi::reader_complete reader;
+            _benchmark.run("reader_complete::read", parameters(n, d + 1, 0), n, [&] { reader.read(file); });
+            std::filesystem::remove(file);
+        }
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::datasets()
+{
+    try
+    {
+        ksi::dataset_generator generator (SEED);
+        const std::size_t d = 8;
+        for (const std::size_t n : {10'000, 100'000})
+        {
+            auto ds = generator.generate(n, d, 4);
+            auto params = parameters(n, d, 0);
+
+            // copies share data items
+            _benchmark.run("dataset (copy)", params, n, [&] { ksi::dataset copy (ds); });
+            _benchmark.run("dataset::subdataset", params, n / 2, [&] { ds.subdataset(0, n / 2 - 1); });
+            _benchmark.run("dataset::splitDataSetHorizontally", params, n, [&] { ds.splitDataSetHorizontally(n / 2); });
+
+            // the first modification of a shared data item copies it
+            ksi::dataset copy;
+            _benchmark.run("dataset::set (copy on write)", params, n, [&] 
+            {
+                for (std::size_t r = 0; r < n; r++)
+                    copy.set(r, 0, 0.0);
+            }, [&] { copy = ds; });
+        }
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::partitioners()
+{
+    try
+    {
+        ksi::dataset_generator generator (SEED);
+        for (const std::size_t n : {1'000, 10'000})
+            for (const std::size_t d : {4, 16})
+                for (const std::size_t c : {4, 16})
+                {
+                    auto ds = generator.generate(n, d, c);
+                    auto params = parameters(n, d, c);
+
+                    ksi::fcm algorithm_fcm (c, CLUSTERING_ITERATIONS);
+                    _benchmark.run("fcm::doPartition", params, n, [&] { algorithm_fcm.doPartition(ds); });
+
+                    ksi::gk algorithm_gk (c, CLUSTERING_ITERATIONS);
+                    _benchmark.run("gk::doPartition", params, n, [&] { algorithm_gk.doPartition(ds); });
+
+                    ksi::fubi algorithm_fubi (c, CLUSTERING_ITERATIONS);
+                    _benchmark.run("fubi::doPartition", params, n, [&] { algorithm_fubi.doPartition(ds); });
+
+                    ksi::dis_log dissimilarity;
+                    ksi::sowa owa (n, 0.5, 0.2);
+                    ksi::fcom algorithm_fcom (c, 1e-8, dissimilarity, owa);
+                    ksi::dataset copy;
+                    _benchmark.run("fcom::doPartition", params, n, [&] { algorithm_fcom.doPartition(copy); }, [&] { copy = ds; });
+                }
+
+        // FCM of a larger dataset: the whole dataset against a coreset and mini-batches,
+        // the quality is the FCM objective of the whole dataset for elaborated centres.
+        {
+            const std::size_t n = 200'000;
+            const std::size_t d = 8;
+            const std::size_t c = 8;
+            auto ds = generator.generate(n, d, c);
+            auto params = parameters(n, d, c);
+            auto objective = [&ds] (const ksi::partition & part)
+            {
+                const auto V = part.getClusterCentres();
+                const std::size_t nAttr = ds.getNumberOfAttributes();
+                double result = 0.0;
+                for (std::size_t i = 0; i < ds.getNumberOfData(); i++)
+                {
+                    double sum_of_inverses = 0.0;
+                    for (const auto & v : V)
+                    {
+                        double distance = 0.0;
+                        for (std::size_t a = 0; a < nAttr; a++)
+                            distance += (ds.get(i, a) - v[a]) * (ds.get(i, a) - v[a]);
+                        sum_of_inverses += 1.0 / distance;
+                    }
+                    result += 1.0 / sum_of_inverses;
+                }
+                return result;
+            };
+
+            ksi::partition part;
+            ksi::fcm algorithm_fcm (c, CLUSTERING_ITERATIONS);
+            _benchmark.run("fcm::doPartition", params, n, [&] { ksi::random_task task (0); part = algorithm_fcm.doPartition(ds); });
+            _benchmark.add_measurement("fcm_objective", objective(part));
+
+            ksi::fcm_minibatch algorithm_whole (c, CLUSTERING_ITERATIONS, 0);
+            _benchmark.run("fcm_minibatch::doPartition (whole dataset)", params, n, [&] { ksi::random_task task (0); part = algorithm_whole.doPartition(ds); });
+            _benchmark.add_measurement("fcm_objective", objective(part));
+
+            ksi::fcm_minibatch algorithm_coreset (c, CLUSTERING_ITERATIONS, 0, 10'000);
+            _benchmark.run("fcm_minibatch::doPartition (coreset 10000)", params, n, [&] { ksi::random_task task (0); part = algorithm_coreset.doPartition(ds); });
+            _benchmark.add_measurement("fcm_objective", objective(part));
+
+            ksi::fcm_minibatch algorithm_batches (c, 300, 1'000, 20'000);
+            _benchmark.run("fcm_minibatch::doPartition (coreset 20000, 300 mini-batches of 1000)", params, n, [&] { ksi::random_task task (0); part = algorithm_batches.doPartition(ds); });
+            _benchmark.add_measurement("fcm_objective", objective(part));
+        }
+
+        // DBSCAN is quadratic in the number of data items.
+        for (const std::size_t n : {1'000, 5'000})
+        {
+            const std::size_t d = 4;
+            auto ds = generator.generate(n, d, 8);
+            ksi::metric_euclidean metric;
+            ksi::dbscan algorithm (1.5, 10, metric);
+            _benchmark.run("dbscan::doPartition", parameters(n, d, 8), n, [&] { algorithm.doPartition(ds); });
+        }
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::inference()
+{
+    try
+    {
+        ksi::dataset_generator generator (SEED);
+        const std::size_t n = 10'000;
+        const std::size_t d = 8;
+        const int rules = 16;
+        auto ds = generator.generate(n, d, rules);
+
+        ksi::t_norm_product tnorm;
+        ksi::tsk system (rules, CLUSTERING_ITERATIONS, 1, 0.01, false, tnorm);
+        ksi::neuro_fuzzy_system & nfs = system;
+        nfs.createFuzzyRulebase(CLUSTERING_ITERATIONS, 1, 0.01, ds, ds);
+
+        auto X = ds.splitDataSetVertically(d).first;
+        auto params = parameters(n, d, rules);
+
+        volatile double sink = 0.0; // keeps the answers from being optimised away
+        _benchmark.run("tsk::answer (single item)", params, n, [&] {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < n; i++)
+                sum += system.answer(*X.getDatum(i));
+            sink = sum;
+        });
+        _benchmark.run("tsk::elaborate_rmse_for_dataset (dataset)", params, n, [&] { system.elaborate_rmse_for_dataset(ds); });
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::rule_activation()
+{
+    try
+    {
+        // many local rules: most rules contribute nothing to an answer
+        ksi::dataset_generator generator (SEED);
+        const std::size_t n = 10'000;
+        const std::size_t d = 4;
+        const int rules = 200;
+        const int epochs = 2;
+        auto ds = generator.generate(n, d, rules);
+        auto XY = ds.splitDataSetVertically(d);
+        auto params = parameters(n, d, rules);
+        
+        ksi::t_norm_product tnorm;
+        ksi::tsk system (rules, CLUSTERING_ITERATIONS, epochs, 0.01, false, tnorm);
+        ksi::neuro_fuzzy_system & nfs = system;
+        ksi::fcm_minibatch partitioner (rules, CLUSTERING_ITERATIONS, 0);
+        partitioner.setFuzzification(1.2); // crisp clusters give local rules
+        nfs.set_partitioner(partitioner);
+        {
+            ksi::random_task task (0);
+            nfs.createFuzzyRulebase(CLUSTERING_ITERATIONS, epochs, 0.01, ds, ds);
+        }
+        
+        std::vector<double> answers_exact;
+        _benchmark.run("tsk::answers (exact)", params, n, [&] { answers_exact = nfs.answers(XY.first); });
+        
+        const std::vector<std::pair<double, std::string>> thresholds { { 1e-4, "1e-4" }, { 1e-8, "1e-8" } };
+        for (const auto & [threshold, threshold_name] : thresholds)
+            for (const std::size_t top_k : { std::size_t (0), std::size_t (16) })
+                for (const bool indexed : { false, true })
+                {
+                    const std::string name = "threshold " + threshold_name
+                                           + (top_k > 0 ? ", top " + std::to_string(top_k) : std::string (""))
+                                           + (indexed ? ", indexed" : "");
+                    std::vector<double> answers_bounded;
+                    nfs.set_bounded_activation(threshold, top_k, indexed);
+                    _benchmark.run("tsk::answers (bounded activation: " + name + ")", params, n, [&] { answers_bounded = nfs.answers(XY.first); });
+                    
+                    auto [answers, bounds] = nfs.answers_with_error_bounds(XY.first);
+                    double max_difference = 0.0, max_bound = 0.0;
+                    for (std::size_t i = 0; i < n; i++)
+                    {
+                        max_difference = std::max(max_difference, std::fabs(answers_bounded[i] - answers_exact[i]));
+                        max_bound = std::max(max_bound, bounds[i]);
+                    }
+                    _benchmark.add_measurement("max_abs_difference_of_answers (" + name + ")", max_difference);
+                    _benchmark.add_measurement("max_error_bound (" + name + ")", max_bound);
+                }
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::prototype_similarities()
+{
+    try
+    {
+        ksi::dataset_generator generator (SEED);
+        const std::size_t n = 100'000;
+        const std::size_t d = 8;
+        const int nPrototypes = 16;
+        auto ds = generator.generate(n, d, nPrototypes);
+        auto XY = ds.splitDataSetVertically(d);
+        const auto X = XY.first.getMatrix();
+        std::vector<double> Y (n);
+        for (std::size_t i = 0; i < n; i++)
+            Y[i] = XY.second.get(i, 0);
+        auto params = parameters(n, d, nPrototypes);
+        
+        // clusters with matrices of the Mahalanobis distance
+        ksi::gk partitioner (nPrototypes, CLUSTERING_ITERATIONS);
+        ksi::partition partition;
+        {
+            ksi::random_task task (0);
+            partition = partitioner.doPartition(XY.first);
+        }
+        
+        ksi::fac_prototype_minkowski_regression minkowski (2.0);
+        ksi::fac_prototype_mahalanobis_regression mahalanobis;
+        const std::vector<std::pair<ksi::fac_prototype *, std::string>> factories { { & minkowski, "minkowski" }, { & mahalanobis, "mahalanobis" } };
+        for (const auto & [pFactory, name] : factories)
+        {
+            std::vector<std::shared_ptr<ksi::prototype>> owners;
+            std::vector<const ksi::prototype *> prototypes;
+            for (int c = 0; c < nPrototypes; c++)
+            {
+                owners.push_back(pFactory->get_prototype_for_cluster(*partition.getCluster(c)));
+                prototypes.push_back(owners.back().get());
+            }
+            
+            std::vector<double> cardinalities_items (nPrototypes), averages_items (nPrototypes);
+            _benchmark.run("prototype::get_similarity (" + name + ", item by item)", params, n, [&]
+            {
+                for (int p = 0; p < nPrototypes; p++)
+                {
+                    double cardinality = 0, numerator = 0;
+                    for (std::size_t x = 0; x < n; x++)
+                    {
+                        auto sim = prototypes[p]->get_similarity(X[x]);
+                        cardinality += sim;
+                        numerator += sim * Y[x];
+                    }
+                    cardinalities_items[p] = cardinality;
+                    averages_items[p] = numerator / cardinality;
+                }
+            });
+            
+            std::vector<double> cardinalities_matrix, averages_matrix;
+            _benchmark.run("prototype_similarity_matrix (" + name + ")", params, n, [&]
+            {
+                ksi::prototype_similarity_matrix matrix (prototypes, X);
+                cardinalities_matrix = matrix.get_cardinalities();
+                averages_matrix = matrix.get_decision_averages(Y);
+            });
+            
+            double max_difference = 0.0;
+            for (int p = 0; p < nPrototypes; p++)
+            {
+                max_difference = std::max(max_difference, std::fabs(cardinalities_items[p] - cardinalities_matrix[p]));
+                max_difference = std::max(max_difference, std::fabs(averages_items[p] - averages_matrix[p]));
+            }
+            _benchmark.add_measurement("max_abs_difference_of_statistics (" + name + ")", max_difference);
+        }
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::precisions()
+{
+    try
+    {
+        ksi::dataset_generator generator (SEED);
+        const std::size_t n = 10'000;
+        const std::size_t d = 8;
+        const int rules = 16;
+        // one gradient epoch and one least squares epoch (consequences are elaborated in odd epochs)
+        const int epochs = 2;
+        auto ds = generator.generate(n, d, rules);
+        auto XY = ds.splitDataSetVertically(d);
+        auto params = parameters(n, d, rules);
+        
+        auto max_abs_difference = [] (const std::vector<double> & a, const std::vector<double> & b)
+        {
+            double result = 0.0;
+            for (std::size_t i = 0; i < a.size(); i++)
+                result = std::max(result, std::fabs(a[i] - b[i]));
+            return result;
+        };
+        
+        // FCM: both partitioners start from the same random partition matrix.
+        ksi::fcm fcm_double (rules, CLUSTERING_ITERATIONS);
+        ksi::fcm_T<float> fcm_single (rules, CLUSTERING_ITERATIONS);
+        ksi::partition partition_double, partition_single;
+        _benchmark.run("fcm::doPartition (double)", params, n, [&] { ksi::random_task task (0); partition_double = fcm_double.doPartition(ds); });
+        _benchmark.run("fcm_T<float>::doPartition (single)", params, n, [&] { ksi::random_task task (0); partition_single = fcm_single.doPartition(ds); });
+        {
+            auto V_double = partition_double.getClusterCentres();
+            auto V_single = partition_single.getClusterCentres();
+            double difference = 0.0;
+            for (std::size_t c = 0; c < V_double.size(); c++)
+                difference = std::max(difference, max_abs_difference(V_double[c], V_single[c]));
+            _benchmark.add_measurement("max_abs_difference_of_cluster_centres", difference);
+        }
+        
+        // inference: the same model answers in double and single precision
+        ksi::t_norm_product tnorm;
+        ksi::tsk system (rules, CLUSTERING_ITERATIONS, epochs, 0.01, false, tnorm);
+        ksi::neuro_fuzzy_system & nfs = system;
+        {
+            ksi::random_task task (0);
+            nfs.createFuzzyRulebase(CLUSTERING_ITERATIONS, epochs, 0.01, ds, ds);
+        }
+        
+        std::vector<double> answers_double, answers_single;
+        nfs.set_precision(ksi::precision::double_precision);
+        _benchmark.run("tsk::answers (double)", params, n, [&] { answers_double = nfs.answers(XY.first); });
+        nfs.set_precision(ksi::precision::single_precision);
+        _benchmark.run("tsk::answers (single)", params, n, [&] { answers_single = nfs.answers(XY.first); });
+        
+        std::vector<double> expected (n);
+        for (std::size_t i = 0; i < n; i++)
+            expected[i] = XY.second.get(i, 0);
+        auto rmse = [&expected] (const std::vector<double> & elaborated)
+        {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < expected.size(); i++)
+                sum += (expected[i] - elaborated[i]) * (expected[i] - elaborated[i]);
+            return std::sqrt(sum / expected.size());
+        };
+        const double difference_of_answers = max_abs_difference(answers_double, answers_single);
+        const double rmse_double = rmse(answers_double);
+        const double rmse_single = rmse(answers_single);
+        _benchmark.add_measurement("max_abs_difference_of_answers", difference_of_answers);
+        _benchmark.add_measurement("rmse_double", rmse_double);
+        _benchmark.add_measurement("rmse_single", rmse_single);
+        if (difference_of_answers > SINGLE_PRECISION_MAX_ABS_DIFFERENCE_OF_ANSWERS)
+            throw ksi::exception ("Single precision answers exceed their tolerance: " + std::to_string(difference_of_answers));
+        if (std::fabs(rmse_single - rmse_double) > SINGLE_PRECISION_MAX_RELATIVE_DIFFERENCE_OF_RMSE * rmse_double)
+            throw ksi::exception ("RMSE of single precision answers exceeds its tolerance: " + std::to_string(rmse_single) + " (double: " + std::to_string(rmse_double) + ")");
+        
+        // training: the whole model in single precision (clustering and answers)
+        ksi::tsk system_single (rules, CLUSTERING_ITERATIONS, epochs, 0.01, false, tnorm);
+        ksi::neuro_fuzzy_system & nfs_single = system_single;
+        nfs_single.set_precision(ksi::precision::single_precision);
+        _benchmark.run("tsk::createFuzzyRulebase (single)", params, n, [&] {
+            ksi::random_task task (0);
+            nfs_single.createFuzzyRulebase(CLUSTERING_ITERATIONS, epochs, 0.01, ds, ds);
+        });
+        _benchmark.add_measurement("rmse_double_model", rmse(answers_double));
+        _benchmark.add_measurement("rmse_single_model", rmse(nfs_single.answers(XY.first)));
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::fast_math()
+{
+    try
+    {
+        // maximal errors of approximations on grids, checked against documented bounds
+        {
+            double error_exp = 0.0, error_tanh = 0.0, error_atan = 0.0;
+            const std::size_t points = 1'000'000;
+            _benchmark.run("fast_math errors (exp, tanh, atan)", "points=" + std::to_string(points), points, [&] {
+                for (std::size_t i = 0; i <= points; i++)
+                {
+                    const double x_exp = -700.0 + 1400.0 * i / points;
+                    error_exp = std::max(error_exp, std::fabs(ksi::fast_math::exp(x_exp) - std::exp(x_exp)) / std::exp(x_exp));
+                    const double x = -50.0 + 100.0 * i / points;
+                    error_tanh = std::max(error_tanh, std::fabs(ksi::fast_math::tanh(x) - std::tanh(x)));
+                    error_atan = std::max(error_atan, std::fabs(ksi::fast_math::atan(x) - std::atan(x)));
+                }
+            });
+            _benchmark.add_measurement("max_relative_error_exp", error_exp);
+            _benchmark.add_measurement("max_absolute_error_tanh", error_tanh);
+            _benchmark.add_measurement("max_absolute_error_atan", error_atan);
+            if (error_exp > ksi::fast_math::EXP_MAX_RELATIVE_ERROR)
+                throw ksi::exception ("fast_math::exp exceeds its error bound: " + std::to_string(error_exp));
+            if (error_tanh > ksi::fast_math::TANH_MAX_ABSOLUTE_ERROR)
+                throw ksi::exception ("fast_math::tanh exceeds its error bound: " + std::to_string(error_tanh));
+            if (error_atan > ksi::fast_math::ATAN_MAX_ABSOLUTE_ERROR)
+                throw ksi::exception ("fast_math::atan exceeds its error bound: " + std::to_string(error_atan));
+        }
+        
+        ksi::dataset_generator generator (SEED);
+        const std::size_t n = 10'000;
+        const std::size_t d = 8;
+        const int rules = 16;
+        const int epochs = 2;
+        auto ds = generator.generate(n, d, rules);
+        auto XY = ds.splitDataSetVertically(d);
+        auto params = parameters(n, d, rules);
+        
+        ksi::t_norm_product tnorm;
+        ksi::tsk system (rules, CLUSTERING_ITERATIONS, epochs, 0.01, false, tnorm);
+        ksi::neuro_fuzzy_system & nfs = system;
+        {
+            ksi::random_task task (0);
+            nfs.createFuzzyRulebase(CLUSTERING_ITERATIONS, epochs, 0.01, ds, ds);
+        }
+        
+        auto max_abs_difference = [] (const std::vector<double> & a, const std::vector<double> & b)
+        {
+            double result = 0.0;
+            for (std::size_t i = 0; i < a.size(); i++)
+                result = std::max(result, std::fabs(a[i] - b[i]));
+            return result;
+        };
+        
+        for (const auto accuracy : { ksi::precision::double_precision, ksi::precision::single_precision })
+        {
+            const std::string name = accuracy == ksi::precision::double_precision ? "double" : "single";
+            std::vector<double> answers_exact, answers_fast;
+            nfs.set_precision(accuracy);
+            nfs.set_fast_math(false);
+            _benchmark.run("tsk::answers (" + name + ", exact)", params, n, [&] { answers_exact = nfs.answers(XY.first); });
+            nfs.set_fast_math(true);
+            _benchmark.run("tsk::answers (" + name + ", fast_math)", params, n, [&] { answers_fast = nfs.answers(XY.first); });
+            _benchmark.add_measurement("max_abs_difference_of_answers_" + name, max_abs_difference(answers_exact, answers_fast));
+        }
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::training()
+{
+    try
+    {
+        ksi::dataset_generator generator (SEED);
+        const std::size_t n = 5'000;
+        const std::size_t d = 8;
+        const int rules = 8;
+        const double eta = 0.01;
+        auto ds = generator.generate(n, d, rules);
+        auto params = parameters(n, d, rules);
+
+        ksi::t_norm_product tnorm;
+        ksi::imp_reichenbach implication;
+
+        // Clustering only (no tuning) and clustering with one tuning epoch:
+        // the difference is the time of one epoch.
+        for (const int epochs : {0, 1})
+        {
+            auto suffix = " (" + std::to_string(epochs) + " tuning epochs)";
+
+            ksi::annbfis system_annbfis (rules, CLUSTERING_ITERATIONS, epochs, eta, false, tnorm, implication);
+            ksi::tsk     system_tsk     (rules, CLUSTERING_ITERATIONS, epochs, eta, false, tnorm);
+            ksi::ma      system_ma      (rules, CLUSTERING_ITERATIONS, epochs, eta, false, tnorm);
+
+            for (ksi::neuro_fuzzy_system * p : std::vector<ksi::neuro_fuzzy_system *> { & system_annbfis, & system_tsk, & system_ma })
+                _benchmark.run(p->get_brief_nfs_name() + "::createFuzzyRulebase" + suffix, params, n,
+                    [&] { p->createFuzzyRulebase(CLUSTERING_ITERATIONS, epochs, eta, ds, ds); });
+        }
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::out_of_core()
+{
+    try
+    {
+        ksi::dataset_generator generator (SEED);
+        const std::size_t n = 50'000;
+        const std::size_t d = 8;
+        const int rules = 8;
+        const int epochs = 2;
+        const double eta = 0.01;
+        auto ds = generator.generate(n, d, rules);
+        auto params = parameters(n, d, rules);
+        auto file = (std::filesystem::temp_directory_path() / ("ksi-bench-out-of-core-" + std::to_string(n) + ".data")).string();
+        {
+            std::ofstream output (file);
+            output << ds.to_string();
+        }
+
+        ksi::t_norm_product tnorm;
+        ksi::tsk tsk (rules, CLUSTERING_ITERATIONS, epochs, eta, false, tnorm);
+        ksi::neuro_fuzzy_system & system = tsk;
+
+        // the whole file is read into memory
+        _benchmark.run("tsk (read + createFuzzyRulebase)", params, n, [&]
+        {
+            ksi::reader_complete reader;
+            auto train = reader.read(file);
+            system.createFuzzyRulebase(CLUSTERING_ITERATIONS, epochs, eta, train, train);
+        });
+        _benchmark.add_measurement("rmse", system.elaborate_rmse_for_dataset(ds));
+
+        // clustering of a sample, epochs stream the file in chunks
+        for (const std::size_t sample_size : {5'000, 50'000})
+        {
+            _benchmark.run("tsk::train_out_of_core (sample " + std::to_string(sample_size) + ")", params, n,
+                [&] { system.train_out_of_core(file, 4'096, sample_size); });
+            _benchmark.add_measurement("rmse", system.elaborate_rmse_for_dataset(ds));
+        }
+        std::filesystem::remove(file);
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::model_copies()
+{
+    try
+    {
+        const std::size_t d = 8;
+        ksi::t_norm_product tnorm;
+        for (const std::size_t nRules : {16, 256})
+        {
+            ksi::rulebase rulebase;
+            for (std::size_t r = 0; r < nRules; r++)
+            {
+                ksi::premise premise (tnorm);
+                for (std::size_t a = 0; a < d; a++)
+                    premise.addDescriptor(new ksi::descriptor_gaussian (double (r + a), 1.0));
+                ksi::rule rule (tnorm);
+                rule.setPremise(premise);
+                rule.setConsequence(ksi::consequence_TSK (std::vector<double> (d + 1, 1.0)));
+                rulebase.addRule(rule);
+            }
+            
+            // rows: rules
+            _benchmark.run("rulebase (copy)", parameters(nRules, d, nRules), nRules, [&] { ksi::rulebase copy (rulebase); });
+        }
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::least_squares()
+{
+    try
+    {
+        ksi::dataset_generator generator (SEED);
+        for (const std::size_t d : {4, 16, 64})
+        {
+            const std::size_t n = 10'000;
+            auto XY = generator.generate(n, d, 1).splitDataSetVertically(d);
+            auto X = XY.first.getMatrix();
+            auto mY = XY.second.getMatrix();
+            std::vector<double> Y (n);
+            for (std::size_t i = 0; i < n; i++)
+                Y[i] = mY[i][0];
+
+            _benchmark.run("least_square_error_regression::recursive_linear_regression", parameters(n, d, 1), n,
+                [&] { ksi::least_square_error_regression::recursive_linear_regression(X, Y); });
+        }
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::imputers()
+{
+    try
+    {
+        ksi::dataset_generator generator (SEED);
+        const std::size_t n = 2'000;
+        const std::size_t d = 8;
+        const int k = 5;
+        for (const double missing_ratio : {0.05, 0.2})
+        {
+            auto ds = generator.generate(n, d, 4, missing_ratio);
+            auto params = parameters(n, d, 4) + " missing=" + std::to_string(missing_ratio) + " k=" + std::to_string(k);
+            ksi::dataset copy;
+
+            ksi::data_modifier_imputer_knn_average average (k);
+            _benchmark.run("data_modifier_imputer_knn_average::modify", params, n, [&] { average.modify(copy); }, [&] { copy = ds; });
+
+            ksi::data_modifier_imputer_knn_median median (k);
+            _benchmark.run("data_modifier_imputer_knn_median::modify", params, n, [&] { median.modify(copy); }, [&] { copy = ds; });
+
+            ksi::data_modifier_imputer_values_from_knn values (k);
+            _benchmark.run("data_modifier_imputer_values_from_knn::modify", params, n, [&] { values.modify(copy); }, [&] { copy = ds; });
+
+            ksi::imputation_overlay overlay;
+            _benchmark.run("data_modifier_imputer_values_from_knn::overlay", params, n, [&] { overlay = values.overlay(ds); });
+            // without the overlay rfcm holds the lower and upper data sets and their matrices
+            const auto nItems = overlay.get_number_of_items(ksi::imputation_overlay::view::lower)
+                              + overlay.get_number_of_items(ksi::imputation_overlay::view::upper);
+            _benchmark.add_measurement("lower_and_upper_items", nItems);
+            _benchmark.add_measurement("bytes_of_lower_and_upper_matrices", nItems * (d * sizeof(double) + sizeof(std::vector<double>)));
+            _benchmark.add_measurement("bytes_of_overlay", overlay.get_memory_size());
+
+            ksi::rfcm algorithm (values, ksi::data_modifier_marginaliser());
+            algorithm.setNumberOfClusters(4);
+            algorithm.setNumberOfIterations(CLUSTERING_ITERATIONS);
+            _benchmark.run("rfcm::doPartition (imputation overlay)", params, n, [&] { algorithm.doPartition(overlay); });
+        }
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::roc()
+{
+    try
+    {
+        std::mt19937_64 engine (SEED);
+        std::normal_distribution<double> gauss (0.0, 1.0);
+        for (const std::size_t n : {10'000, 1'000'000})
+        {
+            std::vector<double> expected (n), elaborated (n);
+            for (std::size_t i = 0; i < n; i++)
+            {
+                expected[i] = i % 2;
+                elaborated[i] = gauss(engine) + expected[i];
+            }
+            auto params = "n=" + std::to_string(n);
+
+            ksi::roc analysis;
+            _benchmark.run("roc::calculate_ROC_points", params, n, [&] { analysis.calculate_ROC_points(expected, elaborated, 1.0, 0.0, {}, false); });
+
+            ksi::roc_histogram histogram (-5.0, 6.0, 1000, 1.0, 0.0);
+            _benchmark.run("roc_histogram::add + AUC", params, n, [&] { histogram.clear(); histogram.add(expected, elaborated); histogram.AUC(); });
+        }
+    }
+    CATCH;
+}
+
+void ksi::exp_bench::evaluation()
+{
+    try
+    {
+        std::mt19937_64 engine (SEED);
+        std::normal_distribution<double> gauss (0.0, 1.0);
+        const std::size_t n = 1'000'000;
+        std::vector<double> expected (n), elaborated (n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            expected[i] = i % 2;
+            elaborated[i] = gauss(engine) + expected[i];
+        }
+        const std::vector<double> thresholds { 0.0, 0.25, 0.5, 0.75, 1.0 };
+        const std::string params = "n=" + std::to_string(n) + " thresholds=" + std::to_string(thresholds.size());
+        
+        // separate passes: RMSE, MAE, a confusion matrix for each threshold, ROC histogram
+        double rmse = 0, mae = 0;
+        std::vector<int> true_positives (thresholds.size());
+        ksi::roc_histogram histogram (-5.0, 6.0, 1000, 1.0, 0.0);
+        _benchmark.run("error_RMSE + error_MAE + confusion_matrix + roc_histogram", params, n, [&] {
+            rmse = ksi::error_RMSE().getError(elaborated, expected);
+            mae  = ksi::error_MAE().getError(elaborated, expected);
+            ksi::confusion_matrix matrix;
+            int TN, FP, FN;
+            for (std::size_t t = 0; t < thresholds.size(); t++)
+                matrix.calculate_statistics(expected, elaborated, 1.0, 0.0, true_positives[t], TN, FP, FN, thresholds[t]);
+            histogram.clear();
+            histogram.add(expected, elaborated);
+        });
+        
+        // one pass
+        ksi::evaluation_accumulator accumulator (1.0, 0.0, thresholds, ksi::roc_histogram (-5.0, 6.0, 1000, 1.0, 0.0));
+        _benchmark.run("evaluation_accumulator::add", params, n, [&] {
+            accumulator.clear();
+            accumulator.add(expected, elaborated);
+        });
+        
+        double difference = std::max(std::fabs(rmse - accumulator.RMSE()), std::fabs(mae - accumulator.MAE()));
+        difference = std::max(difference, std::fabs(histogram.AUC() - accumulator.AUC()));
+        auto matrices = accumulator.confusion_matrices();
+        for (std::size_t t = 0; t < thresholds.size(); t++)
+            difference = std::max(difference, std::fabs(true_positives[t] - matrices[t].TP));
+        _benchmark.add_measurement("max_abs_difference", difference);
+        _benchmark.add_measurement("R2", accumulator.R2());
+    }
+    CATCH;
+}
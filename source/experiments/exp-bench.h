@@ -0,0 +1,56 @@
+/** @file */
+
+#ifndef EXP_BENCH_H
+#define EXP_BENCH_H
+
+#include <string>
+
+#include "../experiments/experiment.h"
+#include "../auxiliary/benchmark.h"
+
+namespace ksi
+{
+   /** Micro- and macro-benchmarks of the library.
+       All data are generated with ksi::dataset_generator, so the results
+       of different builds can be compared.
+       Results are printed in JSON to the standard output.
+       @date 2026-10-18
+    */
+   class exp_bench : virtual public experiment
+   {
+   protected:
+      ksi::benchmark _benchmark;
+
+      void readers ();
+      /** copies, subdatasets and modifications of copies of datasets: times */
+      void datasets ();
+      void partitioners ();
+      void inference ();
+      /** bounded activation of rules against exact inference: times, differences of answers and their bounds */
+      void rule_activation ();
+      /** similarities of prototypes elaborated item by item against the similarity matrix: times and differences */
+      void prototype_similarities ();
+      /** single precision against double precision: times and differences of results */
+      void precisions ();
+      void fast_math ();
+      void training ();
+      /** training in memory against out-of-core training with streamed epochs: times and errors */
+      void out_of_core ();
+      /** copies of rulebases: times and allocations */
+      void model_copies ();
+      void least_squares ();
+      void imputers ();
+      void roc ();
+      void evaluation ();
+
+      /** @return parameters in the format "n=... d=... c=..." */
+      static std::string parameters (const std::size_t n, const std::size_t d, const std::size_t c);
+
+   public:
+      exp_bench ();
+      /** The method executes all benchmarks. */
+      virtual void execute ();
+   };
+}
+
+#endif
@@ -1,5 +1,8 @@
 
+#include <vector>
+
 #include "discriminative_model.h"
+#include "../service/debug.h"
 
 ksi::discriminative_model::discriminative_model ()
 {
@@ -44,3 +47,24 @@ ksi::discriminative_model::~discriminative_model ()
 
  
 
+std::vector<double> ksi::discriminative_model::discriminate_dataset(const ksi::dataset & ds)
+{
+   try
+   {
+      const std::size_t size = ds.getNumberOfData();
+      std::vector<double> answers (size);
+      for (std::size_t i = 0; i < size; i++)
+         answers[i] = discriminate(*(ds.getDatum(i)));
+      return answers;
+   }
+   CATCH;
+}
+
+void ksi::discriminative_model::continue_training_discriminative_model(const ksi::dataset & ds)
+{
+   try
+   {
+      train_discriminative_model(ds);
+   }
+   CATCH;
+}
@@ -27,6 +27,22 @@ namespace ksi
        */
       virtual double discriminate (const datum & d) = 0; 
       
+      /** The method elaborates answers of the discriminative model for all data items. 
+       Default behaviour: discriminate is called for each data item.
+       @param ds dataset to elaborate answers for
+       @return answers for data items 
+       @date 2026-10-18
+       */
+      virtual std::vector<double> discriminate_dataset (const dataset & ds);
+      
+      /** The method trains the already trained discriminative model with new data:
+       *  training starts from the current parameters of the model.
+       *  Default behaviour: train_discriminative_model (training from scratch).
+       *  @param ds dataset to train with
+       *  @date 2026-10-18
+       */
+      virtual void continue_training_discriminative_model (const dataset & ds);
+      
       /** The method returns a string representing information on the discriminative model */
       virtual std::string to_string () = 0;
    };
@@ -2,6 +2,8 @@
 #include <algorithm>
 #include <random>
 #include <chrono>
+#include <cstdint>
+#include <vector>
 
 #include "../gan/gan.h"
 
@@ -17,6 +19,32 @@ ksi::gan::gan(const int number_of_iterations,
 {
     _pGenerator = p_gen.clone_generator();
     _pDiscriminator = p_dis.clone_discriminant();
+    _seed = std::chrono::system_clock::now().time_since_epoch().count();
+}
+
+ksi::gan::gan(const int number_of_iterations,
+              const generative_model & p_gen,
+              const discriminative_model & p_dis,
+              const std::uint64_t seed) 
+          :
+  _nIterations (number_of_iterations), _seed (seed)
+{
+    _pGenerator = p_gen.clone_generator();
+    _pDiscriminator = p_dis.clone_discriminant();
+}
+
+void ksi::gan::set_warm_start(const bool warm_start)
+{
+    _warm_start = warm_start;
+}
+
+std::uint64_t ksi::gan::stream_seed(const int iteration, const int stream) const
+{
+    // splitmix64: rozne iteracje i strumienie daja niezalezne ziarna
+    std::uint64_t z = _seed + 0x9e3779b97f4a7c15ULL * (2 * static_cast<std::uint64_t>(iteration) + stream + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
 }
 
 
@@ -26,6 +54,8 @@ ksi::gan::gan (const ksi::gan & wzor)
     _pGenerator     = wzor._pGenerator->clone_generator();
     
     _nIterations = wzor._nIterations;
+    _seed        = wzor._seed;
+    _warm_start  = wzor._warm_start;
 }
 
 ksi::gan::gan (ksi::gan && wzor)
@@ -34,6 +64,8 @@ ksi::gan::gan (ksi::gan && wzor)
     std::swap (_pGenerator, wzor._pGenerator);
     
     std::swap (_nIterations, wzor._nIterations);
+    std::swap (_seed, wzor._seed);
+    std::swap (_warm_start, wzor._warm_start);
 }
 
 ksi::gan & ksi::gan::operator= (const ksi::gan & wzor)
@@ -50,6 +82,8 @@ ksi::gan & ksi::gan::operator= (const ksi::gan & wzor)
    _pGenerator     = wzor._pGenerator->clone_generator();
    
    _nIterations = wzor._nIterations;
+   _seed        = wzor._seed;
+   _warm_start  = wzor._warm_start;
 
    return *this;
 }
@@ -65,6 +99,8 @@ ksi::gan & ksi::gan::operator= (ksi::gan && wzor)
    std::swap (_pGenerator, wzor._pGenerator);
    
    std::swap (_nIterations, wzor._nIterations);
+   std::swap (_seed, wzor._seed);
+   std::swap (_warm_start, wzor._warm_start);
 
    return *this;
 }
@@ -92,13 +128,13 @@ void ksi::gan::train(const ksi::dataset& zbior_oryginalny)
         debug(train.getNumberOfAttributes());
         auto test  = podzielone.second;
         
-        std::default_random_engine silnik (std::chrono::system_clock::now().time_since_epoch().count());
-        
-        auto zbior_rozszerzony_o_atrybut_autentycznosci = train;
-        auto nAttributes = zbior_oryginalny.getNumberOfAttributes();
-        
+        // Zbiory dla dyskryminatora i generatora tworzone sa raz. Ich poczatek 
+        // (dane oryginalne) sie nie zmienia, w kazdej iteracji podmieniane sa 
+        // tylko dane dolaczone na koncu.
+        auto merged = train;
         for (std::size_t i = 0; i < train.getNumberOfData(); i++)
-            zbior_rozszerzony_o_atrybut_autentycznosci.getDatumNonConst(i)->push_back(ORIGINAL);
+            merged.getDatumNonConst(i)->push_back(ORIGINAL);
+        auto zbior_dla_generatora = train;
         
         // najpierw stroimy generator
         
@@ -110,52 +146,55 @@ void ksi::gan::train(const ksi::dataset& zbior_oryginalny)
         // teraz mamy utworzony generator
         std::cout << "# iteracja\tliczba_danych\tRMSE" << std::endl;
         
+        const double GRANICA = (ORIGINAL + FORGED) / 2.0;
+        
 //         debug(_nIterations);
         for (int i = 0; i < _nIterations; i++)
         {
 //             debug(i);
             
-            ksi::dataset podrobione;
-            for (int k = 0; k < nDataItemsTrain; k++)
+            ksi::dataset podrobione = _pGenerator->get_random_data(nDataItemsTrain, stream_seed(i, 0));
+            for (std::size_t k = 0; k < podrobione.getNumberOfData(); k++)
             {
-                auto podrobka = _pGenerator->get_random_datum(silnik);
-                podrobka.push_back (FORGED);
-                podrobka.setDecision(FORGED);
-                podrobione.addDatum(podrobka);
+                auto podrobka = podrobione.getDatumNonConst(k);
+                podrobka->push_back (FORGED);
+                podrobka->setDecision(FORGED);
 //                 debug(podrobka);
             }
 
-            ksi::dataset merged = zbior_rozszerzony_o_atrybut_autentycznosci;
-            if (podrobione.getNumberOfData() > 0)
-               merged += podrobione;
+            merged.truncate(nDataItemsTrain);
+            merged += std::move(podrobione);
             
-            _pDiscriminator->train_discriminative_model (merged);
+            if (_warm_start and i > 0)
+                _pDiscriminator->continue_training_discriminative_model (merged);
+            else
+                _pDiscriminator->train_discriminative_model (merged);
 //             debug(_pDiscriminator->to_string());
             
             // wybor tych przykladow, dla ktorych dyskryminator dal sie zwiesc 
-            ksi::dataset oszukujace;
-            std::size_t podrobione_size = podrobione.getNumberOfData();
-            double GRANICA = (ORIGINAL + FORGED) / 2.0;
+            ksi::dataset kandydaci = _pGenerator->get_random_data(nDataItemsTrain, stream_seed(i, 1));
+            auto odpowiedzi = _pDiscriminator->discriminate_dataset(kandydaci);
             
-            for (std::size_t k = 0; k < podrobione_size; k++)
+            zbior_dla_generatora.truncate(nDataItemsTrain);
+            std::vector<std::size_t> indeksy;
+            for (std::size_t k = 0; k < odpowiedzi.size(); k++)
             {
 //                 auto podzielona = podrobione.getDatum(k)->splitDatum(nAttributes).first;
 //                 auto odpowiedz = _pDiscriminator->discriminate (podzielona);
-                auto podrobka = _pGenerator->get_random_datum(silnik);
-                auto odpowiedz = _pDiscriminator->discriminate (podrobka);
-                if (odpowiedz > GRANICA)
-                {
-                    oszukujace.addDatum(podrobka);
-                }
+                if (odpowiedzi[k] > GRANICA)
+                    indeksy.push_back(k);
             }
-            
+            ksi::dataset oszukujace = kandydaci.subdataset(indeksy);
 //             debug(oszukujace.getNumberOfData());
-            auto zbior_dla_generatora = train;
-            if (oszukujace.getNumberOfData() > 0)
-                 zbior_dla_generatora += oszukujace;
+            std::size_t nOszukujace = oszukujace.getNumberOfData();
+            if (nOszukujace > 0)
+                zbior_dla_generatora += std::move(oszukujace);
 //                 zbior_dla_generatora = oszukujace;
             
-            _pGenerator->train_generative_model (zbior_dla_generatora);
+            if (_warm_start)
+                _pGenerator->continue_training_generative_model (zbior_dla_generatora);
+            else
+                _pGenerator->train_generative_model (zbior_dla_generatora);
             
 //             double rmse = _pGenerator->elaborate_rmse_for_dataset(test);
             double rmse = _pGenerator->elaborate_rmse_for_dataset(test);
@@ -172,7 +211,7 @@ void ksi::gan::train(const ksi::dataset& zbior_oryginalny)
 //                 _pGenerator = pBestGenerator->clone_generator();
             }
             
-            std::cout << i << "\t" << oszukujace.getNumberOfData() << "\t" << rmse << std::endl;
+            std::cout << i << "\t" << nOszukujace << "\t" << rmse << std::endl;
         }
         
         //debug(_pGenerator->to_string());
@@ -187,4 +226,3 @@ void ksi::gan::train(const ksi::dataset& zbior_oryginalny)
     CATCH;
     // w sumie ta metoda powinna cos zwrocic    
 }
-
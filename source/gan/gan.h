@@ -2,6 +2,8 @@
 #ifndef GAN_H
 #define GAN_H
 
+#include <cstdint>
+
 #include "../common/dataset.h"
 #include "../gan/generative_model.h"
 #include "../gan/discriminative_model.h"
@@ -19,6 +21,19 @@ namespace ksi
       
       const int ORIGINAL = 1;
       const int FORGED   = 0;
+      
+      /** seed of random streams of the generator */
+      std::uint64_t _seed;
+      
+      /** if true, models are trained from scratch only in the first iteration,
+          in next iterations their training continues from current parameters */
+      bool _warm_start = true;
+      
+      /** @return seed of a random stream for an iteration 
+          @param iteration number of iteration
+          @param stream number of stream in the iteration
+          @date 2026-10-18 */
+      std::uint64_t stream_seed (const int iteration, const int stream) const;
        
     public:
         
@@ -26,6 +41,13 @@ namespace ksi
            const generative_model & p_gen,
            const discriminative_model & p_dis);
       
+      /** @param seed seed of random streams, the same seed gives the same forged data
+          @date 2026-10-18 */
+      gan (const int number_of_iterations,
+           const generative_model & p_gen,
+           const discriminative_model & p_dis,
+           const std::uint64_t seed);
+      
       
       gan (const gan & wzor);
       gan (gan && wzor);
@@ -39,6 +61,10 @@ namespace ksi
        */
       void train (const dataset & ds);
       
+      /** @param warm_start if false, both models are trained from scratch in each iteration 
+          @date 2026-10-18 */
+      void set_warm_start (const bool warm_start);
+      
       
    };
 }
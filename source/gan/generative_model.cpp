@@ -1,5 +1,9 @@
 
+#include <random>
+#include <cstdint>
+
 #include "generative_model.h"
+#include "../service/debug.h"
 
 ksi::generative_model::generative_model ()
 {
@@ -44,3 +48,26 @@ ksi::generative_model::~generative_model ()
 
  
 
+ksi::dataset ksi::generative_model::get_random_data(const std::size_t number_of_items, const std::uint64_t seed)
+{
+   try
+   {
+      std::seed_seq sequence { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+      std::default_random_engine engine (sequence);
+      
+      ksi::dataset ds;
+      for (std::size_t i = 0; i < number_of_items; i++)
+         ds.addDatum(new ksi::datum (get_random_datum(engine)));
+      return ds;
+   }
+   CATCH;
+}
+
+void ksi::generative_model::continue_training_generative_model(const ksi::dataset & ds)
+{
+   try
+   {
+      train_generative_model(ds);
+   }
+   CATCH;
+}
@@ -4,6 +4,7 @@
 #define GENERATIVE_MODEL_H
 
 #include <random>
+#include <cstdint>
 
 #include "../common/dataset.h"
 #include "../common/datum.h"
@@ -29,6 +30,22 @@ namespace ksi
       /** The method trains the generative model. */
       virtual void train_generative_model (const dataset & ds) = 0;
       
+      /** The method returns random data items. The items depend only on the seed.
+       *  Default behaviour: get_random_datum is called for each data item with one engine.
+       *  @param number_of_items number of data items to generate
+       *  @param seed seed of random engines
+       *  @date 2026-10-18
+       */
+      virtual dataset get_random_data (const std::size_t number_of_items, const std::uint64_t seed);
+      
+      /** The method trains the already trained generative model with new data:
+       *  training starts from the current parameters of the model.
+       *  Default behaviour: train_generative_model (training from scratch).
+       *  @param ds dataset to train with
+       *  @date 2026-10-18
+       */
+      virtual void continue_training_generative_model (const dataset & ds);
+      
       /** The method returns a string representing information on the generative model */
       virtual std::string to_string () = 0;
       
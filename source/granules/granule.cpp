@@ -8,8 +8,6 @@
 #include "../service/debug.h"
 
 
-std::default_random_engine ksi::granule::_engine;
-
 ksi::granule::~granule ()
 {
 }
@@ -37,7 +35,6 @@ void ksi::granule::reset_cardinality()
 
 ksi::granule::granule ()
 {
-    _engine.seed (std::chrono::system_clock::now().time_since_epoch().count());
     _cardinality = 1.0;
     _quality = -1.0;
     _error = 1.0;
@@ -45,7 +42,6 @@ ksi::granule::granule ()
 
 ksi::granule::granule (const ksi::granule & wzor)
 {
-    _engine = wzor._engine;
     _cardinality = wzor._cardinality;
     _quality = wzor._quality;
     _error = wzor._error;
@@ -53,7 +49,6 @@ ksi::granule::granule (const ksi::granule & wzor)
 
 ksi::granule::granule (ksi::granule && wzor)
 {
-    std::swap(_engine, wzor._engine);
     std::swap(_cardinality, wzor._cardinality);
     std::swap(_quality, wzor._quality);
     std::swap(_error, wzor._error);
@@ -64,7 +59,6 @@ ksi::granule & ksi::granule::operator= (const ksi::granule & wzor)
    if (this == & wzor)
       return *this;
 
-   _engine = wzor._engine;
    _cardinality = wzor._cardinality;
    _quality = wzor._quality;
    _error = wzor._error;
@@ -77,7 +71,6 @@ ksi::granule & ksi::granule::operator= (ksi::granule && wzor)
    if (this == & wzor)
       return *this;
 
-   std::swap(_engine, wzor._engine);
    std::swap(_cardinality, wzor._cardinality);
    std::swap(_quality, wzor._quality);
    std::swap(_error, wzor._error);
@@ -85,6 +78,11 @@ ksi::granule & ksi::granule::operator= (ksi::granule && wzor)
    return *this;
 }
 
+ksi::datum ksi::granule::get_data_item(std::default_random_engine &)
+{
+    return get_data_item();
+}
+
 void ksi::granule::set_cardinality(const double cardinality)
 {
     _cardinality =  std::max ( cardinality, 0.0 );
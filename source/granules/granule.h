@@ -22,8 +22,6 @@ namespace ksi
     {
     protected:
         
-        static std::default_random_engine _engine;
-        
         /** cardinality of granule (number of items covered by the granule) */
         double _cardinality;
         /** quality of granule, 0.0 -- the lowest quality, 1.0 -- the highest quality */
@@ -77,6 +75,12 @@ namespace ksi
         /** @return The method returns a data_item represented by the data granule. */
         virtual datum get_data_item () = 0;
         
+        /** @return The method returns a data_item represented by the data granule.
+         *  Random items are drawn with the engine, so each thread or task can sample with its own stream.
+         *  @param engine random engine 
+         *  @date 2026-10-18 */
+        virtual datum get_data_item (std::default_random_engine & engine);
+        
         /** @return The method returns a decision for a datum.
          *  @param  d the datum to elaborated answer for .*/
         virtual const number get_answer (const datum & d) = 0;
@@ -0,0 +1,259 @@
+/** @file */
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <exception>
+#include <algorithm>
+
+#include "nfs_hyperparameter_search.h"
+#include "simulated-annealing.h"
+#include "../neuro-fuzzy/neuro-fuzzy-system.h"
+#include "../service/debug.h"
+#include "../service/exception.h"
+
+ksi::nfs_hyperparameter_search::nfs_hyperparameter_search(
+   const std::vector<ksi::hyperparameter> & hyperparameters,
+   const ksi::nfs_hyperparameter_search::factory & factory_of_systems,
+   const ksi::dataset & train,
+   const ksi::dataset & validation,
+   const double initial_temperature,
+   const double temperature_descrease_ratio,
+   const int maximal_number_of_iterations,
+   const int maximal_number_of_iterations_without_temperature_descrease)
+: ksi::simulated_annealing (initial_temperature, temperature_descrease_ratio,
+                            maximal_number_of_iterations,
+                            maximal_number_of_iterations_without_temperature_descrease),
+  _hyperparameters (hyperparameters),
+  _factory (factory_of_systems),
+  _pTrain (std::make_shared<const ksi::dataset>(train)),
+  _pValidation (std::make_shared<const ksi::dataset>(validation)),
+  _pCache (std::make_shared<cache>()),
+  _best_error (std::numeric_limits<double>::infinity())
+{
+   for (const auto & h : _hyperparameters)
+   {
+      if (h.maximum < h.minimum)
+         throw ksi::exception ("The range of hyperparameter " + h.name + " is empty.");
+      if (h.logarithmic and h.minimum <= 0)
+         throw ksi::exception ("The range of logarithmic hyperparameter " + h.name + " has to be positive.");
+   }
+   _engine.seed(get_seed());
+}
+
+ksi::nfs_hyperparameter_search::nfs_hyperparameter_search(const ksi::nfs_hyperparameter_search & wzor)
+: ksi::simulated_annealing (wzor)
+{
+   _hyperparameters = wzor._hyperparameters;
+   _factory = wzor._factory;
+   _pTrain = wzor._pTrain;
+   _pValidation = wzor._pValidation;
+   _pCache = wzor._pCache;
+   _partial_fraction = wzor._partial_fraction;
+   _pruning_ratio = wzor._pruning_ratio;
+   _step = wzor._step;
+   _best_error = wzor._best_error;
+   _engine = wzor._engine;
+}
+
+ksi::nfs_hyperparameter_search::~nfs_hyperparameter_search()
+{
+}
+
+ksi::simulated_annealing * ksi::nfs_hyperparameter_search::clone() const
+{
+   return new ksi::nfs_hyperparameter_search (*this);
+}
+
+void ksi::nfs_hyperparameter_search::set_seed(const std::uint64_t seed)
+{
+   ksi::simulated_annealing::set_seed(seed);
+   _engine.seed(seed);
+}
+
+void ksi::nfs_hyperparameter_search::set_pruning(const double fraction, const double ratio)
+{
+   try
+   {
+      if (fraction <= 0 or fraction > 1)
+         throw ksi::exception ("The fraction of tuning iterations (" + std::to_string(fraction) + ") has to be in (0, 1].");
+      if (ratio < 1)
+         throw ksi::exception ("The pruning ratio (" + std::to_string(ratio) + ") cannot be less than 1.");
+      _partial_fraction = fraction;
+      _pruning_ratio = ratio;
+   }
+   CATCH;
+}
+
+void ksi::nfs_hyperparameter_search::set_step(const double step)
+{
+   _step = step;
+}
+
+std::vector<double> ksi::nfs_hyperparameter_search::get_first_point()
+{
+   std::uniform_real_distribution<double> distro (0, 1);
+   std::vector<double> point (_hyperparameters.size());
+   for (auto & p : point)
+      p = distro(_engine);
+   return point;
+}
+
+std::vector<double> ksi::nfs_hyperparameter_search::get_next_point(const std::vector<double> & point)
+{
+   std::normal_distribution<double> distro (0, _step);
+   auto next = point;
+   for (auto & p : next)
+   {
+      p += distro(_engine);
+      // odbicie od brzegow przedzialu [0, 1]
+      p = std::fabs(p);
+      if (p > 1)
+         p = std::max(0.0, 2 - p);
+   }
+   return next;
+}
+
+std::vector<double> ksi::nfs_hyperparameter_search::decode(const std::vector<double> & x) const
+{
+   try
+   {
+      if (x.size() != _hyperparameters.size())
+         throw ksi::exception ("The point has " + std::to_string(x.size()) + " coordinates, but there are " + std::to_string(_hyperparameters.size()) + " hyperparameters.");
+
+      std::vector<double> values (x.size());
+      for (std::size_t i = 0; i < x.size(); i++)
+      {
+         const auto & h = _hyperparameters[i];
+         double u = std::clamp(x[i], 0.0, 1.0);
+         if (h.logarithmic)
+            values[i] = std::exp(std::log(h.minimum) + u * (std::log(h.maximum) - std::log(h.minimum)));
+         else
+            values[i] = h.minimum + u * (h.maximum - h.minimum);
+         if (h.integer)
+            values[i] = std::round(values[i]);
+      }
+      return values;
+   }
+   CATCH;
+}
+
+std::string ksi::nfs_hyperparameter_search::to_string(const std::vector<double> & x) const
+{
+   auto values = decode(x);
+   std::stringstream ss;
+   for (std::size_t i = 0; i < values.size(); i++)
+      ss << (i > 0 ? ", " : "") << _hyperparameters[i].name << " = " << values[i];
+   return ss.str();
+}
+
+double ksi::nfs_hyperparameter_search::train_and_validate(const std::vector<double> & hyperparameters, const double fraction) const
+{
+   try
+   {
+      std::unique_ptr<ksi::neuro_fuzzy_system> pSystem (_factory(hyperparameters));
+      if (not pSystem)
+         throw ksi::exception ("The factory has not created a system.");
+
+      int nTuningIterations = pSystem->get_number_of_tuning_iterations();
+      if (fraction < 1)
+         nTuningIterations = std::max(1, (int) std::round(fraction * nTuningIterations));
+      
+      pSystem->createFuzzyRulebase(pSystem->get_number_of_clustering_iterations(),
+                                   nTuningIterations,
+                                   pSystem->get_learning_coefficient(),
+                                   *_pTrain, *_pValidation);
+      return pSystem->elaborate_rmse_for_dataset(*_pValidation);
+   }
+   CATCH;
+}
+
+double ksi::nfs_hyperparameter_search::cached_error(const std::vector<double> & hyperparameters, const bool full) const
+{
+   try
+   {
+      std::promise<double> promise;
+      std::shared_future<double> error;
+      bool elaborate = false;
+      {
+         std::lock_guard<std::mutex> lock (_pCache->mutex);
+         auto & errors = full ? _pCache->full_errors : _pCache->partial_errors;
+         auto it = errors.find(hyperparameters);
+         if (it != errors.end())
+         {
+            error = it->second;
+            _pCache->number_of_hits++;
+         }
+         else
+         {
+            // Other chains wait for the error instead of training the same configuration.
+            error = promise.get_future().share();
+            errors.emplace(hyperparameters, error);
+            _pCache->number_of_trainings++;
+            elaborate = true;
+         }
+      }
+
+      if (elaborate)
+      {
+         try
+         {
+            promise.set_value(train_and_validate(hyperparameters, full ? 1.0 : _partial_fraction));
+         }
+         catch (...)
+         {
+            promise.set_exception(std::current_exception());
+         }
+      }
+      return error.get();
+   }
+   CATCH;
+}
+
+double ksi::nfs_hyperparameter_search::f(const std::vector<double> & x) const
+{
+   try
+   {
+      auto h = decode(x);
+
+      // The configuration is pruned with the best error of this chain only.
+      if (_partial_fraction < 1)
+      {
+         const double partial_error = cached_error(h, false);
+         if (partial_error > _pruning_ratio * _best_error)
+         {
+            std::lock_guard<std::mutex> lock (_pCache->mutex);
+            _pCache->number_of_pruned++;
+            return partial_error;
+         }
+      }
+
+      const double full_error = cached_error(h, true);
+      _best_error = std::min(_best_error, full_error);
+      return full_error;
+   }
+   CATCH;
+}
+
+std::size_t ksi::nfs_hyperparameter_search::get_number_of_trainings() const
+{
+   std::lock_guard<std::mutex> lock (_pCache->mutex);
+   return _pCache->number_of_trainings;
+}
+
+std::size_t ksi::nfs_hyperparameter_search::get_number_of_cache_hits() const
+{
+   std::lock_guard<std::mutex> lock (_pCache->mutex);
+   return _pCache->number_of_hits;
+}
+
+std::size_t ksi::nfs_hyperparameter_search::get_number_of_pruned() const
+{
+   std::lock_guard<std::mutex> lock (_pCache->mutex);
+   return _pCache->number_of_pruned;
+}
@@ -0,0 +1,177 @@
+/** @file */
+
+#ifndef NFS_HYPERPARAMETER_SEARCH_H
+#define NFS_HYPERPARAMETER_SEARCH_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <mutex>
+#include <future>
+#include <memory>
+#include <random>
+#include <cstdint>
+#include <functional>
+
+#include "simulated-annealing.h"
+#include "../common/dataset.h"
+#include "../neuro-fuzzy/neuro-fuzzy-system.h"
+
+namespace ksi
+{
+   /** A hyperparameter of a neuro-fuzzy system searched in a range.
+       @date 2026-10-18 */
+   struct hyperparameter
+   {
+      std::string name;
+      double minimum;
+      double maximum;
+      /** the value is rounded to an integer (eg. number of rules, number of iterations) */
+      bool integer = false;
+      /** the range is searched in logarithmic scale (eg. learning coefficient) */
+      bool logarithmic = false;
+   };
+
+   /** Simulated annealing in the space of hyperparameters of a neuro-fuzzy system.
+    *  A point of the heuristics is a vector of hyperparameters normalised to [0, 1].
+    *  The value of the function is the RMSE on the validation dataset of a system
+    *  built by the factory and trained with the train dataset.
+    *
+    *  Each configuration is first trained with a fraction of tuning iterations.
+    *  If its validation error exceeds the best error found by the chain
+    *  multiplied by the pruning ratio, the configuration is rejected without full training.
+    *  Partial and full errors of configurations are cached. The cache is shared by all clones,
+    *  so chains run by ksi::parallel_annealing do not train the same configuration twice:
+    *  a chain that needs an error being elaborated by another chain waits for it.
+    *  A chain prunes a configuration only with its partial error and the best error 
+    *  of the chain, whichever errors other chains have already cached, so the values 
+    *  of the function and the points visited by a chain depend only on its seed. 
+    *  The search is reproducible if the systems are trained deterministically 
+    *  (eg. partition initialisation is seeded).
+    *
+    *  Example:
+    *  @code
+    *  ksi::nfs_hyperparameter_search search (
+    *     { {"rules", 2, 20, true}, {"eta", 0.0001, 0.1, false, true} },
+    *     [] (const std::vector<double> & h) -> ksi::neuro_fuzzy_system *
+    *     { return new ksi::tsk (h[0], 100, 100, h[1], true, ksi::t_norm_product()); },
+    *     train, validation, 1.0, 0.9, 100, 10);
+    *  auto [point, error] = ksi::parallel_annealing (8, seed).run(search);
+    *  auto best = search.decode(point);
+    *  @endcode
+    *  @date 2026-10-18
+    */
+   class nfs_hyperparameter_search : public simulated_annealing
+   {
+   public:
+      /** The factory creates a new neuro-fuzzy system for hyperparameters.
+          The caller takes the ownership of the system. 
+          The factory is called concurrently by chains. */
+      typedef std::function<neuro_fuzzy_system * (const std::vector<double> & hyperparameters)> factory;
+
+   protected:
+      /** cache of evaluations shared by all clones */
+      struct cache
+      {
+         std::mutex mutex;
+         /** validation errors after partial tuning (elaborated or being elaborated) */
+         std::map<std::vector<double>, std::shared_future<double>> partial_errors;
+         /** validation errors after full tuning (elaborated or being elaborated) */
+         std::map<std::vector<double>, std::shared_future<double>> full_errors;
+         std::size_t number_of_trainings = 0;
+         std::size_t number_of_hits = 0;
+         std::size_t number_of_pruned = 0;
+      };
+
+      std::vector<hyperparameter> _hyperparameters;
+      factory _factory;
+      std::shared_ptr<const dataset> _pTrain;
+      std::shared_ptr<const dataset> _pValidation;
+      std::shared_ptr<cache> _pCache;
+
+      /** fraction of tuning iterations in partial training */
+      double _partial_fraction = 0.25;
+
+      /** a configuration is pruned if its partial error exceeds the best error times this ratio */
+      double _pruning_ratio = 1.5;
+
+      /** standard deviation of a step in the normalised space */
+      double _step = 0.1;
+
+      /** the best full error found by this chain */
+      mutable double _best_error;
+
+      std::default_random_engine _engine;
+
+      /** @return a random point in the normalised space */
+      virtual std::vector<double> get_first_point () override;
+
+      /** @return a neighbour of the point: a Gaussian step reflected into [0, 1] */
+      virtual std::vector<double> get_next_point (const std::vector<double> & point) override;
+
+      /** The method creates a system, trains it and elaborates the validation error.
+          @param hyperparameters decoded hyperparameters
+          @param fraction fraction of tuning iterations of the system to execute */
+      double train_and_validate (const std::vector<double> & hyperparameters, const double fraction) const;
+
+      /** The method returns the cached validation error of a configuration. 
+          If the error is not cached, it is elaborated (train_and_validate).
+          If it is being elaborated by another chain, the method waits for it.
+          @param hyperparameters decoded hyperparameters
+          @param full true: error after full tuning, false: after partial tuning */
+      double cached_error (const std::vector<double> & hyperparameters, const bool full) const;
+
+   public:
+      /** @param hyperparameters searched hyperparameters
+          @param factory_of_systems creates a system for decoded hyperparameters
+          @param train train dataset
+          @param validation validation dataset
+          @param initial_temperature initial temperature for simulated annealing
+          @param temperature_descrease_ratio temperature decrease ratio
+          @param maximal_number_of_iterations maximal number of iterations of a chain
+          @param maximal_number_of_iterations_without_temperature_descrease maximal number of iterations with the same temperature */
+      nfs_hyperparameter_search (const std::vector<hyperparameter> & hyperparameters,
+                                 const factory & factory_of_systems,
+                                 const dataset & train,
+                                 const dataset & validation,
+                                 const double initial_temperature,
+                                 const double temperature_descrease_ratio,
+                                 const int maximal_number_of_iterations,
+                                 const int maximal_number_of_iterations_without_temperature_descrease);
+
+      nfs_hyperparameter_search (const nfs_hyperparameter_search & wzor);
+      virtual ~nfs_hyperparameter_search ();
+
+      /** @return validation error of the configuration (partial error for a pruned one)
+          @param x normalised point */
+      virtual double f (const std::vector<double> & x) const override;
+
+      /** The method sets the seed of the heuristics and of the engine of neighbours. */
+      virtual void set_seed (const std::uint64_t seed) override;
+
+      /** @return hyperparameters for a normalised point */
+      std::vector<double> decode (const std::vector<double> & x) const;
+
+      /** @return names and values of hyperparameters for a normalised point */
+      std::string to_string (const std::vector<double> & x) const;
+
+      /** @param fraction fraction of tuning iterations in partial training,
+                 a value from (0, 1], 1 switches pruning off
+          @param ratio pruning ratio (not less than 1) */
+      void set_pruning (const double fraction, const double ratio);
+
+      /** @param step standard deviation of a step in the normalised space */
+      void set_step (const double step);
+
+      /** @return number of trainings of systems (partial and full) */
+      std::size_t get_number_of_trainings () const;
+      /** @return number of evaluations read from the cache */
+      std::size_t get_number_of_cache_hits () const;
+      /** @return number of pruned evaluations */
+      std::size_t get_number_of_pruned () const;
+
+      virtual simulated_annealing * clone () const override;
+   };
+}
+
+#endif
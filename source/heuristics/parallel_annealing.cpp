@@ -0,0 +1,83 @@
+/** @file */
+
+#include <vector>
+#include <utility>
+#include <memory>
+#include <thread>
+#include <exception>
+#include <random>
+
+#include "parallel_annealing.h"
+#include "simulated-annealing.h"
+#include "../service/debug.h"
+#include "../service/exception.h"
+#include "../auxiliary/random_service.h"
+
+ksi::parallel_annealing::parallel_annealing(const int number_of_chains, const std::uint64_t seed)
+: _nChains (number_of_chains), _seed (seed)
+{
+}
+
+std::uint64_t ksi::parallel_annealing::get_chain_seed(const int chain) const
+{
+   std::seed_seq sequence { static_cast<std::uint32_t>(_seed), static_cast<std::uint32_t>(_seed >> 32), static_cast<std::uint32_t>(chain) };
+   std::uint32_t words[2];
+   sequence.generate(words, words + 2);
+   return (static_cast<std::uint64_t>(words[1]) << 32) | words[0];
+}
+
+std::pair<std::vector<double>, double> ksi::parallel_annealing::run(const ksi::simulated_annealing & prototype)
+{
+   try
+   {
+      if (_nChains < 1)
+         throw ksi::exception ("The number of chains (" + std::to_string(_nChains) + ") has to be positive.");
+
+      std::vector<std::unique_ptr<ksi::simulated_annealing>> chains;
+      for (int c = 0; c < _nChains; c++)
+      {
+         chains.emplace_back(prototype.clone());
+         chains.back()->set_seed(get_chain_seed(c));
+      }
+
+      _chain_results.assign(_nChains, {});
+      std::vector<std::exception_ptr> errors (_nChains);
+
+      std::vector<std::thread> threads;
+      for (int c = 0; c < _nChains; c++)
+      {
+         threads.emplace_back([this, &chains, &errors, c] ()
+         {
+            // random streams drawn by the chain (eg. initialisation of partitions) depend on the chain, not on the thread
+            ksi::random_task task (get_chain_seed(c));
+            try
+            {
+               _chain_results[c] = chains[c]->run();
+            }
+            catch (...)
+            {
+               errors[c] = std::current_exception();
+            }
+         });
+      }
+      for (auto & thread : threads)
+         thread.join();
+
+      for (auto & error : errors)
+         if (error)
+            std::rethrow_exception(error);
+
+      std::size_t best = 0;
+      for (std::size_t c = 1; c < _chain_results.size(); c++)
+         if (_chain_results[c].second < _chain_results[best].second)
+            best = c;
+
+      return _chain_results[best];
+   }
+   CATCH;
+}
+
+const std::vector<std::pair<std::vector<double>, double>> & ksi::parallel_annealing::get_chain_results() const
+{
+   return _chain_results;
+}
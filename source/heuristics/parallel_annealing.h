@@ -0,0 +1,52 @@
+/** @file */
+
+#ifndef PARALLEL_ANNEALING_H
+#define PARALLEL_ANNEALING_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "simulated-annealing.h"
+
+namespace ksi
+{
+   /** The class runs several independent chains of simulated annealing concurrently.
+    *  Each chain is a clone of a prototype heuristics with its own seed elaborated
+    *  from the seed of the class, so the result depends only on the seed
+    *  (unless the chains are limited by time).
+    *  @date 2026-10-18
+    */
+   class parallel_annealing
+   {
+      /** number of chains */
+      int _nChains;
+
+      /** seed of chains */
+      std::uint64_t _seed;
+
+      /** results of chains of the last run */
+      std::vector<std::pair<std::vector<double>, double>> _chain_results;
+
+   public:
+      /** @param number_of_chains number of concurrent chains
+          @param seed seed of the chains */
+      parallel_annealing (const int number_of_chains, const std::uint64_t seed);
+
+      /** @return seed of a chain
+          @param chain number of chain */
+      std::uint64_t get_chain_seed (const int chain) const;
+
+      /** The method runs all chains, each in its own thread.
+          @param prototype heuristics to clone for each chain
+          @return the best point of all chains and the value of the function for it;
+                  for equal values the chain with a lower number wins
+          @throw ksi::exception if any chain throws */
+      std::pair<std::vector<double>, double> run (const simulated_annealing & prototype);
+
+      /** @return results of each chain of the last run */
+      const std::vector<std::pair<std::vector<double>, double>> & get_chain_results () const;
+   };
+}
+
+#endif
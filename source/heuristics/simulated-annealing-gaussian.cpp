@@ -59,7 +59,13 @@ ksi::simulated_annealing_gaussian::simulated_annealing_gaussian(
 }
  
 
-double ksi::simulated_annealing_gaussian::f(std::vector<double> x) const
+void ksi::simulated_annealing_gaussian::set_seed(const std::uint64_t seed)
+{
+   ksi::simulated_annealing::set_seed(seed);
+   engine.seed(seed);
+}
+
+double ksi::simulated_annealing_gaussian::f(const std::vector<double> & x) const
 {
    return error(_experimental_data, x[0], // m
                                     x[1]  // s
@@ -56,7 +56,11 @@ namespace ksi
    public:   
       /** The method implements a function whose root is searched. 
        @param x is a vector of two items: m (mean value) and s (fuzzyfication) */
-      virtual double f (std::vector<double> x) const;
+      virtual double f (const std::vector<double> & x) const;
+      
+      /** The method sets the seed of the heuristics and of the engine of neighbours. 
+          @date 2026-10-18 */
+      virtual void set_seed (const std::uint64_t seed) override;
  
       
        
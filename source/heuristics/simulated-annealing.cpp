@@ -20,7 +20,8 @@ std::pair<std::vector<double>, double> ksi::simulated_annealing::run()
       //if (_minimal_parameter_values.size() != _maximal_parameter_values.size())
       //   throw std::string ("minimal and maximal paramter numbers do not match");
       
-      std::default_random_engine randomizer;      
+      std::default_random_engine randomizer (_seed);
+      const auto start = std::chrono::steady_clock::now();
       std::uniform_real_distribution<double> distro_for_worse_points (0, 1);
       
       /*
@@ -77,6 +78,8 @@ std::pair<std::vector<double>, double> ksi::simulated_annealing::run()
          
          if (iter++ > _max_iterations)
             finish = true;
+         if (_time_limit > 0 and std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > _time_limit)
+            finish = true;
          iter_t++;
          if (iter_t > _max_iteration_for_temperature)
          {
@@ -99,6 +102,21 @@ std::pair<std::vector<double>, double> ksi::simulated_annealing::run()
    CATCH;
 }
  
+void ksi::simulated_annealing::set_seed(const std::uint64_t seed)
+{
+   _seed = seed;
+}
+
+std::uint64_t ksi::simulated_annealing::get_seed() const
+{
+   return _seed;
+}
+
+void ksi::simulated_annealing::set_time_limit(const double seconds)
+{
+   _time_limit = seconds;
+}
+
 ksi::simulated_annealing::~simulated_annealing()
 {
 }
@@ -112,6 +130,8 @@ ksi::simulated_annealing::simulated_annealing(const ksi::simulated_annealing & w
    _max_iteration_for_temperature = wzor._max_iteration_for_temperature;
    _the_best_point = wzor._the_best_point;
    _f_the_best_point = wzor._f_the_best_point; 
+   _seed = wzor._seed;
+   _time_limit = wzor._time_limit;
 }
 
 ksi::simulated_annealing::simulated_annealing(ksi::simulated_annealing && wzor)
@@ -122,6 +142,8 @@ ksi::simulated_annealing::simulated_annealing(ksi::simulated_annealing && wzor)
    std::swap(_max_iteration_for_temperature, wzor._max_iteration_for_temperature);
    std::swap(_the_best_point, wzor._the_best_point);
    std::swap(_f_the_best_point, wzor._f_the_best_point);   
+   std::swap(_seed, wzor._seed);
+   std::swap(_time_limit, wzor._time_limit);
 }
 
 ksi::simulated_annealing & ksi::simulated_annealing::operator=(const ksi::simulated_annealing& wzor)
@@ -135,6 +157,8 @@ ksi::simulated_annealing & ksi::simulated_annealing::operator=(const ksi::simula
    _max_iteration_for_temperature = wzor._max_iteration_for_temperature;
    _the_best_point = wzor._the_best_point;
    _f_the_best_point = wzor._f_the_best_point; 
+   _seed = wzor._seed;
+   _time_limit = wzor._time_limit;
    
    
    return *this;
@@ -152,6 +176,8 @@ ksi::simulated_annealing & ksi::simulated_annealing::operator=(ksi::simulated_an
    std::swap(_max_iteration_for_temperature, wzor._max_iteration_for_temperature);
    std::swap(_the_best_point, wzor._the_best_point);
    std::swap(_f_the_best_point, wzor._f_the_best_point); 
+   std::swap(_seed, wzor._seed);
+   std::swap(_time_limit, wzor._time_limit);
    
    return *this;
 }
@@ -4,6 +4,8 @@
 #define SIMULATED_ANNEALING_H
 
 #include <vector>
+#include <cstdint>
+#include <random>
 #include "../service/debug.h"
 
 namespace ksi
@@ -11,7 +13,7 @@ namespace ksi
    /** The class executed simulated annealing opimisation heuristics – minimum search
     * 
     * 
-    * For your function derive a new class from this one and implement an f(std::vector<double> x) method.
+    * For your function derive a new class from this one and implement an f(const std::vector<double> & x) method.
     */
    class simulated_annealing
    {
@@ -32,6 +34,14 @@ namespace ksi
       /** function value for the best point -- presumed global minimum */
       double _f_the_best_point;
       
+      /** seed of the random engine accepting worse points 
+          @date 2026-10-18 */
+      std::uint64_t _seed = std::default_random_engine::default_seed;
+      
+      /** maximal time of run in seconds, non-positive value: no limit 
+          @date 2026-10-18 */
+      double _time_limit = 0.0;
+      
       /** The method elaborates the first point for the heuristics. 
        * @return the first point */
       virtual std::vector<double> get_first_point () = 0;
@@ -48,7 +58,24 @@ namespace ksi
        
    public:   
       /** The method implements a function whose root is searched. */
-      virtual double f (std::vector<double> x) const = 0;
+      virtual double f (const std::vector<double> & x) const = 0;
+      
+      /** The method sets the seed of random engines used in the heuristics. 
+          Derived classes with their own engines should reseed them too.
+          @param seed seed to set 
+          @date 2026-10-18 */
+      virtual void set_seed (const std::uint64_t seed);
+      
+      /** @return the seed of the heuristics 
+          @date 2026-10-18 */
+      std::uint64_t get_seed () const;
+      
+      /** The method limits time of the run. The run finishes after the number 
+          of iterations or after the time limit, whichever comes first. 
+          A run stopped by time is not reproducible.
+          @param seconds maximal time in seconds, non-positive value: no limit 
+          @date 2026-10-18 */
+      void set_time_limit (const double seconds);
 
       /** implements simulated_annealing heuristics
        @return a pair: the best point, value of the function for the best point
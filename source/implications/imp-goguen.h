@@ -13,11 +13,20 @@ namespace ksi
       /** @return value of fuzzy implication: \f$ x \rightarrow y = 1\f$ for \f$x \leq  y\f$ and \f$ x \rightarrow y = \frac{y}{x}\f$ for \f$x > y\f$ */
       virtual double imply (double, double) const override;
       /** @return G function for ANNBFIS NFS  */
-      virtual double G (double F, double w) const override;
+      virtual double G (double F, double w) const override
+      {
+         return w * (1.0 - 0.5 * F);
+      }
       /** @return differential dG / dF for  ANNBFIS NFS */
-      virtual double dG_dF (double F, double w) const override;
+      virtual double dG_dF (double, double w) const override
+      {
+         return - 0.5 * w;
+      }
       /** @return differential dG / dw for  ANNBFIS NFS */
-      virtual double dG_dw (double F, double w) const override;
+      virtual double dG_dw (double F, double) const override
+      {
+         return 1.0 - F / 2.0;
+      }
       /** cloning method */
       virtual implication * clone() const override; 
       
@@ -13,11 +13,20 @@ namespace ksi
       /** @return value of fuzzy implication: \f$x \rightarrow y = \min[1, 1 - x + y]\f$*/
       virtual double imply (double, double) const override;
       /** @return G function for ANNBFIS NFS  */
-      virtual double G (double F, double w) const override;
+      virtual double G (double F, double w) const override
+      {
+         return w * F * (1.0 - F / 2.0);
+      }
       /** @return differential dG / dF for  ANNBFIS NFS */
-      virtual double dG_dF (double F, double w) const override;
+      virtual double dG_dF (double F, double w) const override
+      {
+         return w * (1 - F);
+      }
       /** @return differential dG / dw for  ANNBFIS NFS */
-      virtual double dG_dw (double F, double w) const override;
+      virtual double dG_dw (double F, double) const override
+      {
+         return F * (1 - F / 2.0);
+      }
       /** cloning method */
       virtual implication * clone() const override; 
       
@@ -13,11 +13,20 @@ namespace ksi
       /** @return value of fuzzy implication: \f$x \rightarrow y = 1 - x + xy\f$*/
       virtual double imply (double, double) const override;
       /** @return G function for ANNBFIS NFS  */
-      virtual double G (double F, double w) const override;
+      virtual double G (double F, double w) const override
+      {
+         return w * F / 0.5;
+      }
       /** @return differential dG / dF for  ANNBFIS NFS */
-      virtual double dG_dF (double F, double w) const override;
+      virtual double dG_dF (double, double w) const override
+      {
+         return w / 2.0;
+      }
       /** @return differential dG / dw for  ANNBFIS NFS */
-      virtual double dG_dw (double F, double w) const override;
+      virtual double dG_dw (double F, double) const override
+      {
+         return F / 2.0;
+      }
       /** cloning method */
       virtual implication * clone() const override; 
       
@@ -14,11 +14,29 @@ namespace ksi
       /** @return value of fuzzy implication: \f$x \rightarrow y = \max [1 - x, \min (x, y)] \f$*/
       virtual double imply (double, double) const override;
       /** @return G function for ANNBFIS NFS  */
-      virtual double G (double F, double w) const override;
+      virtual double G (double F, double w) const override
+      {
+         if (F >= 0.5)
+            return w * (F - 0.5);
+         else
+            return 0.0;
+      }
       /** @return differential dG / dF for  ANNBFIS NFS */
-      virtual double dG_dF (double F, double w) const override;
+      virtual double dG_dF (double F, double w) const override
+      {
+         if (F >= 0.5)
+            return w;
+         else
+            return 0;
+      }
       /** @return differential dG / dw for  ANNBFIS NFS */
-      virtual double dG_dw (double F, double w) const override;
+      virtual double dG_dw (double F, double) const override
+      {
+         if (F >= 0.5)
+            return F - 0.5;
+         else
+            return 0;
+      }
       /** cloning method */
       virtual implication * clone() const override; 
       
@@ -12,6 +12,7 @@
 #include "./experiments/exp-004.h"
 #include "./experiments/exp-005.h"
 #include "./experiments/exp-lab.h"
+#include "./experiments/exp-bench.h"
 
  
 int main (int argc, char ** params)
@@ -55,6 +56,11 @@ int main (int argc, char ** params)
                     experiment.execute();
                     break;
                 }
+                case 6: { 
+                    ksi::exp_bench experiment;
+                    experiment.execute();
+                    break;
+                }
                 case 0: { 
                     ksi::exp_lab experiment;
                     experiment.execute();
@@ -66,12 +66,8 @@ double ksi::metric_minkowski_weighted::calculateDistance(const std::vector<doubl
             throw ksi::exception (ss.str());
         }
 
-        double suma = 0.0;
-        for (std::size_t a = 0; a < lsize; a++)
-        {
-            suma += _weights[a] * pow( std::fabs(l[a] - p[a]) , _m);
-        }
-        return pow (suma, 1.0 / _m);
+        double suma = _kernel.weighted_sum_of_powers(l.data(), p.data(), _weights.data(), lsize);
+        return _kernel.root(suma);
     }
     CATCH;
 }
@@ -23,7 +23,7 @@ ksi::metric_minkowski::~metric_minkowski()
 {
 }
 
-ksi::metric_minkowski::metric_minkowski(double m) : _m (m)
+ksi::metric_minkowski::metric_minkowski(double m) : _m (m), _kernel (m)
 {
 }
 
@@ -59,12 +59,8 @@ double ksi::metric_minkowski::calculateDistance(const std::vector<double>& l, co
             throw ksi::exception (ss.str());
         }
 
-        double suma = 0.0;
-        for (std::size_t a = 0; a < lsize; a++)
-        {
-            suma += pow( std::fabs(l[a] - p[a]) , _m);
-        }
-        return pow (suma, 1.0 / _m);
+        double suma = _kernel.weighted_sum_of_powers(l.data(), p.data(), nullptr, lsize);
+        return _kernel.root(suma);
     }
     CATCH;
 }
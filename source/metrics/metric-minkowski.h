@@ -9,6 +9,7 @@
 #include "../common/number.h"
 #include "../common/datum.h"
 #include "../metrics/metric.h"
+#include "../auxiliary/minkowski_kernel.h"
 
 namespace ksi
 {
@@ -20,6 +21,7 @@ namespace ksi
    {
    protected:
       double _m; ///< exponent
+      minkowski_kernel _kernel; ///< powers and roots specialised for the exponent
    public:
       /** @param m exponent */ 
       metric_minkowski (double m); 
@@ -1,6 +1,7 @@
 /** @file */
 
 #include <algorithm>
+#include <memory>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
@@ -14,6 +15,7 @@
 #include "../neuro-fuzzy/annbfis.h"
 #include "../neuro-fuzzy/abstract-annbfis.h"
 #include "../neuro-fuzzy/logicalrule.h"
+#include "../neuro-fuzzy/rule_kernel.h"
 #include "../neuro-fuzzy/premise.h"
 #include "../neuro-fuzzy/consequence-CL.h"
 #include "../tnorms/t-norm-product.h"
@@ -28,6 +30,7 @@
 #include "../auxiliary/least-error-squares-regression.h"
 #include "../auxiliary/tempus.h"
 #include "../auxiliary/clock.h"
+#include "../auxiliary/profiler.h"
 #include "../auxiliary/confusion-matrix.h"
 #include "../auxiliary/roc.h"
 #include "../service/debug.h"
@@ -35,11 +38,18 @@
 #include "../auxiliary/error-MAE.h"
 #include "../common/number.h"
 #include "../readers/reader-complete.h"
+#include "../readers/data_stream.h"
 #include "../common/data-modifier-normaliser.h"
 #include "../partitions/partition.h"
 #include "../gan/discriminative_model.h"
 #include "../gan/generative_model.h"
 
+namespace
+{
+   /** initial value of the parameter w of consequences */
+   const double INITIAL_W = 2.0;
+}
+
 ksi::abstract_annbfis::abstract_annbfis(const ksi::implication& imp, 
                                         const ksi::partitioner& Partitioner) :
                                         ksi::abstract_annbfis::abstract_annbfis ()
@@ -72,7 +82,6 @@ void ksi::abstract_annbfis::createFuzzyRulebase
 //           throw ksi::exception("no partition object provided");
  
       // std::deque<double> errors; 
-      const double INITIAL_W = 2.0;
       
       _nClusteringIterations = nClusteringIterations;
       _nTuningIterations = nTuningIterations;
@@ -144,9 +153,11 @@ void ksi::abstract_annbfis::createFuzzyRulebase
          regula.setPremise(przeslanka);
          consequence_CL konkluzja (std::vector<double>(nAttr_1 + 1, 1.0), INITIAL_W);
          regula.setConsequence(konkluzja);
+         // specialised kernel for the t-norm and implication (if available)
+         std::unique_ptr<rule> pRegula (make_rule_kernel(regula));
 
          #pragma omp critical
-         _pRulebase->addRule(regula);
+         _pRulebase->addRule(*pRegula);
       }
       
       // dla wyznaczenia wartosci konkuzji:
@@ -157,6 +168,7 @@ void ksi::abstract_annbfis::createFuzzyRulebase
       {
          if (i % 2 == 0)
          { 
+            ksi::scoped_timer timer ("tuning: gradient epoch", nX);
             G_przyklad_regula.clear(); // dla konkluzji
             
             // strojenie gradientowe
@@ -180,6 +192,7 @@ void ksi::abstract_annbfis::createFuzzyRulebase
          
          else
          {
+            ksi::scoped_timer timer ("tuning: least squares epoch", nX);
             // wyznaczanie wspolczynnikow konkluzji.
             least_square_error_regression lser ((nAttr_1 + 1) * _nRules);
             
@@ -482,6 +495,7 @@ ksi::partition ksi::abstract_annbfis::doPartition(const ksi::dataset& X)
 {
     try 
     {
+      ksi::scoped_timer timer ("clustering", X.getNumberOfData());
         if (_pPartitioner)
             return _pPartitioner->doPartition(X);
         else 
@@ -501,3 +515,13 @@ std::string ksi::abstract_annbfis::extra_report() const
    }
    CATCH;
 }
+
+void ksi::abstract_annbfis::tune_out_of_core(ksi::data_stream & stream, const int nTuningIterations, const double eta)
+{
+   try
+   {
+      tune_rulebase_out_of_core(stream, nTuningIterations, eta,
+         [] (const std::vector<double> & coefficients) { return new ksi::consequence_CL (coefficients, INITIAL_W); });
+   }
+   CATCH;
+}
@@ -160,6 +160,14 @@ namespace ksi
          double dbLearningCoefficient,
          const dataset & train, const dataset & validation) override; 
       
+   protected:
+      /** The method tunes the rulebase with data streamed from a file 
+       * (ksi::neuro_fuzzy_system::train_out_of_core): gradient epochs
+       * interleave with least squares estimation of consequences.
+       * @date 2026-10-19
+       */
+      virtual void tune_out_of_core (ksi::data_stream & stream, const int nTuningIterations, const double eta) override;
+      
 
    public:   
       /** 
@@ -23,6 +23,7 @@
 #include "../auxiliary/least-error-squares-regression.h"
 #include "../auxiliary/tempus.h"
 #include "../auxiliary/clock.h"
+#include "../auxiliary/profiler.h"
 #include "../auxiliary/confusion-matrix.h"
 #include "../auxiliary/roc.h"
 #include "../service/debug.h"
@@ -30,6 +31,7 @@
 #include "../auxiliary/error-MAE.h"
 #include "../common/number.h"
 #include "../readers/reader-complete.h"
+#include "../readers/data_stream.h"
 #include "../common/data-modifier-normaliser.h"
 #include "../partitions/partition.h"
 #include "../service/debug.h"
@@ -142,6 +144,7 @@ void ksi::abstract_ma::createFuzzyRulebase
       // mam zgrupowane dane, teraz trzeba nastroic system
       for (int i = 0; i < nTuningIterations; i++)
       {
+         ksi::scoped_timer timer ("tuning: gradient epoch", nX);
          // strojenie gradientowe
          _pRulebase->reset_differentials();
          for (std::size_t x = 0; x < nX; x++)
@@ -423,6 +426,7 @@ ksi::partition ksi::abstract_ma::doPartition(const ksi::dataset& X)
 {
    try 
    {
+      ksi::scoped_timer timer ("clustering", X.getNumberOfData());
       if (_pPartitioner)
          return _pPartitioner->doPartition(X);
       else 
@@ -431,3 +435,12 @@ ksi::partition ksi::abstract_ma::doPartition(const ksi::dataset& X)
    CATCH;
 }
 
+void ksi::abstract_ma::tune_out_of_core(ksi::data_stream & stream, const int nTuningIterations, const double eta)
+{
+   try
+   {
+      // consequences are tuned with the gradient method only
+      tune_rulebase_out_of_core(stream, nTuningIterations, eta, nullptr);
+   }
+   CATCH;
+}
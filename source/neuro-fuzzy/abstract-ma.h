@@ -155,6 +155,12 @@ namespace ksi
        @param X dataset to partition
        @date 2019-12-24 */
       virtual partition doPartition (const dataset & X);
+      
+      /** The method tunes the rulebase with data streamed from a file 
+       * (ksi::neuro_fuzzy_system::train_out_of_core): all epochs are gradient epochs.
+       * @date 2026-10-19
+       */
+      virtual void tune_out_of_core (ksi::data_stream & stream, const int nTuningIterations, const double eta) override;
  
    public:  
      
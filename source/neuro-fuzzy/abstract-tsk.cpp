@@ -7,12 +7,15 @@
 #include <string>
 #include <numeric>
 #include <deque>
+#include <random>
+#include <cstdint>
 
 #include "../neuro-fuzzy/neuro-fuzzy-system.h"
 #include "../neuro-fuzzy/abstract-tsk.h"
 #include "../neuro-fuzzy/rule.h"
 #include "../neuro-fuzzy/premise.h"
 #include "../neuro-fuzzy/consequence-TSK.h"
+#include "../neuro-fuzzy/bounded_activation.h"
 #include "../tnorms/t-norm-product.h"
 #include "../partitions/cluster.h"
 #include "../partitions/fcm.h"
@@ -22,6 +25,8 @@
 #include "../auxiliary/least-error-squares-regression.h"
 #include "../auxiliary/tempus.h"
 #include "../auxiliary/clock.h"
+#include "../auxiliary/profiler.h"
+#include "../auxiliary/random_service.h"
 #include "../auxiliary/confusion-matrix.h"
 #include "../auxiliary/roc.h"
 #include "../service/debug.h"
@@ -29,6 +34,7 @@
 #include "../auxiliary/error-MAE.h"
 #include "../common/number.h"
 #include "../readers/reader-complete.h"
+#include "../readers/data_stream.h"
 #include "../common/data-modifier-normaliser.h"
 #include "../partitions/partition.h"
 #include "../service/debug.h"
@@ -129,16 +135,38 @@ void ksi::abstract_tsk::createFuzzyRulebase (int nClusteringIterations,
          _pRulebase->addRule(regula);
       }
       
+      // mam zgrupowane dane, teraz trzeba nastroic system
+      tune_rulebase(wTrainX, wY, nTuningIterations, eta);
+      
+      // system nastrojony :-)
+      // update the rulebase with the best one:
+      // delete _pRulebase;
+      // _pRulebase = pTheBest->clone();
+   }
+   CATCH;
+}
+
+void ksi::abstract_tsk::tune_rulebase (const std::vector<std::vector<double>> & wTrainX,
+                                      const std::vector<double> & wY,
+                                      const int nTuningIterations,
+                                      const double eta)
+{
+   try
+   {
+      const std::size_t nX = wTrainX.size();
+      const std::size_t nAttr_1 = nX > 0 ? wTrainX[0].size() : 0;
+      
       // dla wyznaczenia wartosci konkuzji:
       std::vector<std::vector<double>> F_przyklad_regula; 
-      
+   
       // mam zgrupowane dane, teraz trzeba nastroic system
       for (int i = 0; i < nTuningIterations; i++)
       {
          if (i % 2 == 0)
          { 
+            ksi::scoped_timer timer ("tuning: gradient epoch", nX);
             F_przyklad_regula.clear(); // dla konkluzji
-            
+         
             // strojenie gradientowe
             _pRulebase->reset_differentials();
             for (std::size_t x = 0; x < nX; x++)
@@ -150,25 +178,26 @@ void ksi::abstract_tsk::createFuzzyRulebase (int nClusteringIterations,
                std::vector<double> Gs;
                for (auto & p : localisation_weight)
                   Gs.push_back(p.second);
-               
+            
                F_przyklad_regula.push_back(Gs);
                // no i juz zwykla metoda gradientowa
                _pRulebase->cummulate_differentials(wTrainX[x], wY[x]);
             }         
             _pRulebase->actualise_parameters(eta);
          }
-         
+      
          else
          {
+            ksi::scoped_timer timer ("tuning: least squares epoch", nX);
             // wyznaczanie wspolczynnikow konkluzji.
             least_square_error_regression lser ((nAttr_1 + 1) * _nRules);
-            
+         
             // przygotowanie wektora D 
             for (std::size_t x = 0; x < nX; x++)
             {
                auto F_suma = std::accumulate(F_przyklad_regula[x].begin(),
                   F_przyklad_regula[x].end(), 0.0);
-               
+            
                std::vector<double> linia((nAttr_1 + 1) * _nRules);
                int index = 0;
                for (int r = 0; r < _nRules; r++)
@@ -186,26 +215,26 @@ void ksi::abstract_tsk::createFuzzyRulebase (int nClusteringIterations,
             for (int r = 0; r < _nRules; r++)
             {
                std::vector<double> coeff (nAttr_1 + 1);
-            
+         
                for (std::size_t a = 0; a < nAttr_1 + 1; a++)
                   coeff[a] = p[r * (nAttr_1 + 1) + a];
                consequence_TSK konkluzja (coeff);
                (*_pRulebase)[r].setConsequence(konkluzja);
             }
          }
-         
+      
          //////////////////////////////////
          // test: wyznaczam blad systemu
-         
+      
          // std::vector<double> wYelaborated (nValY);
          // for (std::size_t x = 0; x < nX; x++)
              // wYelaborated[x] = answer( *(validateX.getDatum(x)));
-         
+      
          ///////////////////////////
          // ksi::error_RMSE rmse;
          // double blad = rmse.getError(wvalidateY, wYelaborated);
          // errors.push_front(blad);
-         
+      
          // eta = modify_learning_coefficient(eta, errors); // modify learning coefficient
          // remember the best rulebase:
          // if (dbTheBestRMSE > blad)
@@ -215,10 +244,6 @@ void ksi::abstract_tsk::createFuzzyRulebase (int nClusteringIterations,
          // }
          ///////////////////////////
       }
-      // system nastrojony :-)
-      // update the rulebase with the best one:
-      // delete _pRulebase;
-      // _pRulebase = pTheBest->clone();
    }
    CATCH;
 }
@@ -229,6 +254,21 @@ double ksi::abstract_tsk::answer(const ksi::datum& item) const
    return _pRulebase->answer(attrs);
 }
 
+std::vector<double> ksi::abstract_tsk::answers(const ksi::dataset & X) const
+{
+   try
+   {
+      if (get_bounded_activation() and _pRulebase->has_plain_tsk_rules())
+      {
+         auto premises = _pRulebase->get_premises();
+         if (ksi::bounded_activation::is_representable(premises))
+            return _pRulebase->answer(X.getMatrix(), ksi::bounded_activation (premises, _activation_threshold, _activation_top_k, _activation_indexed));
+      }
+      return _pRulebase->answer(X.getMatrix(), _precision, _fast_math);
+   }
+   CATCH;
+}
+
 ksi::number ksi::abstract_tsk::elaborate_answer(const ksi::datum& d) const
 {
    return number (answer(d));
@@ -521,7 +561,7 @@ void ksi::abstract_tsk::train_generative_model(const ksi::dataset& ds)
 ksi::datum ksi::abstract_tsk::get_random_datum(std::default_random_engine & engine)
 {
     std::uniform_int_distribution<int> rozklad (0, _nRules - 1);
-    ksi::datum krotka = (_pRulebase->operator[](rozklad (engine))).get_data_item();
+    ksi::datum krotka = (_pRulebase->operator[](rozklad (engine))).get_data_item(engine);
     
     double decyzja = this->answer(krotka);
     krotka.push_back(ksi::number(decyzja));
@@ -529,10 +569,95 @@ ksi::datum ksi::abstract_tsk::get_random_datum(std::default_random_engine & engi
     return krotka;
 }
 
+ksi::dataset ksi::abstract_tsk::get_random_data(const std::size_t number_of_items, const std::uint64_t seed)
+{
+    try 
+    {
+        const std::size_t BLOCK_SIZE = 256;
+        const std::size_t nBlocks = (number_of_items + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        std::vector<ksi::datum> items (number_of_items);
+        
+        const ksi::philox stream (seed);
+        
+        #pragma omp parallel for
+        for (std::size_t b = 0; b < nBlocks; b++)
+        {
+            auto block_stream = stream.split(b);
+            auto engine = ksi::random_service::make_engine(block_stream);
+            std::uniform_int_distribution<int> rozklad (0, _nRules - 1);
+            
+            const std::size_t last = std::min((b + 1) * BLOCK_SIZE, number_of_items);
+            for (std::size_t i = b * BLOCK_SIZE; i < last; i++)
+                items[i] = (*_pRulebase)[rozklad(engine)].get_random_premise_value(engine);
+        }
+        
+        ksi::dataset X;
+        for (auto & item : items)
+            X.addDatum(new ksi::datum (std::move(item)));
+        
+        auto decisions = answers(X);
+        for (std::size_t i = 0; i < number_of_items; i++)
+        {
+            X.getDatumNonConst(i)->push_back(ksi::number(decisions[i]));
+        }
+        return X;
+    }
+    CATCH;
+}
+
+std::vector<double> ksi::abstract_tsk::discriminate_dataset(const ksi::dataset & ds)
+{
+    try 
+    {
+        return answers(ds);
+    }
+    CATCH;
+}
+
+void ksi::abstract_tsk::continue_tuning(const ksi::dataset & ds)
+{
+    try 
+    {
+        std::size_t nAttr = ds.getNumberOfAttributes();
+        bool matches = _pRulebase and _pRulebase->getNumberOfRules() > 0;
+        if (matches)
+        {
+            auto pTSK = dynamic_cast<const ksi::consequence_TSK *>((*_pRulebase)[0].getConsequence());
+            matches = pTSK and pTSK->get_parameters().size() == nAttr;
+        }
+        if (not matches)
+        {
+            createFuzzyRulebase(_nClusteringIterations, _nTuningIterations, _dbLearningCoefficient, ds, ds);
+            return;
+        }
+        
+        auto XY = ds.splitDataSetVertically (nAttr - 1);
+        auto wTrainX = XY.first.getMatrix();
+        auto wTrainY = XY.second.getMatrix();
+        std::vector<double> wY (wTrainY.size());
+        for (std::size_t x = 0; x < wY.size(); x++)
+            wY[x] = wTrainY[x][0];
+        
+        tune_rulebase(wTrainX, wY, _nTuningIterations, _dbLearningCoefficient);
+    }
+    CATCH;
+}
+
+void ksi::abstract_tsk::continue_training_discriminative_model(const ksi::dataset & ds)
+{
+    continue_tuning(ds);
+}
+
+void ksi::abstract_tsk::continue_training_generative_model(const ksi::dataset & ds)
+{
+    continue_tuning(ds);
+}
+
 ksi::partition ksi::abstract_tsk::doPartition(const ksi::dataset& X)
 {
    try 
    {
+      ksi::scoped_timer timer ("clustering", X.getNumberOfData());
       if (_pPartitioner)
          return _pPartitioner->doPartition(X);
       else 
@@ -541,3 +666,12 @@ ksi::partition ksi::abstract_tsk::doPartition(const ksi::dataset& X)
    CATCH;
 }
 
+void ksi::abstract_tsk::tune_out_of_core(ksi::data_stream & stream, const int nTuningIterations, const double eta)
+{
+   try
+   {
+      tune_rulebase_out_of_core(stream, nTuningIterations, eta,
+         [] (const std::vector<double> & coefficients) { return new ksi::consequence_TSK (coefficients); });
+   }
+   CATCH;
+}
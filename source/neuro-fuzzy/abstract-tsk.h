@@ -6,6 +6,7 @@
 
 #include <vector>
 #include <iostream>
+#include <cstdint>
 
 #include "../common/dataset.h"
 #include "../common/number.h"
@@ -197,6 +198,34 @@ namespace ksi
        @date 2019-12-19 */
       virtual partition doPartition (const dataset & X);
       
+      /** The method tunes the existing rulebase: gradient epochs (even iterations)
+       * interleave with least squares estimation of consequences (odd iterations).
+       * @param wTrainX train data items (without the decision attribute)
+       * @param wY decision attribute of train data items
+       * @param nTuningIterations number of tuning iterations
+       * @param eta learning coefficient for gradient method
+       * @date 2026-10-18
+       */
+      void tune_rulebase (const std::vector<std::vector<double>> & wTrainX,
+                          const std::vector<double> & wY,
+                          const int nTuningIterations,
+                          const double eta);
+      
+      /** The method continues tuning of the rulebase with a dataset.
+       * If there is no rulebase or it does not match the dataset, 
+       * the rulebase is created from scratch.
+       * @param ds dataset (with the decision attribute)
+       * @date 2026-10-18
+       */
+      void continue_tuning (const dataset & ds);
+      
+      /** The method tunes the rulebase with data streamed from a file 
+       * (ksi::neuro_fuzzy_system::train_out_of_core): gradient epochs
+       * interleave with least squares estimation of consequences.
+       * @date 2026-10-19
+       */
+      virtual void tune_out_of_core (ksi::data_stream & stream, const int nTuningIterations, const double eta) override;
+      
    public:   
       /** 
        @return rulebase's answer of a data item
@@ -204,6 +233,14 @@ namespace ksi
        */
       virtual double answer (const datum & item) const;
       
+      /** The method elaborates answers for all data items with the batched
+          TSK consequences of the rulebase (with bounded activation of rules 
+          if it is set and premises are Gaussian with the product t-norm).
+       @return answers for data items
+       @param X dataset to elaborate answers for
+       @date 2026-10-18
+       */
+      virtual std::vector<double> answers (const dataset & X) const override;
  
       
       /** A method elaborates an answer of a datum (data item). 
@@ -223,6 +260,26 @@ namespace ksi
       
       virtual ksi::datum get_random_datum(std::default_random_engine & engine);
       
+      /** The method returns random data items. Premises of rules are sampled in parallel,
+       *  each block of data items with its own random engine, so the data items
+       *  depend only on the seed. Decisions are elaborated in one batch.
+       *  @param number_of_items number of data items to generate
+       *  @param seed seed of random engines
+       *  @date 2026-10-18 */
+      virtual dataset get_random_data (const std::size_t number_of_items, const std::uint64_t seed) override;
+      
+      /** The method elaborates answers for all data items in one batch. 
+       *  @date 2026-10-18 */
+      virtual std::vector<double> discriminate_dataset (const dataset & ds) override;
+      
+      /** The method continues tuning of the rulebase (no clustering). 
+       *  @date 2026-10-18 */
+      virtual void continue_training_discriminative_model (const dataset & ds) override;
+      
+      /** The method continues tuning of the rulebase (no clustering). 
+       *  @date 2026-10-18 */
+      virtual void continue_training_generative_model (const dataset & ds) override;
+      
    };
 }
 
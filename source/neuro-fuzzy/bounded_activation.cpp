@@ -0,0 +1,324 @@
+/** @file */
+
+#include <vector>
+#include <cmath>
+#include <string>
+#include <limits>
+#include <typeinfo>
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+#include "../neuro-fuzzy/bounded_activation.h"
+#include "../descriptors/descriptor-gaussian.h"
+#include "../tnorms/t-norm-product.h"
+#include "../auxiliary/fast_math.h"
+#include "../service/debug.h"
+
+namespace
+{
+   /** exponents below are not elaborated: std::exp underflows to 0 */
+   const double MINIMAL_EXPONENT = -746.0;
+   /** maximal number of rules in a leaf of the index */
+   const std::size_t LEAF_SIZE = 32;
+   /** number of attributes summed between comparisons with the cutoff
+       (a comparison after each attribute costs more in mispredicted branches than it saves) */
+   const std::size_t BLOCK_SIZE = 4;
+}
+
+bool ksi::bounded_activation::is_representable(const std::vector<const ksi::premise *> & premises)
+{
+    try
+    {
+        std::size_t nAttributes = 0;
+        for (std::size_t r = 0; r < premises.size(); r++)
+        {
+            const auto pPremise = premises[r];
+            if (not pPremise or typeid(*pPremise) != typeid(ksi::premise) or not pPremise->getTnorm())
+                return false;
+            if (typeid(*pPremise->getTnorm()) != typeid(ksi::t_norm_product))
+                return false;
+            if (r > 0 and pPremise->getNumberOfDescriptors() != nAttributes)
+                return false;
+            nAttributes = pPremise->getNumberOfDescriptors();
+
+            for (std::size_t a = 0; a < nAttributes; a++)
+                if (typeid(*pPremise->getDescriptor(a)) != typeid(ksi::descriptor_gaussian))
+                    return false;
+        }
+        return true;
+    }
+    CATCH;
+}
+
+ksi::bounded_activation::bounded_activation(const std::vector<const ksi::premise *> & premises,
+                                            const double threshold, const std::size_t top_k,
+                                            const bool indexed)
+: _margin (std::numeric_limits<double>::infinity()), _top_k (top_k)
+{
+    try
+    {
+        if (not is_representable(premises))
+            throw ksi::exception ("Premises cannot be represented with Gaussian descriptors and the product t-norm.");
+        if (not (threshold >= 0.0 and threshold <= 1.0))
+            throw ksi::exception ("The threshold of activation (" + std::to_string(threshold) + ") is not in [0, 1].");
+        if (threshold > 0.0)
+            _margin = -std::log(threshold);
+
+        _nRules = premises.size();
+        if (_nRules == 0)
+            return;
+        _nAttributes = premises[0]->getNumberOfDescriptors();
+
+        _centres.resize(_nRules * _nAttributes);
+        _scales.resize(_nRules * _nAttributes);
+        for (std::size_t r = 0; r < _nRules; r++)
+            for (std::size_t a = 0; a < _nAttributes; a++)
+            {
+                auto pDescriptor = premises[r]->getDescriptor(a);
+                double sigma = pDescriptor->getFuzzification();
+                if (sigma <= 0.0)
+                    sigma = 0.000'001; // as in descriptor_gaussian::getMembership
+                _centres[r * _nAttributes + a] = pDescriptor->getCoreMean();
+                _scales[r * _nAttributes + a] = 1.0 / (2.0 * sigma * sigma);
+            }
+
+        _order.resize(_nRules);
+        for (std::size_t r = 0; r < _nRules; r++)
+            _order[r] = r;
+        _indexed = indexed and _nAttributes > 0;
+        if (not _indexed)
+            return;
+
+        _leaf_offsets = { 0 };
+        build_index(0, _nRules);
+
+        // rules of a leaf are stored contiguously
+        std::vector<double> centres (_centres.size()), scales (_scales.size());
+        for (std::size_t i = 0; i < _nRules; i++)
+        {
+            std::copy_n(_centres.begin() + _order[i] * _nAttributes, _nAttributes, centres.begin() + i * _nAttributes);
+            std::copy_n(_scales.begin()  + _order[i] * _nAttributes, _nAttributes, scales.begin()  + i * _nAttributes);
+        }
+        _centres = std::move(centres);
+        _scales = std::move(scales);
+
+        const std::size_t nLeaves = _leaf_offsets.size() - 1;
+        _leaf_lower.assign(nLeaves * _nAttributes, std::numeric_limits<double>::infinity());
+        _leaf_upper.assign(nLeaves * _nAttributes, -std::numeric_limits<double>::infinity());
+        _leaf_scales.assign(nLeaves * _nAttributes, std::numeric_limits<double>::infinity());
+        for (std::size_t l = 0; l < nLeaves; l++)
+            for (std::size_t i = _leaf_offsets[l]; i < _leaf_offsets[l + 1]; i++)
+                for (std::size_t a = 0; a < _nAttributes; a++)
+                {
+                    _leaf_lower[l * _nAttributes + a]  = std::min(_leaf_lower[l * _nAttributes + a],  _centres[i * _nAttributes + a]);
+                    _leaf_upper[l * _nAttributes + a]  = std::max(_leaf_upper[l * _nAttributes + a],  _centres[i * _nAttributes + a]);
+                    _leaf_scales[l * _nAttributes + a] = std::min(_leaf_scales[l * _nAttributes + a], _scales[i * _nAttributes + a]);
+                }
+    }
+    CATCH;
+}
+
+std::size_t ksi::bounded_activation::get_number_of_rules() const
+{
+    return _nRules;
+}
+
+void ksi::bounded_activation::build_index(const std::size_t first, const std::size_t last)
+{
+    if (last - first <= LEAF_SIZE)
+    {
+        _leaf_offsets.push_back(last);
+        return;
+    }
+
+    // split at the median of the attribute with the largest range of centres
+    std::size_t attribute = 0;
+    double largest_range = -1;
+    for (std::size_t a = 0; a < _nAttributes; a++)
+    {
+        double lower = std::numeric_limits<double>::infinity();
+        double upper = -std::numeric_limits<double>::infinity();
+        for (std::size_t i = first; i < last; i++)
+        {
+            lower = std::min(lower, _centres[_order[i] * _nAttributes + a]);
+            upper = std::max(upper, _centres[_order[i] * _nAttributes + a]);
+        }
+        if (upper - lower > largest_range)
+        {
+            largest_range = upper - lower;
+            attribute = a;
+        }
+    }
+
+    const std::size_t middle = first + (last - first) / 2;
+    std::nth_element(_order.begin() + first, _order.begin() + middle, _order.begin() + last,
+                     [this, attribute] (const std::size_t left, const std::size_t right)
+    {
+        return _centres[left * _nAttributes + attribute] < _centres[right * _nAttributes + attribute];
+    });
+    build_index(first, middle);
+    build_index(middle, last);
+}
+
+ksi::bounded_activation::active_rules ksi::bounded_activation::activate(const std::vector<double> & x) const
+{
+    try
+    {
+        if (x.size() != _nAttributes)
+            throw ksi::exception ("Data vector size (" + std::to_string(x.size()) + ") and number of descriptors (" + std::to_string(_nAttributes) + ") do not match!");
+
+        active_rules result;
+        if (_nRules == 0)
+            return result;
+
+        // complete sums of exponents: (sum, rule)
+        std::vector<std::pair<double, std::size_t>> complete;
+        // lower bounds of sums of exponents of dropped rules
+        std::vector<double> dropped;
+        // the smallest complete sum
+        double best = std::numeric_limits<double>::infinity();
+        // the k smallest complete sums (the largest on the top)
+        std::priority_queue<double> strongest;
+
+        auto cutoff = [&] ()
+        {
+            double limit = best + _margin;
+            if (_top_k > 0 and strongest.size() == _top_k)
+                limit = std::min(limit, strongest.top());
+            return limit;
+        };
+
+        // i: index of a stored rule
+        auto elaborate = [&] (const std::size_t i)
+        {
+            const double limit = cutoff();
+            const double * centres = _centres.data() + i * _nAttributes;
+            const double * scales  = _scales.data()  + i * _nAttributes;
+            double sum = 0;
+            std::size_t a = 0;
+            while (a < _nAttributes)
+            {
+                const std::size_t last = std::min(a + BLOCK_SIZE, _nAttributes);
+                for (; a < last; a++)
+                {
+                    const double diff = x[a] - centres[a];
+                    sum += diff * diff * scales[a];
+                }
+                if (sum > limit) // partial sums never decrease
+                    break;
+            }
+            result.elaborated_memberships += a;
+
+            if (sum > limit)
+            {
+                dropped.push_back(sum);
+                return;
+            }
+            complete.emplace_back(sum, _order[i]);
+            best = std::min(best, sum);
+            if (_top_k > 0)
+            {
+                if (strongest.size() < _top_k)
+                    strongest.push(sum);
+                else if (sum < strongest.top())
+                {
+                    strongest.pop();
+                    strongest.push(sum);
+                }
+            }
+        };
+
+        // leaves skipped with the index: (lower bound of sums, number of rules)
+        std::vector<std::pair<double, std::size_t>> skipped;
+
+        if (_indexed)
+        {
+            const std::size_t nLeaves = _leaf_offsets.size() - 1;
+            std::vector<std::pair<double, std::size_t>> leaves (nLeaves);
+            for (std::size_t l = 0; l < nLeaves; l++)
+            {
+                const double * lower  = _leaf_lower.data()  + l * _nAttributes;
+                const double * upper  = _leaf_upper.data()  + l * _nAttributes;
+                const double * scales = _leaf_scales.data() + l * _nAttributes;
+                double bound = 0;
+                for (std::size_t a = 0; a < _nAttributes; a++)
+                {
+                    const double gap = std::max({ lower[a] - x[a], x[a] - upper[a], 0.0 });
+                    bound += gap * gap * scales[a];
+                }
+                leaves[l] = { bound, l };
+            }
+            std::sort(leaves.begin(), leaves.end());
+
+            for (std::size_t j = 0; j < nLeaves; j++)
+            {
+                const auto [bound, l] = leaves[j];
+                if (bound > cutoff())
+                {
+                    for (std::size_t k = j; k < nLeaves; k++)
+                        skipped.emplace_back(leaves[k].first, _leaf_offsets[leaves[k].second + 1] - _leaf_offsets[leaves[k].second]);
+                    break;
+                }
+                for (std::size_t i = _leaf_offsets[l]; i < _leaf_offsets[l + 1]; i++)
+                    elaborate(i);
+            }
+        }
+        else
+            for (std::size_t i = 0; i < _nRules; i++)
+                elaborate(i);
+
+        // Cutoffs only decreased, so rules completed earlier may exceed the final one.
+        if (_top_k > 0 and complete.size() > _top_k)
+        {
+            std::nth_element(complete.begin(), complete.begin() + _top_k, complete.end());
+            for (auto it = complete.begin() + _top_k; it != complete.end(); ++it)
+                dropped.push_back(it->first);
+            complete.resize(_top_k);
+        }
+        const double limit = best + _margin;
+        for (const auto & [sum, r] : complete)
+        {
+            if (sum > limit)
+                dropped.push_back(sum);
+            else
+            {
+                result.rules.push_back(r);
+                result.firing_strengths.push_back(std::exp(best - sum));
+            }
+        }
+
+        // Dropped rules are many: their bounds are elaborated with the fast exponent
+        // enlarged by its relative error.
+        for (const auto sum : dropped)
+            if (best - sum > MINIMAL_EXPONENT)
+                result.dropped_bound += ksi::fast_math::exp(best - sum);
+        for (const auto & [bound, count] : skipped)
+            if (best - bound > MINIMAL_EXPONENT)
+                result.dropped_bound += count * ksi::fast_math::exp(best - bound);
+        result.dropped_bound *= 1.0 + ksi::fast_math::EXP_MAX_RELATIVE_ERROR;
+
+        return result;
+    }
+    CATCH;
+}
+
+std::vector<ksi::bounded_activation::active_rules> ksi::bounded_activation::activate(const std::vector<std::vector<double>> & X) const
+{
+    try
+    {
+        for (const auto & x : X)
+            if (x.size() != _nAttributes)
+                throw ksi::exception ("Data vector size (" + std::to_string(x.size()) + ") and number of descriptors (" + std::to_string(_nAttributes) + ") do not match!");
+
+        const std::size_t nX = X.size();
+        std::vector<active_rules> result (nX);
+
+        #pragma omp parallel for
+        for (std::size_t i = 0; i < nX; i++)
+            result[i] = activate(X[i]);
+
+        return result;
+    }
+    CATCH;
+}
@@ -0,0 +1,115 @@
+/** @file */
+
+#ifndef BOUNDED_ACTIVATION_H
+#define BOUNDED_ACTIVATION_H
+
+#include <vector>
+
+#include "premise.h"
+
+namespace ksi
+{
+   /** Premises of all rules of a rulebase with Gaussian descriptors and the product t-norm
+       elaborated with bounded activation of rules.
+       The firing strength of a rule is the exponent of minus the sum of exponents
+       \f$ e_r = \sum_a s_{ra} (x_a - c_{ra})^2 \f$, \f$ s_{ra} = \frac{1}{2 \sigma_{ra}^2} \f$.
+       Partial sums never decrease, so a rule is dropped as soon as its partial sum
+       (compared after every few attributes) exceeds the cutoff: \f$ e_{best} - \ln \theta \f$ (the firing strength of the rule is lower than
+       \f$ \theta \f$ times the firing strength of the strongest rule elaborated so far)
+       or, for top-k selection, the k-th smallest sum elaborated so far.
+       Cutoffs never increase, so the active rules of a data item are exactly the rules
+       with \f$ F_r \ge \theta F_{best} \f$ (and among the k strongest ones)
+       whatever the order of elaboration of rules.
+
+       The rule-centre index is a k-d tree of centres of rules: the set of rules is split
+       recursively at the median of the attribute with the largest range of centres
+       into leaves of at most a few dozen rules. For each leaf the index holds the bounding box
+       of centres and the smallest scales of descriptors, so
+       \f$ \sum_a s_{min,a} \, \textrm{dist}(x_a, [l_a, u_a])^2 \f$ is a lower bound of
+       \f$ e_r \f$ of all rules of the leaf. Leaves are elaborated in the ascending order
+       of their bounds, so strong rules come first, and when the bound of a leaf exceeds
+       the cutoff, the leaf and all remaining leaves are skipped without elaboration.
+
+       For each data item the class reports an upper bound \f$ \bar{D} \f$ of the sum of firing
+       strengths of dropped rules (the exponent of minus a partial sum or a lower bound for each rule).
+       If \f$ S \f$ is the sum of firing strengths of active rules, the weighted average
+       of local outputs of rules differs from the exact one at most by
+       \f$ \frac{\bar{D}}{S} \max_r |y_r - y| \f$.
+       @date 2026-10-19 */
+   class bounded_activation
+   {
+   protected:
+      std::size_t _nRules = 0;
+      std::size_t _nAttributes = 0;
+      /** centres of descriptors of stored rules, rule major: _centres[i * _nAttributes + a] */
+      std::vector<double> _centres;
+      /** 1 / (2 sigma^2) of descriptors of stored rules, rule major */
+      std::vector<double> _scales;
+
+      /** -ln theta, infinity: no threshold */
+      double _margin;
+      /** number of selected strongest rules, 0: all rules */
+      std::size_t _top_k = 0;
+
+      /** true: rules are elaborated with the rule-centre index */
+      bool _indexed = false;
+      /** indices of rules in the order of storage (leaves of the index are contiguous) */
+      std::vector<std::size_t> _order;
+      /** leaf l holds stored rules [_leaf_offsets[l], _leaf_offsets[l + 1]) */
+      std::vector<std::size_t> _leaf_offsets;
+      /** bounding boxes of centres of leaves, leaf major: _leaf_lower[l * _nAttributes + a] */
+      std::vector<double> _leaf_lower;
+      std::vector<double> _leaf_upper;
+      /** the smallest scales of descriptors of rules of leaves, leaf major */
+      std::vector<double> _leaf_scales;
+
+      /** The method splits stored rules [first, last) into leaves of the index. */
+      void build_index (const std::size_t first, const std::size_t last);
+
+   public:
+      /** active rules of a data item */
+      struct active_rules
+      {
+         /** indices of active rules */
+         std::vector<std::size_t> rules;
+         /** firing strengths of active rules divided by the firing strength of the strongest rule */
+         std::vector<double> firing_strengths;
+         /** upper bound of the sum of (divided) firing strengths of dropped rules */
+         double dropped_bound = 0;
+         /** number of memberships of descriptors elaborated for the data item */
+         std::size_t elaborated_memberships = 0;
+      };
+
+      /** @param premises premises of rules
+          @param threshold rules with firing strengths lower than threshold times the strongest
+                 firing strength are dropped, from [0, 1], 0: no threshold
+          @param top_k number of the strongest rules selected, 0: all rules
+          @param indexed true: rules are elaborated with the rule-centre index
+          @throw ksi::exception if the premises cannot be represented
+                 (see ksi::bounded_activation::is_representable) or the threshold is not in [0, 1] */
+      bounded_activation (const std::vector<const premise *> & premises,
+                          const double threshold, const std::size_t top_k = 0,
+                          const bool indexed = true);
+
+      /** @return true if all premises are plain premises (ksi::premise, not eg. subspace premises 
+                  or prototypes), have only Gaussian descriptors, the same number
+                  of descriptors and the product t-norm
+          @param premises premises of rules */
+      static bool is_representable (const std::vector<const premise *> & premises);
+
+      /** @return number of rules */
+      std::size_t get_number_of_rules () const;
+
+      /** The method elaborates active rules for a data item.
+          @param x data item
+          @throw ksi::exception if sizes of the data item and premises do not match */
+      active_rules activate (const std::vector<double> & x) const;
+
+      /** The method elaborates active rules for data items in parallel.
+          @param X data items
+          @throw ksi::exception if sizes of data items and premises do not match */
+      std::vector<active_rules> activate (const std::vector<std::vector<double>> & X) const;
+   };
+}
+
+#endif
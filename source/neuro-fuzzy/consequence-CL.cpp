@@ -39,7 +39,7 @@ void ksi::consequence_CL::cummulate_differentials(std::vector< double > X,
                                            double firing
                                                  )
 {
-   sum_dE_dw += partial_differential; 
+   cummulate_dE_dw(partial_differential);
 }
 
 void ksi::consequence_CL::actualise_parameters(double eta)
@@ -51,6 +51,17 @@ namespace ksi
                                            double secundary_partial_differential,
                                            double firing
                                           );
+      
+      /** The method cummulates the differential for the support width.
+       * It does the same as cummulate_differentials, but it is not virtual
+       * and does not copy the data item (used by ksi::rule_kernel).
+       @param partial_differential some differentials from other rules
+       @date 2026-10-18
+       */
+      void cummulate_dE_dw (double partial_differential)
+      {
+         sum_dE_dw += partial_differential;
+      }
 
       /** The method actualises values of parameters of the fuzzy consequence.
        * The method actualises the support width only.
@@ -51,13 +51,12 @@ ksi::consequence_TSK::getLocalisationWeight (const std::vector< double >& X, dou
    }
    
    //-------------------------
-   std::vector<double> X1 (X);
-   X1.push_back(1.0); 
-   
+   // X is augmented with 1.0 implicitly: the last parameter is the free one.
    double sum_prod = 0.0;
-   std::size_t size = X1.size();
+   std::size_t size = X.size();
    for (std::size_t i = 0; i < size; i++)
-      sum_prod += (X1[i] * _params[i]);
+      sum_prod += (X[i] * _params[i]);
+   sum_prod += _params[size];
    
    return last_localisationWeight = { sum_prod, firing };
 } 
@@ -82,6 +81,11 @@ ksi::consequence * ksi::consequence_TSK::clone() const
 }
 
 
+const std::vector<double> & ksi::consequence_TSK::get_parameters() const
+{
+   return _params;
+}
+
 void ksi::consequence_TSK::setLinearParameters(std::vector< double >& coefficients)
 {
    this->_params = coefficients;
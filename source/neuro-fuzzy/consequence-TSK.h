@@ -38,6 +38,10 @@ namespace ksi
       
       virtual consequence * clone () const;
       
+      /** @return linear coefficients of the consequence, the last item is a free parameter 
+          @date 2026-10-18 */
+      const std::vector<double> & get_parameters () const;
+      
       /** The method sets linear parameters in the rule. 
        * @param coefficients a vector of coefficients to set.
        */
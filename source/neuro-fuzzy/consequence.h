@@ -8,6 +8,7 @@
 #include <iostream>
 
 #include "../common/DatasetStatistics.h"
+#include "../auxiliary/object_pool.h"
 
 namespace ksi
 {
@@ -21,6 +22,11 @@ namespace ksi
       
       
       virtual ~consequence();
+      
+      /** Consequences are allocated in ksi::object_pool.
+       *  @date 2026-10-19 */
+      static void * operator new (std::size_t size) { return ksi::object_pool::allocate(size); }
+      static void operator delete (void * p, std::size_t size) { ksi::object_pool::deallocate(p, size); }
       /** @return pair: localisation and weight  
        */
       virtual std::pair<double, double> 
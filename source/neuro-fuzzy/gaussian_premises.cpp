@@ -0,0 +1,129 @@
+/** @file */
+
+#include <vector>
+#include <cmath>
+#include <string>
+#include <limits>
+#include <typeinfo>
+#include <algorithm>
+
+#include "../neuro-fuzzy/gaussian_premises.h"
+#include "../descriptors/descriptor-gaussian.h"
+#include "../auxiliary/fast_math.h"
+#include "../tnorms/t-norm-product.h"
+#include "../tnorms/t-norm-min.h"
+#include "../service/debug.h"
+
+bool ksi::gaussian_premises::is_representable(const std::vector<const ksi::premise *> & premises)
+{
+    try
+    {
+        const std::type_info * pTnormType = nullptr;
+        std::size_t nAttributes = 0;
+        for (const auto pPremise : premises)
+        {
+            if (not pPremise or typeid(*pPremise) != typeid(ksi::premise) or not pPremise->getTnorm())
+                return false;
+            const auto & type = typeid(*pPremise->getTnorm());
+            if (type != typeid(ksi::t_norm_product) and type != typeid(ksi::t_norm_min))
+                return false;
+            if (pTnormType and type != *pTnormType)
+                return false;
+            if (pTnormType and pPremise->getNumberOfDescriptors() != nAttributes)
+                return false;
+            pTnormType = & type;
+            nAttributes = pPremise->getNumberOfDescriptors();
+
+            for (std::size_t a = 0; a < nAttributes; a++)
+                if (typeid(*pPremise->getDescriptor(a)) != typeid(ksi::descriptor_gaussian))
+                    return false;
+        }
+        return true;
+    }
+    CATCH;
+}
+
+ksi::gaussian_premises::gaussian_premises(const std::vector<const ksi::premise *> & premises)
+{
+    try
+    {
+        if (not is_representable(premises))
+            throw ksi::exception ("Premises cannot be represented with Gaussian descriptors and a product or minimum t-norm.");
+
+        _nRules = premises.size();
+        if (_nRules == 0)
+            return;
+        _nAttributes = premises[0]->getNumberOfDescriptors();
+        _minimum = typeid(*premises[0]->getTnorm()) == typeid(ksi::t_norm_min);
+
+        _centres.resize(_nAttributes * _nRules);
+        _scales.resize(_nAttributes * _nRules);
+        for (std::size_t r = 0; r < _nRules; r++)
+            for (std::size_t a = 0; a < _nAttributes; a++)
+            {
+                auto pDescriptor = premises[r]->getDescriptor(a);
+                double sigma = pDescriptor->getFuzzification();
+                if (sigma <= 0.0)
+                    sigma = 0.000'001; // as in descriptor_gaussian::getMembership
+                _centres[a * _nRules + r] = pDescriptor->getCoreMean();
+                _scales[a * _nRules + r] = 1.0 / (2.0 * sigma * sigma);
+            }
+    }
+    CATCH;
+}
+
+std::size_t ksi::gaussian_premises::get_number_of_rules() const
+{
+    return _nRules;
+}
+
+std::vector<float> ksi::gaussian_premises::firing_strengths(const std::vector<std::vector<double>> & X, const bool fast_math) const
+{
+    try
+    {
+        const std::size_t nX = X.size();
+        for (const auto & x : X)
+            if (x.size() != _nAttributes)
+                throw ksi::exception ("Data vector size (" + std::to_string(x.size()) + ") and number of descriptors (" + std::to_string(_nAttributes) + ") do not match!");
+
+        std::vector<float> result (nX * _nRules);
+
+        #pragma omp parallel for
+        for (std::size_t x = 0; x < nX; x++)
+        {
+            // exponents: -ln F for each rule
+            float * exponents = result.data() + x * _nRules;
+            std::fill(exponents, exponents + _nRules, 0.0f);
+            for (std::size_t a = 0; a < _nAttributes; a++)
+            {
+                const float value = X[x][a];
+                const float * centres = _centres.data() + a * _nRules;
+                const float * scales  = _scales.data()  + a * _nRules;
+                if (_minimum)
+                    for (std::size_t r = 0; r < _nRules; r++)
+                    {
+                        const float diff = value - centres[r];
+                        exponents[r] = std::max(exponents[r], diff * diff * scales[r]);
+                    }
+                else
+                    for (std::size_t r = 0; r < _nRules; r++)
+                    {
+                        const float diff = value - centres[r];
+                        exponents[r] += diff * diff * scales[r];
+                    }
+            }
+
+            float smallest = std::numeric_limits<float>::infinity();
+            for (std::size_t r = 0; r < _nRules; r++)
+                smallest = std::min(smallest, exponents[r]);
+            if (fast_math)
+                for (std::size_t r = 0; r < _nRules; r++)
+                    exponents[r] = ksi::fast_math::exp(smallest - exponents[r]);
+            else
+                for (std::size_t r = 0; r < _nRules; r++)
+                    exponents[r] = std::exp(smallest - exponents[r]);
+        }
+        return result;
+    }
+    CATCH;
+}
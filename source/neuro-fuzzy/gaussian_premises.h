@@ -0,0 +1,59 @@
+/** @file */
+
+#ifndef GAUSSIAN_PREMISES_H
+#define GAUSSIAN_PREMISES_H
+
+#include <vector>
+
+#include "premise.h"
+
+namespace ksi
+{
+   /** Premises of all rules of a rulebase with Gaussian descriptors
+       stored in contiguous single precision matrices.
+       The class elaborates firing strengths of all rules for a batch of data items.
+       For the product t-norm the firing strength is the exponent of the sum
+       of exponents of memberships, for the minimum t-norm -- of their minimum,
+       so only one exponent is elaborated for a rule and a data item.
+       Firing strengths of a data item are divided by the firing strength
+       of its strongest rule, so they do not underflow in float.
+       The factor cancels in the weighted average of local outputs of rules.
+       @date 2026-10-18 */
+   class gaussian_premises
+   {
+   protected:
+      std::size_t _nRules = 0;
+      std::size_t _nAttributes = 0;
+      /** true for the minimum t-norm, false for the product t-norm */
+      bool _minimum = false;
+      /** centres of descriptors, attribute major: _centres[a * _nRules + r] */
+      std::vector<float> _centres;
+      /** 1 / (2 sigma^2) of descriptors, attribute major */
+      std::vector<float> _scales;
+
+   public:
+      /** @param premises premises of rules
+          @throw ksi::exception if the premises cannot be represented
+                 (see ksi::gaussian_premises::is_representable) */
+      gaussian_premises (const std::vector<const premise *> & premises);
+
+      /** @return true if all premises are plain premises (ksi::premise, not eg. subspace premises 
+                  or prototypes), have only Gaussian descriptors, the same number
+                  of descriptors and the same t-norm (product or minimum)
+          @param premises premises of rules */
+      static bool is_representable (const std::vector<const premise *> & premises);
+
+      /** @return number of rules */
+      std::size_t get_number_of_rules () const;
+
+      /** The method elaborates firing strengths of rules for data items in single precision.
+          @param X data items
+          @param fast_math true: exponents are elaborated with ksi::fast_math::exp
+          @return firing strengths scaled for each data item, so that the strongest rule
+                  has 1, row major: [x * number_of_rules + r]
+          @throw ksi::exception if sizes of data items and premises do not match */
+      std::vector<float> firing_strengths (const std::vector<std::vector<double>> & X, const bool fast_math = false) const;
+   };
+}
+
+#endif
@@ -22,6 +22,7 @@
 #include "../auxiliary/confusion-matrix.h"
 #include "../auxiliary/error-RMSE.h"
 #include "../auxiliary/error-MAE.h"
+#include "../auxiliary/random_service.h"
 
 
 
@@ -153,21 +154,37 @@ ksi::dataset ksi::granular_nfs_regression::generate_dataset_from_granules(
         for (int i = 0; i < diff; i++)
             integer_cardinalities[i % number_of_granules]++;
         
-        // creation of data examples
-        for (int g = 0; g < number_of_granules; g++)
+        // creation of data examples:
+        // each granule draws its items from its own substream, so items can be sampled in parallel
+        // and do not depend on the order of granules
+        std::vector<ksi::granule *> clones (number_of_granules);
+        std::vector<std::vector<ksi::datum>> items (number_of_granules);
+        const auto stream = ksi::random_service::next_stream();
+        
+        #pragma omp parallel for
+        for (std::size_t g = 0; g < number_of_granules; g++)
         {
+            clones[g] = (pGranules->getGranule(g))->clone_granule();
+            auto granule_stream = stream.split(g);
+            auto engine = ksi::random_service::make_engine(granule_stream);
+            
             int max_card = integer_cardinalities[g];
+            items[g].reserve(max_card);
             for (int card = 0; card < max_card; card++)
+                items[g].push_back(clones[g]->get_data_item(engine));
+        }
+        
+        // answers are elaborated serially: get_answer modifies the set of granules
+        for (std::size_t g = 0; g < number_of_granules; g++)
+        {
+            for (auto & d : items[g])
             {
-                ksi::granule * p = (pGranules->getGranule(g))->clone_granule();
-                auto d = p->get_data_item();
-                double answer = pGranules->get_answer(d, p).getValue();
-                delete p;
-      
+                double answer = pGranules->get_answer(d, clones[g]).getValue();
                 d.push_back(answer); // decision attribute  
                 d.setDecision(answer); // decision attribute
                 train.addDatum(d);
             }
+            delete clones[g];
         }
         
         delete pGranules;
@@ -67,6 +67,11 @@ ksi::logicalrule::~logicalrule()
    pImplication = nullptr;
 }
 
+const ksi::implication * ksi::logicalrule::getImplication() const
+{
+   return pImplication;
+}
+
 ksi::rule * ksi::logicalrule::clone() const
 {
    return new logicalrule(*this);
@@ -30,6 +30,10 @@ namespace ksi
       logicalrule & operator = (const logicalrule &);
       logicalrule & operator = (logicalrule &&);
       
+      /** @return a pointer to the implication of the rule (nullptr if no implication) 
+       * @date 2026-10-18 */
+      const implication * getImplication () const;
+      
       /** The method returns localisation and weight of an answer for an X data item
        * @param X data item to elaborate answer for
        * @return a pair: first is localisation, second is weight
@@ -4,17 +4,24 @@
 #include <cmath>
 #include <deque>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
 // #include <syncstream>
 #include <tuple>
+#include <typeinfo>
+#include <vector>
 
 #include "../auxiliary/clock.h"
+#include "../auxiliary/profiler.h"
 #include "../auxiliary/confusion-matrix.h"
 #include "../auxiliary/directory.h"
 #include "../auxiliary/error-MAE.h"
 #include "../auxiliary/error-RMSE.h"
+#include "../auxiliary/evaluation_accumulator.h"
 #include "../auxiliary/roc.h"
 #include "../auxiliary/tempus.h"
 #include "../common/data-modifier-normaliser.h"
@@ -24,8 +31,19 @@
 #include "../gan/generative_model.h"
 #include "../neuro-fuzzy/neuro-fuzzy-system.h"
 #include "../neuro-fuzzy/rulebase.h" 
+#include "../neuro-fuzzy/rule.h"
+#include "../neuro-fuzzy/logicalrule.h"
+#include "../neuro-fuzzy/premise.h"
+#include "../neuro-fuzzy/consequence-TSK.h"
+#include "../neuro-fuzzy/bounded_activation.h"
+#include "../descriptors/descriptor-gaussian.h"
+#include "../auxiliary/least-error-squares-regression.h"
+#include "../partitions/fcm.h"
+#include "../partitions/fcm-T.h"
 #include "../readers/reader-complete.h"
+#include "../readers/data_stream.h"
 // #include "../service/debug.h"
+#include "../service/exception.h"
 
 
 
@@ -103,10 +121,10 @@ void ksi::neuro_fuzzy_system::elaborate_answers_for_regression (
          wYtrainElaborated.push_back(elaborate_answer(*(XYtrain.first.getDatum(i))).getValue());
       }
          
-      ksi::error_RMSE rmse; 
-      double blad_rmse_train = rmse.getError(wYtrainElaborated, wYtrainExpected);
-      ksi::error_MAE mae;
-      double blad_mae_train  = mae.getError(wYtrainElaborated, wYtrainExpected);
+      ksi::evaluation_accumulator evaluation;
+      evaluation.add(wYtrainExpected, wYtrainElaborated);
+      double blad_rmse_train = evaluation.RMSE();
+      double blad_mae_train  = evaluation.MAE();
      
       std::ofstream model (outputFile);
       
@@ -152,6 +170,12 @@ void ksi::neuro_fuzzy_system::set_rulebase(const ksi::rulebase & rb)
     _pRulebase = rb.clone();
 }
 
+void ksi::neuro_fuzzy_system::set_partitioner(const ksi::partitioner & p)
+{
+    delete _pPartitioner;
+    _pPartitioner = p.clone();
+}
+
 ksi::neuro_fuzzy_system::neuro_fuzzy_system (int nRules, 
                                              int nClusteringIterations, 
                                              int nTuningIterations, 
@@ -433,6 +457,17 @@ void ksi::neuro_fuzzy_system::copy_fields(const ksi::neuro_fuzzy_system & wzor)
    
    _original_size_of_training_dataset = wzor._original_size_of_training_dataset;
    _reduced_size_of_training_dataset = wzor._reduced_size_of_training_dataset;
+   
+   _pOnlineRegression = wzor._pOnlineRegression ? std::make_shared<ksi::least_square_error_regression>(*wzor._pOnlineRegression) : nullptr;
+   _online_forgetting_factor = wzor._online_forgetting_factor;
+   _online_premise_learning_coefficient = wzor._online_premise_learning_coefficient;
+   _online_minimal_coverage = wzor._online_minimal_coverage;
+   _online_maximal_number_of_rules = wzor._online_maximal_number_of_rules;
+   _precision = wzor._precision;
+   _fast_math = wzor._fast_math;
+   _activation_threshold = wzor._activation_threshold;
+   _activation_top_k = wzor._activation_top_k;
+   _activation_indexed = wzor._activation_indexed;
 }
 
 ksi::result ksi::neuro_fuzzy_system::experiment_classification_core()
@@ -625,6 +660,501 @@ double ksi::neuro_fuzzy_system::get_number_of_rules() const
 }
 
 
+int ksi::neuro_fuzzy_system::get_number_of_clustering_iterations() const
+{
+    return _nClusteringIterations;
+}
+
+int ksi::neuro_fuzzy_system::get_number_of_tuning_iterations() const
+{
+    return _nTuningIterations;
+}
+
+double ksi::neuro_fuzzy_system::get_learning_coefficient() const
+{
+    return _dbLearningCoefficient;
+}
+
+void ksi::neuro_fuzzy_system::set_precision(const ksi::precision accuracy)
+{
+    try
+    {
+        if (accuracy == ksi::precision::single_precision and get_bounded_activation())
+            throw ksi::exception ("Bounded activation of rules is elaborated only in double precision.");
+        _precision = accuracy;
+        
+        // Only the plain FCM has its single precision counterpart.
+        if (not _pPartitioner or _pPartitioner->get_number_of_iterations() < 1)
+            return;
+        const int nClusters = _pPartitioner->get_number_of_clusters();
+        const int nIterations = _pPartitioner->get_number_of_iterations();
+        
+        ksi::partitioner * pReplacement = nullptr;
+        if (accuracy == ksi::precision::single_precision and typeid(*_pPartitioner) == typeid(ksi::fcm))
+            pReplacement = new ksi::fcm_T<float> (nClusters, nIterations);
+        else if (accuracy == ksi::precision::double_precision and typeid(*_pPartitioner) == typeid(ksi::fcm_T<float>))
+            pReplacement = new ksi::fcm (nClusters, nIterations);
+        
+        if (pReplacement)
+        {
+            delete _pPartitioner;
+            _pPartitioner = pReplacement;
+        }
+    }
+    CATCH;
+}
+
+ksi::precision ksi::neuro_fuzzy_system::get_precision() const
+{
+    return _precision;
+}
+
+void ksi::neuro_fuzzy_system::set_fast_math(const bool fast_math)
+{
+    try
+    {
+        if (fast_math and get_bounded_activation())
+            throw ksi::exception ("Bounded activation of rules is elaborated only with exact functions.");
+        _fast_math = fast_math;
+    }
+    CATCH;
+}
+
+bool ksi::neuro_fuzzy_system::get_fast_math() const
+{
+    return _fast_math;
+}
+
+void ksi::neuro_fuzzy_system::set_bounded_activation(const double threshold, const std::size_t top_k, const bool indexed)
+{
+    try
+    {
+        if (not (threshold >= 0.0 and threshold <= 1.0))
+            throw ksi::exception ("The threshold of activation (" + std::to_string(threshold) + ") is not in [0, 1].");
+        if ((threshold > 0.0 or top_k > 0) and (_precision == ksi::precision::single_precision or _fast_math))
+            throw ksi::exception ("Bounded activation of rules is elaborated only in double precision with exact functions.");
+        _activation_threshold = threshold;
+        _activation_top_k = top_k;
+        _activation_indexed = indexed;
+    }
+    CATCH;
+}
+
+bool ksi::neuro_fuzzy_system::get_bounded_activation() const
+{
+    return _activation_threshold > 0.0 or _activation_top_k > 0;
+}
+
+void ksi::neuro_fuzzy_system::set_online_learning(const double forgetting_factor,
+                                                  const double premise_learning_coefficient,
+                                                  const double minimal_coverage,
+                                                  const int maximal_number_of_rules)
+{
+    try 
+    {
+        if (not (forgetting_factor > 0.0 and forgetting_factor <= 1.0))
+            throw ksi::exception ("The forgetting factor (" + std::to_string(forgetting_factor) + ") should be in (0, 1].");
+        if (premise_learning_coefficient < 0.0)
+            throw ksi::exception ("The learning coefficient for premises (" + std::to_string(premise_learning_coefficient) + ") cannot be negative.");
+        
+        _online_forgetting_factor = forgetting_factor;
+        _online_premise_learning_coefficient = premise_learning_coefficient;
+        _online_minimal_coverage = minimal_coverage;
+        _online_maximal_number_of_rules = maximal_number_of_rules;
+        
+        if (_pOnlineRegression)
+            _pOnlineRegression->set_forgetting_factor(forgetting_factor);
+    }
+    CATCH;
+}
+
+bool ksi::neuro_fuzzy_system::has_linear_consequences(const std::size_t nAttr_1) const
+{
+    if (not _pRulebase or _pRulebase->getNumberOfRules() == 0)
+        return false;
+    
+    for (std::size_t r = 0; r < _pRulebase->getNumberOfRules(); r++)
+    {
+        auto pTSK = dynamic_cast<const ksi::consequence_TSK *>((*_pRulebase)[r].getConsequence());
+        if (not pTSK or pTSK->get_parameters().size() != nAttr_1 + 1)
+            return false;
+    }
+    return true;
+}
+
+bool ksi::neuro_fuzzy_system::spawn_rule(const std::vector<double> & X, const std::size_t closest)
+{
+    try 
+    {
+        const ksi::rule & wzor = (*_pRulebase)[closest];
+        auto pPremise = wzor.getPremise();
+        if (not pPremise or typeid(*pPremise) != typeid(ksi::premise) or pPremise->getNumberOfDescriptors() != X.size())
+            return false;
+        
+        // the new rule has the widths of the closest rule, but it is centred at the data item
+        ksi::premise przeslanka;
+        for (std::size_t a = 0; a < X.size(); a++)
+        {
+            auto pGaussian = dynamic_cast<const ksi::descriptor_gaussian *>(pPremise->getDescriptor(a));
+            if (not pGaussian)
+                return false;
+            przeslanka.addDescriptor(new ksi::descriptor_gaussian (X[a], pGaussian->getFuzzification()));
+        }
+        
+        std::unique_ptr<ksi::rule> pRegula (wzor.clone());
+        pRegula->setPremise(przeslanka);
+        _pRulebase->addRule(*pRegula);
+        _nRules = _pRulebase->getNumberOfRules();
+        
+        // the consequence is copied from the closest rule, its estimation starts with no knowledge
+        auto pTSK = dynamic_cast<const ksi::consequence_TSK *>(wzor.getConsequence());
+        _pOnlineRegression->add_coefficients(pTSK->get_parameters());
+        
+        return true;
+    }
+    CATCH;
+}
+
+void ksi::neuro_fuzzy_system::merge_closest_rules()
+{
+    try 
+    {
+        const std::size_t nRules = _pRulebase->getNumberOfRules();
+        
+        // cores and fuzzifications of descriptors of rules with Gaussian premises
+        std::vector<std::vector<double>> cores (nRules), widths (nRules);
+        for (std::size_t r = 0; r < nRules; r++)
+        {
+            auto pPremise = (*_pRulebase)[r].getPremise();
+            if (not pPremise or typeid(*pPremise) != typeid(ksi::premise))
+                continue;
+            for (std::size_t a = 0; a < pPremise->getNumberOfDescriptors(); a++)
+            {
+                auto pGaussian = dynamic_cast<const ksi::descriptor_gaussian *>(pPremise->getDescriptor(a));
+                if (not pGaussian)
+                {
+                    cores[r].clear();
+                    widths[r].clear();
+                    break;
+                }
+                cores[r].push_back(pGaussian->getCoreMean());
+                widths[r].push_back(pGaussian->getFuzzification());
+            }
+        }
+        
+        double minimal_distance = std::numeric_limits<double>::max();
+        std::size_t left = 0, right = 0;
+        for (std::size_t i = 0; i < nRules; i++)
+        {
+            for (std::size_t j = i + 1; j < nRules; j++)
+            {
+                if (cores[i].empty() or cores[i].size() != cores[j].size())
+                    continue;
+                double distance = 0.0;
+                for (std::size_t a = 0; a < cores[i].size(); a++)
+                {
+                    double diff = (cores[i][a] - cores[j][a]) / (widths[i][a] + widths[j][a]);
+                    distance += diff * diff;
+                }
+                if (distance < minimal_distance)
+                {
+                    minimal_distance = distance;
+                    left = i;
+                    right = j;
+                }
+            }
+        }
+        if (left == right)
+            return; // no rules to merge
+        
+        // the merged rule: averaged premises and consequences
+        ksi::premise przeslanka;
+        for (std::size_t a = 0; a < cores[left].size(); a++)
+            przeslanka.addDescriptor(new ksi::descriptor_gaussian ((cores[left][a] + cores[right][a]) / 2.0, (widths[left][a] + widths[right][a]) / 2.0));
+        
+        auto coefficients = _pOnlineRegression->get_regression_coefficients();
+        const std::size_t nParams = coefficients.size() / nRules;
+        std::vector<double> merged (nParams);
+        for (std::size_t p = 0; p < nParams; p++)
+            merged[p] = (coefficients[left * nParams + p] + coefficients[right * nParams + p]) / 2.0;
+        std::copy(merged.begin(), merged.end(), coefficients.begin() + left * nParams);
+        
+        std::unique_ptr<ksi::consequence> pKonkluzja ((*_pRulebase)[left].getConsequence()->clone());
+        dynamic_cast<ksi::consequence_TSK &>(*pKonkluzja).setLinearParameters(merged);
+        
+        (*_pRulebase)[left].setPremise(przeslanka);
+        (*_pRulebase)[left].setConsequence(*pKonkluzja);
+        _pRulebase->removeRule(right);
+        _nRules = _pRulebase->getNumberOfRules();
+        
+        _pOnlineRegression->set_regression_coefficients(coefficients);
+        _pOnlineRegression->remove_coefficients(right * nParams, nParams);
+    }
+    CATCH;
+}
+
+void ksi::neuro_fuzzy_system::partial_fit(const ksi::dataset & batch)
+{
+    try 
+    {
+        const std::size_t nX = batch.getNumberOfData();
+        if (nX == 0)
+            return;
+        
+        const std::size_t nAttr = batch.getNumberOfAttributes();
+        const std::size_t nAttr_1 = nAttr - 1;
+        const std::size_t nParams = nAttr_1 + 1;
+        
+        bool created = false;
+        if (not has_linear_consequences(nAttr_1))
+        {
+            // no model yet: the first batch creates it
+            createFuzzyRulebase(_nClusteringIterations, _nTuningIterations, _dbLearningCoefficient, batch, batch);
+            _pOnlineRegression = nullptr;
+            if (not has_linear_consequences(nAttr_1))
+                throw ksi::exception ("Online learning requires rules with linear (TSK) consequences.");
+            created = true;
+        }
+        
+        // weights of logical rules do not vanish far from their premises, 
+        // so each item would update all consequences (and forget the earlier ones)
+        for (std::size_t r = 0; r < _pRulebase->getNumberOfRules(); r++)
+            if (dynamic_cast<const ksi::logicalrule *>(&(*_pRulebase)[r]))
+                throw ksi::exception ("Online learning is not available for systems with logical rules (" + get_nfs_name() + ").");
+        if (created)
+            return;
+        
+        // the state of estimation is (re)started from the current consequences, 
+        // if the rulebase has been created or modified outside online learning
+        std::size_t nRules = _pRulebase->getNumberOfRules();
+        if (not _pOnlineRegression or _pOnlineRegression->get_number_of_coefficients() != nRules * nParams)
+        {
+            std::vector<double> coefficients;
+            for (std::size_t r = 0; r < nRules; r++)
+            {
+                const auto & params = dynamic_cast<const ksi::consequence_TSK *>((*_pRulebase)[r].getConsequence())->get_parameters();
+                coefficients.insert(coefficients.end(), params.begin(), params.end());
+            }
+            _pOnlineRegression = std::make_shared<ksi::least_square_error_regression>(nRules * nParams, _online_forgetting_factor);
+            _pOnlineRegression->set_regression_coefficients(coefficients);
+        }
+        
+        auto XY = batch.splitDataSetVertically(nAttr_1);
+        auto wX = XY.first.getMatrix();
+        auto wY = XY.second.getMatrix();
+        
+        for (std::size_t x = 0; x < nX; x++)
+        {
+            if (_online_minimal_coverage > 0.0)
+            {
+                // coverage of the data item by rules
+                double coverage = -1.0;
+                std::size_t closest = 0;
+                for (std::size_t r = 0; r < _pRulebase->getNumberOfRules(); r++)
+                {
+                    double F = (*_pRulebase)[r].getFiringStrength(wX[x]);
+                    if (F > coverage)
+                    {
+                        coverage = F;
+                        closest = r;
+                    }
+                }
+                if (coverage < _online_minimal_coverage and spawn_rule(wX[x], closest))
+                {
+                    if (_online_maximal_number_of_rules > 0 and _pRulebase->getNumberOfRules() > (std::size_t) _online_maximal_number_of_rules)
+                        merge_closest_rules();
+                }
+            }
+            
+            // normalised weights of rules are coefficients of the linear model
+            _pRulebase->answer(wX[x]);
+            auto localisation_weight = _pRulebase->get_last_rules_localisations_weights();
+            double sum = 0.0;
+            for (auto & lw : localisation_weight)
+                sum += lw.second;
+            if (sum == 0.0)
+                continue;
+            
+            std::vector<double> linia (localisation_weight.size() * nParams);
+            std::size_t index = 0;
+            for (auto & lw : localisation_weight)
+            {
+                auto S = lw.second / sum;
+                for (std::size_t a = 0; a < nAttr_1; a++)
+                    linia[index++] = S * wX[x][a];
+                linia[index++] = S;
+            }
+            _pOnlineRegression->read_data_item(linia, wY[x][0]);
+        }
+        
+        // estimated coefficients are written into consequences
+        auto coefficients = _pOnlineRegression->get_regression_coefficients();
+        for (std::size_t r = 0; r < _pRulebase->getNumberOfRules(); r++)
+        {
+            std::vector<double> params (coefficients.begin() + r * nParams, coefficients.begin() + (r + 1) * nParams);
+            std::unique_ptr<ksi::consequence> pKonkluzja ((*_pRulebase)[r].getConsequence()->clone());
+            dynamic_cast<ksi::consequence_TSK &>(*pKonkluzja).setLinearParameters(params);
+            (*_pRulebase)[r].setConsequence(*pKonkluzja);
+        }
+        
+        // one gradient step for premises
+        if (_online_premise_learning_coefficient > 0.0)
+        {
+            _pRulebase->reset_differentials();
+            for (std::size_t x = 0; x < nX; x++)
+                _pRulebase->cummulate_differentials(wX[x], wY[x][0]);
+            _pRulebase->actualise_parameters(_online_premise_learning_coefficient);
+        }
+    }
+    CATCH;
+}
+
+void ksi::neuro_fuzzy_system::train_out_of_core(const std::string & train_file, 
+                                                const std::size_t chunk_size, 
+                                                const std::size_t sample_size)
+{
+    try 
+    {
+        if (sample_size == 0)
+            throw ksi::exception ("The size of the sample for clustering is zero.");
+        
+        const int nTuningIterations = _nTuningIterations;
+        ksi::data_stream stream (train_file, chunk_size);
+        
+        ksi::dataset sample;
+        {
+            ksi::scoped_timer timer ("out of core: sample");
+            sample = stream.sample(sample_size);
+        }
+        if (sample.getNumberOfData() == 0)
+            throw ksi::exception ("No data items in the file <" + train_file + ">.");
+        {
+            ksi::scoped_timer timer ("createFuzzyRulebase", sample.getNumberOfData());
+            createFuzzyRulebase(_nClusteringIterations, 0, _dbLearningCoefficient, sample, sample);
+        }
+        _nTuningIterations = nTuningIterations;
+        
+        tune_out_of_core(stream, _nTuningIterations, _dbLearningCoefficient);
+        _original_size_of_training_dataset = stream.get_number_of_data();
+        _pOnlineRegression = nullptr;
+    }
+    CATCH;
+}
+
+void ksi::neuro_fuzzy_system::tune_out_of_core(ksi::data_stream &, const int, const double)
+{
+    try 
+    {
+        throw ksi::exception ("Out-of-core training is not implemented for " + get_nfs_name() + ".");
+    }
+    CATCH;
+}
+
+void ksi::neuro_fuzzy_system::tune_rulebase_out_of_core(ksi::data_stream & stream, 
+                                                        const int nTuningIterations, 
+                                                        const double eta,
+                                                        const std::function<ksi::consequence * (const std::vector<double> &)> & make_consequence)
+{
+    try 
+    {
+        if (not _pRulebase)
+            throw ksi::exception ("The system has no rulebase.");
+        
+        const std::size_t nRules = _pRulebase->getNumberOfRules();
+        const std::size_t nAttr_1 = stream.get_number_of_attributes() - 1;
+        const std::size_t nParams = nAttr_1 + 1;
+        
+        // least squares statistics accumulated in a gradient epoch for the next epoch
+        std::unique_ptr<ksi::least_square_error_regression> pLser;
+        
+        for (int i = 0; i < nTuningIterations; i++)
+        {
+            if (make_consequence and i % 2 == 1)
+            {
+                ksi::scoped_timer timer ("tuning: least squares epoch (out of core)");
+                auto p = pLser->get_regression_coefficients();
+                for (std::size_t r = 0; r < nRules; r++)
+                {
+                    std::vector<double> coeff (p.begin() + r * nParams, p.begin() + (r + 1) * nParams);
+                    std::unique_ptr<ksi::consequence> pKonkluzja (make_consequence(coeff));
+                    (*_pRulebase)[r].setConsequence(*pKonkluzja);
+                }
+                pLser.reset();
+                continue;
+            }
+            
+            ksi::scoped_timer timer ("tuning: gradient epoch (out of core)");
+            const bool least_squares = make_consequence and i + 1 < nTuningIterations;
+            if (least_squares)
+                pLser = std::make_unique<ksi::least_square_error_regression>(nParams * nRules);
+            
+            std::vector<double> linia (nParams * nRules);
+            _pRulebase->reset_differentials();
+            stream.rewind();
+            ksi::data_stream::chunk chunk;
+            while (stream.next(chunk))
+            {
+                for (std::size_t x = 0; x < chunk.Y.size(); x++)
+                {
+                    const auto & X = chunk.X[x];
+                    _pRulebase->answer(X);
+                    if (least_squares)
+                    {
+                        auto localisation_weight = _pRulebase->get_last_rules_localisations_weights();
+                        double sum = 0.0;
+                        for (auto & lw : localisation_weight)
+                            sum += lw.second;
+                        
+                        // an item that fires no rule adds a zero row
+                        std::size_t index = 0;
+                        for (auto & lw : localisation_weight)
+                        {
+                            auto S = sum != 0.0 ? lw.second / sum : 0.0;
+                            for (std::size_t a = 0; a < nAttr_1; a++)
+                                linia[index++] = S * X[a];
+                            linia[index++] = S;
+                        }
+                        pLser->read_data_item(linia, chunk.Y[x]);
+                    }
+                    _pRulebase->cummulate_differentials(X, chunk.Y[x]);
+                }
+            }
+            _pRulebase->actualise_parameters(eta);
+        }
+    }
+    CATCH;
+}
+
+std::vector<double> ksi::neuro_fuzzy_system::answers(const ksi::dataset & X) const
+{
+    try
+    {
+        const std::size_t size = X.getNumberOfData();
+        std::vector<double> result (size);
+        // answer remembers answers of rules for the last data item in the rulebase
+        for (std::size_t i = 0; i < size; i++)
+            result[i] = answer(*(X.getDatum(i)));
+        return result;
+    }
+    CATCH;
+}
+
+std::pair<std::vector<double>, std::vector<double>> ksi::neuro_fuzzy_system::answers_with_error_bounds(const ksi::dataset & X) const
+{
+    try
+    {
+        if (not _pRulebase)
+            throw ksi::exception ("The system has no rulebase.");
+        if (not _pRulebase->has_plain_tsk_rules())
+            throw ksi::exception ("Bounded activation is elaborated only for plain rules with TSK consequences.");
+        ksi::bounded_activation activation (_pRulebase->get_premises(), _activation_threshold, _activation_top_k, _activation_indexed);
+        std::vector<double> bounds;
+        auto result = _pRulebase->answer(X.getMatrix(), activation, & bounds);
+        return { result, bounds };
+    }
+    CATCH;
+}
+
 std::pair<double, double> ksi::neuro_fuzzy_system::answer_classification(const ksi::datum& item) const
 {
     auto numeric = answer(item);
@@ -687,6 +1217,9 @@ ksi::result ksi::neuro_fuzzy_system::experiment_classification_core(
 {
    try 
    {
+        // The profile of the result file holds phases of this experiment only.
+        ksi::profiler::instance().clear();
+        
         _TrainDataset =  trainDataset;
         _ValidationDataset = validationDataset;
         _TestDataset  =  testDataset;
@@ -714,10 +1247,12 @@ ksi::result ksi::neuro_fuzzy_system::experiment_classification_core(
        
         ksi::clock zegar;
         zegar.start();
-
-        createFuzzyRulebase(nNumberOfClusteringIterations,
-                            nNumberofTuningIterations, dbLearningCoefficient,
-                            _TrainDataset, _ValidationDataset);
+        {
+            ksi::scoped_timer timer ("createFuzzyRulebase", _TrainDataset.getNumberOfData());
+            createFuzzyRulebase(nNumberOfClusteringIterations,
+                                nNumberofTuningIterations, dbLearningCoefficient,
+                                _TrainDataset, _ValidationDataset);
+        }
         zegar.stop();
         run_extra_activities_for_the_model();
 
@@ -744,7 +1279,10 @@ ksi::result ksi::neuro_fuzzy_system::experiment_classification_core(
         std::vector<double> wYtestExpected,  wYtestElaboratedClass,  wYtestElaboratedNumeric,
                             wYtrainExpected, wYtrainElaboratedClass, wYtrainElaboratedNumeric;
         
-        get_answers_for_train_classification();
+        {
+            ksi::scoped_timer timer ("answers: train", _TrainDataset.getNumberOfData());
+            get_answers_for_train_classification();
+        }
         for (const auto & answer : _answers_for_train)
         {
             double expected, el_numeric;
@@ -762,7 +1300,10 @@ ksi::result ksi::neuro_fuzzy_system::experiment_classification_core(
         wYtrainElaboratedNumeric.clear();
         wYtrainExpected.clear();
         
-        get_answers_for_train_classification();
+        {
+            ksi::scoped_timer timer ("answers: train", _TrainDataset.getNumberOfData());
+            get_answers_for_train_classification();
+        }
         for (const auto & answer : _answers_for_train)
         {
             double expected, el_numeric, el_class;
@@ -776,7 +1317,10 @@ ksi::result ksi::neuro_fuzzy_system::experiment_classification_core(
         wYtestElaboratedNumeric.clear();
         wYtestExpected.clear();
         
-        get_answers_for_test_classification();
+        {
+            ksi::scoped_timer timer ("answers: test", _TestDataset.getNumberOfData());
+            get_answers_for_test_classification();
+        }
         for (const auto & answer : _answers_for_test)
         {
             double expected, el_numeric, el_class;
@@ -794,6 +1338,7 @@ ksi::result ksi::neuro_fuzzy_system::experiment_classification_core(
         else 
             model << zegar.elapsed_milliseconds() << " [ms]";
         model << std::endl;
+        report_profile(model, outputFile);
         
         model << report_average_number_of_rules_for_test() << std::endl;
         model << report_average_number_of_rules_for_train() << std::endl;
@@ -974,6 +1519,9 @@ ksi::result ksi::neuro_fuzzy_system::experiment_regression_core(
 {
    try
    {
+        // The profile of the result file holds phases of this experiment only.
+        ksi::profiler::instance().clear();
+        
         _TrainDataset =  trainDataset;
         _ValidationDataset = validationDataset;
         _TestDataset  =  testDataset;
@@ -1001,10 +1549,12 @@ ksi::result ksi::neuro_fuzzy_system::experiment_regression_core(
       
       ksi::clock zegar;
       zegar.start();
-      
-      createFuzzyRulebase(nNumberOfClusteringIterations,
-                        nNumberofTuningIterations, dbLearningCoefficient,
-                            _TrainDataset, _ValidationDataset);
+      {
+         ksi::scoped_timer timer ("createFuzzyRulebase", _TrainDataset.getNumberOfData());
+         createFuzzyRulebase(nNumberOfClusteringIterations,
+                           nNumberofTuningIterations, dbLearningCoefficient,
+                               _TrainDataset, _ValidationDataset);
+      }
       zegar.stop();
       
       if (not _pRulebase->validate())
@@ -1019,27 +1569,29 @@ ksi::result ksi::neuro_fuzzy_system::experiment_regression_core(
 	  std::vector<double> wYtestExpected (nXtest),  wYtestElaborated (nXtest);
       std::vector<double> wYtrainExpected(nXtrain), wYtrainElaborated(nXtrain);
      
-	   #pragma omg parallel for
-      for (std::size_t i = 0; i < nXtest; i++)
       {
-         wYtestExpected[i] = XYtest.second.get(i, 0);
-         wYtestElaborated[i] = answer(*(XYtest.first.getDatum(i)));
+         ksi::scoped_timer timer ("answers: test", nXtest);
+         for (std::size_t i = 0; i < nXtest; i++)
+            wYtestExpected[i] = XYtest.second.get(i, 0);
+         wYtestElaborated = answers(XYtest.first);
       }
       
-	   #pragma omg parallel for
-      for (std::size_t i = 0; i < nXtrain; i++)
       {
-         wYtrainExpected[i] = XYtrain.second.get(i, 0);
-         wYtrainElaborated[i] = answer(*(XYtrain.first.getDatum(i)));
+         ksi::scoped_timer timer ("answers: train", nXtrain);
+         for (std::size_t i = 0; i < nXtrain; i++)
+            wYtrainExpected[i] = XYtrain.second.get(i, 0);
+         wYtrainElaborated = answers(XYtrain.first);
       }
       ///////////////////////////
 
-		ksi::error_RMSE rmse; 
-      double blad_rmse_test  = rmse.getError(wYtestElaborated, wYtestExpected);
-      double blad_rmse_train = rmse.getError(wYtrainElaborated, wYtrainExpected);
-      ksi::error_MAE mae;
-      double blad_mae_test   = mae.getError(wYtestElaborated, wYtestExpected);
-      double blad_mae_train  = mae.getError(wYtrainElaborated, wYtrainExpected);
+      // one pass over answers for all errors
+      ksi::evaluation_accumulator evaluation_test, evaluation_train;
+      evaluation_test.add(wYtestExpected, wYtestElaborated);
+      evaluation_train.add(wYtrainExpected, wYtrainElaborated);
+      double blad_rmse_test  = evaluation_test.RMSE();
+      double blad_rmse_train = evaluation_train.RMSE();
+      double blad_mae_test   = evaluation_test.MAE();
+      double blad_mae_train  = evaluation_train.MAE();
       
       experiment_results.mae_test = blad_mae_test;
       experiment_results.mae_train = blad_mae_train;
@@ -1100,6 +1652,7 @@ ksi::result ksi::neuro_fuzzy_system::experiment_regression_core(
       else 
           model << zegar.elapsed_milliseconds() << " [ms]";
       model << std::endl;
+      report_profile(model, outputFile);
 
       ///////////////////////
       // print model parameters and its linguistic decription
@@ -1384,13 +1937,10 @@ double ksi::neuro_fuzzy_system::elaborate_rmse_for_dataset(const ksi::dataset& d
     auto decision_matrix = train_decision.getMatrix();
     
 	 //////////////////
-	 std::vector<double> elaborated(train_size), expected(train_size);
-    #pragma omp parallel for 
+	 std::vector<double> expected(train_size);
     for (std::size_t i = 0; i < train_size; i++)
-    {
         expected[i] = decision_matrix[i][0];
-        elaborated[i] = answer(*(train_data.getDatum(i)));
-    }
+    auto elaborated = answers(train_data);
     //////////////////
     ksi::error_RMSE errator;
     
@@ -1413,6 +1963,11 @@ void ksi::neuro_fuzzy_system::set_train_dataset(const ksi::dataset& ds)
     _TrainDataset = ds;
 }
 
+void ksi::neuro_fuzzy_system::set_train_dataset(ksi::dataset && ds)
+{
+    _TrainDataset = std::move(ds);
+}
+
 void ksi::neuro_fuzzy_system::createFuzzyRulebase(const ksi::dataset& train, const ksi::dataset& test, const ksi::dataset & validat)
 {
     createFuzzyRulebase(_nClusteringIterations, _nTuningIterations, _dbLearningCoefficient, train, test);
@@ -1619,4 +2174,20 @@ void ksi::neuro_fuzzy_system::run_extra_activities_for_the_model()
    // a non-empty body of this method.
 }
 
+void ksi::neuro_fuzzy_system::report_profile (std::ostream & model, const std::string & outputFile) const
+{
+   try
+   {
+      if (not ksi::profiler::is_enabled())
+         return;
 
+      model << ksi::profiler::instance().report();
+      if (ksi::profiler::is_chrome_trace_enabled())
+      {
+         auto trace_file = outputFile + ".trace.json";
+         ksi::profiler::instance().write_chrome_trace(trace_file);
+         model << "chrome trace: " << trace_file << std::endl;
+      }
+   }
+   CATCH;
+}
@@ -8,6 +8,7 @@
 #include <memory>
 #include <tuple>
 #include <deque>
+#include <functional>
 
 #include "../common/dataset.h"
 #include "../neuro-fuzzy/rulebase.h"
@@ -18,10 +19,14 @@
 #include "../gan/generative_model.h"
 #include "../partitions/partitioner.h"
 #include "../common/result.h"
+#include "../auxiliary/least-error-squares-regression.h"
+#include "../auxiliary/precision.h"
 #include "../common/data-modifier.h"
 
 namespace ksi
 {
+   class data_stream;
+   
    class neuro_fuzzy_system  : public generative_model, public discriminative_model
    {
    protected:
@@ -98,6 +103,29 @@ namespace ksi
       std::vector<std::tuple<double, double, double>> _answers_for_train; 
       /** answers for the test set: expected elaborated_numeric elaborated_class */
       std::vector<std::tuple<double, double, double>> _answers_for_test; 
+      
+      /** state of recursive least squares estimation of consequences in online learning
+          (nullptr: not started yet) */
+      std::shared_ptr<ksi::least_square_error_regression> _pOnlineRegression { nullptr };
+      /** forgetting factor of online learning */
+      double _online_forgetting_factor = 1.0;
+      /** learning coefficient of a gradient step for premises in online learning (0: premises are not modified) */
+      double _online_premise_learning_coefficient = 0.0;
+      /** a rule is spawned for a data item, if the maximal firing strength of rules for the item is lower (0: no rules are spawned) */
+      double _online_minimal_coverage = 0.0;
+      /** if there are more rules, the two closest rules are merged (0: no limit) */
+      int _online_maximal_number_of_rules = 0;
+      
+      /** precision of batched answers and clustering */
+      ksi::precision _precision = ksi::precision::double_precision;
+      /** true: batched answers with fast approximations of memberships */
+      bool _fast_math = false;
+      /** threshold of bounded activation of rules in batched answers (0: no threshold) */
+      double _activation_threshold = 0.0;
+      /** number of the strongest rules in batched answers (0: all rules) */
+      std::size_t _activation_top_k = 0;
+      /** true: bounded activation elaborates rules with the rule-centre index */
+      bool _activation_indexed = true;
              
    public: 
      /** @return number of item in the train dataset 
@@ -129,6 +157,121 @@ namespace ksi
      /** @return number of rules in the fuzzy system
       * @date 2024-03-24 */
       virtual double get_number_of_rules () const;
+      
+      /** @return number of clustering iterations 
+          @date 2026-10-18 */
+      int get_number_of_clustering_iterations () const;
+      
+      /** @return number of tuning iterations 
+          @date 2026-10-18 */
+      int get_number_of_tuning_iterations () const;
+      
+      /** @return learning coefficient of gradient tuning 
+          @date 2026-10-18 */
+      double get_learning_coefficient () const;
+      
+   public:
+      /** The method sets the precision of the model.
+       *  In single precision answers for datasets (ksi::neuro_fuzzy_system::answers) 
+       *  are elaborated with premises and consequences in float (if the rulebase 
+       *  has TSK consequences), and the FCM partitioner (ksi::fcm) is replaced 
+       *  with ksi::fcm_T<float>. Sums are accumulated in double.
+       *  Gradient tuning of parameters is always executed in double.
+       *  @param accuracy precision to set
+       *  @throw ksi::exception for single precision with bounded activation of rules
+       *  @date 2026-10-18 */
+      void set_precision (const ksi::precision accuracy);
+      
+      /** @return precision of the model 
+       *  @date 2026-10-18 */
+      ksi::precision get_precision () const;
+      
+      /** The method switches fast approximations of exp, tanh, and atan (ksi::fast_math)
+       *  in memberships for answers for datasets (ksi::neuro_fuzzy_system::answers).
+       *  The bound of differences of answers is given in ksi::rulebase::answer.
+       *  Answers for single data items and tuning always use exact functions.
+       *  @param fast_math true: fast approximations, false: exact functions (default)
+       *  @throw ksi::exception for fast approximations with bounded activation of rules
+       *  @date 2026-10-18 */
+      void set_fast_math (const bool fast_math);
+      
+      /** @return true if fast approximations of memberships are used 
+       *  @date 2026-10-18 */
+      bool get_fast_math () const;
+      
+      /** The method sets bounded activation of rules for answers for datasets 
+       *  (ksi::neuro_fuzzy_system::answers) of systems with Gaussian premises, 
+       *  the product t-norm and TSK consequences in plain rules (see ksi::bounded_activation);
+       *  other systems elaborate all rules. Bounded activation is elaborated 
+       *  in double precision with exact functions only.
+       *  Rules weaker than threshold times the strongest rule are dropped, 
+       *  elaboration of a rule stops as soon as it is known to be dropped. 
+       *  The bound of differences of answers is given in ksi::rulebase::answer.
+       *  Answers for single data items and tuning always elaborate all rules.
+       *  @param threshold from [0, 1], 0: no threshold
+       *  @param top_k number of the strongest rules used for an answer, 0: all rules
+       *  @param indexed true: distant rules are skipped with the rule-centre index
+       *  @throw ksi::exception if the threshold is not in [0, 1] or the model 
+       *         has single precision or fast approximations of functions
+       *  @date 2026-10-19 */
+      void set_bounded_activation (const double threshold, const std::size_t top_k = 0, const bool indexed = true);
+      
+      /** @return true if batched answers use bounded activation of rules 
+       *  @date 2026-10-19 */
+      bool get_bounded_activation () const;
+      
+   public:
+      /** The method sets parameters of online learning (ksi::neuro_fuzzy_system::partial_fit).
+       * @param forgetting_factor forgetting factor of recursive least squares, from (0, 1]; 
+       *        1 -- all data items are equally important
+       * @param premise_learning_coefficient learning coefficient of one gradient step 
+       *        for premises per batch, 0 -- premises are not modified
+       * @param minimal_coverage a new rule is spawned for a data item, if the maximal firing 
+       *        strength of rules for the item is lower, 0 -- no rules are spawned
+       * @param maximal_number_of_rules if there are more rules, the two closest ones are merged, 
+       *        0 -- no limit
+       * @date 2026-10-18 */
+      void set_online_learning (const double forgetting_factor,
+                                const double premise_learning_coefficient = 0.0,
+                                const double minimal_coverage = 0.0,
+                                const int maximal_number_of_rules = 0);
+      
+      /** The method updates the model with a batch of data items (online learning).
+       *  If there is no model yet (or it does not match the data), the model is created 
+       *  from the batch with createFuzzyRulebase. Then for each data item:
+       *  - if the item is not covered by rules, a new rule is spawned (and the closest
+       *    rules are merged, if there are too many rules),
+       *  - linear consequences are updated with recursive least squares in O(p^2),
+       *    where p is the number of parameters of consequences.
+       *  The state of recursive least squares is kept in the model between calls.
+       *  Finally premises can be nudged with one gradient step.
+       *  The method requires TSK consequences and non-logical rules: weights of logical 
+       *  (ANNBFIS) rules do not vanish for data items far from their premises, so 
+       *  each item would update all consequences and the model would forget earlier batches.
+       *  Spawning and merging of rules requires premises with Gaussian descriptors.
+       *  @param batch data items with the decision attribute (the last one)
+       *  @throw ksi::exception if the rules do not have linear consequences or are logical rules
+       *  @date 2026-10-18 */
+      virtual void partial_fit (const dataset & batch);
+      
+      /** The method trains the model out of core: the train data are not loaded into memory.
+       *  The rulebase is created (with createFuzzyRulebase without tuning) from a uniform sample 
+       *  of data items drawn in one pass over the file. Then each tuning epoch streams the file 
+       *  in chunks (ksi::data_stream). Differentials of the gradient method and statistics 
+       *  of least squares are accumulated item by item in the same order as in memory, 
+       *  so for the same rulebase the tuned model is the same as the one tuned in memory.
+       *  Only the sample and two chunks are kept in memory.
+       *  Numbers of clustering and tuning iterations and the learning coefficient 
+       *  are the ones set for the system. Untypical data items are removed only from the sample.
+       *  @param train_file file with complete train data (the decision attribute is the last one)
+       *  @param chunk_size number of data items in a chunk
+       *  @param sample_size number of data items in the sample for clustering
+       *  @throw ksi::exception if the system does not implement out-of-core tuning (see tune_out_of_core)
+       *         or the size of the sample is zero
+       *  @date 2026-10-19 */
+      virtual void train_out_of_core (const std::string & train_file, 
+                                      const std::size_t chunk_size, 
+                                      const std::size_t sample_size);
        
    public:
        /** @return threshold value elaborated for classification
@@ -627,6 +770,12 @@ virtual result experiment_regression_core(
        @param rb rulebase to set */
       void set_rulebase (const rulebase & rb);
       
+      /** The method sets a partitioner for identification of a fuzzy model
+          (eg. ksi::fcm_minibatch for very large datasets). The partitioner is copied.
+       @param p partitioner to set
+       @date 2026-10-19 */
+      void set_partitioner (const partitioner & p);
+      
       /** The method sets train data file.
        @param file file name for train data
        @date 2021-09-21*/
@@ -674,6 +823,27 @@ virtual result experiment_regression_core(
        */
       virtual double answer (const datum & item) const = 0;
       
+      /** The method elaborates answers for all data items of a dataset 
+          (without the decision attribute). 
+          Default behaviour: answer is called for each data item.
+       @return answers for data items
+       @param X dataset to elaborate answers for
+       @date 2026-10-18
+       */
+      virtual std::vector<double> answers (const dataset & X) const;
+      
+      /** The method elaborates answers for all data items of a dataset 
+          (without the decision attribute) with bounded activation of rules
+          (ksi::neuro_fuzzy_system::set_bounded_activation) and bounds 
+          of differences of the answers from exact ones (see ksi::rulebase::answer).
+       @return a pair: answers, bounds of differences
+       @param X dataset to elaborate answers for
+       @throw ksi::exception if there is no rulebase or its premises are not Gaussian 
+              with the product t-norm or its rules are not plain rules with TSK consequences
+       @date 2026-10-19
+       */
+      std::pair<std::vector<double>, std::vector<double>> answers_with_error_bounds (const dataset & X) const;
+      
       /** The method elaborates answer for classification.
        @return a pair: elaborated numeric, class
        @date   2021-09-27
@@ -696,6 +866,11 @@ virtual result experiment_regression_core(
        @param ds a dataset to set 
        @date  2021-09-14*/
       void set_train_dataset (const ksi::dataset & ds);
+      
+      /** The method sets a train dataset. The dataset is moved, not copied.
+       @param ds a dataset to set 
+       @date  2026-10-18*/
+      void set_train_dataset (ksi::dataset && ds);
             
       /** The method sets a test dataset.
        @param ds a dataset to set 
@@ -728,6 +903,57 @@ virtual result experiment_regression_core(
       *  a non-empty body of this method.
       *  @date 2024-05-02 */  
        virtual void run_extra_activities_for_the_model();
+
+     /** The method prints phase timings recorded by ksi::profiler (if it is enabled)
+      *  into a result file. The profiler is cleared at the start of each experiment,
+      *  so the timings are the ones of the experiment only. If Chrome trace is enabled, the trace is saved
+      *  into the file outputFile + ".trace.json".
+      *  @param model stream of the result file
+      *  @param outputFile name of the result file
+      *  @date 2026-10-18 */
+       void report_profile (std::ostream & model, const std::string & outputFile) const;
+
+     /** @return true if the rulebase exists and all rules have linear (TSK) consequences with nAttr_1 + 1 parameters
+      *  @param nAttr_1 number of attributes without the decision one
+      *  @date 2026-10-18 */
+       bool has_linear_consequences (const std::size_t nAttr_1) const;
+
+     /** The method spawns a new rule for an uncovered data item. The rule is a copy 
+      *  of the closest rule with a premise centred at the data item. 
+      *  @param X data item (without the decision attribute)
+      *  @param closest index of the rule with the highest firing strength for X
+      *  @return true if the rule has been spawned, false if the premise of the closest rule is not Gaussian
+      *  @date 2026-10-18 */
+       bool spawn_rule (const std::vector<double> & X, const std::size_t closest);
+
+     /** The method merges the two closest rules (with the smallest distance of cores of premises
+      *  measured in fuzzifications of descriptors). 
+      *  @date 2026-10-18 */
+       void merge_closest_rules ();
+
+     /** The method tunes the rulebase with data streamed from a file in epochs.
+      *  The default implementation throws an exception, systems that can be trained 
+      *  out of core (ksi::neuro_fuzzy_system::train_out_of_core) implement it 
+      *  with ksi::neuro_fuzzy_system::tune_rulebase_out_of_core.
+      *  @param stream stream of train data
+      *  @param nTuningIterations number of tuning iterations (epochs)
+      *  @param eta learning coefficient of the gradient method
+      *  @throw ksi::exception if the system does not implement out-of-core tuning
+      *  @date 2026-10-19 */
+       virtual void tune_out_of_core (ksi::data_stream & stream, const int nTuningIterations, const double eta);
+
+     /** The method tunes the rulebase with data streamed from a file.
+      *  If make_consequence is empty, all epochs are gradient epochs. Otherwise even epochs 
+      *  are gradient epochs and odd epochs set consequences elaborated with least squares 
+      *  for firing strengths of the previous gradient epoch (accumulated in that epoch, 
+      *  so odd epochs do not read the file).
+      *  @param stream stream of train data
+      *  @param nTuningIterations number of tuning iterations (epochs)
+      *  @param eta learning coefficient of the gradient method
+      *  @param make_consequence returns a new consequence with linear coefficients elaborated with least squares
+      *  @date 2026-10-19 */
+       void tune_rulebase_out_of_core (ksi::data_stream & stream, const int nTuningIterations, const double eta,
+                                       const std::function<ksi::consequence * (const std::vector<double> &)> & make_consequence);
    };
 }
 
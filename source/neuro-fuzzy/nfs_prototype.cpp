@@ -217,6 +217,15 @@ double ksi::nfs_prototype::answer(const ksi::datum& item) const
    return _pRulebase->answer(attrs);
 }
  
+std::vector<double> ksi::nfs_prototype::answers(const ksi::dataset & X) const
+{
+   try
+   {
+      return _pRulebase->answer(X.getMatrix(), _precision, _fast_math);
+   }
+   CATCH;
+}
+
 ksi::number ksi::nfs_prototype::elaborate_answer(const ksi::datum& d) const
 {
     return number (answer(d));
@@ -111,6 +111,9 @@ namespace ksi
             
     public:
       double answer(const ksi::datum & item) const override;
+      /** The method elaborates answers for all data items with the batched answer of the rulebase.
+          @date 2026-10-18 */
+      std::vector<double> answers (const ksi::dataset & X) const override;
       ksi::number elaborate_answer(const ksi::datum & d) const override;
       
       // jakies metody, żeby interfejs był zaimplementowany -- zasmiecanie interfejsami  
@@ -3,11 +3,13 @@
 #include <chrono>
 #include <random>
 #include <sstream>
+#include <string>
 
 #include "../neuro-fuzzy/premise.h"
 #include "../descriptors/descriptor.h"
 #include "../tnorms/t-norm.h"
 #include "../service/debug.h"
+#include "../service/exception.h"
 #include "../common/datum.h"
 
 ksi::premise::premise()
@@ -35,11 +37,31 @@ void ksi::premise::addDescriptor (descriptor * p)
     descriptors.push_back(p);
 }
 
+std::size_t ksi::premise::getNumberOfDescriptors() const
+{
+   return descriptors.size();
+}
+
+ksi::descriptor * ksi::premise::getDescriptor(std::size_t attribute)
+{
+   return descriptors[attribute];
+}
+
+const ksi::descriptor * ksi::premise::getDescriptor(std::size_t attribute) const
+{
+   return descriptors[attribute];
+}
+
 ksi::t_norm * ksi::premise::getTnorm()
 {
    return pTnorma;
 }
 
+const ksi::t_norm * ksi::premise::getTnorm() const
+{
+   return pTnorma;
+}
+
 void ksi::premise::addDescriptor (descriptor & d)
 {
    descriptors.push_back(d.clone());
@@ -52,7 +74,10 @@ ksi::premise::premise (const t_norm & t)
 
 void ksi::premise::setTnorm (const ksi::t_norm & t)
 {
-   pTnorma = t.clone();
+   // t may be the t-norm of the premise itself
+   auto pClone = t.clone();
+   delete pTnorma;
+   pTnorma = pClone;
 }
 
 ksi::premise & ksi::premise::operator = (const ksi::premise & prawa) 
@@ -63,9 +88,11 @@ ksi::premise & ksi::premise::operator = (const ksi::premise & prawa)
          delete p;
       descriptors.clear();
       
+      descriptors.reserve(prawa.descriptors.size());
       for (auto & p : prawa.descriptors)
          descriptors.push_back(p->clone());
       
+      delete pTnorma;
       if (prawa.pTnorma)
          pTnorma = prawa.pTnorma->clone();
       else
@@ -99,6 +126,26 @@ double ksi::premise::getFiringStrength(const std::vector<double> & X)
    CATCH;
 }
 
+double ksi::premise::getFiringStrengthFast(const std::vector<double> & X)
+{
+   try
+   {
+      if (not pTnorma)
+         throw ksi::exception ("no T-norm");
+      if (X.size() != descriptors.size())
+         throw ksi::exception ("Data vector size (" + std::to_string(X.size()) + ") and number of descriptors (" + std::to_string(descriptors.size()) + ") do not match!");
+      
+      double result = 1;
+      std::size_t nAttr = X.size();
+      for (std::size_t a = 0; a < nAttr; a++)
+         result = pTnorma->tnorm (result, descriptors[a]->getMembershipFast(X[a]));
+      last_firingStrength = result;
+      
+      return result;
+   }
+   CATCH;
+}
+
 ksi::premise::premise(const premise & wzor) 
 {
    if (wzor.pTnorma)
@@ -106,6 +153,7 @@ ksi::premise::premise(const premise & wzor)
    else
       pTnorma = nullptr;
    
+   descriptors.reserve(wzor.descriptors.size());
    for (auto * p : wzor.descriptors)
    {
       addDescriptor(p->clone());
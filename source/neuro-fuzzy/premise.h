@@ -7,6 +7,7 @@
 #include <random>
 #include "../descriptors/descriptor.h"
 #include "../tnorms/t-norm.h"
+#include "../auxiliary/object_pool.h"
 #include "../common/datum.h"
 
 namespace ksi
@@ -26,9 +27,18 @@ namespace ksi
      premise (const t_norm & tnorm);
      virtual ~premise ();
      
+     /** Premises (and their descriptors) are cloned with each copy of a rule, 
+      *  so they are allocated in ksi::object_pool. 
+      *  @date 2026-10-19 */
+     static void * operator new (std::size_t size) { return ksi::object_pool::allocate(size); }
+     static void operator delete (void * p, std::size_t size) { ksi::object_pool::deallocate(p, size); }
+     
      
      void setTnorm (const t_norm & tnorm);
      t_norm * getTnorm ();
+     /** @return the t-norm of the premise (without copying)
+      *  @date 2026-10-18 */
+     const t_norm * getTnorm () const;
      premise & operator= (const premise & prawa);
      
      /** The methods add an descriptor WITHOUT allocation of memory. */
@@ -37,6 +47,20 @@ namespace ksi
       *  the descriptor). */
      void addDescriptor (descriptor & d);
      
+     /** @return number of descriptors in the premise 
+      *  @date 2026-10-18 */
+     std::size_t getNumberOfDescriptors () const;
+     
+     /** @return a pointer to the descriptor of an attribute (without copying)
+      *  @param attribute index of the attribute
+      *  @date 2026-10-18 */
+     descriptor * getDescriptor (std::size_t attribute);
+     
+     /** @return a pointer to the descriptor of an attribute (without copying)
+      *  @param attribute index of the attribute
+      *  @date 2026-10-18 */
+     const descriptor * getDescriptor (std::size_t attribute) const;
+     
      
      /** @return firing strength of a rule. It is a T-norm of 
       *          activations of all descriptors.
@@ -45,6 +69,13 @@ namespace ksi
       */
      virtual double getFiringStrength(const std::vector<double> & X);
      
+     /** @return firing strength of a rule elaborated with fast approximations 
+      *          of memberships of descriptors (descriptor::getMembershipFast).
+      *  The method implements the firing strength of this class only, 
+      *  subclasses with other firing strengths do not override it.
+      *  @date 2026-10-18 */
+     double getFiringStrengthFast(const std::vector<double> & X);
+     
      virtual premise * clone () const ;
      
      double getLastFiringStrength();
@@ -59,6 +59,27 @@ double ksi::prototype::getFiringStrength(const std::vector<double>& X)
    return last_firingStrength = get_similarity(X);
 }
 
+void ksi::prototype::elaborate_similarities(const std::vector<std::vector<double>> & X, const std::size_t first, const std::size_t last, double * similarities) const
+{
+   try
+   {
+      for (std::size_t x = first; x < last; x++)
+         similarities[x - first] = get_similarity(X[x]);
+   }
+   CATCH;
+}
+
+std::vector<double> ksi::prototype::get_similarities(const std::vector<std::vector<double>> & X) const
+{
+   try
+   {
+      std::vector<double> similarities (X.size());
+      elaborate_similarities(X, 0, X.size(), similarities.data());
+      return similarities;
+   }
+   CATCH;
+}
+
 std::ostream & ksi::prototype::print(std::ostream& ss) const
 {
     ss << "(default prototype)";
@@ -79,12 +100,11 @@ std::tuple<double, double, std::vector<double>> ksi::prototype::cardinality_simi
         
         double cardinality = 0;
         double average_y_numerator = 0;
-        std::vector<double> similarities(number_of_data_items, 0);
+        auto similarities = get_similarities(X);
             
         for (std::size_t x = 0; x < number_of_data_items; x++)
         {
-            auto sim = get_similarity(X[x]);
-            similarities[x] = sim;
+            auto sim = similarities[x];
             cardinality += sim;
             average_y_numerator += sim * Y[x];  
         }
@@ -28,6 +28,21 @@ namespace ksi
           @param d datum to elaborate similarity for */
       virtual double get_similarity (const std::vector<double> & X) const = 0;
       
+      /** The method elaborates similarities of data items [first, last) to the prototype.
+          Subclasses elaborate the items in one pass with the metric prepared once for the pass.
+          The default implementation calls get_similarity for each item.
+          @param X data items
+          @param first the first data item to elaborate
+          @param last the item after the last data item to elaborate
+          @param[out] similarities array of (last - first) similarities
+          @date 2026-10-19 */
+      virtual void elaborate_similarities (const std::vector<std::vector<double>> & X, const std::size_t first, const std::size_t last, double * similarities) const;
+      
+      /** @return similarities of all data items to the prototype
+          @param X data items
+          @date 2026-10-19 */
+      std::vector<double> get_similarities (const std::vector<std::vector<double>> & X) const;
+      
       virtual double getFiringStrength(const std::vector<double> & X) override;
       
       virtual void addDescriptor (const descriptor & d) = 0;
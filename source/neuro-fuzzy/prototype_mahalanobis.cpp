@@ -8,7 +8,6 @@
 #include "../auxiliary/utility-math.h"
 #include "../auxiliary/vector-operators.h"
 #include "../auxiliary/matrix.h"
-#include "../metrics/metric_mahalanobis.h"
 #include "../partitions/cluster.h"
 
 ksi::prototype_mahalanobis::prototype_mahalanobis () 
@@ -57,8 +56,10 @@ double ksi::prototype_mahalanobis::get_similarity(const std::vector<double>& dat
 {
    try 
    {
-      ksi::metric_mahalanobis metryka (_A);
-     return get_similarity(metryka.calculateDistance(_centre, data));
+      if (data.size() != _centre.size())
+         throw ksi::exception ("Data vector size (" + std::to_string(data.size()) + ") and size of the prototype (" + std::to_string(_centre.size()) + ") do not match!");
+      std::vector<double> difference (_centre.size());
+      return get_similarity(distance(get_flat_matrix(), data, difference));
    }
    CATCH;
 }
@@ -69,11 +70,72 @@ double ksi::prototype_mahalanobis::get_similarity(const double distance) const
 }
 
 
+const std::vector<double> & ksi::prototype_mahalanobis::get_flat_matrix() const
+{
+   try
+   {
+      const std::size_t size = _centre.size();
+      if (_flat_A.size() != size * size)
+         throw ksi::exception ("Size of the matrix (" + std::to_string(_A.getRows()) + " x " + std::to_string(_A.getCols()) + ") and size of the prototype (" + std::to_string(size) + ") do not match!");
+      return _flat_A;
+   }
+   CATCH;
+}
+
+void ksi::prototype_mahalanobis::update_flat_matrix()
+{
+   const std::size_t size = _centre.size();
+   _flat_A.clear();
+   if ((std::size_t) _A.getRows() != size or (std::size_t) _A.getCols() != size)
+      return;
+   
+   _flat_A.resize(size * size);
+   for (std::size_t i = 0; i < size; i++)
+      for (std::size_t j = 0; j < size; j++)
+         _flat_A[j * size + i] = _A.get_value(i, j);
+}
+
+double ksi::prototype_mahalanobis::distance(const std::vector<double> & A, const std::vector<double> & data, std::vector<double> & difference) const
+{
+   const std::size_t size = _centre.size();
+   for (std::size_t i = 0; i < size; i++)
+      difference[i] = _centre[i] - data[i];
+   
+   // (c - x)^T A (c - x): the row (c - x)^T A is elaborated first
+   double sum = 0;
+   for (std::size_t j = 0; j < size; j++)
+   {
+      double row = 0;
+      for (std::size_t i = 0; i < size; i++)
+         row += difference[i] * A[j * size + i];
+      sum += row * difference[j];
+   }
+   return std::sqrt(sum);
+}
+
+void ksi::prototype_mahalanobis::elaborate_similarities(const std::vector<std::vector<double>> & X, const std::size_t first, const std::size_t last, double * similarities) const
+{
+   try
+   {
+      const std::size_t size = _centre.size();
+      for (std::size_t x = first; x < last; x++)
+         if (X[x].size() != size)
+            throw ksi::exception ("Data vector size (" + std::to_string(X[x].size()) + ") and size of the prototype (" + std::to_string(size) + ") do not match!");
+      
+      const auto & A = get_flat_matrix();
+      std::vector<double> difference (size);
+      for (std::size_t x = first; x < last; x++)
+         similarities[x - first] = get_similarity(distance(A, X[x], difference));
+   }
+   CATCH;
+}
+
 void ksi::prototype_mahalanobis::addDescriptor(const ksi::descriptor & d)
 {
    try 
    {
       _centre.push_back(d.getCoreMean()); 
+      update_flat_matrix();
    } CATCH;
 }
 
@@ -82,10 +144,11 @@ void ksi::prototype_mahalanobis::cummulate_differentials(std::vector<double> X,
    try 
    {
       auto similarity = last_firingStrength;
-      ksi::metric_mahalanobis maha(_A); 
-
       auto size = X.size();
-      double dist = maha.calculateDistance(_centre, X);
+      if (size != _centre.size())
+         throw ksi::exception ("Data vector size (" + std::to_string(size) + ") and size of the prototype (" + std::to_string(_centre.size()) + ") do not match!");
+      std::vector<double> difference (size);
+      double dist = distance(get_flat_matrix(), X, difference);
       double sim_dist = similarity / (2.0 * dist);
 
       for (std::size_t d = 0; d < size; d++) // for each attribute:
@@ -144,6 +207,7 @@ void ksi::prototype_mahalanobis::actualise_parameters(double eta)
       {
          _A -= (_d_A * eta);
          _d_A = ksi::Matrix<double> (csize, csize, 0.0);
+         update_flat_matrix();
       }
    }
    CATCH; 
@@ -206,7 +270,10 @@ void ksi::prototype_mahalanobis::justified_granularity_principle(const std::vect
          if (ksi::is_valid(differentials_centre))
             _centre  += differentials_centre * ETA;
          if (ksi::is_valid(differentials_matrix))
+         {
             _A += differentials_matrix * ETA;
+            update_flat_matrix();
+         }
       }
    } CATCH;
 }
@@ -221,15 +288,18 @@ std::pair<std::vector<std::vector<double>>, std::vector<ksi::Matrix<double>>> ks
 
       std::vector<std::vector<double>> ds_dp_x(nDataItems, std::vector<double>(nAttributes));  // differentials of similarity with regard to each attribute for each data item
       std::vector<ksi::Matrix<double>> ds_daij_x (nDataItems); // differentials of similarity with regard to each element of the covariance matrix for each each data item
-      ksi::metric_mahalanobis Metric (_A); // Mahalobis matrix with covariance matrix _A
+      const auto & A = get_flat_matrix(); // covariance matrix _A for the Mahalanobis distance
+      std::vector<double> difference (nAttributes);
       double dri_dpi = -1;  // 
 
       for (std::size_t x = 0; x < nDataItems; x++)
       {
          // similarity of x-th data item and the centre of the prototype:
          const auto & dataitem = X[x];
+         if (dataitem.size() != nAttributes)
+            throw ksi::exception ("Data vector size (" + std::to_string(dataitem.size()) + ") and size of the prototype (" + std::to_string(nAttributes) + ") do not match!");
          // squared distance:
-         double d = Metric.calculateDistance(_centre, dataitem);
+         double d = distance(A, dataitem, difference);
          if (d < 0)
             throw ksi::exception("Negative distance!");
 
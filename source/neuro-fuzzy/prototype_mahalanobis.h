@@ -18,6 +18,10 @@ namespace ksi
    protected:
        Matrix<double> _A;   ///< matrix for the Mahalanobis distance
        std::vector<double> _centre; ///< localisation of prototype centre (attributes)
+       /** the matrix _A in a contiguous array, column major (see get_flat_matrix), 
+           empty if sizes of _A and _centre do not match;
+           updated (update_flat_matrix) whenever _A or the size of _centre changes */
+       std::vector<double> _flat_A;
        
        Matrix<double> _d_A;   ///< differencial for matrix for the Mahalanobis distance
        std::vector<double> _d_centre; ///< differentials of centres
@@ -36,6 +40,12 @@ namespace ksi
       virtual double get_similarity (const std::vector<double> & X) const override;
       virtual double get_similarity (const double distance) const;
       
+      /** The method elaborates similarities with the matrix of the metric copied once 
+          into a contiguous array, so no metric and no matrices are constructed for items.
+          @throw ksi::exception if sizes of a data item and the prototype do not match
+          @date 2026-10-19 */
+      virtual void elaborate_similarities (const std::vector<std::vector<double>> & X, const std::size_t first, const std::size_t last, double * similarities) const override;
+      
       virtual void addDescriptor (const descriptor & d) override; 
       
       
@@ -66,6 +76,26 @@ namespace ksi
      virtual void justified_granularity_principle (const std::vector<std::vector<double>> & X, const std::vector<double> & Y) override; 
                                                    
    protected:
+     /** @return the matrix of the metric in a contiguous array, column major 
+                 (columns are contiguous for the product of a row and the matrix),
+                 without a copy
+      @throw ksi::exception if sizes of the matrix and the prototype do not match
+      @date 2026-10-19 */
+     const std::vector<double> & get_flat_matrix () const;
+     
+     /** The method copies the matrix _A into _flat_A. It has to be called 
+         whenever _A or the size of _centre changes.
+      @date 2026-10-19 */
+     void update_flat_matrix ();
+     
+     /** @return the Mahalanobis distance of a data item to the centre, 
+                 elaborated in the same order of operations as ksi::metric_mahalanobis
+      @param A the matrix of the metric, column major (see get_flat_matrix)
+      @param data data item
+      @param difference work array of the size of the centre 
+      @date 2026-10-19 */
+     double distance (const std::vector<double> & A, const std::vector<double> & data, std::vector<double> & difference) const;
+     
      /** The method elaborates differentials for the justified granularity principle.
       @date 2023-07-04
       @return first:  vector of differentials for prototype centres
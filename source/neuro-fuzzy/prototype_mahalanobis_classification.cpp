@@ -99,7 +99,7 @@ std::tuple<double, double, double, std::vector<double>> ksi::prototype_mahalanob
    {
       auto nDataItems = X.size(); // number of data items
       double cardinality = 0;
-      std::vector<double> similarities(nDataItems, 0);
+      auto similarities = get_similarities(X);
 
       // elaboration of sums of similarities to the positive and negative classes
       double sum_similarities_positive = 0;
@@ -107,8 +107,7 @@ std::tuple<double, double, double, std::vector<double>> ksi::prototype_mahalanob
 
       for (std::size_t x = 0; x < nDataItems; x++)
       {
-         auto sim = get_similarity(X[x]);
-         similarities[x] = sim;
+         auto sim = similarities[x];
          cardinality += sim;
          if (ksi::utility_math::double_equal(Y[x], positive_class))
             sum_similarities_positive += sim;
@@ -12,11 +12,11 @@
 #include "../partitions/cluster.h"
 #include "../service/exception.h"
 
-ksi::prototype_minkowski::prototype_minkowski (const double m) : ksi::prototype(), _m(m)
+ksi::prototype_minkowski::prototype_minkowski (const double m) : ksi::prototype(), _m(m), _kernel(m)
 {
 }
 
-ksi::prototype_minkowski::prototype_minkowski (const cluster & cl, const double m) : _m (m)
+ksi::prototype_minkowski::prototype_minkowski (const cluster & cl, const double m) : _m (m), _kernel (m)
 {
    try 
    {
@@ -49,8 +49,23 @@ double ksi::prototype_minkowski::get_similarity(const std::vector<double>& data)
 {
     try 
     {
-        ksi::metric_minkowski_weighted metryka (_m, _weights);
-        return distance_to_similarity(metryka.calculateDistance(_centre, data));
+        auto suma = _kernel.weighted_sum_of_powers(_centre, data, _weights);
+        return distance_to_similarity(_kernel.root(suma));
+    }
+    CATCH;
+}
+
+void ksi::prototype_minkowski::elaborate_similarities(const std::vector<std::vector<double>> & X, const std::size_t first, const std::size_t last, double * similarities) const
+{
+    try 
+    {
+        const auto size = _centre.size();
+        for (std::size_t x = first; x < last; x++)
+            if (X[x].size() != size)
+                throw ksi::exception ("Data vector size (" + std::to_string(X[x].size()) + ") and size of the prototype (" + std::to_string(size) + ") do not match!");
+        
+        for (std::size_t x = first; x < last; x++)
+            similarities[x - first] = distance_to_similarity(_kernel.root(_kernel.weighted_sum_of_powers(_centre.data(), X[x].data(), _weights.data(), size)));
     }
     CATCH;
 }
@@ -75,21 +90,22 @@ void ksi::prototype_minkowski::cummulate_differentials(std::vector<double> X, do
         
         auto size = X.size();
         
+        // |x - c|^m and |x - c|^(m-1) are elaborated once for each attribute
+        std::vector<double> power_m (size), power_m_1 (size);
         for (std::size_t i = 0; i < size; i++) // for each attribute
         {
-            auto difference = std::fabs(X[i] - _centre[i]);
-            suma += pow(difference, _m);
+            _kernel.powers(X[i] - _centre[i], power_m[i], power_m_1[i]);
+            suma += power_m[i];
         }
-        auto suma_do_m_1 = pow(suma, (1.0 / _m) - 1.0);
+        auto suma_do_m_1 = _kernel.root_m_1(suma);
         
         auto factor { similarity * (1.0 / _m) * suma_do_m_1 } ;
         for (std::size_t i = 0; i < size; i++)
         {
-            auto difference = std::fabs(X[i] - _centre[i]);
             auto signum = ksi::utility_math::signum(X[i] - _centre[i]);
             
-            _d_centre[i]  += partial_differential * factor * _m * pow(difference, _m - 1) * signum;
-            _d_weights[i] += partial_differential * factor *      pow(difference, _m)     * (-1);
+            _d_centre[i]  += partial_differential * factor * _m * power_m_1[i] * signum;
+            _d_weights[i] += partial_differential * factor *      power_m[i]    * (-1);
         }
     } CATCH;
 }
@@ -204,24 +220,25 @@ std::pair<ksi::Matrix<double>, ksi::Matrix<double>> ksi::prototype_minkowski::si
         ksi::Matrix<double> dsim_da(nDataItems, nAttributes);  // differentials of similarity with regard to centres.
         ksi::Matrix<double> dsim_dz(nDataItems, nAttributes);  // differentials of similarity with regard to weights.
             
+        auto common_factors = _kernel.weighted_sums_of_powers(X, _centre, _weights);
+        
+        #pragma omp parallel for
         for (std::size_t x = 0; x < nDataItems; x++)
         {
-            double common_factor = 0;
-            for (std::size_t i = 0; i < nAttributes; i++)
-            {
-                common_factor += _weights[i] * pow( std::fabs (_centre[i] - X[x][i]), _m);
-            }
-            auto common_factor_1_m   = pow(common_factor, 1.0 / _m);
-            auto common_factor_1_m_1 = pow(common_factor, (1.0 / _m ) - 1.0);
+            double common_factor = common_factors[x];
+            auto common_factor_1_m   = _kernel.root(common_factor);
+            auto common_factor_1_m_1 = _kernel.root_m_1(common_factor);
             auto factor = exp(- common_factor_1_m) * (-1) / _m * common_factor_1_m_1; 
             
             
             for (std::size_t a = 0; a < nAttributes; a++)
             {
                 auto difference = X[x][a] - _centre[a];
-                dsim_da(x, a) = factor * _weights[a] * _m * pow(std::fabs(difference), _m - 1) * (-1) * ksi::utility_math::signum(difference); 
+                double power_m, power_m_1;
+                _kernel.powers(difference, power_m, power_m_1);
+                dsim_da(x, a) = factor * _weights[a] * _m * power_m_1 * (-1) * ksi::utility_math::signum(difference); 
                 
-                dsim_dz(x, a) = factor * pow(std::fabs(difference), _m);
+                dsim_dz(x, a) = factor * power_m;
             }
         }
         return { dsim_da, dsim_dz };
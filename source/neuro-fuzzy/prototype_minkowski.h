@@ -7,6 +7,7 @@
 #include "../neuro-fuzzy/prototype.h"
 #include "../neuro-fuzzy/premise.h"
 #include "../auxiliary/matrix.h"
+#include "../auxiliary/minkowski_kernel.h"
 #include "../partitions/cluster.h"
 
 namespace ksi
@@ -17,6 +18,7 @@ namespace ksi
    {
    protected:
        double _m;   ///< exponent 
+       minkowski_kernel _kernel; ///< powers and roots specialised for the exponent
        std::vector<double> _centre; ///< localisation of prototype centre (attributes)
        std::vector<double> _weights; ///< weights of prototype attributes 
        
@@ -38,6 +40,11 @@ namespace ksi
       
       virtual double get_similarity (const std::vector<double> & X) const override;
       
+      /** The method elaborates similarities with sizes checked once and without a call of get_similarity for each item.
+          @throw ksi::exception if sizes of a data item and the prototype do not match
+          @date 2026-10-19 */
+      virtual void elaborate_similarities (const std::vector<std::vector<double>> & X, const std::size_t first, const std::size_t last, double * similarities) const override;
+      
       virtual void addDescriptor (const descriptor & d) override;
       
       
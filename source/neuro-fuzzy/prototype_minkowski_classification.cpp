@@ -264,15 +264,14 @@ std::tuple<double, double, double, std::vector<double>> ksi::prototype_minkowski
     {
         auto nKrotka = X.size();
         double kardynalnosc = 0;
-        std::vector<double> similarities(nKrotka, 0);
+        auto similarities = get_similarities(X);
         
         double sum_similarities_positive = 0;
         double sum_similarities_negative = 0;
             
         for (std::size_t x = 0; x < nKrotka; x++)
         {
-            auto sim = get_similarity(X[x]);
-            similarities[x] = sim;
+            auto sim = similarities[x];
             kardynalnosc += sim;
             if (utility_math::double_equal(Y[x], positive_class))
                 sum_similarities_positive += sim;
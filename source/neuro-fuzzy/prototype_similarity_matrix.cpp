@@ -0,0 +1,196 @@
+/** @file */
+
+#include <vector>
+#include <string>
+#include <exception>
+#include <algorithm>
+
+#include "../neuro-fuzzy/prototype_similarity_matrix.h"
+#include "../auxiliary/utility-math.h"
+#include "../service/exception.h"
+
+namespace
+{
+   /** number of data items in a tile of the matrix */
+   const std::size_t BLOCK_SIZE = 1024;
+}
+
+ksi::prototype_similarity_matrix::prototype_similarity_matrix(const std::vector<const ksi::prototype *> & prototypes,
+                                                              const std::vector<std::vector<double>> & X)
+: _nPrototypes (prototypes.size()), _nData (X.size())
+{
+   try
+   {
+      for (std::size_t p = 0; p < _nPrototypes; p++)
+         if (not prototypes[p])
+            throw ksi::exception ("The prototype " + std::to_string(p) + " is null.");
+
+      _similarities.resize(_nPrototypes * _nData);
+
+      const std::size_t nBlocks = (_nData + BLOCK_SIZE - 1) / BLOCK_SIZE;
+      const std::size_t nTiles = _nPrototypes * nBlocks;
+      std::vector<std::exception_ptr> errors (nTiles);
+
+      #pragma omp parallel for schedule(dynamic)
+      for (std::size_t t = 0; t < nTiles; t++)
+      {
+         const std::size_t p = t / nBlocks;
+         const std::size_t first = (t % nBlocks) * BLOCK_SIZE;
+         const std::size_t last = std::min(first + BLOCK_SIZE, _nData);
+         try
+         {
+            prototypes[p]->elaborate_similarities(X, first, last, _similarities.data() + p * _nData + first);
+         }
+         catch (...)
+         {
+            errors[t] = std::current_exception();
+         }
+      }
+
+      for (auto & error : errors)
+         if (error)
+            std::rethrow_exception(error);
+   }
+   CATCH;
+}
+
+std::size_t ksi::prototype_similarity_matrix::get_number_of_prototypes() const
+{
+   return _nPrototypes;
+}
+
+std::size_t ksi::prototype_similarity_matrix::get_number_of_data() const
+{
+   return _nData;
+}
+
+double ksi::prototype_similarity_matrix::get_similarity(const std::size_t p, const std::size_t x) const
+{
+   return _similarities[p * _nData + x];
+}
+
+std::vector<double> ksi::prototype_similarity_matrix::get_similarities(const std::size_t p) const
+{
+   try
+   {
+      if (p >= _nPrototypes)
+         throw ksi::exception ("There is no prototype " + std::to_string(p) + " (number of prototypes: " + std::to_string(_nPrototypes) + ").");
+      return std::vector<double> (_similarities.begin() + p * _nData, _similarities.begin() + (p + 1) * _nData);
+   }
+   CATCH;
+}
+
+std::vector<double> ksi::prototype_similarity_matrix::get_item_similarities(const std::size_t x) const
+{
+   try
+   {
+      if (x >= _nData)
+         throw ksi::exception ("There is no data item " + std::to_string(x) + " (number of data items: " + std::to_string(_nData) + ").");
+      std::vector<double> similarities (_nPrototypes);
+      for (std::size_t p = 0; p < _nPrototypes; p++)
+         similarities[p] = _similarities[p * _nData + x];
+      return similarities;
+   }
+   CATCH;
+}
+
+std::vector<double> ksi::prototype_similarity_matrix::get_transposed() const
+{
+   std::vector<double> transposed (_similarities.size());
+
+   #pragma omp parallel for
+   for (std::size_t x = 0; x < _nData; x++)
+      for (std::size_t p = 0; p < _nPrototypes; p++)
+         transposed[x * _nPrototypes + p] = _similarities[p * _nData + x];
+
+   return transposed;
+}
+
+std::vector<double> ksi::prototype_similarity_matrix::get_cardinalities() const
+{
+   std::vector<double> cardinalities (_nPrototypes, 0.0);
+
+   #pragma omp parallel for
+   for (std::size_t p = 0; p < _nPrototypes; p++)
+   {
+      const double * similarities = _similarities.data() + p * _nData;
+      double cardinality = 0;
+      for (std::size_t x = 0; x < _nData; x++)
+         cardinality += similarities[x];
+      cardinalities[p] = cardinality;
+   }
+   return cardinalities;
+}
+
+std::vector<double> ksi::prototype_similarity_matrix::get_decision_averages(const std::vector<double> & Y) const
+{
+   try
+   {
+      if (Y.size() != _nData)
+         throw ksi::exception ("Number of data items (" + std::to_string(_nData) + ") and decision attributes (" + std::to_string(Y.size()) + ") do not match.");
+
+      std::vector<double> averages (_nPrototypes, 0.0);
+
+      #pragma omp parallel for
+      for (std::size_t p = 0; p < _nPrototypes; p++)
+      {
+         const double * similarities = _similarities.data() + p * _nData;
+         double cardinality = 0;
+         double numerator = 0;
+         for (std::size_t x = 0; x < _nData; x++)
+         {
+            cardinality += similarities[x];
+            numerator += similarities[x] * Y[x];
+         }
+         averages[p] = numerator / cardinality;
+      }
+      return averages;
+   }
+   CATCH;
+}
+
+std::vector<ksi::prototype_similarity_matrix::class_statistics> ksi::prototype_similarity_matrix::get_class_statistics(const std::vector<double> & Y, const double positive_class, const double negative_class) const
+{
+   try
+   {
+      if (Y.size() != _nData)
+         throw ksi::exception ("Number of data items (" + std::to_string(_nData) + ") and labels (" + std::to_string(Y.size()) + ") do not match.");
+
+      // classes of data items are recognised once for all prototypes
+      std::vector<char> classes (_nData, 0); // 1: positive, -1: negative, 0: other
+      for (std::size_t x = 0; x < _nData; x++)
+      {
+         if (ksi::utility_math::double_equal(Y[x], positive_class))
+            classes[x] = 1;
+         else if (ksi::utility_math::double_equal(Y[x], negative_class))
+            classes[x] = -1;
+      }
+
+      std::vector<class_statistics> statistics (_nPrototypes);
+
+      #pragma omp parallel for
+      for (std::size_t p = 0; p < _nPrototypes; p++)
+      {
+         const double * similarities = _similarities.data() + p * _nData;
+         double cardinality = 0;
+         double sum_positive = 0;
+         double sum_negative = 0;
+         for (std::size_t x = 0; x < _nData; x++)
+         {
+            cardinality += similarities[x];
+            if (classes[x] == 1)
+               sum_positive += similarities[x];
+            else if (classes[x] == -1)
+               sum_negative += similarities[x];
+         }
+
+         auto & s = statistics[p];
+         s.cardinality = cardinality;
+         s.probability_positive = sum_positive / cardinality;
+         s.probability_negative = sum_negative / cardinality;
+         s.gini = 1 - s.probability_positive * s.probability_positive - s.probability_negative * s.probability_negative;
+      }
+      return statistics;
+   }
+   CATCH;
+}
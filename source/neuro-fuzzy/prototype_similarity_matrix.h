@@ -0,0 +1,83 @@
+/** @file */
+
+#ifndef PROTOTYPE_SIMILARITY_MATRIX_H
+#define PROTOTYPE_SIMILARITY_MATRIX_H
+
+#include <vector>
+
+#include "../neuro-fuzzy/prototype.h"
+
+namespace ksi
+{
+   /** Similarities of all data items to all prototypes elaborated in one pass.
+       The matrix is split into tiles: a prototype and a block of consecutive data items.
+       Tiles are elaborated in parallel, each with one call of
+       ksi::prototype::elaborate_similarities, so a prototype prepares its metric
+       (eg. the matrix of the Mahalanobis distance) once for a block of items,
+       not for each item.
+       Cardinalities, averages of decision attributes and class statistics
+       of prototypes are elaborated from the matrix in parallel for prototypes.
+       @date 2026-10-19 */
+   class prototype_similarity_matrix
+   {
+   protected:
+      std::size_t _nPrototypes = 0;
+      std::size_t _nData = 0;
+      /** similarities, prototype major: _similarities[p * _nData + x] */
+      std::vector<double> _similarities;
+
+   public:
+      /** class statistics of a prototype */
+      struct class_statistics
+      {
+         /** sum of similarities of all data items */
+         double cardinality = 0;
+         /** sum of similarities of items of the positive class divided by the cardinality */
+         double probability_positive = 0;
+         /** sum of similarities of items of the negative class divided by the cardinality */
+         double probability_negative = 0;
+         /** Gini index: 1 - probability_positive^2 - probability_negative^2 */
+         double gini = 0;
+      };
+
+      /** @param prototypes prototypes
+          @param X data items
+          @throw ksi::exception if sizes of data items and prototypes do not match */
+      prototype_similarity_matrix (const std::vector<const prototype *> & prototypes,
+                                   const std::vector<std::vector<double>> & X);
+
+      /** @return number of prototypes */
+      std::size_t get_number_of_prototypes () const;
+      /** @return number of data items */
+      std::size_t get_number_of_data () const;
+
+      /** @return similarity of the x-th data item to the p-th prototype */
+      double get_similarity (const std::size_t p, const std::size_t x) const;
+      /** @return similarities of all data items to the p-th prototype */
+      std::vector<double> get_similarities (const std::size_t p) const;
+      /** @return similarities of the x-th data item to all prototypes */
+      std::vector<double> get_item_similarities (const std::size_t x) const;
+
+      /** @return similarities, data item major: [x * number_of_prototypes + p] */
+      std::vector<double> get_transposed () const;
+
+      /** @return cardinalities (sums of similarities of all data items) of prototypes */
+      std::vector<double> get_cardinalities () const;
+
+      /** @return averages of decision attributes weighted with similarities for prototypes
+          @param Y decision attributes of data items
+          @throw ksi::exception if numbers of data items and decision attributes do not match */
+      std::vector<double> get_decision_averages (const std::vector<double> & Y) const;
+
+      /** @return class statistics of prototypes
+          @param Y labels of classes of data items
+          @param positive_class label of the positive class
+          @param negative_class label of the negative class
+          @throw ksi::exception if numbers of data items and labels do not match */
+      std::vector<class_statistics> get_class_statistics (const std::vector<double> & Y,
+                                                          const double positive_class,
+                                                          const double negative_class) const;
+   };
+}
+
+#endif
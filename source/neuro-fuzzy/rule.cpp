@@ -4,11 +4,13 @@
 #include <utility>
 #include <vector> 
 #include <chrono>
+#include <typeinfo>
 
 #include "rule.h"
 #include "premise.h"
 #include "../service/debug.h"
 #include "../granules/granule.h"
+#include "../auxiliary/random_service.h"
 
 
 ksi::rule::rule()
@@ -47,6 +49,41 @@ ksi::rule::getAnswerLocalisationWeight(const std::vector<double> & X)
 
  
 
+double ksi::rule::getFiringStrength(const std::vector<double> & X)
+{
+   try
+   {
+      return pPremise->getFiringStrength(X);
+   }
+   CATCH;
+}
+
+double ksi::rule::getFiringStrengthFast(const std::vector<double> & X)
+{
+   try
+   {
+      if (typeid(*pPremise) == typeid(ksi::premise))
+         return pPremise->getFiringStrengthFast(X);
+      return pPremise->getFiringStrength(X);
+   }
+   CATCH;
+}
+
+const ksi::consequence * ksi::rule::getConsequence() const
+{
+   return pConsequence;
+}
+
+const ksi::premise * ksi::rule::getPremise() const
+{
+   return pPremise;
+}
+
+const ksi::t_norm * ksi::rule::getTnorm() const
+{
+   return pTnorma;
+}
+
 void ksi::rule::cummulate_differentials(const std::vector< double >& X, 
                                         double partial_differential,
                                         double secundary_partial_differentials
@@ -125,6 +162,10 @@ ksi::rule & ksi::rule::operator = (const ksi::rule & r)
    
    granule::operator= (r);
    
+   delete pTnorma;
+   delete pPremise;
+   delete pConsequence;
+   
    if (r.pTnorma)
       pTnorma = r.pTnorma->clone();
    else
@@ -142,6 +183,7 @@ ksi::rule & ksi::rule::operator = (const ksi::rule & r)
    
    last_localisation = r.last_localisation;
    last_weight = r.last_weight;
+   parts_replaced();
    
    return *this;
 }
@@ -158,6 +200,8 @@ ksi::rule & ksi::rule::operator=(ksi::rule && r)
    std::swap (r.pConsequence, pConsequence);  
    std::swap (r.last_localisation, last_localisation);
    std::swap (r.last_weight, last_weight);
+   parts_replaced();
+   r.parts_replaced();
    
    return *this; 
 }
@@ -179,15 +223,14 @@ void ksi::rule::setPremise(const ksi::premise & p)
 {
     try 
     {
-        if (pPremise)
-        {
-            delete pPremise;
-            pPremise = nullptr;
-        }
-        pPremise = p.clone();
+        // p may be the premise of the rule itself
+        auto pClone = p.clone();
+        delete pPremise;
+        pPremise = pClone;
         
         if (pTnorma)
             pPremise->setTnorm(*pTnorma);
+        parts_replaced();
     }
     CATCH;
 }
@@ -196,14 +239,20 @@ void ksi::rule::setConsequence (const ksi::consequence & con)
 {
     try 
     {
-        if (pConsequence)
-            delete pConsequence;
-        pConsequence = con.clone();
+        // con may be the consequence of the rule itself
+        auto pClone = con.clone();
+        delete pConsequence;
+        pConsequence = pClone;
+        parts_replaced();
     }
     CATCH;
 }
 
 
+void ksi::rule::parts_replaced()
+{
+}
+
 ksi::rule * ksi::rule::clone() const
 {
    return new rule(*this);
@@ -261,7 +310,17 @@ ksi::datum ksi::rule::get_data_item()
 {
     try 
     {
-        ksi::datum x = pPremise->getRandomValue(_engine);
+        auto engine = ksi::random_service::next_engine();
+        return get_data_item(engine);
+    }
+    CATCH;
+}
+
+ksi::datum ksi::rule::get_data_item(std::default_random_engine & engine)
+{
+    try 
+    {
+        ksi::datum x = pPremise->getRandomValue(engine);
         ksi::number odpowiedz = get_answer(x);
         x.setDecision(odpowiedz);
         return x;
@@ -269,6 +328,15 @@ ksi::datum ksi::rule::get_data_item()
     CATCH;
 }
 
+ksi::datum ksi::rule::get_random_premise_value(std::default_random_engine & engine)
+{
+    try 
+    {
+        return pPremise->getRandomValue(engine);
+    }
+    CATCH;
+}
+
 void ksi::rule::elaborate_quality()
 {
     try 
@@ -11,6 +11,7 @@
 #include "consequence.h"
 #include "../tnorms/t-norm.h"
 #include "../granules/granule.h"
+#include "../auxiliary/object_pool.h"
 
 namespace ksi
 {
@@ -26,8 +27,20 @@ namespace ksi
       /** weight of answer for the last data item */
       double last_weight;
       
+      /** The method is called after the premise or the consequence of the rule 
+       *  has been replaced (setPremise, setConsequence, assignment). 
+       *  A new part may be allocated at the address of the old one, 
+       *  so rules that keep pointers into their parts have to reread them.
+       *  @date 2026-10-19 */
+      virtual void parts_replaced ();
+      
    public:
       virtual ~rule();
+      
+      /** Rules are allocated in ksi::object_pool (a rulebase clones all its rules when copied).
+       *  @date 2026-10-19 */
+      static void * operator new (std::size_t size) { return ksi::object_pool::allocate(size); }
+      static void operator delete (void * p, std::size_t size) { ksi::object_pool::deallocate(p, size); }
       rule ();
       rule (const rule &);
       rule (ksi::rule&& r);
@@ -42,6 +55,30 @@ namespace ksi
        */
       virtual std::pair<double, double> getAnswerLocalisationWeight (const std::vector<double> & X); 
       
+      /** @return firing strength of the premise of the rule for an X data item
+       * @param X data item to elaborate firing strength for
+       * @date 2026-10-18 */
+      double getFiringStrength (const std::vector<double> & X);
+      
+      /** @return firing strength of the premise of the rule for an X data item
+       * elaborated with fast approximations of memberships (ksi::premise::getFiringStrengthFast),
+       * for other premises than ksi::premise the exact firing strength
+       * @param X data item to elaborate firing strength for
+       * @date 2026-10-18 */
+      double getFiringStrengthFast (const std::vector<double> & X);
+      
+      /** @return a pointer to the consequence of the rule (nullptr if no consequence) 
+       * @date 2026-10-18 */
+      const consequence * getConsequence () const;
+      
+      /** @return a pointer to the premise of the rule (nullptr if no premise) 
+       * @date 2026-10-18 */
+      const premise * getPremise () const;
+      
+      /** @return a pointer to the t-norm of the rule (nullptr if no t-norm) 
+       * @date 2026-10-18 */
+      const t_norm * getTnorm () const;
+      
       
       
       /** The method cummulates differentials for an X data item in a rule. 
@@ -99,6 +136,16 @@ namespace ksi
        
       /** @return The method returns a data_item represented by the data granule. */
       virtual datum get_data_item ();
+      
+      /** @return The method returns a random data item from the premise of the rule with the answer of the rule as a decision.
+          @param engine random engine 
+          @date 2026-10-18 */
+      virtual datum get_data_item (std::default_random_engine & engine) override;
+      
+      /** @return a random data item (without a decision) from the premise of the rule
+          @param engine random engine 
+          @date 2026-10-18 */
+      datum get_random_premise_value (std::default_random_engine & engine);
        
       /** @return The method returns a decision for a datum.
           @param  d the datum to elaborated answer for .*/
@@ -0,0 +1,69 @@
+/** @file */
+
+#include <typeinfo>
+#include <memory>
+
+#include "rule_kernel.h"
+#include "logicalrule.h"
+#include "../tnorms/t-norm-product.h"
+#include "../tnorms/t-norm-min.h"
+#include "../implications/imp-reichenbach.h"
+#include "../implications/imp-lukasiewicz.h"
+#include "../implications/imp-kleene-dienes.h"
+#include "../implications/imp-zadeh.h"
+#include "../implications/imp-goguen.h"
+#include "../service/debug.h"
+
+namespace
+{
+   /** @return a new kernel for the rule or nullptr if the rule does not match the kernel */
+   template <class TNorm, class Implication>
+   ksi::rule * specialise (const ksi::logicalrule & r)
+   {
+      std::unique_ptr<ksi::rule_kernel<TNorm, Implication>> pKernel (new ksi::rule_kernel<TNorm, Implication> (r));
+      if (pKernel->is_specialised())
+         return pKernel.release();
+      return nullptr;
+   }
+
+   template <class TNorm>
+   ksi::rule * specialise_implication (const ksi::logicalrule & r)
+   {
+      auto pImplication = r.getImplication();
+      if (not pImplication)
+         return nullptr;
+
+      const auto & type = typeid(*pImplication);
+      if (type == typeid(ksi::imp_reichenbach))
+         return specialise<TNorm, ksi::imp_reichenbach>(r);
+      if (type == typeid(ksi::imp_lukasiewicz))
+         return specialise<TNorm, ksi::imp_lukasiewicz>(r);
+      if (type == typeid(ksi::imp_kleene_dienes))
+         return specialise<TNorm, ksi::imp_kleene_dienes>(r);
+      if (type == typeid(ksi::imp_zadeh))
+         return specialise<TNorm, ksi::imp_zadeh>(r);
+      if (type == typeid(ksi::imp_goguen))
+         return specialise<TNorm, ksi::imp_goguen>(r);
+      return nullptr;
+   }
+}
+
+ksi::rule * ksi::make_rule_kernel(const ksi::logicalrule & r)
+{
+   try
+   {
+      ksi::rule * pKernel = nullptr;
+
+      auto pTnorm = r.getTnorm();
+      if (pTnorm and typeid(*pTnorm) == typeid(ksi::t_norm_product))
+         pKernel = specialise_implication<ksi::t_norm_product>(r);
+      else if (pTnorm and typeid(*pTnorm) == typeid(ksi::t_norm_min))
+         pKernel = specialise_implication<ksi::t_norm_min>(r);
+
+      // fallback: the virtual path
+      if (not pKernel)
+         return r.clone();
+      return pKernel;
+   }
+   CATCH;
+}
@@ -0,0 +1,194 @@
+/** @file */
+
+#ifndef RULE_KERNEL_H
+#define RULE_KERNEL_H
+
+#include <utility>
+#include <vector>
+#include <string>
+#include <typeinfo>
+
+#include "logicalrule.h"
+#include "premise.h"
+#include "consequence-CL.h"
+#include "../descriptors/descriptor-gaussian.h"
+#include "../service/exception.h"
+
+namespace ksi
+{
+   /** A logical rule (ANNBFIS) specialised at compile time for a t-norm and an implication.
+    *  The rule works for premises of Gaussian descriptors and Czogała-Łęski consequences.
+    *  The t-norm and the implication are held as objects of concrete types
+    *  and their methods are defined in headers, so the calls in the inner loops
+    *  are not virtual and can be inlined. The same holds for calls of
+    *  descriptor_gaussian methods.
+    *  The rule elaborates the same values as ksi::logicalrule.
+    *  Pointers to descriptors and the consequence are reread after the premise or
+    *  the consequence has been replaced (eg. with setPremise).
+    *  If the premise or consequence of the rule does not match, the rule falls back
+    *  to the virtual methods of ksi::logicalrule.
+    *  Rules are created with ksi::make_rule_kernel.
+    *  @date 2026-10-18
+    */
+   template <class TNorm, class Implication>
+   class rule_kernel : public logicalrule
+   {
+   protected:
+      TNorm _tnorm;
+      Implication _implication;
+
+      /** descriptors of the premise, owned by the premise */
+      std::vector<descriptor_gaussian *> _descriptors;
+      /** consequence of the rule, owned by the rule */
+      consequence_CL * _pConsequence = nullptr;
+
+      /** true if the pointers above have been read from the current premise and consequence */
+      bool _bound = false;
+
+      /** true if the premise and the consequence match the kernel */
+      bool _specialised = false;
+
+      /** firing strength for the last data item */
+      double _last_firing = 0.0;
+
+      /** The method reads pointers to descriptors and consequence,
+          if the premise or consequence has been replaced since the last call. */
+      void bind ()
+      {
+         if (_bound)
+            return;
+
+         _bound = true;
+         _descriptors.clear();
+         _pConsequence = nullptr;
+         _specialised = false;
+
+         if (not pPremise or not pConsequence or not pImplication)
+            return;
+         if (typeid(*pPremise) != typeid(premise) or typeid(*pConsequence) != typeid(consequence_CL))
+            return;
+         if (typeid(*pImplication) != typeid(Implication))
+            return;
+         auto pTnorm = pPremise->getTnorm();
+         if (not pTnorm or typeid(*pTnorm) != typeid(TNorm))
+            return;
+
+         std::size_t nDescriptors = pPremise->getNumberOfDescriptors();
+         for (std::size_t a = 0; a < nDescriptors; a++)
+         {
+            auto pDescriptor = pPremise->getDescriptor(a);
+            if (typeid(*pDescriptor) != typeid(descriptor_gaussian))
+            {
+               _descriptors.clear();
+               return;
+            }
+            _descriptors.push_back(dynamic_cast<descriptor_gaussian *>(pDescriptor));
+         }
+         _pConsequence = dynamic_cast<consequence_CL *>(pConsequence);
+         _specialised = true;
+      }
+
+   public:
+      /** @param r logical rule to specialise (it is copied) */
+      rule_kernel (const logicalrule & r) : rule (r), logicalrule (r)
+      {
+         bind();
+      }
+
+      rule_kernel (const rule_kernel & wzor) : rule (wzor), logicalrule (wzor)
+      {
+         bind();
+      }
+
+      virtual ~rule_kernel ()
+      {
+      }
+
+   protected:
+      /** The parts are rebound at the next call (addresses cannot be compared: 
+          a new part may be allocated at the address of the old one). */
+      virtual void parts_replaced () override
+      {
+         _bound = false;
+         _descriptors.clear();
+         _pConsequence = nullptr;
+         _specialised = false;
+      }
+
+   public:
+
+      /** @return true if the rule uses the specialised path, false if it falls back to ksi::logicalrule */
+      bool is_specialised ()
+      {
+         bind();
+         return _specialised;
+      }
+
+      virtual std::pair<double, double> getAnswerLocalisationWeight (const std::vector<double> & X) override
+      {
+         bind();
+         if (not _specialised)
+            return logicalrule::getAnswerLocalisationWeight(X);
+
+         const std::size_t nAttr = X.size();
+         const auto & params = _pConsequence->get_parameters();
+         if (nAttr != _descriptors.size() or nAttr + 1 != params.size())
+            throw ksi::exception ("Data vector size (" + std::to_string(nAttr) + ") and rule size (" + std::to_string(_descriptors.size()) + " descriptors, " + std::to_string(params.size()) + " parameters) do not match!");
+
+         double firingStrength = 1.0;
+         double localisation = 0.0;
+         for (std::size_t a = 0; a < nAttr; a++)
+         {
+            firingStrength = _tnorm.tnorm(firingStrength, _descriptors[a]->descriptor_gaussian::getMembership(X[a]));
+            localisation += X[a] * params[a];
+         }
+         localisation += params[nAttr];
+         _last_firing = firingStrength;
+
+         // A TSK consequence returns the firing strength as a weight (as in ksi::logicalrule).
+         double g = _implication.G(firingStrength, firingStrength);
+
+         last_localisation = localisation;
+         last_weight = g;
+
+         return { localisation, g };
+      }
+
+      virtual void cummulate_differentials (const std::vector<double> & X,
+                                            double partial_differential,
+                                            double secundary_partial_differentials
+                                           ) override
+      {
+         bind();
+         if (not _specialised)
+            return logicalrule::cummulate_differentials(X, partial_differential, secundary_partial_differentials);
+
+         double w = _pConsequence->consequence_CL::getW();
+
+         // the premise scales differentials with its firing strength
+         double factor = partial_differential * _implication.dG_dF(_last_firing, w) * _last_firing;
+         for (std::size_t a = 0; a < _descriptors.size(); a++)
+            _descriptors[a]->descriptor_gaussian::cummulate_differentials(X[a], factor);
+
+         _pConsequence->cummulate_dE_dw(partial_differential * _implication.dG_dw(_last_firing, w));
+      }
+
+      virtual rule * clone () const override
+      {
+         return new rule_kernel (*this);
+      }
+   };
+
+   /** The factory specialises a logical rule.
+    *  Specialised kernels are provided for product and minimum t-norms and
+    *  Reichenbach, Łukasiewicz, Kleene-Dienes, Zadeh, and Goguen implications
+    *  in rules with Gaussian premises and Czogała-Łęski consequences.
+    *  @param r a rule to specialise
+    *  @return a new rule_kernel if the rule can be specialised, otherwise a copy of the rule.
+    *          The caller takes the ownership of the rule.
+    *  @date 2026-10-18
+    */
+   rule * make_rule_kernel (const logicalrule & r);
+}
+
+#endif
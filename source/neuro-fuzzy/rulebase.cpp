@@ -5,11 +5,21 @@
 #include <algorithm>
 #include <cmath>
 #include <sstream>
+#include <string>
+#include <limits>
+#include <typeinfo>
 
 #include "rulebase.h"
 #include "rule.h"
+#include "consequence-TSK.h"
+#include "tsk_consequents.h"
+#include "gaussian_premises.h"
+#include "bounded_activation.h"
+#include "prototype.h"
+#include "prototype_similarity_matrix.h"
 #include "../common/DatasetStatistics.h"
 #include "../service/debug.h"
+#include "../service/exception.h"
 
 bool ksi::rulebase::validate() const
 {
@@ -34,6 +44,18 @@ void ksi::rulebase::addRule(const ksi::rule & r)
     CATCH;
 }
 
+void ksi::rulebase::removeRule(std::size_t index)
+{
+    try 
+    {
+        if (index >= rules.size())
+            throw ksi::exception ("The rule index " + std::to_string(index) + " exceeds the number of rules (" + std::to_string(rules.size()) + ").");
+        delete rules[index];
+        rules.erase(rules.begin() + index);
+    }
+    CATCH;
+}
+
 double ksi::rulebase::answer(const std::vector<double> & X)
 {
    try
@@ -78,6 +100,170 @@ double ksi::rulebase::answer(const std::vector<double> & X)
    CATCH;
 }
 
+std::vector<double> ksi::rulebase::answer(const std::vector<std::vector<double>> & X)
+{
+   try
+   {
+      return answer(X, ksi::precision::double_precision);
+   }
+   CATCH;
+}
+
+std::vector<double> ksi::rulebase::answer(const std::vector<std::vector<double>> & X, const ksi::precision accuracy, const bool fast_math)
+{
+   try
+   {
+      const std::size_t nX = X.size();
+      const std::size_t nRules = rules.size();
+      
+      if (not has_plain_tsk_rules())
+      {
+         // no batched path for logical rules and other consequences
+         std::vector<double> result (nX);
+         for (std::size_t x = 0; x < nX; x++)
+            result[x] = answer(X[x]);
+         return result;
+      }
+      
+      std::vector<std::vector<double>> parameters;
+      for (const auto & r : rules)
+         parameters.push_back(dynamic_cast<const ksi::consequence_TSK *>(r->getConsequence())->get_parameters());
+      
+      if (accuracy == ksi::precision::single_precision)
+      {
+         auto premises = get_premises();
+         if (ksi::gaussian_premises::is_representable(premises))
+            return ksi::tsk_consequents (parameters).answers(X, ksi::gaussian_premises (premises).firing_strengths(X, fast_math));
+      }
+      
+      // Firing strengths of prototypes are their similarities.
+      std::vector<const ksi::prototype *> prototypes;
+      for (const auto & r : rules)
+      {
+         auto pPrototype = dynamic_cast<const ksi::prototype *>(r->getPremise());
+         if (not pPrototype)
+            break;
+         prototypes.push_back(pPrototype);
+      }
+      
+      std::vector<double> firing_strengths;
+      if (nRules > 0 and prototypes.size() == nRules)
+         firing_strengths = ksi::prototype_similarity_matrix (prototypes, X).get_transposed();
+      else
+      {
+         // Premises remember their last firing strengths, so a rule is handled by one thread.
+         firing_strengths.resize(nX * nRules);
+         #pragma omp parallel for
+         for (std::size_t r = 0; r < nRules; r++)
+            for (std::size_t x = 0; x < nX; x++)
+               firing_strengths[x * nRules + r] = fast_math ? rules[r]->getFiringStrengthFast(X[x]) : rules[r]->getFiringStrength(X[x]);
+      }
+      
+      if (accuracy == ksi::precision::single_precision)
+         return ksi::tsk_consequents (parameters).answers(X, std::vector<float> (firing_strengths.begin(), firing_strengths.end()));
+      return ksi::tsk_consequents (parameters).answers(X, firing_strengths);
+   }
+   CATCH;
+}
+
+std::vector<double> ksi::rulebase::answer(const std::vector<std::vector<double>> & X, const ksi::bounded_activation & activation, std::vector<double> * error_bounds) const
+{
+   try
+   {
+      const std::size_t nRules = rules.size();
+      if (activation.get_number_of_rules() != nRules)
+         throw ksi::exception ("Number of rules of the activation (" + std::to_string(activation.get_number_of_rules()) + ") and of the rulebase (" + std::to_string(nRules) + ") do not match.");
+      if (not has_plain_tsk_rules())
+         throw ksi::exception ("Bounded activation is elaborated only for plain rules with TSK consequences.");
+      
+      std::vector<const std::vector<double> *> parameters (nRules);
+      double max_bias = 0, max_norm = 0;
+      for (std::size_t r = 0; r < nRules; r++)
+      {
+         auto pTSK = dynamic_cast<const ksi::consequence_TSK *>(rules[r]->getConsequence());
+         if (not pTSK)
+            throw ksi::exception ("The rule " + std::to_string(r) + " has no TSK consequence.");
+         parameters[r] = & pTSK->get_parameters();
+         if (parameters[r]->empty())
+            throw ksi::exception ("The consequence of the rule " + std::to_string(r) + " has no parameters.");
+         double norm = 0;
+         for (std::size_t a = 0; a + 1 < parameters[r]->size(); a++)
+            norm += (*parameters[r])[a] * (*parameters[r])[a];
+         max_norm = std::max(max_norm, std::sqrt(norm));
+         max_bias = std::max(max_bias, std::fabs(parameters[r]->back()));
+      }
+      
+      const std::size_t nX = X.size();
+      for (std::size_t x = 0; x < nX; x++)
+         for (std::size_t r = 0; r < nRules; r++)
+            if (parameters[r]->size() != X[x].size() + 1)
+               throw ksi::exception ("Size of data (" + std::to_string(X[x].size()) + ") and number of parameters (" + std::to_string(parameters[r]->size()) + ") do not match.");
+      
+      std::vector<double> result (nX, 0.0);
+      if (error_bounds)
+         error_bounds->assign(nX, 0.0);
+      
+      #pragma omp parallel for
+      for (std::size_t x = 0; x < nX; x++)
+      {
+         const auto active = activation.activate(X[x]);
+         double sumLocalisationWeight = 0;
+         double sumWeight             = 0;
+         for (std::size_t i = 0; i < active.rules.size(); i++)
+         {
+            const auto & p = *parameters[active.rules[i]];
+            double localisation = p.back();
+            for (std::size_t a = 0; a < X[x].size(); a++)
+               localisation += p[a] * X[x][a];
+            const double weight = active.firing_strengths[i];
+            if (not std::isfinite(localisation) or not std::isfinite(weight))
+               continue;
+            sumLocalisationWeight += localisation * weight;
+            sumWeight += weight;
+         }
+         if (sumWeight == 0.0)
+         {
+            // no finite active rules: the answer is not bounded
+            if (error_bounds and nRules > 0)
+               (*error_bounds)[x] = std::numeric_limits<double>::infinity();
+            continue;
+         }
+         result[x] = sumLocalisationWeight / sumWeight;
+         
+         if (error_bounds)
+         {
+            double norm = 0;
+            for (const auto value : X[x])
+               norm += value * value;
+            (*error_bounds)[x] = active.dropped_bound / sumWeight * (max_bias + max_norm * std::sqrt(norm) + std::fabs(result[x]));
+         }
+      }
+      return result;
+   }
+   CATCH;
+}
+
+bool ksi::rulebase::has_plain_tsk_rules() const
+{
+   for (const auto & r : rules)
+   {
+      if (typeid(*r) != typeid(ksi::rule))
+         return false;
+      auto pConsequence = r->getConsequence();
+      if (not pConsequence or typeid(*pConsequence) != typeid(ksi::consequence_TSK))
+         return false;
+   }
+   return true;
+}
+
+std::vector<const ksi::premise *> ksi::rulebase::get_premises() const
+{
+   std::vector<const ksi::premise *> premises;
+   for (const auto & r : rules)
+      premises.push_back(r->getPremise());
+   return premises;
+}
+
 // void ksi::rulebase::cummulate_differentials(const std::vector< double >& X, 
 //                                             const double Yexpected)
 // {
@@ -151,6 +337,7 @@ ksi::rulebase::rulebase()
 
 ksi::rulebase::rulebase(const rulebase & rb)
 {
+   rules.reserve(rb.rules.size());
    for (auto & r : rb.rules)
       rules.push_back(r->clone());
    
@@ -175,6 +362,7 @@ ksi::rulebase & ksi::rulebase::operator= (const rulebase & rb)
       delete p;
    rules.clear();
    
+   rules.reserve(rb.rules.size());
    for (auto & r : rb.rules)
       rules.push_back(r->clone());
    
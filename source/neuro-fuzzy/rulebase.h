@@ -12,6 +12,8 @@
 #include "../granules/granule.h"
 #include "../granules/set_of_cooperating_granules.h"
 #include "../common/DatasetStatistics.h"
+#include "../auxiliary/precision.h"
+#include "../neuro-fuzzy/bounded_activation.h"
 
 namespace ksi
 {
@@ -35,12 +37,79 @@ namespace ksi
       rulebase & operator= (rulebase &&);
       void addRule (const rule &);
       
+      /** The method removes a rule from the rulebase.
+       * @param index index of the rule to remove
+       * @date 2026-10-18 */
+      void removeRule (std::size_t index);
+      
       /** The method elaborates an answer for an X data item.
        * @param X data item to elaborate answer for 
        * @return an answer 
        */
       double answer (const std::vector<double> & X);
       
+      /** The method elaborates answers for a batch of data items.
+       * If all rules are plain TSK rules (see has_plain_tsk_rules), local outputs of rules are elaborated 
+       * with ksi::tsk_consequents (one contiguous matrix of parameters), 
+       * otherwise the answer for a single data item is called for each data item.
+       * The method does not update answers for the last data item.
+       * @param X data items to elaborate answers for 
+       * @return answers for data items
+       * @date 2026-10-18
+       */
+      std::vector<double> answer (const std::vector<std::vector<double>> & X);
+      
+      /** The method elaborates answers for a batch of data items in a requested precision.
+       * In single precision firing strengths of rules with Gaussian premises are elaborated 
+       * with ksi::gaussian_premises (other premises are elaborated in double and 
+       * converted) and local outputs of rules in float, sums are accumulated in double. 
+       * Rules without TSK consequences are always elaborated in double.
+       * 
+       * With fast_math memberships are elaborated with ksi::fast_math approximations.
+       * If firing strengths have relative errors at most e, the answer differs from
+       * the exact one at most by e / (1 - e) max_r |y_r - y|, where y_r are local outputs
+       * of rules and y is the exact answer. For Gaussian premises in single precision 
+       * e is the error of one exponent, for other premises with the product t-norm 
+       * errors of memberships of attributes add up.
+       * 
+       * If all premises are prototypes, their firing strengths are elaborated 
+       * with ksi::prototype_similarity_matrix (fast_math has no effect on prototypes).
+       * @param X data items to elaborate answers for 
+       * @param accuracy precision of computations
+       * @param fast_math true: fast approximations of memberships
+       * @return answers for data items
+       * @date 2026-10-18
+       */
+      std::vector<double> answer (const std::vector<std::vector<double>> & X, const ksi::precision accuracy, const bool fast_math = false);
+      
+      /** The method elaborates answers for a batch of data items with bounded activation of rules.
+       * Local outputs are elaborated only for active rules (see ksi::bounded_activation). 
+       * The difference from the exact answer y is at most 
+       * \f$ \frac{\bar{D}}{S} \left( \max_r |b_r| + \max_r \|p_r\| \|x\| + |y| \right) \f$, 
+       * where \f$ \bar{D} \f$ bounds the sum of firing strengths of dropped rules, 
+       * \f$ S \f$ is the sum of firing strengths of active rules and 
+       * \f$ p_r, b_r \f$ are linear and free parameters of the consequence of the r-th rule
+       * (\f$ |y_r| \le |b_r| + \|p_r\| \|x\| \f$).
+       * The method does not update answers for the last data item.
+       * @param X data items to elaborate answers for 
+       * @param activation premises of rules of the rulebase
+       * @param error_bounds if not nullptr, bounds of differences from exact answers are stored here
+       * @return answers for data items (0 if there are no active rules)
+       * @throw ksi::exception if a rule is not a plain TSK rule (see has_plain_tsk_rules) or numbers of rules do not match
+       * @date 2026-10-19
+       */
+      std::vector<double> answer (const std::vector<std::vector<double>> & X, const ksi::bounded_activation & activation, std::vector<double> * error_bounds = nullptr) const;
+      
+      /** @return premises of all rules (without copying) 
+       * @date 2026-10-19 */
+      std::vector<const ksi::premise *> get_premises () const;
+      
+      /** @return true if all rules are plain TSK rules: objects of ksi::rule (not logical rules, 
+       *  that apply an implication to weights) with ksi::consequence_TSK consequences 
+       *  (not ksi::consequence_CL). Only such rulebases are answered with batched TSK paths.
+       * @date 2026-10-19 */
+      bool has_plain_tsk_rules () const;
+      
 //       /** The method cummulates the differentials for an X data item.
 //        * @param X data item to cummulate differentials for
 //        * @param Y expected value
@@ -15,7 +15,7 @@ ksi::subspace_premise::subspace_premise(double weight_exponent)
 
 ksi::premise* ksi::subspace_premise::clone() const
 {
-   return new ksi::subspace_premise::premise (*this);
+   return new ksi::subspace_premise (*this);
 }
 
 ksi::subspace_premise::subspace_premise(const ksi::t_norm & tnorm) : ksi::premise(tnorm)
@@ -26,6 +26,10 @@ ksi::subspace_premise::subspace_premise(const ksi::t_norm & tnorm) : ksi::premis
 ksi::subspace_premise::subspace_premise(const ksi::subspace_premise & wzor) : ksi::premise (wzor)
 {
    _weight_expo = wzor._weight_expo;
+   _negligible_weight = wzor._negligible_weight;
+   _active_attributes = wzor._active_attributes;
+   _active_weights = wzor._active_weights;
+   _compiled_descriptors = wzor._compiled_descriptors;
 }
 
 ksi::subspace_premise::subspace_premise() : ksi::premise()
@@ -45,6 +49,10 @@ ksi::subspace_premise & ksi::subspace_premise::operator=(const ksi::subspace_pre
    
    ksi::premise::operator=(prawa);
    _weight_expo = prawa._weight_expo;
+   _negligible_weight = prawa._negligible_weight;
+   _active_attributes = prawa._active_attributes;
+   _active_weights = prawa._active_weights;
+   _compiled_descriptors = prawa._compiled_descriptors;
    
    return *this;
 }
@@ -57,6 +65,10 @@ ksi::subspace_premise & ksi::subspace_premise::operator=(ksi::subspace_premise &
    
    ksi::premise::operator=(prawa);
    _weight_expo = prawa._weight_expo;
+   _negligible_weight = prawa._negligible_weight;
+   _active_attributes = prawa._active_attributes;
+   _active_weights = prawa._active_weights;
+   _compiled_descriptors = prawa._compiled_descriptors;
    
    return *this;
 }
@@ -67,12 +79,15 @@ double ksi::subspace_premise::getFiringStrength(const std::vector<double> & X)
       return -1;
    if (X.size() != descriptors.size())
       return -1; 
+   if (_compiled_descriptors != descriptors.size())
+      compile_active_attributes();
    
    double result = 1;
-   std::size_t nAttr = X.size();
-   for (std::size_t a = 0; a < nAttr; a++)
+   const std::size_t nActive = _active_attributes.size();
+   for (std::size_t k = 0; k < nActive; k++)
    {
-      auto weighted_firing = 1.0 - std::pow(descriptors[a]->getWeight(), _weight_expo) * (1 - descriptors[a]->getMembership(X[a]));
+      const std::size_t a = _active_attributes[k];
+      auto weighted_firing = 1.0 - _active_weights[k] * (1 - descriptors[a]->getMembership(X[a]));
       result = pTnorma->tnorm (result, weighted_firing);
    }
    last_firingStrength = result;
@@ -84,21 +99,66 @@ void ksi::subspace_premise::augment_attribute(int a, double maxi_weight)
 {
    auto weight = descriptors[a]->getWeight();
    descriptors[a]->setWeight(weight / maxi_weight);
+   compile_active_attributes();
 }
 
 
 void ksi::subspace_premise::cummulate_differentials(std::vector<double> X, 
                                                     double factor)
 {
-   for (std::size_t i = 0; i < descriptors.size(); i++)
+   if (_compiled_descriptors != descriptors.size())
+      compile_active_attributes();
+   
+   const std::size_t nActive = _active_attributes.size();
+   for (std::size_t k = 0; k < nActive; k++)
    {
-      auto z = descriptors[i]->getWeight();
-      auto zf = std::pow(z, _weight_expo);
+      const std::size_t i = _active_attributes[k];
+      auto zf = _active_weights[k];
       auto mi = descriptors[i]->getMembership(X[i]);
-      auto ulamek = 1.0 / ( 1.0 - zf * (1.0 - mi) );
+      auto weighted_firing = 1.0 - zf * (1.0 - mi);
+      // zero weighted firing only for mi == 0, then the differential is zero (not 0 / 0)
+      if (weighted_firing <= 0.0)
+         continue;
+      auto ulamek = 1.0 / weighted_firing;
       auto czynnik = zf * mi;
       
       descriptors[i]->cummulate_differentials(X[i], 
          factor * last_firingStrength * ulamek * czynnik);
    }
 }
+
+void ksi::subspace_premise::actualise_parameters(double eta)
+{
+   ksi::premise::actualise_parameters(eta);
+   compile_active_attributes();
+}
+
+void ksi::subspace_premise::compile_active_attributes()
+{
+   _active_attributes.clear();
+   _active_weights.clear();
+   const std::size_t nAttr = descriptors.size();
+   for (std::size_t a = 0; a < nAttr; a++)
+   {
+      const double zf = std::pow(descriptors[a]->getWeight(), _weight_expo);
+      if (zf > _negligible_weight or _negligible_weight < 0)
+      {
+         _active_attributes.push_back(a);
+         _active_weights.push_back(zf);
+      }
+   }
+   _compiled_descriptors = nAttr;
+}
+
+void ksi::subspace_premise::set_negligible_weight(const double negligible_weight)
+{
+   _negligible_weight = negligible_weight;
+   compile_active_attributes();
+}
+
+std::size_t ksi::subspace_premise::get_number_of_active_attributes()
+{
+   if (_compiled_descriptors != descriptors.size())
+      compile_active_attributes();
+   return _active_attributes.size();
+}
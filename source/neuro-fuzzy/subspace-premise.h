@@ -11,10 +11,33 @@
 
 namespace ksi
 {
+  /** Premise of a subspace rule: each descriptor has a weight of its attribute.
+   *  The premise is compiled into a sparse list of active attributes
+   *  with cached powers of their weights \f$ z^e \f$. Attributes with
+   *  \f$ z^e \f$ not greater than the negligible weight are skipped in evaluation
+   *  and tuning: their weighted firings lie in \f$ [1 - z^e, 1] \f$, so for
+   *  the product, minimum and Łukasiewicz t-norms each skipped attribute changes
+   *  the firing strength at most by the negligible weight. Parameters of skipped
+   *  attributes are not tuned. The list is compiled again when weights are modified
+   *  by the premise (augment_attribute, actualise_parameters) and when descriptors are added;
+   *  after weights of descriptors are modified directly, call compile_active_attributes.
+   *  @date 2026-10-19 */
   class subspace_premise : virtual public premise
   {
      /** default weight exponent */
      double _weight_expo = 2.0;
+     
+     /** attributes with powers of weights not greater than this value are skipped,
+         a negative value: all attributes are evaluated */
+     double _negligible_weight = 1e-6;
+     
+     /** indices of active attributes */
+     std::vector<std::size_t> _active_attributes;
+     /** powers of weights of active attributes z^_weight_expo */
+     std::vector<double> _active_weights;
+     /** number of descriptors when the active attributes were compiled */
+     std::size_t _compiled_descriptors = 0;
+     
   public:
      subspace_premise ();
      /** construct a subspace premise with weight exponent */
@@ -54,6 +77,27 @@ namespace ksi
      
      /** The method augments a-th attribute weights. */
      void augment_attribute (int a, double maxi_weight);
+     
+     /** The method actualises values of parameters of descriptors 
+       * and compiles the active attributes with new weights.
+       * @param eta learning coefficient
+       * @date 2026-10-19
+       */
+     virtual void actualise_parameters (double eta) override;
+     
+     /** The method compiles the list of active attributes and powers of their weights.
+      *  @date 2026-10-19 */
+     void compile_active_attributes ();
+     
+     /** The method sets the negligible weight and compiles the active attributes.
+      *  @param negligible_weight attributes with powers of weights not greater than
+      *         this value are skipped, a negative value: all attributes are evaluated
+      *  @date 2026-10-19 */
+     void set_negligible_weight (const double negligible_weight);
+     
+     /** @return number of active attributes 
+      *  @date 2026-10-19 */
+     std::size_t get_number_of_active_attributes ();
       
   };
 }
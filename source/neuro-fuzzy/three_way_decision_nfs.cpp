@@ -5,6 +5,7 @@
 #include <tuple>
 #include <iostream>
 #include <iomanip>
+#include <numeric>
 #include <sstream>
 #include <syncstream>
 
@@ -262,8 +263,10 @@ void ksi::three_way_decision_nfs::createFuzzyRulebase(const ksi::dataset& train,
 {
     try 
     {
-        auto zbior_treningowy = train;
-        auto nAttributes = zbior_treningowy.getNumberOfAttributes(); 
+        auto nAttributes = train.getNumberOfAttributes(); 
+        // indeksy (w zbiorze treningowym) danych dla kolejnego systemu w kaskadzie
+        std::vector<std::size_t> indices (train.size());
+        std::iota(indices.begin(), indices.end(), 0);
         bool remove_system = false;
         for (std::size_t i = 0; i < _cascade.size(); i++)
         {
@@ -278,7 +281,10 @@ void ksi::three_way_decision_nfs::createFuzzyRulebase(const ksi::dataset& train,
                 pSystem->set_validation_data_file (this->_validation_data_file);
                 pSystem->set_test_data_file (this->_test_data_file);
                 pSystem->set_output_file(this->_output_file + std::to_string(i));
-                pSystem->set_train_dataset(zbior_treningowy);
+                if (i == 0)
+                    pSystem->set_train_dataset(train);
+                else 
+                    pSystem->set_train_dataset(train.subdataset(indices));
                 pSystem->set_validation_dataset(validation);
                 pSystem->set_test_dataset(test);
                 pSystem->experiment_classification_core(); 
@@ -287,10 +293,10 @@ void ksi::three_way_decision_nfs::createFuzzyRulebase(const ksi::dataset& train,
                 auto results_train = pSystem->get_answers_for_train_classification();
                 auto threshold_value = pSystem->get_threshold_value();
                 
-                // zapisanie do zbioru_treningowego danych bliskich progowi
-                zbior_treningowy = extract_poor_results(zbior_treningowy, results_train, threshold_value, _noncommitment_widths[i]); 
+                // zapamietanie indeksow danych bliskich progowi
+                indices = extract_poor_results(indices, results_train, threshold_value, _noncommitment_widths[i]); 
                   
-                if (zbior_treningowy.size() < nAttributes)
+                if (indices.size() < nAttributes)
                 {
                     // wszystkie nastepne systemy trzeba skasowac
                     remove_system = true;  
@@ -308,19 +314,14 @@ double ksi::three_way_decision_nfs::answer(const ksi::datum& item) const
     {
         double result = std::numeric_limits<double>::signaling_NaN();
         
-        std::size_t number_of_rules = 0;
         for (std::size_t i = 0; i < _cascade.size(); i++)
         {
             auto & pSystem = _cascade[i];
-            number_of_rules += pSystem->get_number_of_rules();
             result = pSystem->answer(item);
             auto threshold_value = pSystem->get_threshold_value();
             
             if (std::fabs(result - threshold_value) > _noncommitment_widths[i])
-            {
-                _number_of_rules_used += number_of_rules;
                 return result;
-            }
         }
         return result; 
     }
@@ -329,23 +330,44 @@ double ksi::three_way_decision_nfs::answer(const ksi::datum& item) const
 
 std::vector<std::tuple<double, double, double>> ksi::three_way_decision_nfs::get_answers_for_train_classification()
 {
-    _number_of_rules_used = 0;
-    _number_of_data_items = 0;
-    auto result = ksi::neuro_fuzzy_system::get_answers_for_train_classification();
-    auto data_size = _TrainDataset.size();
-    _dbTrainAverageNumerOfRulesUsed = 1.0 * _number_of_rules_used / _number_of_data_items;
-    return result;
+    constexpr std::size_t MAX {std::numeric_limits<std::size_t>::max()};
+    return get_answers_for_train_classification(MAX);
 }
 
 
 std::vector<std::tuple<double, double, double>> ksi::three_way_decision_nfs::get_answers_for_test_classification()
 {
-    _number_of_rules_used = 0;
-    _number_of_data_items = 0;
-    auto result = ksi::neuro_fuzzy_system::get_answers_for_test_classification();
-    auto data_size = _TestDataset.size();
-    _dbTestAverageNumerOfRulesUsed = 1.0 * _number_of_rules_used / _number_of_data_items;
-    return result;
+    constexpr std::size_t MAX {std::numeric_limits<std::size_t>::max()};
+    return get_answers_for_test_classification(MAX);
+}
+
+std::vector<std::tuple<double, double, double>> ksi::three_way_decision_nfs::elaborate_answers_for_classification(const ksi::dataset & ds, const std::size_t cascade_depth, double & average_number_of_rules_used)
+{
+    try 
+    {
+        auto XY = ds.splitDataSetVertically(ds.getNumberOfAttributes() - 1);
+        std::size_t nX = ds.getNumberOfData();
+        
+        std::vector<std::size_t> items_per_stage;
+        auto answers = answer_classification_cascade(XY.first, cascade_depth, items_per_stage);
+        
+        std::vector<std::tuple<double, double, double>> result (nX);
+        for (std::size_t i = 0; i < nX; i++)
+        {
+            auto [ elaborated_numeric, elaborated_class ] = answers[i];
+            result[i] = { XY.second.get(i, 0), elaborated_numeric, elaborated_class };
+        }
+        
+        // Each data item evaluated by a system in the cascade uses all its rules.
+        _number_of_rules_used = 0;
+        for (std::size_t s = 0; s < items_per_stage.size(); s++)
+            _number_of_rules_used += items_per_stage[s] * static_cast<std::size_t>(_cascade[s]->get_number_of_rules());
+        _number_of_data_items = nX;
+        
+        average_number_of_rules_used = 1.0 * _number_of_rules_used / _number_of_data_items;
+        return result;
+    }
+    CATCH;
 }
 
 double ksi::three_way_decision_nfs::get_train_F1score_for_part_of_the_cascade(const std::size_t depth) 
@@ -396,52 +418,13 @@ double ksi::three_way_decision_nfs::get_test_F1score_for_part_of_the_cascade(con
 
 std::vector<std::tuple<double, double, double> > ksi::three_way_decision_nfs::get_answers_for_train_classification(const std::size_t cascade_depth)
 {
-    _number_of_rules_used = 0;
-    _number_of_data_items = 0;
-    
-    _answers_for_train.clear();
-    
-    auto XYtrain = _TrainDataset.splitDataSetVertically(_TrainDataset.getNumberOfAttributes() - 1);
-    std::size_t nXtrain  = _TrainDataset.getNumberOfData();
-    
-    _answers_for_train.resize(nXtrain);
-    #pragma omp parallel for 
-    for (std::size_t i = 0; i < nXtrain; i++)
-    {
-        auto [ elaborated_numeric, elaborated_class ] = answer_classification(*(XYtrain.first.getDatum(i)), cascade_depth);
-        auto expected = XYtrain.second.get(i, 0);
-        
-        // _answers_for_train.push_back({expected, elaborated_numeric, elaborated_class});
-        _answers_for_train[i] = {expected, elaborated_numeric, elaborated_class}; 
-    }
-    
-    auto data_size = _TrainDataset.size();
-    _dbTrainAverageNumerOfRulesUsed = 1.0 * _number_of_rules_used / _number_of_data_items;
+    _answers_for_train = elaborate_answers_for_classification(_TrainDataset, cascade_depth, _dbTrainAverageNumerOfRulesUsed);
     return _answers_for_train;
 }
 
 std::vector<std::tuple<double, double, double> > ksi::three_way_decision_nfs::get_answers_for_test_classification(const std::size_t cascade_depth)
 {
-    _number_of_rules_used = 0;
-    _number_of_data_items = 0;
-    
-    _answers_for_test.clear(); 
-    
-    auto XYtest  = _TestDataset.splitDataSetVertically(_TestDataset.getNumberOfAttributes() - 1);
-    std::size_t nXtest  = _TestDataset.getNumberOfData();
-    
-    _answers_for_test.resize(nXtest);
-    #pragma omp parallel for 
-    for (std::size_t i = 0; i < nXtest; i++)
-    {
-        auto [ elaborated_numeric, elaborated_class ] = answer_classification(*(XYtest.first.getDatum(i)), cascade_depth);
-        auto expected = XYtest.second.get(i, 0);
-        
-        // _answers_for_test.push_back({expected, elaborated_numeric, elaborated_class});
-        _answers_for_test[i] = {expected, elaborated_numeric, elaborated_class}; 
-    }
-    auto data_size = _TestDataset.size();
-    _dbTestAverageNumerOfRulesUsed = 1.0 * _number_of_rules_used / _number_of_data_items;
+    _answers_for_test = elaborate_answers_for_classification(_TestDataset, cascade_depth, _dbTestAverageNumerOfRulesUsed);
     return _answers_for_test;
 }
 
@@ -488,54 +471,100 @@ std::pair<double, double> ksi::three_way_decision_nfs::answer_classification(con
     {
         auto nan = std::numeric_limits<double>::signaling_NaN();
         auto result = std::make_pair (nan, nan);
-        std::size_t number_of_rules = 0;
         
         auto depth = std::min(cascade_depth, _cascade.size() - 1);
         for (std::size_t i = 0; i < depth + 1; i++)
         {
             auto & pSystem = _cascade[i];
             result = pSystem->answer_classification(item);
-            number_of_rules += pSystem->get_number_of_rules();
             auto threshold_value = pSystem->get_threshold_value();
             auto numeric = result.first;
             if ((i == depth) or (std::fabs(numeric - threshold_value) > _noncommitment_widths[i]))
-            {
-                ++_number_of_data_items;
-                _number_of_rules_used += number_of_rules;
                 return result;
-            }
         }
-        ++_number_of_data_items;
-        _number_of_rules_used += number_of_rules;
         return result; 
     }
     CATCH;
 }
 
-ksi::dataset ksi::three_way_decision_nfs::extract_poor_results(
-    const ksi::dataset & data, 
+std::vector<std::pair<double, double>> ksi::three_way_decision_nfs::answer_classification_cascade(
+    const ksi::dataset & X, 
+    const std::size_t cascade_depth, 
+    std::vector<std::size_t> & items_per_stage) const
+{
+    try 
+    {
+        auto nan = std::numeric_limits<double>::signaling_NaN();
+        const std::size_t nX = X.getNumberOfData();
+        std::vector<std::pair<double, double>> answers (nX, {nan, nan});
+        
+        items_per_stage.assign(_cascade.size(), 0);
+        if (_cascade.empty())
+            return answers;
+        
+        // indices of data items undecided by the previous systems in the cascade
+        std::vector<std::size_t> undecided (nX);
+        std::iota(undecided.begin(), undecided.end(), 0);
+        std::vector<char> decided;
+        
+        auto depth = std::min(cascade_depth, _cascade.size() - 1);
+        for (std::size_t i = 0; i < depth + 1 and not undecided.empty(); i++)
+        {
+            auto & pSystem = _cascade[i];
+            const auto threshold_value = pSystem->get_threshold_value();
+            const auto width = _noncommitment_widths[i];
+            const bool last = (i == depth);
+            const std::size_t nUndecided = undecided.size();
+            
+            items_per_stage[i] = nUndecided;
+            decided.assign(nUndecided, 0);
+            
+            #pragma omp parallel for
+            for (std::size_t j = 0; j < nUndecided; j++)
+            {
+                auto index = undecided[j];
+                answers[index] = pSystem->answer_classification(*(X.getDatum(index)));
+                decided[j] = last or (std::fabs(answers[index].first - threshold_value) > width);
+            }
+            
+            // Only the undecided items are passed to the next system.
+            std::size_t k = 0;
+            for (std::size_t j = 0; j < nUndecided; j++)
+                if (not decided[j])
+                    undecided[k++] = undecided[j];
+            undecided.resize(k);
+        }
+        return answers;
+    }
+    CATCH;
+}
+
+std::vector<std::size_t> ksi::three_way_decision_nfs::extract_poor_results(
+    const std::vector<std::size_t> & indices, 
     const std::vector<std::tuple<double, double, double>> & answers, 
     const double threshold_value, 
     const double maximal_deviation)
 {
     try 
     {
-        std::vector<std::size_t> indices;
+        if (indices.size() != answers.size())
+        {
+            std::stringstream sos;
+            sos << "The number of indices (" << indices.size() << ") and the number of answers (" << answers.size() << ") do not match.";
+            throw sos.str();
+        }
+        
+        std::vector<std::size_t> poor_indices;
         
         for (std::size_t i = 0; i < answers.size(); i++)
         {
             double elaborated;
             std::tie(std::ignore, elaborated, std::ignore) = answers[i];
             if (fabs(threshold_value - elaborated) < maximal_deviation)
-                indices.push_back(i);
+                poor_indices.push_back(indices[i]);
         }
         
-        ksi::dataset poor_data;
-        for (const auto i : indices)
-        {
-            poor_data.addDatum(*data.getDatum(i));
-        }
-        return poor_data;    
+        return poor_indices;    
     }
     CATCH;
 }
@@ -21,10 +21,10 @@ namespace ksi
    class three_way_decision_nfs : public neuro_fuzzy_system
    {
    protected:
-       mutable std::size_t _number_of_rules_used      {0};
-       mutable std::size_t _number_of_data_items      {0};
-       mutable double _dbTrainAverageNumerOfRulesUsed {0.0};
-       mutable double _dbTestAverageNumerOfRulesUsed  {0.0};
+       std::size_t _number_of_rules_used      {0};
+       std::size_t _number_of_data_items      {0};
+       double _dbTrainAverageNumerOfRulesUsed {0.0};
+       double _dbTestAverageNumerOfRulesUsed  {0.0};
 
    protected:
        /** The vector stores F1score for the train dataset.
@@ -215,6 +215,18 @@ namespace ksi
        * @return a pair: elaborated numeric, class 
        * @date   2024-04-29 */
       virtual std::pair<double, double> answer_classification (const datum & item, const std::size_t depth) const;
+      
+      /** The method elaborates answers for classification for all items of a dataset.
+       *  The cascade is evaluated stage by stage: the first system answers all items,
+       *  only the items in its noncommitment interval are passed to the next system, and so on.
+       *  No fields are modified, so the method can be called concurrently.
+       * @param X dataset to elaborate answers for (without the decision attribute)
+       * @param cascade_depth number of systems (in the cascade) used to elaborate the answers 
+       *          Depth is indexed from 0 up to _cascade.size() - 1.
+       * @param items_per_stage [out] number of data items evaluated by each system in the cascade 
+       * @return pairs: elaborated numeric, class (for all items in X)
+       * @date   2026-10-18 */
+      std::vector<std::pair<double, double>> answer_classification_cascade (const dataset & X, const std::size_t cascade_depth, std::vector<std::size_t> & items_per_stage) const;
        
        /** The method prints rule base.
        * @param ss ostream to print to */
@@ -289,11 +301,26 @@ namespace ksi
                                          const ksi::roc_threshold & type) override;
               
    protected:
-       /** @todo Ta metoda jest do poprawy. Nie działa dobrze.  */
-       ksi::dataset extract_poor_results(const dataset & data, 
+       /** The method selects data items whose answers are in the noncommitment interval.
+        @param indices indices (in the original train dataset) of data items the answers have been elaborated for
+        @param results_train answers (expected, elaborated numeric, elaborated class) for the data items
+        @param threshold_value classification threshold
+        @param maximal_deviation half of the width of the noncommitment interval
+        @return indices (in the original train dataset) of data items with poor results
+        @date 2026-10-18 */
+       std::vector<std::size_t> extract_poor_results(const std::vector<std::size_t> & indices, 
                                          const std::vector<std::tuple<double, double, double>> & results_train, 
                                          const double threshold_value, 
                                          const double maximal_deviation);
+       
+       /** The method elaborates answers for classification for a dataset with the cascade
+        *  and updates the counters of rules used.
+        @param ds dataset (with the decision attribute) 
+        @param cascade_depth number of systems (in the cascade) used to elaborate the answers
+        @param average_number_of_rules_used [out] average number of rules used for one data item 
+        @return expected class, elaborated_numeric answer, elaborated_class for the dataset 
+        @date 2026-10-18 */
+       std::vector<std::tuple<double, double, double>> elaborate_answers_for_classification (const dataset & ds, const std::size_t cascade_depth, double & average_number_of_rules_used);
       
    protected:    
        std::string extra_report() const override;
@@ -0,0 +1,123 @@
+/** @file */
+
+#include <vector>
+#include <cmath>
+#include <string>
+#include <algorithm>
+
+#include "../neuro-fuzzy/tsk_consequents.h"
+#include "../service/debug.h"
+
+const std::size_t ksi::tsk_consequents::BLOCK_SIZE = 64;
+
+ksi::tsk_consequents::tsk_consequents(const std::vector<std::vector<double>> & parameters)
+{
+    try
+    {
+        _nRules = parameters.size();
+        _nAttributes = _nRules > 0 ? parameters[0].size() - 1 : 0;
+        for (const auto & p : parameters)
+            if (p.size() != _nAttributes + 1)
+                throw ksi::exception ("Consequences have different numbers of parameters: " + std::to_string(p.size()) + " and " + std::to_string(_nAttributes + 1) + ".");
+
+        _parameters.resize((_nAttributes + 1) * _nRules);
+        for (std::size_t r = 0; r < _nRules; r++)
+            for (std::size_t a = 0; a <= _nAttributes; a++)
+                _parameters[a * _nRules + r] = parameters[r][a];
+        _parameters_single.assign(_parameters.begin(), _parameters.end());
+    }
+    CATCH;
+}
+
+std::size_t ksi::tsk_consequents::get_number_of_rules() const
+{
+    return _nRules;
+}
+
+std::size_t ksi::tsk_consequents::get_number_of_attributes() const
+{
+    return _nAttributes;
+}
+
+std::vector<double> ksi::tsk_consequents::answers(const std::vector<std::vector<double>> & X,
+                                                  const std::vector<double> & firing_strengths) const
+{
+    try
+    {
+        return answers_T(X, _parameters, firing_strengths);
+    }
+    CATCH;
+}
+
+std::vector<double> ksi::tsk_consequents::answers(const std::vector<std::vector<double>> & X,
+                                                  const std::vector<float> & firing_strengths) const
+{
+    try
+    {
+        return answers_T(X, _parameters_single, firing_strengths);
+    }
+    CATCH;
+}
+
+template <class T>
+std::vector<double> ksi::tsk_consequents::answers_T(const std::vector<std::vector<double>> & X,
+                                                    const std::vector<T> & parameters,
+                                                    const std::vector<T> & firing_strengths) const
+{
+    try
+    {
+        const std::size_t nX = X.size();
+        if (firing_strengths.size() != nX * _nRules)
+            throw ksi::exception ("Number of firing strengths (" + std::to_string(firing_strengths.size()) + ") does not match number of data items times number of rules (" + std::to_string(nX * _nRules) + ").");
+        for (const auto & x : X)
+            if (x.size() != _nAttributes)
+                throw ksi::exception ("Size of data (" + std::to_string(x.size()) + ") and number of parameters (" + std::to_string(_nAttributes + 1) + ") do not match.");
+
+        std::vector<double> result (nX, 0.0);
+        const std::size_t nBlocks = (nX + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        const T * bias = parameters.data() + _nAttributes * _nRules;
+
+        #pragma omp parallel for
+        for (std::size_t b = 0; b < nBlocks; b++)
+        {
+            const std::size_t first = b * BLOCK_SIZE;
+            const std::size_t last  = std::min(first + BLOCK_SIZE, nX);
+            // local outputs of all rules for the block: (last - first) x _nRules
+            std::vector<T> local ((last - first) * _nRules, T {});
+
+            for (std::size_t x = first; x < last; x++)
+            {
+                T * row = local.data() + (x - first) * _nRules;
+                for (std::size_t a = 0; a < _nAttributes; a++)
+                {
+                    const T value = X[x][a];
+                    const T * p = parameters.data() + a * _nRules;
+                    for (std::size_t r = 0; r < _nRules; r++)
+                        row[r] += value * p[r];
+                }
+                for (std::size_t r = 0; r < _nRules; r++)
+                    row[r] += bias[r];
+            }
+
+            // weighted average with firing strengths
+            for (std::size_t x = first; x < last; x++)
+            {
+                const T * row = local.data() + (x - first) * _nRules;
+                const T * F = firing_strengths.data() + x * _nRules;
+                double sumLocalisationWeight = 0.0;
+                double sumWeight = 0.0;
+                for (std::size_t r = 0; r < _nRules; r++)
+                {
+                    if (std::isfinite(row[r]) and std::isfinite(F[r]))
+                    {
+                        sumLocalisationWeight += static_cast<double>(row[r]) * F[r];
+                        sumWeight += F[r];
+                    }
+                }
+                result[x] = sumWeight != 0.0 ? sumLocalisationWeight / sumWeight : 0.0;
+            }
+        }
+        return result;
+    }
+    CATCH;
+}
@@ -0,0 +1,77 @@
+/** @file */
+
+#ifndef TSK_CONSEQUENTS_H
+#define TSK_CONSEQUENTS_H
+
+#include <vector>
+
+namespace ksi
+{
+   /** Linear (TSK) consequences of all rules of a rulebase stored in one contiguous matrix.
+       The class elaborates answers of a rulebase for a batch of data items:
+       local outputs of all rules (a matrix product with an implicit bias column)
+       are elaborated in blocks of data items and immediately weighted 
+       with firing strengths of rules, so the local outputs are never stored 
+       for the whole batch.
+       @date 2026-10-18 */
+   class tsk_consequents
+   {
+   protected:
+      std::size_t _nRules;
+      std::size_t _nAttributes;
+      /** Parameters of consequences, attribute major: 
+          _parameters[a * _nRules + r] is the a-th parameter of the r-th rule,
+          the last row (a == _nAttributes) holds free parameters. */
+      std::vector<double> _parameters;
+      /** The same parameters in single precision. */
+      std::vector<float> _parameters_single;
+
+      /** number of data items elaborated in one block */
+      static const std::size_t BLOCK_SIZE;
+
+      /** The method elaborates answers with parameters and firing strengths of type T.
+          Local outputs of rules are elaborated in T, weighted sums are accumulated in double. */
+      template <class T>
+      std::vector<double> answers_T (const std::vector<std::vector<double>> & X,
+                                     const std::vector<T> & parameters,
+                                     const std::vector<T> & firing_strengths) const;
+
+   public:
+      /** @param parameters parameters of consequences of rules, 
+                 the last item in each vector is a free parameter
+          @throw ksi::exception if vectors have different sizes */
+      tsk_consequents (const std::vector<std::vector<double>> & parameters);
+
+      /** @return number of rules */
+      std::size_t get_number_of_rules () const;
+
+      /** @return number of attributes of data items (without the bias) */
+      std::size_t get_number_of_attributes () const;
+
+      /** The method elaborates answers of the rulebase for data items.
+          The answer is a weighted average of local outputs of rules,
+          firing strengths are weights. A rule with a non-finite local output
+          or firing strength is skipped (as in ksi::rulebase::answer).
+          @param X data items
+          @param firing_strengths firing strengths of rules for data items, 
+                 row major: firing_strengths[x * number_of_rules + r]
+          @return answers for data items (0 if all firing strengths are 0)
+          @throw ksi::exception if sizes do not match */
+      std::vector<double> answers (const std::vector<std::vector<double>> & X,
+                                   const std::vector<double> & firing_strengths) const;
+
+      /** The method elaborates answers of the rulebase for data items in single precision.
+          Data items are converted to float, local outputs of rules are elaborated in float,
+          the weighted average is accumulated in double.
+          @param X data items
+          @param firing_strengths firing strengths of rules for data items, 
+                 row major: firing_strengths[x * number_of_rules + r]
+          @return answers for data items (0 if all firing strengths are 0)
+          @throw ksi::exception if sizes do not match
+          @date 2026-10-18 */
+      std::vector<double> answers (const std::vector<std::vector<double>> & X,
+                                   const std::vector<float> & firing_strengths) const;
+   };
+}
+
+#endif
@@ -1,10 +1,12 @@
 
 #include <deque>
+#include <memory>
 
 #include "../neuro-fuzzy/neuro-fuzzy-system.h"
 #include "../neuro-fuzzy/abstract-annbfis.h"
 #include "../neuro-fuzzy/weighted_annbfis.h"
 #include "../neuro-fuzzy/logicalrule.h"
+#include "../neuro-fuzzy/rule_kernel.h"
 #include "../neuro-fuzzy/consequence-CL.h"
 #include "../tnorms/t-norm-product.h"
 #include "../auxiliary/error-RMSE.h"
@@ -180,9 +182,11 @@ void ksi::weighted_annbfis::createFuzzyRulebase
          regula.setPremise(przeslanka);
          consequence_CL konkluzja (std::vector<double>(nAttr_1 + 1, 1.0), INITIAL_W);
          regula.setConsequence(konkluzja);
+         // specialised kernel for the t-norm and implication (if available)
+         std::unique_ptr<rule> pRegula (make_rule_kernel(regula));
 
          #pragma omp critical
-         _pRulebase->addRule(regula);
+         _pRulebase->addRule(*pRegula);
       }
       
       
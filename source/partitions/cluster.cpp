@@ -8,6 +8,7 @@
 #include "../granules/granule.h"
 #include "../service/debug.h"
 #include "../auxiliary/matrix.h"
+#include "../auxiliary/random_service.h"
 
 
 std::size_t ksi::cluster::get_number_of_desciptors() const
@@ -170,10 +171,16 @@ const ksi::number ksi::cluster::get_answer(const ksi::datum& d)
 }
 
 ksi::datum ksi::cluster::get_data_item()
+{
+    auto engine = ksi::random_service::next_engine();
+    return get_data_item(engine);
+}
+
+ksi::datum ksi::cluster::get_data_item(std::default_random_engine & engine)
 {
     ksi::datum d; 
     for (auto * p : descriptors)
-        d.push_back(p->getRandomValue(_engine));
+        d.push_back(p->getRandomValue(engine));
     
     return d;
 }
@@ -83,6 +83,11 @@ namespace ksi
         /** @return The method returns a data_item represented by the data granule. */
         virtual datum get_data_item ();
         
+        /** @return The method returns a random data item drawn from the descriptors of the cluster.
+            @param engine random engine 
+            @date 2026-10-18 */
+        virtual datum get_data_item (std::default_random_engine & engine) override;
+        
         /** @return The method returns a decision for a datum.
             @param  d the datum to elaborated answer for .
             @todo Jaka powinna być odpowiedź dla klastra?
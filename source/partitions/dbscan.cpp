@@ -3,6 +3,7 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <utility>
 
 #include "../partitions/dbscan.h"
 #include "../metrics/metric.h"
@@ -32,8 +33,8 @@ ksi::partition ksi::dbscan::doPartition(const ksi::dataset &ds)
 
 		std::size_t dsSize = ds.getNumberOfData();
 
-		// partition matrix
-		std::vector<std::vector<double>> mU;
+		// crisp partition: label of cluster for each datum (-1: noise)
+		std::vector<int> labels(dsSize, -1);
 
 		std::vector<DatumState> datumStates(dsSize, UNDEFINED);
 
@@ -52,9 +53,8 @@ ksi::partition ksi::dbscan::doPartition(const ksi::dataset &ds)
 			}
 
 			++C;
-			mU.push_back(std::vector<double>(dsSize, 0.0));
 			// cluster membership
-			mU[C][i] = 1.0;
+			labels[i] = C;
 			datumStates[i] = CLUSTER_MEMBER;
 
 			for (std::size_t j = 0; j < neighborsSize; ++j)
@@ -63,13 +63,13 @@ ksi::partition ksi::dbscan::doPartition(const ksi::dataset &ds)
 
 				if (datumStates[neighborIndex] == NOISE)
 				{
-					mU[C][neighborIndex] = 1.0;
+					labels[neighborIndex] = C;
 					datumStates[neighborIndex] = CLUSTER_MEMBER;
 				}
 				if (datumStates[neighborIndex] != UNDEFINED)
 					continue;
 
-				mU[C][neighborIndex] = 1.0;
+				labels[neighborIndex] = C;
 				datumStates[neighborIndex] = CLUSTER_MEMBER;
 
 				auto expandedNeighborsIndices = findNeighborsIndices(neighborIndex, ds);
@@ -88,7 +88,8 @@ ksi::partition ksi::dbscan::doPartition(const ksi::dataset &ds)
 		}
 
 		ksi::partition part;
-		part.setPartitionMatrix(mU);
+		part.set_crisp_labels(std::move(labels), C + 1);
+		part.elaborate_gaussian_clusters(ds);
 		return part;
 	}
 	CATCH
@@ -41,7 +41,10 @@ namespace ksi
 
 		/** The method executes DBSCAN clustering algorithm.
 		 * @param ds dataset to cluster
-		 * @return partition into clusters
+		 * @return partition into clusters stored as crisp labels 
+		 *         (memory proportional to the number of data items)
+		 *         with Gaussian clusters elaborated from labels 
+		 *         (see ksi::partition::elaborate_gaussian_clusters)
 		 */
 		partition doPartition(const dataset &ds);
 
@@ -12,6 +12,7 @@
 #include <chrono>
 #include <sstream>
 
+#include "../auxiliary/random_service.h"
 #include "../auxiliary/definitions.h"
 #include "partitioner.h"
 #include "partition.h"
@@ -293,11 +294,8 @@ void ksi::fcm_T_metrics<T>::randomise(std::vector<std::vector<T>> & m)
 {
    try
    {
-      auto czas = std::chrono::system_clock::now();
-      auto interwal = czas.time_since_epoch();
-      std::default_random_engine silnik;
+      auto silnik = ksi::random_service::next_stream();
       std::uniform_real_distribution <double> rozklad(0, 1);
-      silnik.seed(interwal.count());
       
       for (auto & wiersz : m)
          for (auto & liczba : wiersz)
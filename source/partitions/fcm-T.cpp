@@ -100,3 +100,57 @@ ksi::partition ksi::fcm_T<ksi::ext_fuzzy_number_gaussian>::elaborate_gaussian_pa
    
    return part;
 }
+
+template<>
+ksi::dataset ksi::fcm_T<float>::elaborate_gaussian_prototypes (
+   const int _nClusters, 
+   const int nAttr,  
+   const std::vector<std::vector<float>> & mV, 
+   const std::vector<std::vector<float>> & mS)
+{
+   ksi::dataset ds;
+   
+   for (std::size_t c = 0; c < _nClusters; c++)
+   {
+      ksi::datum d;
+      for (std::size_t a = 0; a < nAttr; a++)
+      {
+         ksi::ext_fuzzy_number_gaussian num (mV[c][a], mS[c][a]);
+         d.push_back(ksi::number (num));
+      }
+      ds.addDatum(d);
+   }
+   return ds;
+}
+
+template <> 
+ksi::partition ksi::fcm_T<float>::elaborate_gaussian_partition (
+   const int _nClusters, 
+   const int nAttr, 
+   const std::vector<std::vector<float>> & mV, 
+   const std::vector<std::vector<float>> & mS)
+{
+   // przeksztalcenie do postaci zbiorow gaussowskich
+   ksi::partition part;
+   for (int c = 0; c < _nClusters; c++)
+   {
+      ksi::cluster cl; 
+      for (std::size_t a = 0; a < nAttr; a++)
+      {
+         ksi::descriptor_gaussian d (mV[c][a], mS[c][a]);
+         cl.addDescriptor(d);
+      }
+      part.addCluster(cl);
+   }
+   
+   // partition keeps matrices in double
+   std::vector<std::vector<double>> V (mV.size()), U (mU.size());
+   for (std::size_t c = 0; c < mV.size(); c++)
+      V[c].assign(mV[c].begin(), mV[c].end());
+   for (std::size_t c = 0; c < mU.size(); c++)
+      U[c].assign(mU[c].begin(), mU[c].end());
+   part.setClusterCentres(V);
+   part.setPartitionMatrix(std::move(U));
+   
+   return part;
+}
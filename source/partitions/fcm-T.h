@@ -12,6 +12,7 @@
 #include <chrono>
 #include <sstream>
 
+#include "../auxiliary/random_service.h"
 #include "../auxiliary/definitions.h"
 #include "partitioner.h"
 #include "partition.h"
@@ -25,11 +26,31 @@
 
 namespace ksi
 {
-   /** The class implements Fuzzy C-means clustering algorithm. */
+   /** Type of sums over data items in ksi::fcm_T.
+       Sums of single precision values are accumulated in double.
+       @date 2026-10-18 */
+   template<class T>
+   struct fcm_accumulator
+   {
+      typedef T type;
+   };
+   
+   template<>
+   struct fcm_accumulator<float>
+   {
+      typedef double type;
+   };
+   
+   /** The class implements Fuzzy C-means clustering algorithm. 
+       The class is instantiated for double, float (distances and memberships 
+       in single precision, sums in double), and ksi::ext_fuzzy_number_gaussian. */
    template<class T>
    class fcm_T : virtual public partitioner
    {
    protected:
+      /** type of sums over data items */
+      typedef typename fcm_accumulator<T>::type A;
+      
       /** fuzzification parameter */
       double _m = 2.0;
       // /** number of clusters */
@@ -241,8 +262,8 @@ std::vector<std::vector<T>> ksi::fcm_T<T>::calculateClusterCentres(
          std::size_t nAttr = X[0].size();
          for (int c = 0; c < _nClusters; c++)
          {
-            std::vector<T> suma_x (nAttr, 0.0);
-            T suma_u_ci_m {};
+            std::vector<A> suma_x (nAttr, 0.0);
+            A suma_u_ci_m {};
             
             for (std::size_t i = 0; i < nX; i++)
             {
@@ -271,11 +292,8 @@ void ksi::fcm_T<T>::randomise(std::vector<std::vector<T>> & m)
 {
    try
    {
-      auto czas = std::chrono::system_clock::now();
-      auto interwal = czas.time_since_epoch();
-      std::default_random_engine silnik;
+      auto silnik = ksi::random_service::next_stream();
       std::uniform_real_distribution <double> rozklad(0, 1);
-      silnik.seed(interwal.count());
       
       for (auto & wiersz : m)
          for (auto & liczba : wiersz)
@@ -296,7 +314,7 @@ void ksi::fcm_T<T>::normaliseByColumns(std::vector<std::vector<T>> & m)
          
          for (std::size_t a = 0; a < nAttr; a++)
          {
-            T suma {};
+            A suma {};
             for (std::size_t r = 0; r < nRows; r++)
                suma += m[r][a];
             for (std::size_t r = 0; r < nRows; r++)
@@ -349,7 +367,7 @@ std::vector<std::vector<T>> ksi::fcm_T<T>::modifyPartitionMatrix(
             u = std::vector<T> (nX);
 
          // distance matrix:
-         std::vector<T>   Dmsums  (nX, T{});
+         std::vector<A>   Dmsums  (nX, A{});
          std::vector<int> Dmzeros (nX, 0.0);
          Dm = std::vector<std::vector<T>> (nClusters);
          for (std::size_t c = 0; c < nClusters; c++)
@@ -447,8 +465,8 @@ std::vector< std::vector<T>> ksi::fcm_T<T>::calculateClusterFuzzification(
          
          for (int c = 0; c < _nClusters; c++)
          {
-            T sumU {};
-            std::vector<T> sumUXV (nAttr, 0.0);
+            A sumU {};
+            std::vector<A> sumUXV (nAttr, 0.0);
             for (std::size_t x = 0; x < nX; x++)
             {
                T um = ksi::power(mU[c][x], _m);
@@ -0,0 +1,484 @@
+/** @file */
+
+#include <cmath>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+
+#include "../common/dataset.h"
+#include "../common/datum.h"
+#include "../descriptors/descriptor-gaussian.h"
+#include "../partitions/cluster.h"
+#include "../partitions/partition.h"
+#include "../partitions/fcm_minibatch.h"
+#include "../service/debug.h"
+
+namespace
+{
+   /** minimal number of data items in a block elaborated by one thread */
+   const std::size_t BLOCK_SIZE = 4096;
+   /** maximal number of blocks, it bounds memory of partial sums */
+   const std::size_t MAX_BLOCKS = 1024;
+
+   /** @return number of blocks of n data items, it does not depend on the number of threads */
+   std::size_t number_of_blocks (const std::size_t n)
+   {
+      return std::max<std::size_t>(1, std::min(MAX_BLOCKS, (n + BLOCK_SIZE - 1) / BLOCK_SIZE));
+   }
+
+   /** maximal number of items of the sample, in which cluster centres are seeded */
+   const std::size_t SEEDING_SIZE = 4096;
+
+   /** The function reads values of attributes of a data item without a copy of the datum. */
+   void read_item (const ksi::dataset & ds, const std::size_t r, const std::size_t nAttr, double * x)
+   {
+      const ksi::datum * p = ds.getDatum(r);
+      for (std::size_t a = 0; a < nAttr; a++)
+         x[a] = p->at(a)->getValue();
+   }
+}
+
+ksi::fcm_minibatch::fcm_minibatch(const int nClusters, const int nIterations,
+                                  const std::size_t batch_size, const std::size_t coreset_size)
+: _batch_size (batch_size), _coreset_size (coreset_size)
+{
+   _nClusters = nClusters;
+   _nIterations = nIterations;
+}
+
+ksi::fcm_minibatch::~fcm_minibatch()
+{
+}
+
+void ksi::fcm_minibatch::setFuzzification(const double m)
+{
+   try
+   {
+      if (m <= 1)
+         throw ksi::exception ("The fuzzification parameter (" + std::to_string(m) + ") should be greater than 1.");
+      _m = m;
+   }
+   CATCH;
+}
+
+ksi::partitioner * ksi::fcm_minibatch::clone() const
+{
+   return new ksi::fcm_minibatch (*this);
+}
+
+std::string ksi::fcm_minibatch::getAbbreviation() const
+{
+   return std::string ("fcm_minibatch");
+}
+
+void ksi::fcm_minibatch::memberships(const double * x, const std::vector<double> & V,
+                                     const std::size_t nAttr, double * u) const
+{
+   const std::size_t nClusters = V.size() / nAttr;
+   std::size_t zeros = 0;
+   for (std::size_t c = 0; c < nClusters; c++)
+   {
+      const double * v = V.data() + c * nAttr;
+      double distance {0};
+      for (std::size_t a = 0; a < nAttr; a++)
+         distance += (x[a] - v[a]) * (x[a] - v[a]);
+      u[c] = distance;
+      if (distance == 0)
+         zeros++;
+   }
+
+   // the item lies in centres: memberships are shared by these clusters
+   if (zeros > 0)
+   {
+      for (std::size_t c = 0; c < nClusters; c++)
+         u[c] = (u[c] == 0) ? 1.0 / zeros : 0.0;
+      return;
+   }
+
+   // u_c ~ (distance^2)^(1 / (1 - m))
+   const double exponent = 1.0 / (1.0 - _m);
+   double sum {0};
+   for (std::size_t c = 0; c < nClusters; c++)
+   {
+      u[c] = (_m == 2.0) ? 1.0 / u[c] : std::pow(u[c], exponent);
+      sum += u[c];
+   }
+   for (std::size_t c = 0; c < nClusters; c++)
+      u[c] /= sum;
+}
+
+std::vector<double> ksi::fcm_minibatch::seed_centres(const std::vector<double> & X,
+                                                     const std::vector<double> & weights,
+                                                     const std::size_t nAttr, ksi::philox & engine) const
+{
+   const std::size_t nItems = weights.size();
+   const std::size_t nClusters = _nClusters;
+   std::uniform_real_distribution<double> distribution (0.0, 1.0);
+
+   // index of an item drawn with probabilities proportional to values
+   auto draw = [&] (const std::vector<double> & values)
+   {
+      double total {0};
+      for (const auto value : values)
+         total += value;
+      // all items lie in centres: any item
+      if (not (total > 0))
+         return std::min(nItems - 1, static_cast<std::size_t>(distribution(engine) * nItems));
+      double threshold = distribution(engine) * total;
+      for (std::size_t i = 0; i < nItems; i++)
+      {
+         threshold -= values[i];
+         if (threshold < 0)
+            return i;
+      }
+      return nItems - 1;
+   };
+
+   std::vector<double> V;
+   V.reserve(nClusters * nAttr);
+   // weights of items times squared distances to the closest centre
+   std::vector<double> values (weights);
+   for (std::size_t c = 0; c < nClusters; c++)
+   {
+      const std::size_t chosen = draw(values);
+      const double * v = X.data() + chosen * nAttr;
+      V.insert(V.end(), v, v + nAttr);
+      for (std::size_t i = 0; i < nItems; i++)
+      {
+         const double * x = X.data() + i * nAttr;
+         double distance {0};
+         for (std::size_t a = 0; a < nAttr; a++)
+            distance += (x[a] - v[a]) * (x[a] - v[a]);
+         values[i] = (c == 0) ? weights[i] * distance : std::min(values[i], weights[i] * distance);
+      }
+   }
+   return V;
+}
+
+ksi::fcm_minibatch::coreset ksi::fcm_minibatch::build_coreset(const ksi::dataset & ds, ksi::philox & engine) const
+{
+   try
+   {
+      const std::size_t nX = ds.getNumberOfData();
+      const std::size_t nAttr = ds.getNumberOfAttributes();
+      const std::size_t m = _coreset_size;
+      const std::size_t nBlocks = number_of_blocks(nX);
+      const std::size_t length = (nX + nBlocks - 1) / nBlocks;
+
+      // sweep 1: mean of data
+      std::vector<double> partial_sums (nBlocks * nAttr, 0.0);
+      #pragma omp parallel for
+      for (std::size_t b = 0; b < nBlocks; b++)
+      {
+         std::vector<double> x (nAttr);
+         double * sums = partial_sums.data() + b * nAttr;
+         const std::size_t last = std::min(nX, (b + 1) * length);
+         for (std::size_t r = b * length; r < last; r++)
+         {
+            read_item(ds, r, nAttr, x.data());
+            for (std::size_t a = 0; a < nAttr; a++)
+               sums[a] += x[a];
+         }
+      }
+      std::vector<double> mean (nAttr, 0.0);
+      for (std::size_t b = 0; b < nBlocks; b++)
+         for (std::size_t a = 0; a < nAttr; a++)
+            mean[a] += partial_sums[b * nAttr + a];
+      for (auto & value : mean)
+         value /= nX;
+
+      auto squared_distance = [&mean, nAttr] (const double * x)
+      {
+         double distance {0};
+         for (std::size_t a = 0; a < nAttr; a++)
+            distance += (x[a] - mean[a]) * (x[a] - mean[a]);
+         return distance;
+      };
+
+      // sweep 2: sums of squared distances to the mean in blocks
+      std::vector<double> block_sums (nBlocks, 0.0);
+      #pragma omp parallel for
+      for (std::size_t b = 0; b < nBlocks; b++)
+      {
+         std::vector<double> x (nAttr);
+         const std::size_t last = std::min(nX, (b + 1) * length);
+         for (std::size_t r = b * length; r < last; r++)
+         {
+            read_item(ds, r, nAttr, x.data());
+            block_sums[b] += squared_distance(x.data());
+         }
+      }
+      double total {0};
+      for (const auto sum : block_sums)
+         total += sum;
+
+      auto probability = [nX, total] (const double distance)
+      {
+         return total > 0 ? 0.5 / nX + 0.5 * distance / total : 1.0 / nX;
+      };
+
+      // m sorted uniform numbers select items by the cumulative distribution of q,
+      // the first uniform number of each block is found with the masses of blocks
+      std::uniform_real_distribution<double> distribution (0.0, 1.0);
+      std::vector<double> thresholds (m);
+      for (auto & threshold : thresholds)
+         threshold = distribution(engine);
+      std::sort(thresholds.begin(), thresholds.end());
+
+      std::vector<double> block_starts (nBlocks + 1, 0.0);
+      for (std::size_t b = 0; b < nBlocks; b++)
+      {
+         const std::size_t items = std::min(nX, (b + 1) * length) - std::min(nX, b * length);
+         const double mass = total > 0 ? 0.5 * items / nX + 0.5 * block_sums[b] / total : 1.0 * items / nX;
+         block_starts[b + 1] = block_starts[b] + mass;
+      }
+
+      // sweep 3: drawn items and their weights
+      coreset result;
+      result.X.resize(m * nAttr);
+      result.weights.resize(m);
+      #pragma omp parallel for
+      for (std::size_t b = 0; b < nBlocks; b++)
+      {
+         std::size_t k = std::lower_bound(thresholds.begin(), thresholds.end(), block_starts[b]) - thresholds.begin();
+         const std::size_t end = (b + 1 == nBlocks) ? m
+                               : std::lower_bound(thresholds.begin(), thresholds.end(), block_starts[b + 1]) - thresholds.begin();
+         std::vector<double> x (nAttr);
+         double cumulative = block_starts[b];
+         const std::size_t last = std::min(nX, (b + 1) * length);
+         for (std::size_t r = b * length; r < last and k < end; r++)
+         {
+            read_item(ds, r, nAttr, x.data());
+            const double q = probability(squared_distance(x.data()));
+            cumulative += q;
+            // rounding of the cumulative sum: the rest of the block goes to its last item
+            while (k < end and (thresholds[k] < cumulative or r + 1 == last))
+            {
+               std::copy(x.begin(), x.end(), result.X.begin() + k * nAttr);
+               result.weights[k] = 1.0 / (m * q);
+               k++;
+            }
+         }
+      }
+      return result;
+   }
+   CATCH;
+}
+
+ksi::partition ksi::fcm_minibatch::doPartition(const ksi::dataset & ds)
+{
+   try
+   {
+      if (_nClusters < 1)
+         throw ksi::exception ("unknown number of clusters");
+      if (_nIterations < 1)
+         throw ksi::exception ("unknown number of iterations");
+
+      const std::size_t nClusters = _nClusters;
+      const std::size_t nAttr = ds.getNumberOfAttributes();
+      const std::size_t nX = ds.getNumberOfData();
+
+      auto engine = ksi::random_service::next_stream();
+
+      const bool use_coreset = _coreset_size > 0 and _coreset_size < nX;
+      coreset sample;
+      if (use_coreset)
+         sample = build_coreset(ds, engine);
+      const std::size_t nSample = use_coreset ? sample.weights.size() : nX;
+      if (nSample < nClusters)
+         throw ksi::exception ("The number of data items (" + std::to_string(nSample) + ") is less than the number of clusters (" + std::to_string(nClusters) + ").");
+
+      // i-th item of the sample: its values (read into the buffer for items of the dataset) and weight
+      auto get_item = [&] (const std::size_t i, double * buffer, const double * & x)
+      {
+         if (use_coreset)
+         {
+            x = sample.X.data() + i * nAttr;
+            return sample.weights[i];
+         }
+         read_item(ds, i, nAttr, buffer);
+         x = buffer;
+         return 1.0;
+      };
+
+      // cluster centres, row major, seeded in a random subset of the sample
+      std::vector<double> V;
+      {
+         const std::size_t nSeeding = std::min(nSample, SEEDING_SIZE);
+         std::uniform_int_distribution<std::size_t> distribution (0, nSample - 1);
+         std::vector<double> X (nSeeding * nAttr), weights (nSeeding), buffer (nAttr);
+         for (std::size_t j = 0; j < nSeeding; j++)
+         {
+            const double * x;
+            weights[j] = get_item(nSeeding == nSample ? j : distribution(engine), buffer.data(), x);
+            std::copy(x, x + nAttr, X.begin() + j * nAttr);
+         }
+         V = seed_centres(X, weights, nAttr, engine);
+      }
+
+      /* The lambda accumulates for items of the sample (all or selected with indices)
+         sums of weighted memberships w u^m and either sums of w u^m x (for centres)
+         or sums of w u^m (x - v)^2 (for fuzzification). Blocks of items are elaborated
+         in parallel, their partial sums are merged in a fixed order. */
+      auto accumulate = [&] (const std::size_t nItems, const std::vector<std::size_t> * indices,
+                             const bool deviations,
+                             std::vector<double> & sum_u, std::vector<double> & sum_ux)
+      {
+         const std::size_t nBlocks = number_of_blocks(nItems);
+         const std::size_t length = (nItems + nBlocks - 1) / nBlocks;
+         const std::size_t nCA = nClusters * nAttr;
+         std::vector<double> partial_u (nBlocks * nClusters, 0.0), partial_ux (nBlocks * nCA, 0.0);
+
+         #pragma omp parallel for
+         for (std::size_t b = 0; b < nBlocks; b++)
+         {
+            std::vector<double> buffer (nAttr), u (nClusters);
+            double * pu  = partial_u.data() + b * nClusters;
+            double * pux = partial_ux.data() + b * nCA;
+            const std::size_t last = std::min(nItems, (b + 1) * length);
+            for (std::size_t i = b * length; i < last; i++)
+            {
+               const double * x;
+               const double w = get_item(indices ? (*indices)[i] : i, buffer.data(), x);
+               memberships(x, V, nAttr, u.data());
+               for (std::size_t c = 0; c < nClusters; c++)
+               {
+                  const double um = w * ((_m == 2.0) ? u[c] * u[c] : std::pow(u[c], _m));
+                  pu[c] += um;
+                  const double * v = V.data() + c * nAttr;
+                  double * s = pux + c * nAttr;
+                  if (deviations)
+                     for (std::size_t a = 0; a < nAttr; a++)
+                        s[a] += um * (x[a] - v[a]) * (x[a] - v[a]);
+                  else
+                     for (std::size_t a = 0; a < nAttr; a++)
+                        s[a] += um * x[a];
+               }
+            }
+         }
+
+         sum_u.assign(nClusters, 0.0);
+         sum_ux.assign(nCA, 0.0);
+         for (std::size_t b = 0; b < nBlocks; b++)
+         {
+            for (std::size_t c = 0; c < nClusters; c++)
+               sum_u[c] += partial_u[b * nClusters + c];
+            for (std::size_t k = 0; k < nCA; k++)
+               sum_ux[k] += partial_ux[b * nCA + k];
+         }
+      };
+
+      std::vector<double> sum_u, sum_ux;
+      if (_batch_size == 0 or _batch_size >= nSample)
+      {
+         // batch FCM over the whole sample
+         for (int iter = 0; iter < _nIterations; iter++)
+         {
+            accumulate(nSample, nullptr, false, sum_u, sum_ux);
+            for (std::size_t c = 0; c < nClusters; c++)
+               if (sum_u[c] > 0)
+                  for (std::size_t a = 0; a < nAttr; a++)
+                     V[c * nAttr + a] = sum_ux[c * nAttr + a] / sum_u[c];
+         }
+      }
+      else
+      {
+         // mini-batch steps with learning rates S_c / N_c
+         std::uniform_int_distribution<std::size_t> distribution (0, nSample - 1);
+         std::vector<std::size_t> batch (_batch_size);
+         std::vector<double> N (nClusters, 0.0);
+         for (int iter = 0; iter < _nIterations; iter++)
+         {
+            for (auto & i : batch)
+               i = distribution(engine);
+            accumulate(_batch_size, & batch, false, sum_u, sum_ux);
+            for (std::size_t c = 0; c < nClusters; c++)
+               if (sum_u[c] > 0)
+               {
+                  N[c] += sum_u[c];
+                  for (std::size_t a = 0; a < nAttr; a++)
+                  {
+                     double & v = V[c * nAttr + a];
+                     v += (sum_ux[c * nAttr + a] - sum_u[c] * v) / N[c];
+                  }
+               }
+         }
+      }
+
+      // fuzzification of clusters in the sample
+      accumulate(nSample, nullptr, true, sum_u, sum_ux);
+      std::vector<double> S (nClusters * nAttr, 0.0);
+      for (std::size_t c = 0; c < nClusters; c++)
+         if (sum_u[c] > 0)
+            for (std::size_t a = 0; a < nAttr; a++)
+               S[c * nAttr + a] = std::sqrt(sum_ux[c * nAttr + a] / sum_u[c]);
+
+      return elaborate_partition(V, S, nAttr);
+   }
+   CATCH;
+}
+
+ksi::partition ksi::fcm_minibatch::elaborate_partition(const std::vector<double> & V,
+                                                       const std::vector<double> & S,
+                                                       const std::size_t nAttr) const
+{
+   ksi::partition part;
+   const std::size_t nClusters = V.size() / nAttr;
+   std::vector<std::vector<double>> centres (nClusters);
+   for (std::size_t c = 0; c < nClusters; c++)
+   {
+      ksi::cluster cl;
+      for (std::size_t a = 0; a < nAttr; a++)
+      {
+         ksi::descriptor_gaussian d (V[c * nAttr + a], S[c * nAttr + a]);
+         cl.addDescriptor(d);
+      }
+      part.addCluster(cl);
+      centres[c].assign(V.begin() + c * nAttr, V.begin() + (c + 1) * nAttr);
+   }
+   part.setClusterCentres(centres);
+   return part;
+}
+
+std::vector<std::vector<double>> ksi::fcm_minibatch::elaborate_memberships(
+   const ksi::partition & part, const ksi::dataset & ds,
+   const std::size_t first, const std::size_t last) const
+{
+   try
+   {
+      if (first > last or last > ds.getNumberOfData())
+         throw ksi::exception ("Invalid range of data items [" + std::to_string(first) + ", " + std::to_string(last) + ") for a dataset with " + std::to_string(ds.getNumberOfData()) + " items.");
+
+      const std::size_t nAttr = ds.getNumberOfAttributes();
+      const auto centres = part.getClusterCentres();
+      const std::size_t nClusters = centres.size();
+      std::vector<double> V;
+      V.reserve(nClusters * nAttr);
+      for (const auto & centre : centres)
+         V.insert(V.end(), centre.begin(), centre.end());
+
+      std::vector<std::vector<double>> U (nClusters, std::vector<double> (last - first));
+      #pragma omp parallel for
+      for (std::size_t i = first; i < last; i++)
+      {
+         std::vector<double> x (nAttr), u (nClusters);
+         read_item(ds, i, nAttr, x.data());
+         memberships(x.data(), V, nAttr, u.data());
+         for (std::size_t c = 0; c < nClusters; c++)
+            U[c][i - first] = u[c];
+      }
+      return U;
+   }
+   CATCH;
+}
+
+std::vector<std::vector<double>> ksi::fcm_minibatch::elaborate_memberships(
+   const ksi::partition & part, const ksi::dataset & ds) const
+{
+   try
+   {
+      return elaborate_memberships(part, ds, 0, ds.getNumberOfData());
+   }
+   CATCH;
+}
@@ -0,0 +1,146 @@
+/** @file */
+
+#ifndef FCM_MINIBATCH_H
+#define FCM_MINIBATCH_H
+
+#include <vector>
+#include <string>
+
+#include "../auxiliary/random_service.h"
+#include "../partitions/partition.h"
+#include "../partitions/partitioner.h"
+#include "../common/dataset.h"
+
+namespace ksi
+{
+   /** Fuzzy C-means for very large datasets.
+    *  The algorithm neither copies data into a matrix nor stores the partition matrix:
+    *  data items are read from the dataset in blocks and each iteration
+    *  accumulates only sums for cluster centres (memory: clusters x attributes
+    *  for each block elaborated in parallel).
+    *
+    *  Data items are clustered in one of two samples:
+    *  - the whole dataset (all items have unit weights),
+    *  - a weighted lightweight coreset (O. Bachem, M. Lucic, A. Krause, Scalable k-Means
+    *    Clustering via Lightweight Coresets, KDD 2018): m items are drawn with probability
+    *    \f$ q_i = \frac{1}{2n} + \frac{1}{2} \frac{\|x_i - \mu\|^2}{\sum_j \|x_j - \mu\|^2} \f$
+    *    (\f$ \mu \f$ -- mean of data) and get weights \f$ \frac{1}{m q_i} \f$.
+    *    The coreset is built in three sweeps over the dataset with memory O(m).
+    *    For any cluster centres the weighted FCM objective of the coreset is
+    *    an unbiased estimate of the objective of the whole dataset. The contribution
+    *    of an item to the FCM objective lies between \f$ c^{1-m} \f$ and 1 times
+    *    its contribution to the k-means objective, so the guarantee of the lightweight
+    *    coreset for k-means (with probability \f$ 1 - \delta \f$ the error is at most
+    *    \f$ \varepsilon \f$ times the sum of the objective and the objective of the mean
+    *    for \f$ m = O\left( (d c \log c + \log 1/\delta) / \varepsilon^2 \right) \f$)
+    *    holds for FCM with the size of the coreset multiplied by \f$ c^{m-1} \f$.
+    *
+    *  In each iteration the algorithm elaborates either the whole sample
+    *  (batch FCM update of centres) or a mini-batch of items drawn uniformly from the sample.
+    *  In a mini-batch step each centre moves towards the mean of the mini-batch
+    *  weighted with memberships with the learning rate
+    *  \f$ \frac{S_c}{N_c} \f$, where \f$ S_c = \sum_{i \in B} w_i u_{ci}^m \f$ and \f$ N_c \f$ is the sum
+    *  of \f$ S_c \f$ in all steps so far (as in D. Sculley, Web-scale k-means clustering, WWW 2010).
+    *  Cluster centres are seeded with the k-means++ rule in a random subset of the sample.
+    *
+    *  The partition holds Gaussian clusters (centres and fuzzification elaborated in the sample),
+    *  so it can be used by any neuro-fuzzy system. The partition has no partition matrix,
+    *  memberships are elaborated on request with ksi::fcm_minibatch::elaborate_memberships.
+    *  @date 2026-10-19
+    */
+   class fcm_minibatch : public partitioner
+   {
+   protected:
+      /** fuzzification parameter */
+      double _m = 2.0;
+      /** number of items in a mini-batch, 0: the whole sample in each iteration */
+      std::size_t _batch_size = 0;
+      /** number of items of the coreset, 0: the whole dataset */
+      std::size_t _coreset_size = 0;
+
+      /** weighted items of a coreset */
+      struct coreset
+      {
+         /** values of items, row major */
+         std::vector<double> X;
+         std::vector<double> weights;
+      };
+
+      /** The method builds a lightweight coreset in three sweeps over the dataset.
+          @param ds dataset
+          @param engine random stream for drawing items */
+      coreset build_coreset (const dataset & ds, ksi::philox & engine) const;
+
+      /** The method seeds cluster centres with the k-means++ rule: the first centre
+          is drawn with probabilities proportional to weights of items, each next one
+          with probabilities proportional to weights times squared distances
+          to the closest centre drawn so far.
+          @param X values of items, row major
+          @param weights weights of items
+          @param nAttr number of attributes
+          @param engine random stream
+          @return cluster centres, row major */
+      std::vector<double> seed_centres (const std::vector<double> & X,
+                                        const std::vector<double> & weights,
+                                        const std::size_t nAttr, ksi::philox & engine) const;
+
+      /** The method elaborates memberships of an item to clusters.
+          @param x values of the item
+          @param V cluster centres, row major
+          @param nAttr number of attributes
+          @param[out] u memberships (one for each cluster) */
+      void memberships (const double * x, const std::vector<double> & V,
+                        const std::size_t nAttr, double * u) const;
+
+      /** @return Gaussian partition with centres V and fuzzification S (both row major) */
+      partition elaborate_partition (const std::vector<double> & V,
+                                     const std::vector<double> & S,
+                                     const std::size_t nAttr) const;
+
+   public:
+      /** @param nClusters number of clusters
+          @param nIterations number of iterations (mini-batch steps if the batch size is set)
+          @param batch_size number of items in a mini-batch, 0: the whole sample in each iteration
+          @param coreset_size number of items of the coreset, 0: the whole dataset */
+      fcm_minibatch (const int nClusters, const int nIterations,
+                     const std::size_t batch_size, const std::size_t coreset_size = 0);
+
+      fcm_minibatch (const fcm_minibatch & wzor) = default;
+      fcm_minibatch (fcm_minibatch && wzor) = default;
+      fcm_minibatch & operator = (const fcm_minibatch & wzor) = default;
+      fcm_minibatch & operator = (fcm_minibatch && wzor) = default;
+      virtual ~fcm_minibatch ();
+
+      /** @param m fuzzification parameter
+          @throw ksi::exception if m <= 1 */
+      void setFuzzification (const double m);
+
+      /** The method clusters the dataset.
+       * @param ds dataset to cluster (complete data)
+       * @return partition into Gaussian clusters (without the partition matrix)
+       * @throw ksi::exception if the number of clusters or iterations is not set
+       *        or the dataset has fewer items than clusters */
+      virtual partition doPartition (const dataset & ds) override;
+
+      /** The method elaborates memberships of data items to clusters of a partition.
+          @param part partition with cluster centres
+          @param ds dataset
+          @param first index of the first data item
+          @param last index of the data item after the last elaborated one
+          @return partition matrix [cluster][item - first]
+          @throw ksi::exception if the range of items is invalid */
+      std::vector<std::vector<double>> elaborate_memberships (const partition & part, const dataset & ds,
+                                                              const std::size_t first, const std::size_t last) const;
+
+      /** The method elaborates memberships of all data items to clusters of a partition.
+          @return partition matrix [cluster][item] */
+      std::vector<std::vector<double>> elaborate_memberships (const partition & part, const dataset & ds) const;
+
+      virtual partitioner * clone () const override;
+
+      /** @return an abbreviation of a method */
+      virtual std::string getAbbreviation () const override;
+   };
+}
+
+#endif
@@ -16,6 +16,7 @@
 #include "partition.h"
 #include "fcom.h"
 #include "../service/debug.h"
+#include "../auxiliary/random_service.h"
 #include "../service/exception.h"
 
 std::string ksi::fcom::getAbbreviation() const
@@ -398,6 +399,10 @@ ksi::partition ksi::fcom::doPartition(const ksi::dataset & ds)
 {
    try
    {
+      // typicalities of data items are the result of the algorithm too: 
+      // they are written into the clustered dataset
+      ksi::dataset & typical = const_cast<ksi::dataset &>(ds);
+      
 //       debug(_nClusters); 
        
       const int MAXITER = 100; 
@@ -442,8 +447,7 @@ ksi::partition ksi::fcom::doPartition(const ksi::dataset & ds)
       //for (auto & row : mV)
       //   row = std::vector<double> (nAttr, 0.0);
       
-      std::default_random_engine silnik;
-      silnik.seed(std::chrono::system_clock::now().time_since_epoch().count());
+      auto silnik = ksi::random_service::next_stream();
       std::uniform_int_distribution<std::size_t> rozklad (0, nX - 1);
       
       // initialize cluster centres at random
@@ -462,7 +466,7 @@ ksi::partition ksi::fcom::doPartition(const ksi::dataset & ds)
          
       // itinialize typicalities with 1
       for (std::size_t x = 0; x < nX; x++)
-         ds.getDatumNonConst(x)->setTypicality(1.0);
+         typical.getDatumNonConst(x)->setTypicality(1.0);
 
       //         set iteration index j = 1
       int iter = 0;
@@ -516,7 +520,7 @@ ksi::partition ksi::fcom::doPartition(const ksi::dataset & ds)
       // trzeba jeszcze wpisac typowosci do danych:
       for (std::size_t x = 0; x < nX; x++)
       {
-         ds.getDatumNonConst(x)->setTypicality(fs[x]);
+         typical.getDatumNonConst(x)->setTypicality(fs[x]);
       }
       
       // przeksztalcenie do postaci zbiorow gaussowskich
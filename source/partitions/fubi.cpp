@@ -5,6 +5,7 @@
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 
 
 #include "../partitions/partitioner.h" 
@@ -39,266 +40,301 @@ ksi::fubi::fubi(const int NUMBER_OF_CLUSTERS, const int NUMBER_OF_ITERATIONS)
     _nIterations = NUMBER_OF_ITERATIONS;
 }
 
-
- 
-std::vector<std::vector<std::vector<double>>> ksi::fubi::randomise (
-    const int number_of_clusters, 
-    const std::size_t number_of_data, 
-    const std::size_t number_of_attributes)
+ksi::fubi::fubi(const int NUMBER_OF_CLUSTERS, const int MAXIMAL_NUMBER_OF_ITERATIONS, const double EPSILON)
+: fubi (NUMBER_OF_CLUSTERS, MAXIMAL_NUMBER_OF_ITERATIONS)
 {
-    std::vector<std::vector<std::vector<double>>> u;
-    for (int c = 0; c < number_of_clusters; c++)
+    try
     {
-        std::vector<std::vector<double>> kd;
-        for (int x = 0; x < number_of_data; x++)
-        {
-            kd.push_back(ksi::get_uniform_unit_random_vector(number_of_attributes));
-        }    
-        u.push_back(kd);
+        setEpsilonForFrobeniusNorm(EPSILON);
     }
-    return u;
-} 
+    CATCH;
+}
 
-std::vector<std::vector<std::vector<double> > > ksi::fubi::normalise(
-    const std::vector<std::vector<std::vector<double>>> & U)
+void ksi::fubi::setEpsilonForFrobeniusNorm(const double EPSILON)
 {
-    std::vector<std::vector<std::vector<double>>> norm_U(U);
-     
-    for (std::size_t a = 0; a < _number_of_attributes; a++)
+    try
     {
+        if (EPSILON <= 0)
+            throw ksi::exception ("Use positive value for EPSILON!");
+        _epsilon = EPSILON;
+    }
+    CATCH;
+}
+
+namespace
+{
+    /** number of data items in a block elaborated by one thread */
+    const std::size_t BLOCK_SIZE = 256;
+}
+ 
+std::vector<double> ksi::fubi::randomise ()
+{
+    std::vector<double> U (_number_of_clusters * _number_of_data * _number_of_attributes);
+    
+    // random values are drawn in the same order as in the nested vector representation
+    for (std::size_t c = 0; c < _number_of_clusters; c++)
         for (std::size_t x = 0; x < _number_of_data; x++)
         {
+            auto random = ksi::get_uniform_unit_random_vector(_number_of_attributes);
+            for (std::size_t a = 0; a < _number_of_attributes; a++)
+                U[index(c, x, a)] = random[a];
+        }
+    
+    // normalisation
+    #pragma omp parallel for
+    for (std::size_t x = 0; x < _number_of_data; x++)
+        for (std::size_t a = 0; a < _number_of_attributes; a++)
+        {
+            double * u = U.data() + index(0, x, a);
             double suma {0};
-            for (std::size_t c = 0; c < _nClusters; c++)
-            {
-                suma += U[c][x][a];
-            }
-            for (std::size_t c = 0; c < _nClusters; c++)
-            {
-                norm_U[c][x][a] = U[c][x][a] / suma;
-                 //debug(suma);
-                 if (std::isnan(suma))
-                 {
-                     debug(a);
-                     debug(x);
-                 }
-            }
+            for (std::size_t c = 0; c < _number_of_clusters; c++)
+                suma += u[c];
+            for (std::size_t c = 0; c < _number_of_clusters; c++)
+                u[c] /= suma;
         }
-    }
     
-
-    return norm_U;
-}
+    return U;
+} 
 
 std::vector<std::vector<double>> ksi::fubi::cluster_centres_for_data (
     const std::vector<std::vector<double>> & X, 
-    const std::vector<std::vector<std::vector<double>>> & _U)
+    const std::vector<double> & U)
 {
-    std::vector<std::vector<double>> V (_nClusters,
-                                        std::vector<double> (_number_of_attributes,0));
+    const std::size_t nCA = _number_of_clusters * _number_of_attributes;
+    const std::size_t nBlocks = (_number_of_data + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    // partial sums of blocks: [block][d * C + c]
+    std::vector<double> sum_membership (nBlocks * nCA, 0.0), sum_membership_times_value (nBlocks * nCA, 0.0);
     
-    for (std::size_t c = 0; c < _nClusters; c++)
+    #pragma omp parallel for
+    for (std::size_t b = 0; b < nBlocks; b++)
     {
-        for (std::size_t a = 0; a < _number_of_attributes; a++)
+        double * sum_u  = sum_membership.data() + b * nCA;
+        double * sum_ux = sum_membership_times_value.data() + b * nCA;
+        const std::size_t last = std::min(_number_of_data, (b + 1) * BLOCK_SIZE);
+        for (std::size_t x = b * BLOCK_SIZE; x < last; x++)
         {
-            double sum_membership {0};
-            double sum_membership_times_value {0};
-            for (std::size_t x = 0; x < _number_of_data; x++)
+            const double * u = U.data() + index(0, x, 0);
+            for (std::size_t i = 0; i < nCA; i++)
             {
-                sum_membership += _U[c][x][a];
-                sum_membership_times_value += _U[c][x][a] * X[x][a];
+                sum_u[i]  += u[i];
+                sum_ux[i] += u[i] * X[x][i / _number_of_clusters];
             }
-            V[c][a] = sum_membership_times_value / sum_membership;
         }
     }
-    return V;
-}
-
-
-std::vector<std::vector<double>> ksi::fubi::cluster_centres_for_attibutes (
-    const std::vector<std::vector<double>> & X, 
-    const std::vector<std::vector<std::vector<double>>> & _U)
-{
-    std::vector<std::vector<double>> V (_nClusters,
-                                        std::vector<double> (_number_of_data,0));
     
-    for (std::size_t c = 0; c < _nClusters; c++)
-    {
-        for (std::size_t x = 0; x < _number_of_data; x++)
+    std::vector<std::vector<double>> V (_number_of_clusters, std::vector<double> (_number_of_attributes, 0));
+    for (std::size_t c = 0; c < _number_of_clusters; c++)
+        for (std::size_t a = 0; a < _number_of_attributes; a++)
         {
-            double sum_membership {0};
-            double sum_membership_times_value {0};
-            for (std::size_t a = 0; a < _number_of_attributes; a++)
+            double sum_u {0}, sum_ux {0};
+            for (std::size_t b = 0; b < nBlocks; b++)
             {
-                sum_membership += _U[c][x][a];
-                sum_membership_times_value += _U[c][x][a] * X[x][a];
+                sum_u  += sum_membership[b * nCA + a * _number_of_clusters + c];
+                sum_ux += sum_membership_times_value[b * nCA + a * _number_of_clusters + c];
             }
-            
-            auto iloraz = sum_membership_times_value / sum_membership;
-            if (not std::isnan(iloraz))
-               V[c][x] = iloraz;
+            V[c][a] = sum_ux / sum_u;
         }
-    }
     return V;
 }
 
-double ksi::fubi::ksi(
+double ksi::fubi::update_membership_tensor(
+    std::vector<double> & U, 
     const std::vector<std::vector<double>> & X, 
-    const std::vector<std::vector<double>> & V_data, 
-    const std::vector<std::vector<double>> & V_attr,
-    int c,
-    std::size_t k,
-    std::size_t d)
+    std::vector<std::vector<double>> & V_data)
 {
-    return pow((X[k][d] - V_data[c][d]), 2) + pow((X[k][d] - V_attr[c][k]), 2);   
-}
-
-
-std::vector<std::vector<std::vector<double>>> 
-ksi::fubi::update_membership_matrix(
-    const std::vector<std::vector<std::vector<double>>> & U, 
-    const std::vector<std::vector<double>> & X, 
-    const std::vector<std::vector<double>> & V_data, 
-    const std::vector<std::vector<double>> & V_attr)
-{
-    auto U_new = U;
-    
     const double expo = (1.0 / (1.0 - _m));
+    const std::size_t nCA = _number_of_clusters * _number_of_attributes;
+    const std::size_t nBlocks = (_number_of_data + BLOCK_SIZE - 1) / BLOCK_SIZE;
     
-    for (std::size_t x = 0; x < _number_of_data; x++)
-    {
+    // cluster centres with regard to data: [d * C + c]
+    std::vector<double> v_data (nCA);
+    for (std::size_t c = 0; c < _number_of_clusters; c++)
         for (std::size_t a = 0; a < _number_of_attributes; a++)
+            v_data[a * _number_of_clusters + c] = V_data[c][a];
+    
+    // partial sums of blocks for new centres: [block][d * C + c]
+    std::vector<double> sum_membership (nBlocks * nCA, 0.0), sum_membership_times_value (nBlocks * nCA, 0.0);
+    std::vector<double> squared_differences (nBlocks, 0.0);
+    
+    #pragma omp parallel for
+    for (std::size_t b = 0; b < nBlocks; b++)
+    {
+        std::vector<double> v_attr (_number_of_clusters), powers (_number_of_clusters);
+        double * sum_u  = sum_membership.data() + b * nCA;
+        double * sum_ux = sum_membership_times_value.data() + b * nCA;
+        double squared_difference {0};
+        
+        const std::size_t last = std::min(_number_of_data, (b + 1) * BLOCK_SIZE);
+        for (std::size_t x = b * BLOCK_SIZE; x < last; x++)
         {
-            double sum {0};
-            for (std::size_t c = 0; c < _nClusters; c++)
+            const auto & xx = X[x];
+            
+            // cluster centres with regard to attributes for the data item (old memberships)
+            std::fill(v_attr.begin(), v_attr.end(), 0.0);
+            std::fill(powers.begin(), powers.end(), 0.0);  // here: sums of memberships
+            for (std::size_t a = 0; a < _number_of_attributes; a++)
             {
-                auto xi = ksi (X, V_data, V_attr, c, x, a);
-                sum += pow (xi, expo);   
+                const double * u = U.data() + index(0, x, a);
+                for (std::size_t c = 0; c < _number_of_clusters; c++)
+                {
+                    powers[c] += u[c];
+                    v_attr[c] += u[c] * xx[a];
+                }
             }
-
-            for (std::size_t c = 0; c < _nClusters; c++)
+            for (std::size_t c = 0; c < _number_of_clusters; c++)
+            {
+                auto iloraz = v_attr[c] / powers[c];
+                v_attr[c] = std::isnan(iloraz) ? 0.0 : iloraz;
+            }
+            
+            // new memberships
+            for (std::size_t a = 0; a < _number_of_attributes; a++)
             {
-                auto new_value = pow (ksi (X, V_data, V_attr, c, x, a), expo)  / sum;  
+                double * u = U.data() + index(0, x, a);
+                const double * vd = v_data.data() + a * _number_of_clusters;
                 
-                U_new[c][x][a] = std::isnan(new_value) ? 1.0 : new_value;
+                double sum {0};
+                for (std::size_t c = 0; c < _number_of_clusters; c++)
+                {
+                    const double xi = (xx[a] - vd[c]) * (xx[a] - vd[c]) + (xx[a] - v_attr[c]) * (xx[a] - v_attr[c]);
+                    powers[c] = std::pow(xi, expo);
+                    sum += powers[c];
+                }
+                
+                double suma {0};
+                for (std::size_t c = 0; c < _number_of_clusters; c++)
+                {
+                    auto new_value = powers[c] / sum;
+                    powers[c] = std::isnan(new_value) ? 1.0 : new_value;
+                    suma += powers[c];
+                }
+                
+                for (std::size_t c = 0; c < _number_of_clusters; c++)
+                {
+                    const double new_value = powers[c] / suma;
+                    squared_difference += (new_value - u[c]) * (new_value - u[c]);
+                    u[c] = new_value;
+                    sum_u [a * _number_of_clusters + c] += new_value;
+                    sum_ux[a * _number_of_clusters + c] += new_value * xx[a];
+                }
             }
         }
+        squared_differences[b] = squared_difference;
     }
     
-    return U_new;
+    double squared_norm {0};
+    for (std::size_t b = 0; b < nBlocks; b++)
+        squared_norm += squared_differences[b];
+    
+    for (std::size_t c = 0; c < _number_of_clusters; c++)
+        for (std::size_t a = 0; a < _number_of_attributes; a++)
+        {
+            double sum_u {0}, sum_ux {0};
+            for (std::size_t b = 0; b < nBlocks; b++)
+            {
+                sum_u  += sum_membership[b * nCA + a * _number_of_clusters + c];
+                sum_ux += sum_membership_times_value[b * nCA + a * _number_of_clusters + c];
+            }
+            V_data[c][a] = sum_ux / sum_u;
+        }
+    
+    return std::sqrt(squared_norm);
 }
 
 
 ksi::partition ksi::fubi::doPartition(const ksi::dataset& ds)
 {
-    const double EPSILON = 1e-6;
-       
-    _number_of_attributes = ds.getNumberOfAttributes();
-    _number_of_data       = ds.getNumberOfData();
-    
-    // macierz przynaleznosci jest trojwymiarowa: _U[klaster][dana][atrybut]
-    std::vector<std::vector<std::vector<double>>> _U = randomise(_nClusters, _number_of_data, _number_of_attributes);
-    
-    _U = normalise(_U);
-    
-    auto X = ds.getMatrix();
-    
-    for (int iter = 0 ; iter < _nIterations; iter++)
+    try
     {
-        // wyznacz srodki klastrow dla danych i dla atrybutow
-//         debug(iter);
+        const double EPSILON = 1e-6;
         
-        auto V_data = cluster_centres_for_data (X, _U);
-//         debug(V_data);
-        auto V_attr = cluster_centres_for_attibutes (X, _U);
-//         debug(V_attr);
+        _number_of_attributes = ds.getNumberOfAttributes();
+        _number_of_data       = ds.getNumberOfData();
+        _number_of_clusters   = _nClusters;
         
-        _U = update_membership_matrix (_U, X, V_data, V_attr);
-        _U = normalise(_U);
+        // membership tensor u_{ckd} in a contiguous buffer (see ksi::fubi::index)
+        auto U = randomise();
+        auto X = ds.getMatrix();
+        auto V_data = cluster_centres_for_data (X, U);
         
-    }
-    
-    auto V_data = cluster_centres_for_data (X, _U);
-    auto mS = calculateClusterFuzzification(_U, V_data, X);
-    auto mZ = calculateAttributeWeights(_U, V_data, X);
-//     
-//     // przeksztalcenie do postaci zbiorow gaussowskich
-    ksi::partition part;
-    for (int c = 0; c < _nClusters; c++)
-    {
-        ksi::cluster cl; 
-        for (std::size_t a = 0; a < _number_of_attributes; a++)
+        for (int iter = 0 ; iter < _nIterations; iter++)
         {
-            ksi::descriptor_gaussian_subspace d (V_data[c][a], std::max(mS[c][a], EPSILON), mZ[c][a]);
-            cl.addDescriptor(d);
+            // memberships and cluster centres in one sweep
+            auto frobenius = update_membership_tensor (U, X, V_data);
+            if (_epsilon > 0 and frobenius < _epsilon)
+                break;
         }
-        part.addCluster(cl);
+        
+        std::vector<std::vector<double>> mS, mZ;
+        calculateClusterFuzzificationAndAttributeWeights(U, V_data, X, mS, mZ);
+        
+        // przeksztalcenie do postaci zbiorow gaussowskich
+        ksi::partition part;
+        for (std::size_t c = 0; c < _number_of_clusters; c++)
+        {
+            ksi::cluster cl; 
+            for (std::size_t a = 0; a < _number_of_attributes; a++)
+            {
+                ksi::descriptor_gaussian_subspace d (V_data[c][a], std::max(mS[c][a], EPSILON), mZ[c][a]);
+                cl.addDescriptor(d);
+            }
+            part.addCluster(cl);
+        }
+        
+        return part;
     }
-    
-    return part;
+    CATCH;
 }
 
-std::vector<std::vector<double> > ksi::fubi::calculateClusterFuzzification(
-    const std::vector<std::vector<std::vector<double>>> & U, 
+void ksi::fubi::calculateClusterFuzzificationAndAttributeWeights(
+    const std::vector<double> & U, 
     const std::vector<std::vector<double>> & V_data, 
-    const std::vector<std::vector<double>> & X)
+    const std::vector<std::vector<double>> & X,
+    std::vector<std::vector<double>> & S,
+    std::vector<std::vector<double>> & Z)
 {
-    auto S (V_data);
+    const std::size_t nCA = _number_of_clusters * _number_of_attributes;
+    const std::size_t nBlocks = (_number_of_data + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    // partial sums of blocks: [block][d * C + c]
+    std::vector<double> sums_um (nBlocks * nCA, 0.0), sums_um_squares (nBlocks * nCA, 0.0);
     
-    for (int c = 0; c < _nClusters; c++)
+    #pragma omp parallel for
+    for (std::size_t b = 0; b < nBlocks; b++)
     {
-        for (std::size_t d = 0; d < _number_of_attributes; d++)
-        {
-            double sum_numerator {0.0},
-                   sum_denominator {0.0};
-                
-            for (std::size_t i = 0; i < _number_of_data; i++)
+        double * sum_um = sums_um.data() + b * nCA;
+        double * sum_um_square = sums_um_squares.data() + b * nCA;
+        const std::size_t last = std::min(_number_of_data, (b + 1) * BLOCK_SIZE);
+        for (std::size_t x = b * BLOCK_SIZE; x < last; x++)
+            for (std::size_t a = 0; a < _number_of_attributes; a++)
             {
-                auto um = pow(U[c][i][d], _m);
-                
-                sum_numerator += (um * pow (X[i][d] - V_data[c][d], 2));
-                sum_denominator += um;
+                const double * u = U.data() + index(0, x, a);
+                for (std::size_t c = 0; c < _number_of_clusters; c++)
+                {
+                    auto um = std::pow(u[c], _m);
+                    auto diff = X[x][a] - V_data[c][a];
+                    sum_um[a * _number_of_clusters + c] += um;
+                    sum_um_square[a * _number_of_clusters + c] += um * diff * diff;
+                }
             }
-            S[c][d] = std::sqrt(sum_numerator / sum_denominator);
-        }      
     }
-    return S;
-}
-
-
-std::vector<std::vector<double> > ksi::fubi::calculateAttributeWeights(
-    const std::vector<std::vector<std::vector<double>>> & U, 
-    const std::vector<std::vector<double>> & V_data, 
-    const std::vector<std::vector<double>> & X)
-{
-    auto Z (V_data);
     
-    for (int c = 0; c < _nClusters; c++)
+    S = Z = V_data;
+    for (std::size_t c = 0; c < _number_of_clusters; c++)
     {
         double sum_of_all {0.0};
-        for (std::size_t d = 0; d < _number_of_attributes; d++)
-        {
-            for (std::size_t i = 0; i < _number_of_data; i++)
-            {
-                auto um = pow(U[c][i][d], _m);
-                
-                sum_of_all += um;
-            }
-        }
-        
-        for (std::size_t d = 0; d < _number_of_attributes; d++)
+        for (std::size_t a = 0; a < _number_of_attributes; a++)
         {
-            double sum {0.0};
-            for (std::size_t i = 0; i < _number_of_data; i++)
+            double sum_numerator {0.0}, sum_denominator {0.0};
+            for (std::size_t b = 0; b < nBlocks; b++)
             {
-                auto um = pow(U[c][i][d], _m);
-                
-                sum += um;
+                sum_denominator += sums_um[b * nCA + a * _number_of_clusters + c];
+                sum_numerator   += sums_um_squares[b * nCA + a * _number_of_clusters + c];
             }
-            
-            Z[c][d] = sum / sum_of_all;
+            S[c][a] = std::sqrt(sum_numerator / sum_denominator);
+            Z[c][a] = sum_denominator;
+            sum_of_all += sum_denominator;
         }
+        for (std::size_t a = 0; a < _number_of_attributes; a++)
+            Z[c][a] /= sum_of_all;
     }
-    return Z;
 }
-
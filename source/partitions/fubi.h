@@ -5,6 +5,8 @@
 
 
 
+#include <vector>
+
 #include "../partitions/partition.h"
 #include "../partitions/partitioner.h"
 #include "../common/dataset.h"
@@ -40,26 +42,35 @@ namespace ksi
    class fubi : public partitioner
    { 
        //int _nClusters;           ///< number of clusters 
-       //int _nIterations;         ///< number of iterations 
+       //int _nIterations;         ///< maximal number of iterations 
        std::size_t _number_of_attributes; ///< number of attributes of data 
        std::size_t _number_of_data;       ///< number of data 
+       std::size_t _number_of_clusters;   ///< number of clusters (_nClusters of the partitioner) 
        double _m = 2.0;                   ///< clustering parameter 
        
+       /** When the Frobenius norm of differences of membership tensors 
+           in two consecutive iterations is less than _epsilon, the algorithm stops.
+           Negative value: the algorithm runs all _nIterations iterations. */
+       double _epsilon = -1;
+       
        const double EPSILON { 0.0001 };   ///< indistiguishability threshold for distance (if the distance for a cluster is lower that EPSILON, we assume an example is exactly in the centre of the cluster)
        
+       /* The membership tensor is stored in one contiguous buffer, 
+          data major: u_{ckd} = U[(k * D + d) * C + c],
+          so memberships of a data item are contiguous and blocks of data 
+          are elaborated in parallel. 
+          The tensor is updated in place: new memberships of a data item 
+          depend only on its old memberships (via cluster centres 
+          with regard to attributes) and cluster centres with regard to data. */
        
-       /** The method creates a 3D matrix with random values from uniform distribution [0,1]. 
-        * The indices are: number of clusters, number of data, and number of attributes.
-        @param number_of_clusters number of clusters
-        @param number_of_data number of data
-        @param number_of_attributes number of attributes
-        */
-       std::vector<std::vector<std::vector<double>>> randomise (
-           const int number_of_clusters,
-           const std::size_t number_of_data,
-           const std::size_t number_of_attributes);
+       /** @return index of \f$ u_{ckd} \f$ in the membership tensor */
+       inline std::size_t index (const std::size_t c, const std::size_t k, const std::size_t d) const
+       {
+           return (k * _number_of_attributes + d) * _number_of_clusters + c;
+       }
        
-       /** The method normalises the partition matrix U
+       /** The method creates a membership tensor with random values from uniform distribution [0,1]
+        *  and normalises it
        * \f[ 
        *  \forall_{k \in K} \forall_{d \in D} \sum_{c =1}^{C} u_{ckd} = 1,
        * \f] 
@@ -71,119 +82,100 @@ namespace ksi
        * \f$ c \f$ -- cluster<br/>
        * \f$ C \f$ -- set of clusters<br/>
        * \f$ u_{ckd} \f$ -- membership value of the \f$d\f$-th attribute for the \f$k\f$-th data item in the \f$c\f$-th cluster<br/>
-        @param U partition matrix to normalise
-        @return normalised partition matrix */
-       std::vector<std::vector<std::vector<double>>> normalise (const std::vector<std::vector<std::vector<double>>> & U);
+        @return normalised membership tensor */
+       std::vector<double> randomise ();
        
        /** The method elaborates cluster centres with regard to data.
        * \f[ 
        * v_{cd}^{(k)} = \frac{\sum_{k=1}^{K} u_{ckd} x_{kd} }{\sum_{k=1}^{K} u_{ckd} } ,
        * \f] 
        * where: <br/>
-       * \f$ k \f$ -- data item<br/>
-       * \f$ K \f$ -- set of data items<br/>
-       * \f$ d \f$ -- attribute<br/>
-       * \f$ D \f$ -- set of attributes<br/>
-       * \f$ c \f$ -- cluster<br/>
-       * \f$ C \f$ -- set of clusters<br/>
-       * \f$ u_{ckd} \f$ -- membership value of the \f$d\f$-th attribute for the \f$k\f$-th data item in the \f$c\f$-th cluster<br/>
        * \f$ x_{kd} \f$ -- value of \f$d\f$-th attribute for the \f$k\f$-th data item<br/>
         @param X data set
-        @param _U membership matrix
-        @return a matrix of cluster centres: each row represents a cluster, each column – an a data item.
+        @param U membership tensor
+        @return a matrix of cluster centres: each row represents a cluster, each column – an attribute.
         */
        std::vector<std::vector<double>> cluster_centres_for_data (
            const std::vector<std::vector<double>> & X, 
-           const std::vector<std::vector<std::vector<double>>> & _U);
+           const std::vector<double> & U);
 
-       /** The method elaborates cluster centres with regard to attributes.
+       /** One iteration of the algorithm in a single sweep over data. For each data item
+        *  the method elaborates its cluster centres with regard to attributes
        * \f[ 
        * v_{ck}^{(d)} = \frac{\sum_{d=1}^{D} u_{ckd} x_{kd} }{\sum_{d=1}^{D} u_{ckd} } ,
        * \f] 
-       * where: <br/>
-       * \f$ k \f$ -- data item<br/>
-       * \f$ K \f$ -- set of data items<br/>
-       * \f$ d \f$ -- attribute<br/>
-       * \f$ D \f$ -- set of attributes<br/>
-       * \f$ c \f$ -- cluster<br/>
-       * \f$ C \f$ -- set of clusters<br/>
-       * \f$ u_{ckd} \f$ -- membership value of the \f$d\f$-th attribute for the \f$k\f$-th data item in the \f$c\f$-th cluster<br/>
-       * \f$ x_{kd} \f$ -- value of \f$d\f$-th attribute for the \f$k\f$-th data item<br/>
-        @param X data set
-        @param _U membership matrix
-        @return a matrix of cluster centres: each row represents a cluster, each column – an attribute.
-        */
-       std::vector<std::vector<double>> cluster_centres_for_attibutes (
-           const std::vector<std::vector<double>> & X, 
-           const std::vector<std::vector<std::vector<double>>> & _U);
-       
-       
-       /** The method updates the membership matrix.
-        @param U membership matrix
-        @param X data set
-        @param V_data matrix of cluster centres with regard to data 
-        @param V_attr matrix of cluster centres with regard to attributes
-        @return updated membership matrix
-        */
-       
-       std::vector<std::vector<std::vector<double>>> update_membership_matrix (
-           const std::vector<std::vector<std::vector<double>>> & U,
-           const std::vector<std::vector<double>> & X, 
-           const std::vector<std::vector<double>> & V_data, 
-           const std::vector<std::vector<double>> & V_attr);
-       
-       /** @return The method returns the distance defined as 
+        *  updates its memberships in place
        * \f[ 
+       * u_{ckd} = \frac{ \xi_{ckd}^{\frac{1}{1 - m}} }{ \sum_{j=1}^C \xi_{jkd}^{\frac{1}{1 - m}} }, \quad
        * \xi_{ckd} = \left( x_{kd} - v_{cd}^{(k)}\right)^2 
        *           + \left( x_{kd} - v_{ck}^{(d)}\right)^2  ,
        * \f] 
-       * where: <br/>
-       * \f$ x_{kd} \f$ -- value of \f$d\f$-th attribute for the \f$k\f$-th data item<br/>
+        *  and accumulates sums for new cluster centres with regard to data. 
+        *  Blocks of data are elaborated in parallel, their partial sums are merged 
+        *  in a fixed order.
+        @param U membership tensor (updated in place)
+        @param X data set
+        @param V_data cluster centres with regard to data (updated to the new memberships)
+        @return Frobenius norm of the difference of old and new membership tensors
         */
-       inline double ksi  (
+       double update_membership_tensor (
+           std::vector<double> & U,
            const std::vector<std::vector<double>> & X, 
-           const std::vector<std::vector<double>> & V_data, 
-           const std::vector<std::vector<double>> & V_attr,
-           int c,
-           std::size_t k,
-           std::size_t d);
+           std::vector<std::vector<double>> & V_data);
        
-       /** @return The method returns fuzzification of clusters with regard to data. Each row represents a cluster, each column -- an attribute.
+       /** The method elaborates fuzzification of clusters and weights of attributes 
+        *  with regard to data in one sweep. 
+        *  Fuzzification (each row represents a cluster, each column -- an attribute):
        * \f[ 
        * s_{cd} = \sqrt{ \frac{\sum_{i=1}^X u^m_{cid} \left(x_{id} - v_{cd}^{(k)}\right)^2}{\sum_{i=1}^X u^m_{cid}} }
         * \f] 
-       * where: <br/>
-       * \f$ s_{cd} \f$ -- fuzzification of \f$d\f$-th attribute in the \f$c\f$-th cluster<br/>
-        * 
-         */
-       std::vector<std::vector<double>> calculateClusterFuzzification(
-           const std::vector<std::vector<std::vector<double>>> & U, 
-           const std::vector<std::vector<double>> & V_data, 
-           const std::vector<std::vector<double>> & X);
-       
-       /** @return The method returns weights of attributes in clusters with regard to data. Each row represents a cluster, each column -- an attribute.
+        *  weights of attributes:
        * \f[ 
        * z_{cd} = \frac{\sum_{i=1}^X u^m_{cid} }{\sum_{g=1}^D\sum_{i=1}^X u^m_{cig}} 
         * \f] 
-       * where: <br/>
-       * \f$ z_{cd} \f$ -- weight of \f$d\f$-th attribute in the \f$c\f$-th cluster<br/>
-        * 
+        @param U membership tensor
+        @param V_data cluster centres with regard to data
+        @param X data set
+        @param[out] S fuzzification of clusters
+        @param[out] Z weights of attributes
          */
-       std::vector<std::vector<double>> calculateAttributeWeights(
-           const std::vector<std::vector<std::vector<double>>> & U, 
+       void calculateClusterFuzzificationAndAttributeWeights(
+           const std::vector<double> & U, 
            const std::vector<std::vector<double>> & V_data, 
-           const std::vector<std::vector<double>> & X);
+           const std::vector<std::vector<double>> & X,
+           std::vector<std::vector<double>> & S,
+           std::vector<std::vector<double>> & Z);
 
        
    public:
+       /** @param NUMBER_OF_CLUSTERS number of clusters
+           @param NUMBER_OF_ITERATIONS number of iterations */
        fubi (const int NUMBER_OF_CLUSTERS,
              const int NUMBER_OF_ITERATIONS);
        
+       /** @param NUMBER_OF_CLUSTERS number of clusters
+           @param MAXIMAL_NUMBER_OF_ITERATIONS maximal number of iterations
+           @param EPSILON the algorithm stops when the Frobenius norm of differences 
+                  of membership tensors in two consecutive iterations is less than EPSILON
+           @throw ksi::exception if EPSILON negative or zero 
+           @date 2026-10-19 */
+       fubi (const int NUMBER_OF_CLUSTERS,
+             const int MAXIMAL_NUMBER_OF_ITERATIONS,
+             const double EPSILON);
+       
        fubi (const fubi & wzor) = default;
        fubi (fubi && wzor) = default;
        
        virtual ~fubi();
       
+      /** The method sets an epsilon. When the Frobenius norm of 
+          differences of membership tensors in two consecutive iterations
+          is less than EPSILON, the algorithm stops (but it runs 
+          at most the number of iterations passed to the constructor).
+          @throw ksi::exception if EPSILON negative or zero
+          @date 2026-10-19 */
+      void setEpsilonForFrobeniusNorm (const double EPSILON);
+      
       /** Virtual method for partition of dataset.
        * @param ds dataset to partition 
        * @return returns a elaborated partition (clusters with descriptors)
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <vector>
+#include <utility>
 
 #include "../partitions/granular-dbscan.h"
 #include "../partitions/partitioner.h"
@@ -209,50 +210,53 @@ ksi::partition ksi::granular_dbscan::doPartition(const ksi::dataset &ds)
       ksi::partition part;
       // part.setPartitionMatrix(mU);
       
-      part.setPartitionMatrix(mClusterDatum);
+      part.setPartitionMatrix(std::move(mClusterDatum));
+      part.elaborate_gaussian_clusters(ds);
       return part;
    }
    CATCH
 }
 
-std::vector<std::vector<double>> ksi::granular_dbscan::getClusterDatumMatrix(const ksi::dataset& ds, const std::vector<std::vector<std::shared_ptr<descriptor>>>& granularDs, const std::vector<std::vector<double>>& mU)
+ksi::sparse_membership_matrix ksi::granular_dbscan::getClusterDatumMatrix(const ksi::dataset& ds, const std::vector<std::vector<std::shared_ptr<descriptor>>>& granularDs, const std::vector<std::vector<double>>& mU)
 {
    try 
    {
       const auto ds_size = ds.size();    // number of input data 
       const auto gr_size = granularDs.size();         // number of granules 
       const auto cl_size = mU.size();  // number of clusters
-      std::vector<std::vector<double>> mGranuleDatum (gr_size, std::vector<double> (ds_size));
-    
-      // We have to calculate membership of each data item to each granule. 
       
-      for (std::size_t i = 0; i < ds_size; i++)
-      {
-         auto d = ds.getDatum(i);
-         for (std::size_t g = 0; g < gr_size; g++)
-         {
-             auto memb = getMembershipToGranule(*d, granularDs[g], _pTnorm);
-             mGranuleDatum[g][i] = memb;
-         }
-      }
-      
-      // We have just calculated memberships of all data items to granules.
-      // We already have memberships of granules to clusters.
-      // Now we are elaborating memberships of all data items to clusters.
+      // Memberships of a data item to granules are elaborated once per data item
+      // and immediately combined with memberships of granules to clusters, 
+      // so no granules x data items matrix is stored. Only non-zero memberships 
+      // of data items to clusters are kept.
       
-      std::vector<std::vector<double>> mClusterDatum (cl_size, std::vector<double> (ds_size)); 
+      std::vector<std::vector<std::size_t>> items (cl_size);
+      std::vector<std::vector<double>> memberships (cl_size);
+      std::vector<double> granule_memberships (gr_size);
       
-      for (std::size_t c = 0; c < cl_size; c++)
+      for (std::size_t d = 0; d < ds_size; d++)
       {
-         for (std::size_t d = 0; d < ds_size; d++)
+         auto pDatum = ds.getDatum(d);
+         for (std::size_t g = 0; g < gr_size; g++)
+            granule_memberships[g] = getMembershipToGranule(*pDatum, granularDs[g], _pTnorm);
+         
+         for (std::size_t c = 0; c < cl_size; c++)
          {
             double v { 0 };
             for (std::size_t g = 0; g < gr_size; g++)
-               v = std::max(v, mU[c][g] * mGranuleDatum[g][d]);
-            mClusterDatum[c][d] = v;
+               v = std::max(v, mU[c][g] * granule_memberships[g]);
+            if (v > 0)
+            {
+               items[c].push_back(d);
+               memberships[c].push_back(v);
+            }
          }
       }
       
+      ksi::sparse_membership_matrix mClusterDatum (ds_size);
+      for (std::size_t c = 0; c < cl_size; c++)
+         mClusterDatum.add_row(items[c], memberships[c]);
+      
       return mClusterDatum;
  
    }
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "../partitions/partitioner.h"
+#include "../partitions/sparse_membership_matrix.h"
 #include "../tnorms/t-norm.h"
 #include "../snorms/s-norm.h"
 #include "../descriptors/descriptor.h"
@@ -56,6 +57,10 @@ namespace ksi
 
         granular_dbscan(const granular_dbscan &obj);
 
+        /** @return partition into clusters with a sparse membership matrix 
+                    and Gaussian clusters elaborated from memberships 
+                    (see ksi::partition::elaborate_gaussian_clusters)
+            @param ds dataset to cluster */
         virtual partition doPartition(const dataset &ds) override;
 
         granular_dbscan &operator=(const granular_dbscan &obj);
@@ -118,14 +123,14 @@ namespace ksi
          */
         double getMembershipToGranule(const datum &d, const std::vector<std::shared_ptr<descriptor>> &granule, const std::shared_ptr<t_norm> pTnorm);
 
-        /** @return The method returns the membership matrix. Each row represents a cluster. Each column represents input data item. The i-th cell in the j-th column in the matrix holds membership value of the j-th input data item to the i-th cluster.
+        /** @return The method returns the sparse membership matrix (only non-zero memberships are stored). Each row represents a cluster. Each column represents input data item. The i-th cell in the j-th column in the matrix holds membership value of the j-th input data item to the i-th cluster.
          *  @param ds dataset: a set of input data items
          *  @param granularDs granules: granulated dataset
          *  @param mU membership matrix for granules. Each row represents a cluster. Each column represents a granule.
          *  @date   2022-09-23
          *  @author Krzysztof Siminski
          */
-        std::vector<std::vector<double>> getClusterDatumMatrix(const dataset &ds, const std::vector<std::vector<std::shared_ptr<descriptor>>> &granularDs, const std::vector<std::vector<double>> &mU);
+        sparse_membership_matrix getClusterDatumMatrix(const dataset &ds, const std::vector<std::vector<std::shared_ptr<descriptor>>> &granularDs, const std::vector<std::vector<double>> &mU);
     };
 }
 #endif
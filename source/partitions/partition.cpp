@@ -4,8 +4,12 @@
 #include <vector>
 #include <sstream>
 #include <string>
+#include <cmath>
+#include <utility>
 
 #include "../partitions/partition.h"
+#include "../partitions/sparse_membership_matrix.h"
+#include "../descriptors/descriptor-gaussian.h"
 #include "../service/debug.h"
 #include "../common/extensional-fuzzy-number-gaussian.h"
 #include "../common/datum.h"
@@ -42,6 +46,10 @@ ksi::partition::partition(const ksi::partition & part)
    
    U = part.U;
    V = part.V;
+   _storage = part._storage;
+   _sparse_U = part._sparse_U;
+   _crisp_labels = part._crisp_labels;
+   _nCrispClusters = part._nCrispClusters;
 }
 
 ksi::partition::partition(ksi::partition && part)
@@ -49,6 +57,10 @@ ksi::partition::partition(ksi::partition && part)
    std::swap (clusters, part.clusters);
    std::swap (U, part.U);
    std::swap (V, part.V);
+   std::swap (_storage, part._storage);
+   std::swap (_sparse_U, part._sparse_U);
+   std::swap (_crisp_labels, part._crisp_labels);
+   std::swap (_nCrispClusters, part._nCrispClusters);
 }
 
 ksi::partition& ksi::partition::operator=(const ksi::partition & part)
@@ -58,12 +70,17 @@ ksi::partition& ksi::partition::operator=(const ksi::partition & part)
    
    for (auto & p : clusters)
       delete p;
+   clusters.clear();
    
    for (auto & p : part.clusters)
-      addCluster(p);
+      addCluster(*p);
    
    U = part.U;
    V = part.V;
+   _storage = part._storage;
+   _sparse_U = part._sparse_U;
+   _crisp_labels = part._crisp_labels;
+   _nCrispClusters = part._nCrispClusters;
    
    return * this;
 }
@@ -78,6 +95,10 @@ ksi::partition& ksi::partition::operator=(ksi::partition && part)
    
    std::swap (U, part.U);
    std::swap (V, part.V);
+   std::swap (_storage, part._storage);
+   std::swap (_sparse_U, part._sparse_U);
+   std::swap (_crisp_labels, part._crisp_labels);
+   std::swap (_nCrispClusters, part._nCrispClusters);
    
    return *this;
 }
@@ -142,7 +163,160 @@ std::vector<std::vector<ksi::ext_fuzzy_number_gaussian>> ksi::partition::getGran
 
 std::vector<std::vector<double>> ksi::partition::getPartitionMatrix() const
 {
-   return U;
+   switch (_storage)
+   {
+      case ksi::partition_storage::sparse:
+         return _sparse_U.to_dense();
+      case ksi::partition_storage::crisp:
+      {
+         std::vector<std::vector<double>> mU (_nCrispClusters, std::vector<double> (_crisp_labels.size(), 0.0));
+         for_each_membership([&mU] (std::size_t c, std::size_t i, double u) { mU[c][i] = u; });
+         return mU;
+      }
+      default:
+         return U;
+   }
+}
+
+ksi::partition_storage ksi::partition::get_storage() const
+{
+   return _storage;
+}
+
+std::size_t ksi::partition::get_number_of_partition_rows() const
+{
+   switch (_storage)
+   {
+      case ksi::partition_storage::sparse: return _sparse_U.get_number_of_rows();
+      case ksi::partition_storage::crisp:  return _nCrispClusters;
+      default:                             return U.size();
+   }
+}
+
+std::size_t ksi::partition::get_number_of_partition_columns() const
+{
+   switch (_storage)
+   {
+      case ksi::partition_storage::sparse: return _sparse_U.get_number_of_columns();
+      case ksi::partition_storage::crisp:  return _crisp_labels.size();
+      default:                             return U.empty() ? 0 : U[0].size();
+   }
+}
+
+const std::vector<std::vector<double>> & ksi::partition::get_dense_partition_matrix() const
+{
+   try
+   {
+      if (_storage != ksi::partition_storage::dense)
+         throw ksi::exception ("The partition matrix is not stored in the dense form.");
+      return U;
+   }
+   CATCH;
+}
+
+const ksi::sparse_membership_matrix & ksi::partition::get_sparse_partition_matrix() const
+{
+   try
+   {
+      if (_storage != ksi::partition_storage::sparse)
+         throw ksi::exception ("The partition matrix is not stored in the sparse form.");
+      return _sparse_U;
+   }
+   CATCH;
+}
+
+const std::vector<int> & ksi::partition::get_crisp_labels() const
+{
+   try
+   {
+      if (_storage != ksi::partition_storage::crisp)
+         throw ksi::exception ("The partition is not stored as crisp labels.");
+      return _crisp_labels;
+   }
+   CATCH;
+}
+
+double ksi::partition::get_membership(const std::size_t cluster, const std::size_t item) const
+{
+   switch (_storage)
+   {
+      case ksi::partition_storage::sparse: return _sparse_U.get_value(cluster, item);
+      case ksi::partition_storage::crisp:  return _crisp_labels[item] == (int) cluster ? 1.0 : 0.0;
+      default:                             return U[cluster][item];
+   }
+}
+
+std::vector<int> ksi::partition::get_crisp_membership() const
+{
+   if (_storage == ksi::partition_storage::crisp)
+      return _crisp_labels;
+   
+   std::vector<int> labels (get_number_of_partition_columns(), -1);
+   std::vector<double> highest (labels.size(), 0.0);
+   for_each_membership([&labels, &highest] (std::size_t c, std::size_t i, double u)
+   {
+      // przy rownych przynaleznosciach wygrywa klaster o nizszym numerze
+      if (u > highest[i])
+      {
+         highest[i] = u;
+         labels[i] = (int) c;
+      }
+   });
+   return labels;
+}
+
+void ksi::partition::elaborate_gaussian_clusters(const ksi::dataset & ds)
+{
+   try
+   {
+      const std::size_t nClusters = get_number_of_partition_rows();
+      const std::size_t nItems = get_number_of_partition_columns();
+      if (nItems != ds.getNumberOfData())
+         throw ksi::exception ("Number of data items (" + std::to_string(ds.getNumberOfData()) + ") and number of columns in membership matrix (" + std::to_string(nItems) + ") do not match!");
+      
+      auto X = ds.getMatrix();
+      const std::size_t nAttr = ds.getNumberOfAttributes();
+      
+      std::vector<double> sums (nClusters, 0.0);
+      std::vector<std::vector<double>> mV (nClusters, std::vector<double> (nAttr, 0.0));
+      for_each_membership([&] (std::size_t c, std::size_t i, double u)
+      {
+         sums[c] += u;
+         for (std::size_t a = 0; a < nAttr; a++)
+            mV[c][a] += u * X[i][a];
+      });
+      for (std::size_t c = 0; c < nClusters; c++)
+         if (sums[c] > 0)
+            for (auto & v : mV[c])
+               v /= sums[c];
+      
+      std::vector<std::vector<double>> mS (nClusters, std::vector<double> (nAttr, 0.0));
+      for_each_membership([&] (std::size_t c, std::size_t i, double u)
+      {
+         for (std::size_t a = 0; a < nAttr; a++)
+         {
+            double diff = X[i][a] - mV[c][a];
+            mS[c][a] += u * diff * diff;
+         }
+      });
+      
+      for (auto & p : clusters)
+         delete p;
+      clusters.clear();
+      
+      for (std::size_t c = 0; c < nClusters; c++)
+      {
+         ksi::cluster cl;
+         for (std::size_t a = 0; a < nAttr; a++)
+         {
+            double s = sums[c] > 0 ? std::sqrt(mS[c][a] / sums[c]) : 0.0;
+            cl.addDescriptor(ksi::descriptor_gaussian (mV[c][a], std::max(s, ksi::descriptor_gaussian::MINIMAL_FUZZIFICATION)));
+         }
+         addCluster(cl);
+      }
+      V = std::move(mV);
+   }
+   CATCH;
 }
 
 void ksi::partition::setClusterCentres(const std::vector<std::vector<double>> & cluster_centres)
@@ -159,20 +333,52 @@ void ksi::partition::setClusterCentres(const std::vector<std::vector<ksi::ext_fu
 void ksi::partition::setPartitionMatrix(const std::vector<std::vector<double>> & partition_matrix)
 {
    U = partition_matrix;
+   _storage = ksi::partition_storage::dense;
+}
+
+void ksi::partition::setPartitionMatrix(std::vector<std::vector<double>> && partition_matrix)
+{
+   U = std::move(partition_matrix);
+   _storage = ksi::partition_storage::dense;
+}
+
+void ksi::partition::setPartitionMatrix(ksi::sparse_membership_matrix partition_matrix)
+{
+   _sparse_U = std::move(partition_matrix);
+   U.clear();
+   _storage = ksi::partition_storage::sparse;
+}
+
+void ksi::partition::set_crisp_labels(std::vector<int> labels, const std::size_t number_of_clusters)
+{
+   try
+   {
+      for (const auto l : labels)
+         if (l >= (int) number_of_clusters)
+            throw ksi::exception ("The label " + std::to_string(l) + " exceeds the number of clusters (" + std::to_string(number_of_clusters) + ").");
+      
+      _crisp_labels = std::move(labels);
+      _nCrispClusters = number_of_clusters;
+      U.clear();
+      _storage = ksi::partition_storage::crisp;
+   }
+   CATCH;
 }
 
 void ksi::partition::setPartitionMatrix(const std::vector<std::vector<ksi::ext_fuzzy_number_gaussian> >& partition_matrix)
 {
     U = ksi::ext_fuzzy_number_gaussian::matrix_of_extensional_fuzzy_number_2_double(partition_matrix);
+    _storage = ksi::partition_storage::dense;
 }
 
 std::string ksi::partition::print_partition_matrix()
 {
     std::stringstream ss;
-    for (const auto & cluster : U)
+    const std::size_t nItems = get_number_of_partition_columns();
+    for (std::size_t c = 0; c < get_number_of_partition_rows(); c++)
     {
-        for (const auto & item : cluster)
-            ss << item << '\t';
+        for (std::size_t i = 0; i < nItems; i++)
+            ss << get_membership(c, i) << '\t';
         ss << std::endl;
     }
     
@@ -185,8 +391,7 @@ std::string ksi::partition::print_crisp_membership_for_data(const ksi::dataset&
     try 
     {
         std::stringstream ss; 
-        std::size_t nItems = U[0].size();
-        std::size_t nCluster = U.size();
+        std::size_t nItems = get_number_of_partition_columns();
         if (nItems != ds.getNumberOfData())
         {
             std::stringstream errors;
@@ -194,22 +399,15 @@ std::string ksi::partition::print_crisp_membership_for_data(const ksi::dataset&
             throw errors.str();
         }
         
+        auto labels = get_crisp_membership();
         for (std::size_t i = 0; i < nItems; i++)
         {
             ss << ds.getDatum(i)->to_string() << "\t|\t";
             
-            std::size_t max_cluster_number = 0;
-            for (std::size_t c = 1; c < nCluster; c++)
-            {
-                if (U[max_cluster_number][i] < U[c][i])
-                {
-                    max_cluster_number = c;
-                }
-            }
-            if (U[max_cluster_number][i] == 0)
+            if (labels[i] < 0)
                ss << "NOISE" << std::endl;
             else
-               ss << max_cluster_number << std::endl;
+               ss << labels[i] << std::endl;
         }
         return ss.str();
     }
@@ -221,8 +419,8 @@ std::string ksi::partition::print_dataitems_with_memberships_to_clusters(const k
     try 
     {
         std::stringstream ss; 
-        std::size_t nItems = U[0].size();
-        std::size_t nCluster = U.size();
+        std::size_t nItems = get_number_of_partition_columns();
+        std::size_t nCluster = get_number_of_partition_rows();
         if (nItems != ds.getNumberOfData())
         {
             std::stringstream errors;
@@ -236,7 +434,7 @@ std::string ksi::partition::print_dataitems_with_memberships_to_clusters(const k
             
             for (std::size_t c = 0; c < nCluster; c++)
             {
-                ss << U[c][i] << '\t';
+                ss << get_membership(c, i) << '\t';
             }
             ss << std::endl;
         }
@@ -7,11 +7,21 @@
 #include <iostream>
 #include <string>
 #include "../partitions/cluster.h"
+#include "../partitions/sparse_membership_matrix.h"
 #include "../common/extensional-fuzzy-number-gaussian.h"
 #include "../common/dataset.h"
 
 namespace ksi
 {
+   /** storage of the partition matrix 
+       @date 2026-10-18 */
+   enum class partition_storage
+   {
+      dense,  ///< full matrix clusters x data items
+      sparse, ///< only non-zero memberships (ksi::sparse_membership_matrix)
+      crisp   ///< one label of a cluster for each data item (-1 for noise)
+   };
+   
    /** Class partition implements an interface for input domain partitions.
     *  Class cluster (subclass of partition class) and partitioner class compose a factory design pattern (role: product).
     *  Class cluster (subclass of partition class) and descriptor class compose a factory design pattern (role: producer)
@@ -26,6 +36,54 @@ namespace ksi
       /** cluster centres */
       std::vector<std::vector<double>> V;
       
+      /** which of U, _sparse_U, _crisp_labels holds the partition matrix 
+          @date 2026-10-18 */
+      partition_storage _storage = partition_storage::dense;
+      
+      /** sparse partition matrix 
+          @date 2026-10-18 */
+      sparse_membership_matrix _sparse_U;
+      
+      /** crisp labels of data items, -1 for noise 
+          @date 2026-10-18 */
+      std::vector<int> _crisp_labels;
+      
+      /** number of clusters for crisp labels 
+          @date 2026-10-18 */
+      std::size_t _nCrispClusters = 0;
+      
+      /** The method calls fn (cluster, item, membership) for each non-zero 
+          membership in the partition matrix. The cost is proportional to the size 
+          of the storage: clusters x items (dense), non-zeros (sparse), items (crisp).
+          @date 2026-10-18 */
+      template <typename Function>
+      void for_each_membership (Function fn) const
+      {
+         switch (_storage)
+         {
+            case partition_storage::dense:
+               for (std::size_t c = 0; c < U.size(); c++)
+                  for (std::size_t i = 0; i < U[c].size(); i++)
+                     if (U[c][i] != 0)
+                        fn(c, i, U[c][i]);
+               break;
+            case partition_storage::sparse:
+               for (std::size_t c = 0; c < _sparse_U.get_number_of_rows(); c++)
+               {
+                  auto items = _sparse_U.get_columns(c);
+                  auto memberships = _sparse_U.get_values(c);
+                  for (std::size_t k = 0; k < items.size(); k++)
+                     fn(c, items[k], memberships[k]);
+               }
+               break;
+            case partition_storage::crisp:
+               for (std::size_t i = 0; i < _crisp_labels.size(); i++)
+                  if (_crisp_labels[i] >= 0)
+                     fn((std::size_t) _crisp_labels[i], i, 1.0);
+               break;
+         }
+      }
+      
    public:
       ~partition();
       partition ();
@@ -65,8 +123,48 @@ namespace ksi
        */
       std::size_t getNumberOfClusters () const ;
             
-      /** @return partition matrix */
+      /** @return partition matrix (in the dense form, whatever the storage) 
+          The copy has clusters x items elements even for sparse and crisp storage, 
+          so the library itself does not call the method: it visits memberships 
+          with for_each_membership or reads get_sparse_partition_matrix and get_crisp_labels. 
+          The method is kept for users of the dense matrix. */
       std::vector<std::vector<double>> getPartitionMatrix () const;
+      
+      /** @return storage of the partition matrix 
+          @date 2026-10-18 */
+      partition_storage get_storage () const;
+      
+      /** @return number of rows (clusters) of the partition matrix 
+          @date 2026-10-18 */
+      std::size_t get_number_of_partition_rows () const;
+      
+      /** @return number of columns (data items) of the partition matrix 
+          @date 2026-10-18 */
+      std::size_t get_number_of_partition_columns () const;
+      
+      /** @return the dense partition matrix (without a copy) 
+          @throw ksi::exception if the storage is not dense
+          @date 2026-10-18 */
+      const std::vector<std::vector<double>> & get_dense_partition_matrix () const;
+      
+      /** @return the sparse partition matrix (without a copy) 
+          @throw ksi::exception if the storage is not sparse
+          @date 2026-10-18 */
+      const sparse_membership_matrix & get_sparse_partition_matrix () const;
+      
+      /** @return crisp labels of data items, -1 for noise (without a copy) 
+          @throw ksi::exception if the storage is not crisp
+          @date 2026-10-18 */
+      const std::vector<int> & get_crisp_labels () const;
+      
+      /** @return membership of a data item to a cluster 
+          @date 2026-10-18 */
+      double get_membership (const std::size_t cluster, const std::size_t item) const;
+      
+      /** @return for each data item the cluster with the highest membership,
+                  -1 if all memberships are zero (noise)
+          @date 2026-10-18 */
+      std::vector<int> get_crisp_membership () const;
       /** @return cluster centres 
        *  @date 2018-12-16
        */
@@ -84,6 +182,25 @@ namespace ksi
        @date 2018-12-16
        */
       void setPartitionMatrix (const std::vector<std::vector<double>> & partition_matrix);
+      
+      /** The method sets partition matrix.
+       @param partition_matrix a matrix to move 
+       @date 2026-10-18
+       */
+      void setPartitionMatrix (std::vector<std::vector<double>> && partition_matrix);
+      
+      /** The method sets sparse partition matrix.
+       @param partition_matrix a matrix to set 
+       @date 2026-10-18
+       */
+      void setPartitionMatrix (sparse_membership_matrix partition_matrix);
+      
+      /** The method sets crisp partition.
+       @param labels label of a cluster for each data item, -1 for noise
+       @param number_of_clusters number of clusters
+       @date 2026-10-18
+       */
+      void set_crisp_labels (std::vector<int> labels, const std::size_t number_of_clusters);
 
       /** The method sets partition matrix.
        @param partition_matrix a matrix to set, it is set with cores of gaussian extensional numbers
@@ -104,6 +221,18 @@ namespace ksi
       void setClusterCentres (const std::vector<std::vector<ksi::ext_fuzzy_number_gaussian>> & cluster_centres);
 
       
+      /** The method elaborates cluster centres and Gaussian clusters from memberships:
+          the centre is the weighted mean, the fuzzification -- the weighted standard deviation
+          of each attribute (at least ksi::descriptor_gaussian::MINIMAL_FUZZIFICATION, 
+          so clusters of single or identical items have positive fuzzification). 
+          Only non-zero memberships are visited. 
+          Previous clusters are removed. Partitioners without clusters 
+          of their own (ksi::dbscan, ksi::granular_dbscan) call it, so their 
+          partitions can be used for premises of rules.
+          @param ds clustered dataset
+          @date 2026-10-18 */
+      void elaborate_gaussian_clusters (const dataset & ds);
+      
       /** The method sets matrices for the Mahalanobis distance.
        @param A_matrices A vector of matrices to set.
        @date 2023-04-27 */
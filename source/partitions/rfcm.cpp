@@ -1,11 +1,14 @@
 /** @file */  
  
 #include <cmath>
+#include <typeinfo>
  
 #include "../auxiliary/definitions.h"
 #include "partitioner.h"
 #include "partition.h"
 #include "../common/dataset.h"
+#include "../common/imputation_overlay.h"
+#include "../common/data-modifier-imputer-values-from-knn.h"
 #include "../descriptors/descriptor-interval-gaussian.h"
 #include "../service/debug.h"
 #include "rfcm.h"
@@ -107,6 +110,15 @@ ksi::partition ksi::rfcm::doPartition(const ksi::dataset & ds)
       if (_nIterations > 0 and _epsilon > 0)
          throw std::string ("Both number of iterations and minimal epsilon set -- you should set either number of iterations or minimal epsilon.");
    
+      // The imputed data set multiplies observed values of incomplete data items,
+      // the overlay stores only candidate values of missing attributes.
+      if (typeid(*_pImputer) == typeid(ksi::data_modifier_imputer_values_from_knn) 
+          and typeid(*_pMarginaliser) == typeid(ksi::data_modifier_marginaliser)
+          and not _pImputer->hasNextModifier() and not _pMarginaliser->hasNextModifier())
+      {
+         auto pImputer = dynamic_cast<ksi::data_modifier_imputer_values_from_knn *>(_pImputer);
+         return doPartition(pImputer->overlay(ds));
+      }
       
       ksi::dataset lowerDataset (ds);   // marginalised
       ksi::dataset upperDataset (ds);   // imputed
@@ -267,3 +279,280 @@ std::vector<std::vector<double>> ksi::rfcm::calculateClusterCentres(
    }
    CATCH;
 }
+
+ksi::partition ksi::rfcm::doPartition(const ksi::imputation_overlay & overlay)
+{
+   try
+   {
+      if (_nClusters < 1)
+         throw std::string ("number of clusters not set");
+      if (_nIterations < 1 and _epsilon < 0)
+         throw std::string ("You should set a maximal number of iteration or "
+                            "minimal difference -- epsilon.");
+      if (_nIterations > 0 and _epsilon > 0)
+         throw std::string ("Both number of iterations and minimal epsilon set -- you should set either number of iterations or minimal epsilon.");
+      
+      using view = ksi::imputation_overlay::view;
+      
+      std::size_t nAttr = overlay.get_number_of_attributes();
+      std::vector<std::vector<double>> mV;
+      
+      // dla lower
+      auto mUlower = std::vector<std::vector<double>> (_nClusters, std::vector<double> (overlay.get_number_of_items(view::lower)));
+      randomise(mUlower);
+      fcm::normaliseByColumns(mUlower);
+      
+      // dla upper (all items have unit weights)
+      auto mUupper = std::vector<std::vector<double>> (_nClusters, std::vector<double> (overlay.get_number_of_items(view::upper)));
+      randomise(mUupper);
+      fcm::normaliseByColumns(mUupper);
+      
+      auto centres = [&] ()
+      {
+         if (_useMarginalisedDataForCentres) 
+            return calculateClusterCentres(mUlower, overlay, view::lower);
+         else
+            return calculateClusterCentres(mUupper, overlay, view::upper);
+      };
+      
+      if (_nIterations > 0)
+      {
+         for (int iter = 0; iter < _nIterations; iter++)
+         {
+            mV = centres();
+            mUlower = modifyPartitionMatrix (mV, overlay, view::lower);
+            mUupper = modifyPartitionMatrix (mV, overlay, view::upper);
+         }
+      }
+      else if (_epsilon > 0)
+      {
+         double frobUpper, frobLower;
+         do 
+         {
+            mV = centres();
+            auto mUlowerNew = modifyPartitionMatrix (mV, overlay, view::lower);
+            auto mUupperNew = modifyPartitionMatrix (mV, overlay, view::upper);
+            frobUpper = Frobenius_norm_of_difference (mUupper, mUupperNew);
+            frobLower = Frobenius_norm_of_difference (mUlower, mUlowerNew);
+            mUupper = std::move(mUupperNew);
+            mUlower = std::move(mUlowerNew);
+         } while (frobUpper > _epsilon or frobLower > _epsilon);
+      }     
+      
+      mV = centres();
+      
+      auto mSupper = calculateClusterFuzzification(mUupper, mV, overlay, view::upper);
+      auto mSlower = calculateClusterFuzzification(mUlower, mV, overlay, view::lower);
+      
+      // przeksztalcenie do postaci zbiorow gaussowskich
+      ksi::partition part;
+      for (int c = 0; c < _nClusters; c++)
+      {
+         ksi::cluster cl; 
+         for (std::size_t a = 0; a < nAttr; a++)
+         {
+            ksi::descriptor_interval_gaussian d (mV[c][a], 
+                                        mSlower[c][a], 
+                                        mSupper[c][a]);
+            cl.addDescriptor(d);
+         }
+         part.addCluster(cl);
+      }
+      return part;
+   }
+   CATCH;
+}
+
+std::vector<std::vector<double>> ksi::rfcm::calculateClusterCentres(
+   const std::vector<std::vector<double>> & U, 
+   const ksi::imputation_overlay & overlay,
+   const ksi::imputation_overlay::view v)
+{
+   try
+   {
+      const std::size_t nAttr = overlay.get_number_of_attributes();
+      const std::size_t nRows = overlay.get_number_of_rows(v);
+      std::vector<std::vector<double>> V (_nClusters, std::vector<double> (nAttr));
+      
+      #pragma omp parallel for
+      for (int c = 0; c < _nClusters; c++)
+      {
+         std::vector<double> suma_x (nAttr, 0.0);
+         double suma_u_ci_m = 0.0;
+         
+         for (std::size_t i = 0; i < nRows; i++)
+         {
+            const auto values     = overlay.get_values(v, i);
+            const auto missing    = overlay.get_missing_columns(v, i);
+            const auto candidates = overlay.get_candidates(v, i);
+            const std::size_t first  = overlay.get_first_item(v, i);
+            const std::size_t nItems = overlay.get_number_of_items(v, i);
+            
+            double suma_u_row = 0.0;
+            for (std::size_t j = 0; j < nItems; j++)
+            {
+               const double u_ci_m = std::pow(U[c][first + j], _m);
+               suma_u_row += u_ci_m;
+               for (std::size_t m = 0; m < missing.size(); m++)
+                  suma_x[missing[m]] += u_ci_m * candidates[j * missing.size() + m];
+            }
+            // missing values are 0 in the observed values
+            for (std::size_t a = 0; a < nAttr; a++)
+               suma_x[a] += suma_u_row * values[a];
+            suma_u_ci_m += suma_u_row;
+         }
+         
+         for (std::size_t a = 0; a < nAttr; a++)
+            V[c][a] = suma_x[a] / suma_u_ci_m;
+      }
+      return V;
+   }
+   CATCH;
+}
+
+std::vector<std::vector<double>> ksi::rfcm::modifyPartitionMatrix(
+   const std::vector<std::vector<double>> & mV, 
+   const ksi::imputation_overlay & overlay,
+   const ksi::imputation_overlay::view v)
+{
+   try
+   {
+      const std::size_t nClusters = mV.size();
+      const std::size_t nAttr = overlay.get_number_of_attributes();
+      const std::size_t nRows = overlay.get_number_of_rows(v);
+      const double exponent = 2.0 / (1.0 - _m);
+      
+      std::vector<std::vector<double>> U (nClusters, std::vector<double> (overlay.get_number_of_items(v)));
+      
+      #pragma omp parallel 
+      {
+         std::vector<double> observed (nClusters);
+         std::vector<double> Dm (nClusters);
+         
+         #pragma omp for
+         for (std::size_t i = 0; i < nRows; i++)
+         {
+            const auto values     = overlay.get_values(v, i);
+            const auto missing    = overlay.get_missing_columns(v, i);
+            const auto candidates = overlay.get_candidates(v, i);
+            const std::size_t first  = overlay.get_first_item(v, i);
+            const std::size_t nItems = overlay.get_number_of_items(v, i);
+            
+            // squared distances of the observed part (shared by all items of the data item)
+            for (std::size_t c = 0; c < nClusters; c++)
+            {
+               double suma = 0.0;
+               std::size_t m = 0;
+               for (std::size_t a = 0; a < nAttr; a++)
+               {
+                  if (m < missing.size() and missing[m] == a)
+                     m++;
+                  else
+                  {
+                     const double roznica = values[a] - mV[c][a];
+                     suma += roznica * roznica;
+                  }
+               }
+               observed[c] = suma;
+            }
+            
+            for (std::size_t j = 0; j < nItems; j++)
+            {
+               const double * imputed = candidates.data() + j * missing.size();
+               double Dmsum = 0.0;
+               int Dmzeros = 0;
+               for (std::size_t c = 0; c < nClusters; c++)
+               {
+                  double suma = observed[c];
+                  for (std::size_t m = 0; m < missing.size(); m++)
+                  {
+                     const double roznica = imputed[m] - mV[c][missing[m]];
+                     suma += roznica * roznica;
+                  }
+                  if (suma == 0.0)
+                  {
+                     Dm[c] = 0.0;
+                     Dmzeros++;
+                  }
+                  else
+                  {
+                     Dm[c] = std::pow(std::sqrt(suma), exponent);
+                     Dmsum += Dm[c];
+                  }
+               }
+               
+               // an item in a cluster centre belongs only to this cluster(s)
+               for (std::size_t c = 0; c < nClusters; c++)
+               {
+                  if (Dmzeros > 0)
+                     U[c][first + j] = Dm[c] == 0.0 ? 1.0 / Dmzeros : 0.0;
+                  else
+                     U[c][first + j] = Dm[c] / Dmsum;
+               }
+            }
+         }
+      }
+      return U;
+   }
+   CATCH;
+}
+
+std::vector<std::vector<double>> ksi::rfcm::calculateClusterFuzzification(
+   const std::vector<std::vector<double>> & mU, 
+   const std::vector<std::vector<double>> & mV, 
+   const ksi::imputation_overlay & overlay,
+   const ksi::imputation_overlay::view v)
+{
+   try
+   {
+      const std::size_t nAttr = overlay.get_number_of_attributes();
+      const std::size_t nRows = overlay.get_number_of_rows(v);
+      auto mS (mV);
+      
+      #pragma omp parallel for
+      for (int c = 0; c < _nClusters; c++)
+      {
+         double sumU = 0.0;
+         std::vector<double> sumUXV (nAttr, 0.0);
+         
+         for (std::size_t i = 0; i < nRows; i++)
+         {
+            const auto values     = overlay.get_values(v, i);
+            const auto missing    = overlay.get_missing_columns(v, i);
+            const auto candidates = overlay.get_candidates(v, i);
+            const std::size_t first  = overlay.get_first_item(v, i);
+            const std::size_t nItems = overlay.get_number_of_items(v, i);
+            
+            double sumU_row = 0.0;
+            for (std::size_t j = 0; j < nItems; j++)
+            {
+               const double um = std::pow(mU[c][first + j], _m);
+               sumU_row += um;
+               for (std::size_t m = 0; m < missing.size(); m++)
+               {
+                  const double roznica = candidates[j * missing.size() + m] - mV[c][missing[m]];
+                  sumUXV[missing[m]] += um * roznica * roznica;
+               }
+            }
+            
+            std::size_t m = 0;
+            for (std::size_t a = 0; a < nAttr; a++)
+            {
+               if (m < missing.size() and missing[m] == a)
+                  m++;
+               else
+               {
+                  const double roznica = values[a] - mV[c][a];
+                  sumUXV[a] += sumU_row * roznica * roznica;
+               }
+            }
+            sumU += sumU_row;
+         }
+         
+         for (std::size_t a = 0; a < nAttr; a++)
+            mS[c][a] = std::sqrt (sumUXV[a] / sumU);
+      }
+      return mS;
+   }
+   CATCH;
+}
@@ -12,6 +12,7 @@
 #include "fcm-conditional.h"
 #include "../common/data-modifier-imputer.h"
 #include "../common/data-modifier-marginaliser.h"
+#include "../common/imputation_overlay.h"
 
 
 namespace ksi
@@ -65,6 +66,50 @@ namespace ksi
          const std::vector<std::vector<double>> & U,
          const std::vector<std::vector<double>> & X,
          const std::vector<double>              & w);
+      
+      /** The method calculates cluster centres of items of a view of 
+       * an imputation overlay. The observed values of an incomplete data item
+       * are multiplied by the sum of memberships of its imputed items.
+       * @param U partition matrix of items of the view
+       * @param overlay imputed data
+       * @param v view
+       * @return matrix of cluster centres 
+       * @date 2026-10-19
+       */
+      std::vector<std::vector<double>> calculateClusterCentres (
+         const std::vector<std::vector<double>> & U,
+         const ksi::imputation_overlay & overlay,
+         const ksi::imputation_overlay::view v);
+      
+      /** The method elaborates the normalised partition matrix of items of a view
+       * of an imputation overlay. The squared distance of the observed part
+       * of an incomplete data item to a cluster centre is elaborated once
+       * for all its imputed items.
+       * @param mV cluster centres
+       * @param overlay imputed data
+       * @param v view
+       * @return partition matrix 
+       * @date 2026-10-19
+       */
+      std::vector<std::vector<double>> modifyPartitionMatrix (
+         const std::vector<std::vector<double>> & mV,
+         const ksi::imputation_overlay & overlay,
+         const ksi::imputation_overlay::view v);
+      
+      /** The method calculates fuzzifications of clusters for items of a view 
+       * of an imputation overlay.
+       * @param mU partition matrix of items of the view
+       * @param mV cluster centres
+       * @param overlay imputed data
+       * @param v view
+       * @return matrix of fuzzifications of clusters
+       * @date 2026-10-19
+       */
+      std::vector<std::vector<double>> calculateClusterFuzzification (
+         const std::vector<std::vector<double>> & mU,
+         const std::vector<std::vector<double>> & mV,
+         const ksi::imputation_overlay & overlay,
+         const ksi::imputation_overlay::view v);
    public: 
       
       /** Constructor of ksi::rfcm -- constructor copies the 
@@ -84,8 +129,20 @@ namespace ksi
       rfcm & operator= (rfcm && wzor);
       virtual ~rfcm ();      
       
-      /** @throw ksi::exception if _pImputer or _pMarginaliser not set */
+      /** If the imputer is ksi::data_modifier_imputer_values_from_knn and 
+       * the marginaliser is ksi::data_modifier_marginaliser (both without 
+       * next modifiers), the data are clustered with an imputation overlay
+       * and the imputed data set is not created.
+       * @throw ksi::exception if _pImputer or _pMarginaliser not set */
       virtual partition doPartition(const ksi::dataset& ds);
+      
+      /** The method clusters imputed data stored in an imputation overlay.
+       * The lower view is clustered as the marginalised data set, 
+       * the upper view -- as the imputed data set.
+       * @param overlay imputed data
+       * @date 2026-10-19
+       */
+      partition doPartition (const ksi::imputation_overlay & overlay);
       virtual partitioner * clone () const;
       
       /** The method sets bLowersetBasedLocalisation flag.
@@ -4,15 +4,20 @@
 #include <random>
 #include <chrono>
 #include <algorithm>
+#include <typeinfo>
+#include <map>
  
 #include "../service/debug.h"
 #include "partitioner.h"
 #include "partition.h"
 #include "../common/dataset.h"
+#include "../common/imputation_overlay.h"
+#include "../common/data-modifier-imputer-values-from-knn.h"
 #include "../owas/owa.h"
 #include "../owas/uowa.h"
 #include "../descriptors/descriptor-interval-gaussian.h"
 #include "../service/debug.h"
+#include "../auxiliary/random_service.h"
 #include "rfcom.h"
 
 
@@ -79,6 +84,10 @@ ksi::partition ksi::rfcom::doPartition(const ksi::dataset & ds)
 {
    try
    {
+      // typicalities of data items are the result of the algorithm too: 
+      // they are written into the clustered dataset
+      ksi::dataset & typical = const_cast<ksi::dataset &>(ds);
+      
       if (not _pMarginaliser)
          throw std::string ("marginalised object not set");
       if (not _pImputer)
@@ -97,34 +106,55 @@ ksi::partition ksi::rfcom::doPartition(const ksi::dataset & ds)
       const auto pOriginalOwa = pOwa;
       ksi::uowa uniformOWA;
       
-      ksi::dataset lowerDataset (ds);   // marginalised
-      ksi::dataset upperDataset (ds);   // imputed
+      // The imputed data set multiplies observed values of incomplete data items,
+      // the overlay stores only candidate values of missing attributes.
+      const bool bOverlay = typeid(*_pImputer) == typeid(ksi::data_modifier_imputer_values_from_knn) 
+                        and typeid(*_pMarginaliser) == typeid(ksi::data_modifier_marginaliser)
+                        and not _pImputer->hasNextModifier() and not _pMarginaliser->hasNextModifier();
       
-      _pMarginaliser->modify(lowerDataset);
-      if (lowerDataset.getNumberOfData() == 0) // empty lower set 
-         return ksi::partition();
+      ksi::imputation_overlay overlay;
+      ksi::dataset lowerDataset;   // marginalised
+      ksi::dataset upperDataset;   // imputed
+      std::vector<std::vector<double>> mXLower, mXUpper;
       
-      _pImputer->modify(upperDataset);
+      if (bOverlay)
+      {
+         overlay = dynamic_cast<ksi::data_modifier_imputer_values_from_knn *>(_pImputer)->overlay(ds);
+         if (overlay.get_number_of_items(ksi::imputation_overlay::view::lower) == 0) // empty lower set 
+            return ksi::partition();
+         mXLower = overlay.get_matrix(ksi::imputation_overlay::view::lower);
+         mXUpper = overlay.get_matrix(ksi::imputation_overlay::view::upper);
+      }
+      else
+      {
+         lowerDataset = ds;
+         _pMarginaliser->modify(lowerDataset);
+         if (lowerDataset.getNumberOfData() == 0) // empty lower set 
+            return ksi::partition();
+         
+         upperDataset = ds;
+         _pImputer->modify(upperDataset);
+         
+         mXLower = lowerDataset.getMatrix();
+         mXUpper = upperDataset.getMatrix();
+      }
       
       std::size_t nAttr = ds.getNumberOfAttributes();
-      std::size_t nXLower = lowerDataset.getNumberOfData();
-      std::size_t nXUpper = upperDataset.getNumberOfData();
-      
-      auto mXLower = lowerDataset.getMatrix();
-      auto mXUpper = upperDataset.getMatrix();
+      std::size_t nXLower = mXLower.size();
+      std::size_t nXUpper = mXUpper.size();
       
-      // weights in upper data set:
+      // weights in upper data set (items of the overlay have unit weights):
       
-      std::vector<double> wWeightsUpper (nXUpper);
-      for (std::size_t x = 0; x < nXUpper; x++)
-         wWeightsUpper[x] = upperDataset.getDatum(x)->getWeight();
+      std::vector<double> wWeightsUpper (nXUpper, 1.0);
+      if (not bOverlay)
+         for (std::size_t x = 0; x < nXUpper; x++)
+            wWeightsUpper[x] = upperDataset.getDatum(x)->getWeight();
       
       std::vector<std::vector<double>> mV, mVnext;
       
       mV = std::vector<std::vector<double>> (_nClusters);
       
-      std::default_random_engine silnik;
-      silnik.seed(std::chrono::system_clock::now().time_since_epoch().count());
+      auto silnik = ksi::random_service::next_stream();
       std::uniform_int_distribution<std::size_t> rozklad (0, nXLower - 1);
     
       // initialize cluster centres at random
@@ -144,9 +174,9 @@ ksi::partition ksi::rfcom::doPartition(const ksi::dataset & ds)
       globalTypicalitiesUpper =  std::vector<double> (nXUpper, 1.0);
       
       // itinialize typicalities in data items with 1
-      for (std::size_t x = 0; x < nXLower; x++)
+      for (std::size_t x = 0; x < lowerDataset.getNumberOfData(); x++)
          lowerDataset.getDatumNonConst(x)->setTypicality(1.0);
-      for (std::size_t x = 0; x < nXUpper; x++)
+      for (std::size_t x = 0; x < upperDataset.getNumberOfData(); x++)
          upperDataset.getDatumNonConst(x)->setTypicality(1.0);
       
       int iter = 0;
@@ -206,9 +236,9 @@ ksi::partition ksi::rfcom::doPartition(const ksi::dataset & ds)
       pOwa = pOriginalOwa;
       
       // set elaborated typicalities into data set:
-      for (std::size_t x = 0; x < nXLower; x++)
+      for (std::size_t x = 0; x < lowerDataset.getNumberOfData(); x++)
          lowerDataset.getDatumNonConst(x)->setTypicality(globalTypicalitiesLower[x]);
-      for (std::size_t x = 0; x < nXUpper; x++)
+      for (std::size_t x = 0; x < upperDataset.getNumberOfData(); x++)
          upperDataset.getDatumNonConst(x)->setTypicality(globalTypicalitiesUpper[x]);
       
       // elaborate descriptors of data partition:
@@ -231,36 +261,57 @@ ksi::partition ksi::rfcom::doPartition(const ksi::dataset & ds)
       
       // The last step: elaborate typicalities of original data items:
       auto nX = ds.getNumberOfData(); 
+      if (bOverlay)
+      {
+         // items of an original data item are consecutive in the upper view
+         auto typicalities = overlay.maximum_by_rows(globalTypicalitiesUpper);
+         for (std::size_t x = 0; x < nXLower; x++)
+         {
+            auto row = overlay.get_row(ksi::imputation_overlay::view::lower, x);
+            typicalities[row] = std::max(typicalities[row], globalTypicalitiesLower[x]);
+         }
+         for (std::size_t x = 0; x < nX; x++)
+            typical.getDatumNonConst(x)->setTypicality(typicalities[x]);
+         return part;
+      }
+      
+      // Data items are found by their IDs. Imputers keep IDs of complete data items 
+      // (with IDincomplete == 0 or -1), imputed items get new IDs and the ID 
+      // of their original data item in IDincomplete.
+      std::map<long int, std::size_t> rows;
       for (std::size_t x = 0; x < nX; x++)
       {
-         ds.getDatumNonConst(x)->setTypicality(0.0);
+         typical.getDatumNonConst(x)->setTypicality(0.0);
+         rows[ds.getDatum(x)->getID()] = x;
       }
+      if (rows.size() != nX)
+         throw ksi::exception ("IDs of data items are not unique (see ksi::dataset::resetIDs).");
+      auto original = [&rows] (const ksi::datum * p)
+      {
+         auto it = rows.find(p->getID());
+         if (it == rows.end())
+            it = rows.find(p->getIDincomplete());
+         if (it == rows.end())
+            throw ksi::exception ("No original data item for the data item with ID " + std::to_string(p->getID()) + ".");
+         return it->second;
+      };
       
       for (std::size_t x = 0; x < nXLower; x++)
       {
          auto typicality = lowerDataset.getDatum(x)->getTypicality();
-         auto id         = lowerDataset.getDatum(x)->getID();
+         auto row = original(lowerDataset.getDatum(x));
          
-         auto ds_typicality = ds.getDatum(id)->getTypicality();
-         ds.getDatumNonConst(id)->setTypicality(std::max(typicality, ds_typicality));
+         auto ds_typicality = ds.getDatum(row)->getTypicality();
+         typical.getDatumNonConst(row)->setTypicality(std::max(typicality, ds_typicality));
       }
       
       for (std::size_t x = 0; x < nXUpper; x++)
       {
          auto typicality = upperDataset.getDatum(x)->getTypicality();
-         auto id         = upperDataset.getDatum(x)->getID();
-         auto id_incomplete = upperDataset.getDatum(x)->getIDincomplete();
+         auto row = original(upperDataset.getDatum(x));
          
-         if (id_incomplete < 0)           
-         {
-            auto ds_typicality = ds.getDatum(id)->getTypicality();
-            ds.getDatumNonConst(id)->setTypicality(std::max(typicality, ds_typicality));
-         }
-         else // imputed tuple, find parent (original tuple)
-         {
-            auto ds_typicality = ds.getDatum(id_incomplete)->getTypicality();
-            ds.getDatumNonConst(id_incomplete)->setTypicality(std::max(typicality, ds_typicality));
-         }
+         auto ds_typicality = ds.getDatum(row)->getTypicality();
+         typical.getDatumNonConst(row)->setTypicality(std::max(typicality, ds_typicality));
       }
       return part;
    }
@@ -385,8 +436,7 @@ std::vector<std::vector<double>> ksi::rfcom::initializeClusterCentres(
       // means calculated
       // now random deviation:
       
-      std::default_random_engine silnik;
-      silnik.seed(std::chrono::system_clock::now().time_since_epoch().count());
+      auto silnik = ksi::random_service::next_stream();
       std::normal_distribution<double> rozklad (MEAN, DEV);
       
       std::vector<std::vector<double>> mV;
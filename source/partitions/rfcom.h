@@ -146,6 +146,12 @@ namespace ksi
        *   <li>The upper typicality of an incomplete data item is composed of several typicalities of imputed data items. These typicalities are aggregated with an S-norm.</li>
        *   <li>In our algorithm we use max S-norm.</li>
        * </ol>
+       * If the imputer is ksi::data_modifier_imputer_values_from_knn and 
+       * the marginaliser is ksi::data_modifier_marginaliser (both without 
+       * next modifiers), the lower and upper data are elaborated from 
+       * an imputation overlay (no imputed data set is created) and typicalities 
+       * of imputed items are aggregated to their original data items
+       * by the overlay.
        * 
        * @throw ksi::exception if _pImputer or _pMarginaliser or _nClusters 
        *                        or _epsilon or pDissimilarity or pOwa not set 
@@ -0,0 +1,105 @@
+/** @file */
+
+#include <vector>
+#include <span>
+#include <string>
+#include <algorithm>
+
+#include "../partitions/sparse_membership_matrix.h"
+#include "../service/debug.h"
+#include "../service/exception.h"
+
+ksi::sparse_membership_matrix::sparse_membership_matrix()
+{
+}
+
+ksi::sparse_membership_matrix::sparse_membership_matrix(const std::size_t number_of_columns)
+: _nColumns (number_of_columns)
+{
+}
+
+void ksi::sparse_membership_matrix::add_row(const std::vector<std::size_t> & columns, const std::vector<double> & values)
+{
+   try
+   {
+      if (columns.size() != values.size())
+         throw ksi::exception ("The numbers of columns (" + std::to_string(columns.size()) + ") and values (" + std::to_string(values.size()) + ") do not match.");
+
+      for (std::size_t i = 0; i < columns.size(); i++)
+      {
+         if (columns[i] >= _nColumns)
+            throw ksi::exception ("The column index " + std::to_string(columns[i]) + " exceeds the number of columns (" + std::to_string(_nColumns) + ").");
+         if (i > 0 and columns[i] <= columns[i - 1])
+            throw ksi::exception ("The column indices are not ascending.");
+      }
+
+      _columns.insert(_columns.end(), columns.begin(), columns.end());
+      _values.insert(_values.end(), values.begin(), values.end());
+      _offsets.push_back(_columns.size());
+   }
+   CATCH;
+}
+
+void ksi::sparse_membership_matrix::add_row(const std::vector<double> & row)
+{
+   try
+   {
+      if (row.size() != _nColumns)
+         throw ksi::exception ("The row has " + std::to_string(row.size()) + " values, but the matrix has " + std::to_string(_nColumns) + " columns.");
+
+      for (std::size_t c = 0; c < row.size(); c++)
+      {
+         if (row[c] != 0)
+         {
+            _columns.push_back(c);
+            _values.push_back(row[c]);
+         }
+      }
+      _offsets.push_back(_columns.size());
+   }
+   CATCH;
+}
+
+std::size_t ksi::sparse_membership_matrix::get_number_of_rows() const
+{
+   return _offsets.size() - 1;
+}
+
+std::size_t ksi::sparse_membership_matrix::get_number_of_columns() const
+{
+   return _nColumns;
+}
+
+std::size_t ksi::sparse_membership_matrix::get_number_of_nonzeros() const
+{
+   return _values.size();
+}
+
+std::span<const std::size_t> ksi::sparse_membership_matrix::get_columns(const std::size_t row) const
+{
+   return { _columns.data() + _offsets[row], _offsets[row + 1] - _offsets[row] };
+}
+
+std::span<const double> ksi::sparse_membership_matrix::get_values(const std::size_t row) const
+{
+   return { _values.data() + _offsets[row], _offsets[row + 1] - _offsets[row] };
+}
+
+double ksi::sparse_membership_matrix::get_value(const std::size_t row, const std::size_t column) const
+{
+   auto first = _columns.begin() + _offsets[row];
+   auto last  = _columns.begin() + _offsets[row + 1];
+   auto it = std::lower_bound(first, last, column);
+   if (it != last and *it == column)
+      return _values[it - _columns.begin()];
+   return 0.0;
+}
+
+std::vector<std::vector<double>> ksi::sparse_membership_matrix::to_dense() const
+{
+   std::vector<std::vector<double>> dense (get_number_of_rows(), std::vector<double> (_nColumns, 0.0));
+   for (std::size_t r = 0; r < get_number_of_rows(); r++)
+      for (std::size_t i = _offsets[r]; i < _offsets[r + 1]; i++)
+         dense[r][_columns[i]] = _values[i];
+   return dense;
+}
@@ -0,0 +1,66 @@
+/** @file */
+
+#ifndef SPARSE_MEMBERSHIP_MATRIX_H
+#define SPARSE_MEMBERSHIP_MATRIX_H
+
+#include <vector>
+#include <span>
+
+namespace ksi
+{
+   /** Sparse membership matrix in the compressed sparse row (CSR) format.
+    *  Each row represents a cluster, each column -- a data item.
+    *  Only non-zero memberships are stored, so the memory is proportional
+    *  to the number of memberships, not to clusters x data items.
+    *  @date 2026-10-18
+    */
+   class sparse_membership_matrix
+   {
+      /** number of columns (data items) */
+      std::size_t _nColumns = 0;
+
+      /** row r occupies [_offsets[r], _offsets[r + 1]) in _columns and _values */
+      std::vector<std::size_t> _offsets { 0 };
+
+      /** column indices of non-zero values, ascending in each row */
+      std::vector<std::size_t> _columns;
+
+      /** non-zero values */
+      std::vector<double> _values;
+
+   public:
+      sparse_membership_matrix ();
+
+      /** @param number_of_columns number of columns (data items) */
+      explicit sparse_membership_matrix (const std::size_t number_of_columns);
+
+      /** The method appends a row.
+          @param columns column indices of non-zero values (ascending)
+          @param values non-zero values
+          @throw ksi::exception if sizes do not match or columns are not ascending or out of range */
+      void add_row (const std::vector<std::size_t> & columns, const std::vector<double> & values);
+
+      /** The method appends a dense row. Zeros are not stored.
+          @param row dense row with number_of_columns values */
+      void add_row (const std::vector<double> & row);
+
+      std::size_t get_number_of_rows () const;
+      std::size_t get_number_of_columns () const;
+      /** @return number of stored (non-zero) values */
+      std::size_t get_number_of_nonzeros () const;
+
+      /** @return column indices of non-zero values in a row */
+      std::span<const std::size_t> get_columns (const std::size_t row) const;
+
+      /** @return non-zero values in a row (in the order of get_columns) */
+      std::span<const double> get_values (const std::size_t row) const;
+
+      /** @return value in a cell (binary search in the row) */
+      double get_value (const std::size_t row, const std::size_t column) const;
+
+      /** @return the matrix in the dense form */
+      std::vector<std::vector<double>> to_dense () const;
+   };
+}
+
+#endif
@@ -0,0 +1,240 @@
+/** @file */
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <future>
+#include <charconv>
+#include <random>
+#include <utility>
+
+#include "../readers/data_stream.h"
+#include "../common/datum.h"
+#include "../common/dataset.h"
+#include "../common/number.h"
+#include "../auxiliary/random_service.h"
+#include "../service/exception.h"
+
+namespace
+{
+   /** @return true for a separator of values in a line */
+   bool is_separator (const char c)
+   {
+      return c == ' ' or c == ',' or c == '\t' or c == '\r';
+   }
+
+   /** The function parses values of a line.
+       @param line line of the file
+       @param values parsed values (the vector is cleared)
+       @return true if the line holds all values legally */
+   bool parse_line (const std::string & line, std::vector<double> & values)
+   {
+      values.clear();
+      const char * p = line.data();
+      const char * end = p + line.size();
+      while (true)
+      {
+         while (p < end and is_separator(*p))
+            p++;
+         if (p == end)
+            return true;
+         if (*p == '+')
+            p++;
+         double value;
+         auto [ptr, error] = std::from_chars(p, end, value);
+         if (error != std::errc() or (ptr < end and not is_separator(*ptr)))
+            return false;
+         values.push_back(value);
+         p = ptr;
+      }
+   }
+}
+
+ksi::data_stream::data_stream(const std::string & filename, const std::size_t chunk_size)
+: _filename (filename), _chunk_size (chunk_size)
+{
+   try
+   {
+      if (_chunk_size == 0)
+         throw ksi::exception ("The size of a chunk is zero.");
+
+      _file.open(_filename);
+      if (not _file)
+         throw ksi::exception ("impossible to open file <" + _filename + ">");
+
+      // the number of attributes is read from the first data item
+      std::string line;
+      std::vector<double> values;
+      while (_nAttributes == 0 and std::getline(_file, line))
+      {
+         if (not parse_line(line, values))
+            throw ksi::exception ("Illegal value in the file <" + _filename + ">: " + line);
+         _nAttributes = values.size();
+      }
+      if (_nAttributes == 0)
+         throw ksi::exception ("No data in the file <" + _filename + ">.");
+
+      rewind();
+   }
+   CATCH;
+}
+
+ksi::data_stream::~data_stream()
+{
+   wait();
+}
+
+void ksi::data_stream::wait()
+{
+   if (_next.valid())
+   {
+      try
+      {
+         _next.get();
+      }
+      catch (...)
+      {
+         // an error of a discarded chunk is not reported
+      }
+   }
+}
+
+ksi::data_stream::chunk ksi::data_stream::read_chunk(chunk buffer)
+{
+   const std::size_t nX = _nAttributes - 1;
+   std::size_t n = 0;
+   std::string line;
+   std::vector<double> values;
+   values.reserve(_nAttributes);
+
+   while (n < _chunk_size and std::getline(_file, line))
+   {
+      if (not parse_line(line, values))
+         throw ksi::exception ("Illegal value in the file <" + _filename + ">: " + line);
+      if (values.empty())
+         continue;
+      if (values.size() != _nAttributes)
+         throw ksi::exception ("A data item in the file <" + _filename + "> has " + std::to_string(values.size())
+                               + " attributes instead of " + std::to_string(_nAttributes) + ": " + line);
+
+      if (n == buffer.X.size())
+      {
+         buffer.X.emplace_back(nX);
+         buffer.Y.push_back(0.0);
+      }
+      std::copy(values.begin(), values.begin() + nX, buffer.X[n].begin());
+      buffer.Y[n] = values[nX];
+      n++;
+   }
+   buffer.X.resize(n);
+   buffer.Y.resize(n);
+   return buffer;
+}
+
+void ksi::data_stream::prefetch(chunk buffer)
+{
+   _next = std::async(std::launch::async, [this, buffer = std::move(buffer)] () mutable
+   {
+      return read_chunk(std::move(buffer));
+   });
+}
+
+void ksi::data_stream::rewind()
+{
+   try
+   {
+      wait();
+      _file.clear();
+      _file.seekg(0);
+      _nRead = 0;
+      prefetch(chunk {});
+   }
+   CATCH;
+}
+
+bool ksi::data_stream::next(chunk & c)
+{
+   try
+   {
+      if (not _next.valid())
+         return false;
+
+      chunk ready = _next.get();
+      if (ready.Y.empty())
+      {
+         _nData = _nRead;
+         _bCounted = true;
+         return false;
+      }
+      _nRead += ready.Y.size();
+
+      // the previous buffer of the caller is filled with the next chunk
+      std::swap(c, ready);
+      prefetch(std::move(ready));
+      return true;
+   }
+   CATCH;
+}
+
+ksi::dataset ksi::data_stream::sample(const std::size_t size)
+{
+   try
+   {
+      rewind();
+
+      std::vector<std::vector<double>> reservoir;
+      auto engine = ksi::random_service::next_stream();
+      std::size_t i = 0;
+      chunk c;
+      while (next(c))
+      {
+         for (std::size_t x = 0; x < c.Y.size(); x++, i++)
+         {
+            std::size_t position = i;
+            if (i >= size)
+            {
+               std::uniform_int_distribution<std::size_t> distribution (0, i);
+               position = distribution(engine);
+               if (position >= size)
+                  continue;
+            }
+            std::vector<double> row (c.X[x]);
+            row.push_back(c.Y[x]);
+            if (position < reservoir.size())
+               reservoir[position] = std::move(row);
+            else
+               reservoir.push_back(std::move(row));
+         }
+      }
+      rewind();
+
+      ksi::dataset ds;
+      for (std::size_t r = 0; r < reservoir.size(); r++)
+      {
+         ksi::datum d;
+         for (const auto value : reservoir[r])
+            d.push_back(ksi::number (value));
+         d.setID(r);
+         d.setIDincomplete(-1);
+         ds.addDatum(d);
+      }
+      return ds;
+   }
+   CATCH;
+}
+
+std::size_t ksi::data_stream::get_number_of_attributes() const
+{
+   return _nAttributes;
+}
+
+std::size_t ksi::data_stream::get_number_of_data() const
+{
+   try
+   {
+      if (not _bCounted)
+         throw ksi::exception ("No pass over the file <" + _filename + "> has been completed yet.");
+      return _nData;
+   }
+   CATCH;
+}
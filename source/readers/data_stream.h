@@ -0,0 +1,99 @@
+/** @file */
+
+#ifndef DATA_STREAM_H
+#define DATA_STREAM_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <future>
+
+#include "../common/dataset.h"
+
+namespace ksi
+{
+   /** Stream of complete data items read from a file in chunks.
+       The file has the format read by ksi::reader_complete (one data item in a line,
+       values separated with spaces, commas or tabs), the last attribute is the decision.
+       Only two chunks are kept in memory: while the caller elaborates a chunk,
+       the next one is read and parsed by another thread (double buffering),
+       so the file can be larger than the memory. Buffers of chunks are reused.
+       The stream is rewound for each pass (epoch) over the data.
+       @date 2026-10-19 */
+   class data_stream
+   {
+   public:
+      /** chunk of data items */
+      struct chunk
+      {
+         /** attributes of data items (without the decision) */
+         std::vector<std::vector<double>> X;
+         /** decisions (last attributes) of data items */
+         std::vector<double> Y;
+      };
+
+   protected:
+      std::string _filename;
+      /** number of data items in a chunk */
+      std::size_t _chunk_size;
+      std::ifstream _file;
+      /** number of attributes of data items (with the decision) read from the first data item */
+      std::size_t _nAttributes = 0;
+      /** number of data items in the file, known after the first pass */
+      std::size_t _nData = 0;
+      /** number of data items read in the current pass */
+      std::size_t _nRead = 0;
+      /** true: the whole file has been read at least once */
+      bool _bCounted = false;
+      /** the next chunk read in the background */
+      std::future<chunk> _next;
+
+      /** The method reads the next chunk from the file into a buffer.
+          @param buffer buffer to reuse (its capacity is kept)
+          @return the chunk, empty at the end of the file
+          @throw ksi::exception if a line has an illegal value or a wrong number of values */
+      chunk read_chunk (chunk buffer);
+
+      /** The method starts reading of the next chunk in the background. */
+      void prefetch (chunk buffer);
+
+      /** The method waits for the chunk read in the background (if any). */
+      void wait ();
+
+   public:
+      /** @param filename name of the file with data
+          @param chunk_size number of data items in a chunk
+          @throw ksi::exception if the file cannot be opened or the chunk size is zero */
+      data_stream (const std::string & filename, const std::size_t chunk_size);
+
+      data_stream (const data_stream &) = delete;
+      data_stream & operator= (const data_stream &) = delete;
+
+      virtual ~data_stream ();
+
+      /** The method starts a new pass over the data from the beginning of the file. */
+      void rewind ();
+
+      /** The method returns the next chunk of the current pass.
+          @param c the chunk read (its previous buffer is reused for the next chunk)
+          @return false if there are no more data items in the pass */
+      bool next (chunk & c);
+
+      /** The method draws a uniform sample of data items in one pass over the data
+          (reservoir sampling). If the file has no more data items than the size of the sample,
+          the sample holds all data items in the order of the file.
+          The stream is rewound after the pass.
+          @param size size of the sample
+          @return the sample (data items with the decision) */
+      dataset sample (const std::size_t size);
+
+      /** @return number of attributes of data items (with the decision) */
+      std::size_t get_number_of_attributes () const;
+
+      /** @return number of data items in the file (known after the first whole pass)
+          @throw ksi::exception if no pass has been completed yet */
+      std::size_t get_number_of_data () const;
+   };
+}
+
+#endif
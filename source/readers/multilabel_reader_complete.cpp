@@ -146,7 +146,8 @@ ksi::dataset ksi::multilabel_reader_complete::read(const std::string& filename)
             
             d.setID(item_number++);
             d.setIDincomplete(-1);
-            ds.addDatum(d);
+            // labels are interned in the label dictionary of the dataset
+            ds.addDatum(new datum (std::move(d)));
           }
       }
 
@@ -13,6 +13,8 @@ namespace ksi
      1.2 5.6 7.8 | A B
      There are three atributes: 1.2 and 5.6 and 7.8.
      There are two labels: A and B.
+     Labels are interned in the label dictionary of the read dataset
+     (ksi::dataset::getLabels, ksi::dataset::getLabelIds).
      
      @author Krzysztof Siminski
      @date 2022-05-15
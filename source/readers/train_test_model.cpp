@@ -64,11 +64,8 @@ void ksi::train_test_model::split(const ksi::dataset & base_dataset, const unsig
         {
             const auto current_size = base_size + (i < remainder ? 1 : 0);
 
-            for (auto j = 0; j < current_size; ++j)
-            {
-                datasets[i].addDatum(*base_dataset.getDatum(index));
-                ++index;
-            }
+            datasets[i] = base_dataset.subdataset(index, index + current_size - 1);
+            index += current_size;
         }
     }
     CATCH;
@@ -94,14 +91,7 @@ void ksi::train_test_model::save(const std::filesystem::path& directory, const s
 
             if (file.is_open())
             {
-                for (auto j = 0; j < datasets[i].size(); ++j)
-                {
-                    const datum* d = datasets[i].getDatum(j);
-                    if (d)
-                    {
-                        d->save_print(file);
-                    }
-                }
+                datasets[i].save_print(file);
                 file.close();
             }
             else
@@ -256,9 +246,7 @@ void ksi::train_test_model::iterator::initialize_test_dataset()
 
     for (auto it = pTT->datasets.cbegin(); it != pTT->datasets.cend(); it++) {
         if (it != test_iterator) {
-            for (std::size_t j = 0; j < it->size(); ++j) {
-                train_dataset.addDatum(*it->getDatum(j));
-            }
+            train_dataset += *it;
         }
     }
 }
@@ -332,9 +320,7 @@ void ksi::train_test_model::const_iterator::initialize_test_dataset()
 
     for (auto it = pTT->datasets.cbegin(); it != pTT->datasets.cend(); it++) {
         if (it != test_iterator) {
-            for (std::size_t j = 0; j < it->size(); ++j) {
-                train_dataset.addDatum(*it->getDatum(j));
-            }
+            train_dataset += *it;
         }
     }
 }
@@ -65,11 +65,8 @@ void ksi::train_validation_test_model::split(const ksi::dataset& base_dataset, c
         {
             const auto current_size = base_size + (i < remainder ? 1 : 0);
 
-            for (auto j = 0; j < current_size; ++j)
-            {
-                datasets[i].addDatum(*base_dataset.getDatum(index));
-                ++index;
-            }
+            datasets[i] = base_dataset.subdataset(index, index + current_size - 1);
+            index += current_size;
         }
     }
     CATCH;
@@ -97,14 +94,7 @@ void ksi::train_validation_test_model::save(const std::filesystem::path& directo
 
             if (file.is_open())
             {
-                for (auto j = 0; j < datasets[i].size(); ++j)
-                {
-                    const datum* d = datasets[i].getDatum(j);
-                    if (d)
-                    {
-                        d->save_print(file);
-                    }
-                }
+                datasets[i].save_print(file);
                 file.close();
             }
             else
@@ -273,9 +263,7 @@ void ksi::train_validation_test_model::iterator::initialize_train_and_validation
         }
 
         if (current_validation_count < pTVT->validation_size && it == current_iterator) {
-            for (std::size_t j = 0; j < it->size(); ++j) {
-                validation_dataset.addDatum(*it->getDatum(j));
-            }
+            validation_dataset += *it;
             ++current_validation_count;
             ++current_iterator;
             if (current_iterator == pTVT->datasets.end()) {
@@ -283,9 +271,7 @@ void ksi::train_validation_test_model::iterator::initialize_train_and_validation
             }
         }
         else {
-            for (std::size_t j = 0; j < it->size(); ++j) {
-                train_dataset.addDatum(*it->getDatum(j));
-            }
+            train_dataset += *it;
         }
     }
 }
@@ -373,9 +359,7 @@ void ksi::train_validation_test_model::const_iterator::initialize_train_and_vali
         }
 
         if (current_validation_count < pTVT->validation_size && it == current_iterator) {
-            for (std::size_t j = 0; j < it->size(); ++j) {
-                validation_dataset.addDatum(*it->getDatum(j));
-            }
+            validation_dataset += *it;
             ++current_validation_count;
             ++current_iterator;
             if (current_iterator == pTVT->datasets.cend()) {
@@ -383,9 +367,7 @@ void ksi::train_validation_test_model::const_iterator::initialize_train_and_vali
             }
         }
         else {
-            for (std::size_t j = 0; j < it->size(); ++j) {
-                train_dataset.addDatum(*it->getDatum(j));
-            }
+            train_dataset += *it;
         }
     }
 }
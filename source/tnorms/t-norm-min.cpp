@@ -6,11 +6,6 @@
 #include "t-norm.h"
 
  
-double ksi::t_norm_min::tnorm (const double a, const double b) const
-{
-   return std::min(a, b);
-}
- 
 ksi::t_norm * ksi::t_norm_min::clone() const 
 {
    return new t_norm_min();
@@ -4,6 +4,7 @@
 #define T_NORM_MIN_H
 
 #include <iostream>
+#include <algorithm>
 #include "t-norm.h"
 
 namespace ksi
@@ -11,7 +12,10 @@ namespace ksi
    struct t_norm_min : public t_norm
    {
       /** value of T-norm: \f$ T(a, b) = \min(a, b) \f$ */
-      virtual double tnorm (const double, const double) const;
+      virtual double tnorm (const double a, const double b) const
+      {
+         return std::min(a, b);
+      }
       virtual t_norm * clone() const ;
       
       /** The method prints an object into output stream.
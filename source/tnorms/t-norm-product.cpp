@@ -5,11 +5,6 @@
 
 #include <iostream>
 
-double ksi::t_norm_product::tnorm (const double a, const double b) const
-{
-   return a * b;
-}
- 
 ksi::t_norm * ksi::t_norm_product::clone() const 
 {
    return new t_norm_product();
@@ -4,6 +4,8 @@
 
 #include <iostream>
 
+#include "../auxiliary/object_pool.h"
+
 namespace ksi
 {
    struct t_norm 
@@ -17,6 +19,11 @@ namespace ksi
       virtual std::ostream & Print (std::ostream & ss) const = 0; 
       
       virtual ~t_norm() = 0;
+      
+      /** T-norms are cloned by premises and rules, so they are allocated in ksi::object_pool.
+       *  @date 2026-10-19 */
+      static void * operator new (std::size_t size) { return ksi::object_pool::allocate(size); }
+      static void operator delete (void * p, std::size_t size) { ksi::object_pool::deallocate(p, size); }
    };
 }
 